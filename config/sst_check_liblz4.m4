@@ -0,0 +1,44 @@
+AC_DEFUN([SST_CHECK_LIBLZ4],
+[
+  sst_check_liblz4_happy="yes"
+
+  AC_ARG_WITH([liblz4],
+    [AS_HELP_STRING([--with-liblz4@<:@=DIR@:>@],
+      [Use liblz4 (compression routines) found in DIR])])
+
+  AS_IF([test "$with_liblz4" = "no"], [sst_check_liblz4_happy="no"])
+
+  CPPFLAGS_saved="$CPPFLAGS"
+  LDFLAGS_saved="$LDFLAGS"
+
+  AS_IF([test "$sst_check_liblz4_happy" = "yes"], [
+    AS_IF([test ! -z "$with_liblz4" -a "$with_liblz4" != "yes"],
+      [LIBLZ4_CPPFLAGS="-I$with_liblz4/include"
+       CPPFLAGS="$LIBLZ4_CPPFLAGS $CPPFLAGS"
+       LIBLZ4_LDFLAGS="-L$with_liblz4/lib"
+       LDFLAGS="$LIBLZ4_LDFLAGS $LDFLAGS"],
+      [LIBLZ4_CPPFLAGS=
+       LIBLZ4_LDFLAGS=
+       LIBLZ4_LIB=])])
+
+  AC_LANG_PUSH([C++])
+  AC_CHECK_HEADER([lz4frame.h], [], [sst_check_liblz4_happy="no"])
+  AC_LANG_POP([C++])
+
+  AC_CHECK_LIB([lz4], [LZ4F_decompress],
+    [LIBLZ4_LIB="-llz4"], [sst_check_liblz4_happy="no"])
+
+  CPPFLAGS="$CPPFLAGS_saved"
+  LDFLAGS="$LDFLAGS_saved"
+
+  AC_SUBST([LIBLZ4_CPPFLAGS])
+  AC_SUBST([LIBLZ4_LDFLAGS])
+  AC_SUBST([LIBLZ4_LIB])
+  AS_IF([test "x$sst_check_liblz4_happy" = "xyes"], [AC_DEFINE([HAVE_LIBLZ4],[1],[Defines whether we have the liblz4 library])])
+  AM_CONDITIONAL([USE_LIBLZ4], [test "x$sst_check_liblz4_happy" = "xyes"])
+
+  AC_MSG_CHECKING([for lz4 compression library])
+  AC_MSG_RESULT([$sst_check_liblz4_happy])
+  AS_IF([test "$sst_check_liblz4_happy" = "no" -a ! -z "$with_liblz4" -a "$with_liblz4" != "no"], [$3])
+  AS_IF([test "$sst_check_liblz4_happy" = "yes"], [$1], [$2])
+])
@@ -0,0 +1,44 @@
+AC_DEFUN([SST_CHECK_LIBZSTD],
+[
+  sst_check_libzstd_happy="yes"
+
+  AC_ARG_WITH([libzstd],
+    [AS_HELP_STRING([--with-libzstd@<:@=DIR@:>@],
+      [Use libzstd (compression routines) found in DIR])])
+
+  AS_IF([test "$with_libzstd" = "no"], [sst_check_libzstd_happy="no"])
+
+  CPPFLAGS_saved="$CPPFLAGS"
+  LDFLAGS_saved="$LDFLAGS"
+
+  AS_IF([test "$sst_check_libzstd_happy" = "yes"], [
+    AS_IF([test ! -z "$with_libzstd" -a "$with_libzstd" != "yes"],
+      [LIBZSTD_CPPFLAGS="-I$with_libzstd/include"
+       CPPFLAGS="$LIBZSTD_CPPFLAGS $CPPFLAGS"
+       LIBZSTD_LDFLAGS="-L$with_libzstd/lib"
+       LDFLAGS="$LIBZSTD_LDFLAGS $LDFLAGS"],
+      [LIBZSTD_CPPFLAGS=
+       LIBZSTD_LDFLAGS=
+       LIBZSTD_LIB=])])
+
+  AC_LANG_PUSH([C++])
+  AC_CHECK_HEADER([zstd.h], [], [sst_check_libzstd_happy="no"])
+  AC_LANG_POP([C++])
+
+  AC_CHECK_LIB([zstd], [ZSTD_decompressStream],
+    [LIBZSTD_LIB="-lzstd"], [sst_check_libzstd_happy="no"])
+
+  CPPFLAGS="$CPPFLAGS_saved"
+  LDFLAGS="$LDFLAGS_saved"
+
+  AC_SUBST([LIBZSTD_CPPFLAGS])
+  AC_SUBST([LIBZSTD_LDFLAGS])
+  AC_SUBST([LIBZSTD_LIB])
+  AS_IF([test "x$sst_check_libzstd_happy" = "xyes"], [AC_DEFINE([HAVE_LIBZSTD],[1],[Defines whether we have the libzstd library])])
+  AM_CONDITIONAL([USE_LIBZSTD], [test "x$sst_check_libzstd_happy" = "xyes"])
+
+  AC_MSG_CHECKING([for zstd compression library])
+  AC_MSG_RESULT([$sst_check_libzstd_happy])
+  AS_IF([test "$sst_check_libzstd_happy" = "no" -a ! -z "$with_libzstd" -a "$with_libzstd" != "no"], [$3])
+  AS_IF([test "$sst_check_libzstd_happy" = "yes"], [$1], [$2])
+])
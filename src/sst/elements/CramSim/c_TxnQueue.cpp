@@ -0,0 +1,101 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+
+// std includes
+#include <assert.h>
+
+// local includes
+#include "c_TxnQueue.hpp"
+
+using namespace SST;
+using namespace SST::CramSim;
+
+
+c_TxnQueue::c_TxnQueue() : m_nextStamp(0), m_seqOrdered(true), m_lastSeqNum(0) {
+}
+
+
+void c_TxnQueue::push_back(c_Transaction* x_txn, SimTime_t x_cycle)
+{
+    const c_HashedAddress& l_addr = x_txn->getHashedAddress();
+
+    if(m_entries.empty())
+        m_seqOrdered = true;
+    else if(x_txn->getSeqNum() <= m_lastSeqNum)
+        m_seqOrdered = false;
+    m_lastSeqNum = x_txn->getSeqNum();
+
+    uint64_t l_stamp = m_nextStamp++;
+    m_entries.insert(m_entries.end(), std::make_pair(l_stamp, x_txn));
+    m_stamps[x_txn] = l_stamp;
+    m_arrivals[l_stamp] = x_cycle;
+    m_banks[l_addr.getBankId()].insert(m_banks[l_addr.getBankId()].end(), l_stamp);
+    m_rows[rowKey(l_addr.getBankId(), l_addr.getRow())].insert(l_stamp);
+    m_addrs[x_txn->getAddress()].insert(l_stamp);
+}
+
+
+void c_TxnQueue::remove(c_Transaction* x_txn)
+{
+    std::unordered_map<c_Transaction*, uint64_t>::iterator l_it = m_stamps.find(x_txn);
+    if(l_it == m_stamps.end())
+        return;
+
+    const uint64_t l_stamp = l_it->second;
+    const c_HashedAddress& l_addr = x_txn->getHashedAddress();
+
+    m_entries.erase(l_stamp);
+    m_stamps.erase(l_it);
+    m_arrivals.erase(l_stamp);
+
+    std::map<unsigned, StampSet>::iterator l_bank = m_banks.find(l_addr.getBankId());
+    l_bank->second.erase(l_stamp);
+    if(l_bank->second.empty())
+        m_banks.erase(l_bank);
+
+    std::unordered_map<uint64_t, StampSet>::iterator l_row = m_rows.find(rowKey(l_addr.getBankId(), l_addr.getRow()));
+    l_row->second.erase(l_stamp);
+    if(l_row->second.empty())
+        m_rows.erase(l_row);
+
+    std::unordered_map<ulong, StampSet>::iterator l_txnAddr = m_addrs.find(x_txn->getAddress());
+    l_txnAddr->second.erase(l_stamp);
+    if(l_txnAddr->second.empty())
+        m_addrs.erase(l_txnAddr);
+}
+
+
+const c_TxnQueue::StampSet* c_TxnQueue::getRow(unsigned x_bankId, unsigned x_row) const
+{
+    std::unordered_map<uint64_t, StampSet>::const_iterator l_it = m_rows.find(rowKey(x_bankId, x_row));
+    return (l_it == m_rows.end()) ? nullptr : &l_it->second;
+}
+
+
+const c_TxnQueue::StampSet* c_TxnQueue::getAddress(ulong x_addr) const
+{
+    std::unordered_map<ulong, StampSet>::const_iterator l_it = m_addrs.find(x_addr);
+    return (l_it == m_addrs.end()) ? nullptr : &l_it->second;
+}
+
+
+c_Transaction* c_TxnQueue::oldestWithAddress(ulong x_addr) const
+{
+    const StampSet* l_stamps = getAddress(x_addr);
+    return (l_stamps == nullptr) ? nullptr : m_entries.at(*l_stamps->begin());
+}
@@ -0,0 +1,88 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef C_TXNQUEUE_HPP
+#define C_TXNQUEUE_HPP
+
+#include <map>
+#include <set>
+#include <unordered_map>
+
+#include "c_Transaction.hpp"
+
+namespace SST {
+    namespace CramSim {
+
+        // Transaction queue of one channel, indexed by bank, by (bank, row) and by address.
+        //
+        // Every transaction gets a stamp when it is pushed; the stamps give the arrival
+        // order, and each index is a set of stamps so that the oldest (or youngest)
+        // transaction of a bank, of an open row or of an address is found without
+        // scanning the queue.
+        class c_TxnQueue {
+        public:
+            typedef std::set<uint64_t> StampSet;
+            typedef std::map<uint64_t, c_Transaction*> EntryMap;
+
+            c_TxnQueue();
+
+            size_t size() const { return m_entries.size(); }
+            bool empty() const { return m_entries.empty(); }
+            c_Transaction* front() const { return m_entries.begin()->second; }
+
+            void push_back(c_Transaction* x_txn, SimTime_t x_cycle);
+            void remove(c_Transaction* x_txn);
+
+            //** transactions in arrival order
+            const EntryMap& entries() const { return m_entries; }
+            c_Transaction* at(uint64_t x_stamp) const { return m_entries.at(x_stamp); }
+            uint64_t getStamp(c_Transaction* x_txn) const { return m_stamps.at(x_txn); }
+            SimTime_t getArrivalCycle(uint64_t x_stamp) const { return m_arrivals.at(x_stamp); }
+
+            //** stamps of the queued transactions of each bank, for banks with at least one
+            const std::map<unsigned, StampSet>& banks() const { return m_banks; }
+            //** stamps of the queued transactions to a row, NULL if there are none
+            const StampSet* getRow(unsigned x_bankId, unsigned x_row) const;
+            //** stamps of the queued transactions to an address, NULL if there are none
+            const StampSet* getAddress(ulong x_addr) const;
+
+            //** oldest queued transaction to x_addr, NULL if there is none
+            c_Transaction* oldestWithAddress(ulong x_addr) const;
+
+            //** true while sequence numbers have increased strictly in arrival order since the
+            //** queue was last empty, i.e., arrival order and sequence order agree
+            bool isSeqOrdered() const { return m_seqOrdered; }
+
+        private:
+            static uint64_t rowKey(unsigned x_bankId, unsigned x_row) {
+                return ((uint64_t) x_bankId << 32) | x_row;
+            }
+
+            EntryMap m_entries;
+            std::unordered_map<c_Transaction*, uint64_t> m_stamps;
+            std::unordered_map<uint64_t, SimTime_t> m_arrivals;
+            std::map<unsigned, StampSet> m_banks;
+            std::unordered_map<uint64_t, StampSet> m_rows;
+            std::unordered_map<ulong, StampSet> m_addrs;
+
+            uint64_t m_nextStamp;
+            bool m_seqOrdered;
+            ulong m_lastSeqNum;
+        };
+    }
+}
+
+#endif //C_TXNQUEUE_HPP
@@ -32,6 +32,8 @@
 
 // std includes
 #include <iostream>
+#include <sstream>
+#include <algorithm>
 #include <assert.h>
 
 // local includes
@@ -68,6 +70,14 @@ void c_TxnScheduler::build(Params& x_params) {
     else if(l_txnSchedulingPolicy=="FRFCFS")
     {
         k_txnSchedulingPolicy=e_txnSchedulingPolicy::FRFCFS;
+    }
+    else if(l_txnSchedulingPolicy=="BLISS")
+    {
+        k_txnSchedulingPolicy=e_txnSchedulingPolicy::BLISS;
+    }
+    else if(l_txnSchedulingPolicy=="ATLAS")
+    {
+        k_txnSchedulingPolicy=e_txnSchedulingPolicy::ATLAS;
     } else
     {
         m_out->fatal(CALL_INFO, 1, "unsupported txnSchedulingPolicy (%s),, exit\n", l_txnSchedulingPolicy.c_str());
@@ -84,6 +94,8 @@ void c_TxnScheduler::build(Params& x_params) {
         m_out->output("boolReadFirstTxnScheduling value is missing... disabled\n");
     }
 
+    k_checkFRFCFS = (unsigned) x_params.find<unsigned>("checkFRFCFS", 0);
+
 
     //initialize per-channel transaction queues
     if(!k_isReadFirstScheduling)
@@ -114,6 +126,78 @@ void c_TxnScheduler::build(Params& x_params) {
         m_minNumPendingWrite = (unsigned) ((float) k_numTxnQEntries * k_minPendingWriteThreshold);
         m_flushWriteQueue = false;
     }
+
+    m_simCycle = 0;
+
+    //source id bit field of the transaction address, shared by BLISS and ATLAS
+    k_sourceIdStart = 0;
+    k_sourceIdMask = 0;
+    k_numSources = 1;
+
+    string l_sourceIdString = (string) x_params.find<string>("sourceIdPos", "", l_found);
+    if(k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS || k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+        if (!l_found) {
+            m_out->output("sourceIdPos value is missing... all transactions will be treated as coming from one source\n");
+        } else {
+            stringstream string_stream;
+            string_stream.str(l_sourceIdString);
+            string item;
+            vector<string> strings;
+            while (getline(string_stream, item, ':')) {
+                strings.push_back(item);
+            }
+
+            if (strings.size() != 2) {
+                m_out->fatal(CALL_INFO, -1, "sourceIdPos error! it should be \"end:start\" =>%s\n", l_sourceIdString.c_str());
+            }
+
+            int l_end = atoi(strings[0].c_str());
+            int l_start = atoi(strings[1].c_str());
+            if (l_end < l_start || l_start < 0 || l_end - l_start >= 16) {
+                m_out->fatal(CALL_INFO, -1, "sourceIdPos error!! End position: %d Start position: %d (at most 16 bits)\n",
+                        l_end, l_start);
+            }
+
+            k_sourceIdStart = l_start;
+            k_numSources = 1 << (l_end - l_start + 1);
+            k_sourceIdMask = k_numSources - 1;
+        }
+    }
+
+    //BLISS
+    k_blissBlacklistThreshold = (unsigned) x_params.find<unsigned>("blissBlacklistThreshold", 4, l_found);
+    if (!l_found && k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS) {
+        m_out->output("blissBlacklistThreshold value is missing... it will be 4 (default)\n");
+    }
+    k_blissClearingInterval = (SimTime_t) x_params.find<SimTime_t>("blissClearingInterval", 10000, l_found);
+    if (!l_found && k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS) {
+        m_out->output("blissClearingInterval value is missing... it will be 10000 (default)\n");
+    }
+    m_blacklisted.assign(k_numSources, false);
+    m_lastSource.assign(m_numChannels, 0);
+    m_sourceStreak.assign(m_numChannels, 0);
+    m_lastBlacklistClear = 0;
+
+    //ATLAS
+    k_atlasQuantum = (SimTime_t) x_params.find<SimTime_t>("atlasQuantum", 1000000, l_found);
+    if (!l_found && k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+        m_out->output("atlasQuantum value is missing... it will be 1000000 (default)\n");
+    }
+    k_atlasHistoryWeight = (double) x_params.find<double>("atlasHistoryWeight", 0.875, l_found);
+    if (!l_found && k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+        m_out->output("atlasHistoryWeight value is missing... it will be 0.875 (default)\n");
+    }
+    k_atlasStarvationThreshold = (SimTime_t) x_params.find<SimTime_t>("atlasStarvationThreshold", 100000, l_found);
+    if (!l_found && k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+        m_out->output("atlasStarvationThreshold value is missing... it will be 100000 (default)\n");
+    }
+    if (k_blissClearingInterval == 0 || k_atlasQuantum == 0 || k_atlasHistoryWeight < 0 || k_atlasHistoryWeight > 1) {
+        m_out->fatal(CALL_INFO, 1, "blissClearingInterval and atlasQuantum should be greater than 0, and atlasHistoryWeight between 0 and 1\n");
+    }
+    m_attainedService.assign(k_numSources, 0);
+    m_totalService.assign(k_numSources, 0.0);
+    m_sourceRank.assign(k_numSources, 0);
+    m_quantumStart = 0;
 }
 
 c_TxnScheduler::~c_TxnScheduler() {
@@ -123,6 +207,8 @@ c_TxnScheduler::~c_TxnScheduler() {
 
 void c_TxnScheduler::run(SimTime_t simCycle){
 
+    m_simCycle = simCycle;
+    updatePolicyState(simCycle);
 
     for(int l_channelID=0; l_channelID<m_numChannels; l_channelID++) {
 
@@ -167,6 +253,7 @@ void c_TxnScheduler::run(SimTime_t simCycle){
 
                 // send the selected transaction
                 m_txnConverter->push(l_nextTxn);
+                recordService(l_nextTxn, l_channelID);
 
                 #ifdef __SST_DEBUG_OUTPUT__
                 l_nextTxn->print(output, "[c_TxnScheduler]",simCycle);
@@ -197,21 +284,16 @@ c_Transaction* c_TxnScheduler::getNextTxn(TxnQueue& x_queue, int x_ch)
             }
         }//FRFCFS
         else if(k_txnSchedulingPolicy == e_txnSchedulingPolicy::FRFCFS) {
-            for (auto &l_txn: x_queue) {
-                if (m_cmdScheduler->getToken(l_txn->getHashedAddress()) >= 3) {
-                    if(hasDependancy(l_txn, x_ch)==false)
-                        l_nxtTxn = l_txn;
-                    else
-                        continue;
-
-                    c_BankInfo *l_bankInfo = m_txnConverter->getBankInfo(l_txn->getHashedAddress().getBankId());
+            l_nxtTxn = getNextTxnFRFCFS(x_queue, x_ch);
 
-                    if (l_bankInfo->isRowOpen()
-                        && l_bankInfo->getOpenRowNum() == l_txn->getHashedAddress().getRow()) {
-                        break;
-                    }
-                }
+            if(k_checkFRFCFS && l_nxtTxn != getNextTxnFRFCFSScan(x_queue, x_ch)) {
+                m_out->fatal(CALL_INFO, 1, "FRFCFS chose a different transaction than a scan of the queue on channel %d at cycle %" PRIu64 "\n",
+                        x_ch, (uint64_t) m_simCycle);
             }
+        }//BLISS, ATLAS
+        else if(k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS
+                || k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+            l_nxtTxn = getNextTxnByPriority(x_queue, x_ch);
         }
         else
         {
@@ -222,6 +304,211 @@ c_Transaction* c_TxnScheduler::getNextTxn(TxnQueue& x_queue, int x_ch)
 }
 
 
+bool c_TxnScheduler::isBankIssuable(const TxnQueue& x_queue, const TxnQueue::StampSet& x_bankStamps)
+{
+    // the command queue tokens are per bank, so any transaction of the bank tells
+    return m_cmdScheduler->getToken(x_queue.at(*x_bankStamps.begin())->getHashedAddress()) >= 3;
+}
+
+
+bool c_TxnScheduler::isRowHit(c_Transaction* x_txn)
+{
+    c_BankInfo *l_bankInfo = m_txnConverter->getBankInfo(x_txn->getHashedAddress().getBankId());
+
+    return l_bankInfo->isRowOpen() && l_bankInfo->getOpenRowNum() == x_txn->getHashedAddress().getRow();
+}
+
+
+// Same choice as a scan of the queue in arrival order that stops at the first issuable row hit and
+// otherwise keeps the last issuable transaction, but only the banks are visited: the row hits of a
+// bank are found through the row index, and the youngest issuable transaction from the back of the
+// bank index.
+c_Transaction* c_TxnScheduler::getNextTxnFRFCFS(TxnQueue& x_queue, int x_ch)
+{
+    c_Transaction* l_hitTxn = nullptr;
+    uint64_t l_hitStamp = 0;
+    c_Transaction* l_lastTxn = nullptr;
+    uint64_t l_lastStamp = 0;
+
+    for (auto &l_bank: x_queue.banks()) {
+        if (!isBankIssuable(x_queue, l_bank.second))
+            continue;
+
+        //oldest issuable row hit of the bank
+        c_BankInfo *l_bankInfo = m_txnConverter->getBankInfo(l_bank.first);
+        if (l_bankInfo->isRowOpen()) {
+            const TxnQueue::StampSet* l_row = x_queue.getRow(l_bank.first, l_bankInfo->getOpenRowNum());
+            if (l_row != nullptr) {
+                for (auto &l_stamp: *l_row) {
+                    if (l_hitTxn != nullptr && l_stamp > l_hitStamp)
+                        break;
+                    c_Transaction* l_txn = x_queue.at(l_stamp);
+                    if (hasDependancy(l_txn, x_ch) == false) {
+                        l_hitTxn = l_txn;
+                        l_hitStamp = l_stamp;
+                        break;
+                    }
+                }
+            }
+        }
+
+        //youngest issuable transaction of the bank
+        if (l_hitTxn == nullptr) {
+            for (auto l_it = l_bank.second.rbegin(); l_it != l_bank.second.rend(); ++l_it) {
+                if (l_lastTxn != nullptr && *l_it < l_lastStamp)
+                    break;
+                c_Transaction* l_txn = x_queue.at(*l_it);
+                if (hasDependancy(l_txn, x_ch) == false) {
+                    l_lastTxn = l_txn;
+                    l_lastStamp = *l_it;
+                    break;
+                }
+            }
+        }
+    }
+
+    return (l_hitTxn != nullptr) ? l_hitTxn : l_lastTxn;
+}
+
+
+// FRFCFS as it was before the queues were indexed
+c_Transaction* c_TxnScheduler::getNextTxnFRFCFSScan(TxnQueue& x_queue, int x_ch)
+{
+    c_Transaction* l_nxtTxn = nullptr;
+
+    for (auto &l_entry: x_queue.entries()) {
+        c_Transaction* l_txn = l_entry.second;
+
+        if (m_cmdScheduler->getToken(l_txn->getHashedAddress()) >= 3) {
+            TxnQueue* l_depQueue = &m_txnQ[x_ch];
+            if (k_isReadFirstScheduling)
+                l_depQueue = l_txn->isRead() ? &m_txnWriteQ[x_ch] : &m_txnReadQ[x_ch];
+
+            if (hasDependancyScan(*l_depQueue, l_txn) == false)
+                l_nxtTxn = l_txn;
+            else
+                continue;
+
+            if (isRowHit(l_txn))
+                break;
+        }
+    }
+
+    return l_nxtTxn;
+}
+
+
+c_Transaction* c_TxnScheduler::getNextTxnByPriority(TxnQueue& x_queue, int x_ch)
+{
+    c_Transaction* l_bestTxn = nullptr;
+    uint64_t l_bestPriority = 0;
+    uint64_t l_bestStamp = 0;
+
+    for (auto &l_bank: x_queue.banks()) {
+        if (!isBankIssuable(x_queue, l_bank.second))
+            continue;
+
+        //within a bank the stamps are visited oldest first, so the first transaction
+        //with the best possible priority ends the search of the bank
+        for (auto &l_stamp: l_bank.second) {
+            c_Transaction* l_txn = x_queue.at(l_stamp);
+            if (hasDependancy(l_txn, x_ch))
+                continue;
+
+            uint64_t l_priority = getPriority(x_queue, l_txn, isRowHit(l_txn));
+            if (l_bestTxn == nullptr || l_priority < l_bestPriority
+                || (l_priority == l_bestPriority && l_stamp < l_bestStamp)) {
+                l_bestTxn = l_txn;
+                l_bestPriority = l_priority;
+                l_bestStamp = l_stamp;
+            }
+
+            if (l_priority == 0)
+                break;
+        }
+    }
+
+    return l_bestTxn;
+}
+
+
+uint64_t c_TxnScheduler::getPriority(const TxnQueue& x_queue, c_Transaction* x_txn, bool x_isHit)
+{
+    unsigned l_source = getSourceId(x_txn);
+
+    if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS) {
+        //non-blacklisted sources first, then row hits
+        return (m_blacklisted[l_source] ? 2 : 0) + (x_isHit ? 0 : 1);
+    }
+
+    //ATLAS: starving transactions first, then the least attained service, then row hits
+    SimTime_t l_age = m_simCycle - x_queue.getArrivalCycle(x_queue.getStamp(x_txn));
+    if (l_age > k_atlasStarvationThreshold)
+        return 0;
+    return 1 + 2 * (uint64_t) m_sourceRank[l_source] + (x_isHit ? 0 : 1);
+}
+
+
+unsigned c_TxnScheduler::getSourceId(c_Transaction* x_txn)
+{
+    return (unsigned) ((x_txn->getAddress() >> k_sourceIdStart) & k_sourceIdMask);
+}
+
+
+void c_TxnScheduler::updatePolicyState(SimTime_t x_cycle)
+{
+    if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS) {
+        if (x_cycle - m_lastBlacklistClear >= k_blissClearingInterval) {
+            std::fill(m_blacklisted.begin(), m_blacklisted.end(), false);
+            m_lastBlacklistClear = x_cycle;
+        }
+    }
+    else if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+        if (x_cycle - m_quantumStart >= k_atlasQuantum) {
+            for (unsigned l_src = 0; l_src < k_numSources; l_src++) {
+                m_totalService[l_src] = k_atlasHistoryWeight * m_totalService[l_src]
+                                        + (1.0 - k_atlasHistoryWeight) * (double) m_attainedService[l_src];
+                m_attainedService[l_src] = 0;
+            }
+
+            std::vector<unsigned> l_order(k_numSources);
+            for (unsigned l_src = 0; l_src < k_numSources; l_src++)
+                l_order[l_src] = l_src;
+            std::stable_sort(l_order.begin(), l_order.end(), [this](unsigned a, unsigned b) {
+                return m_totalService[a] < m_totalService[b];
+            });
+            for (unsigned l_rank = 0; l_rank < k_numSources; l_rank++)
+                m_sourceRank[l_order[l_rank]] = l_rank;
+
+            m_quantumStart = x_cycle;
+        }
+    }
+}
+
+
+void c_TxnScheduler::recordService(c_Transaction* x_txn, int x_ch)
+{
+    unsigned l_source = getSourceId(x_txn);
+
+    if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::BLISS) {
+        if (m_lastSource[x_ch] == l_source) {
+            m_sourceStreak[x_ch]++;
+        } else {
+            m_lastSource[x_ch] = l_source;
+            m_sourceStreak[x_ch] = 1;
+        }
+
+        if (m_sourceStreak[x_ch] > k_blissBlacklistThreshold) {
+            m_blacklisted[l_source] = true;
+            m_sourceStreak[x_ch] = 0;
+        }
+    }
+    else if (k_txnSchedulingPolicy == e_txnSchedulingPolicy::ATLAS) {
+        m_attainedService[l_source]++;
+    }
+}
+
+
 void c_TxnScheduler::popTxn(TxnQueue &x_txnQ, c_Transaction* x_Txn)
 {
     x_txnQ.remove(x_Txn);
@@ -234,7 +521,7 @@ bool c_TxnScheduler::push(c_Transaction* newTxn)
     if(!k_isReadFirstScheduling)
     {
         if (m_txnQ.at(l_channelId).size() < k_numTxnQEntries) {
-            m_txnQ.at(l_channelId).push_back(newTxn);
+            m_txnQ.at(l_channelId).push_back(newTxn, m_simCycle);
             l_success=true;
         } else
             l_success=false;
@@ -243,7 +530,7 @@ bool c_TxnScheduler::push(c_Transaction* newTxn)
         if(newTxn->isRead())
         {
             if(m_txnReadQ[l_channelId].size()< k_numTxnQEntries) {
-                m_txnReadQ[l_channelId].push_back(newTxn);
+                m_txnReadQ[l_channelId].push_back(newTxn, m_simCycle);
                 l_success = true;
             }
             else
@@ -252,7 +539,7 @@ bool c_TxnScheduler::push(c_Transaction* newTxn)
         {
             if(m_txnWriteQ[l_channelId].size()< k_numTxnQEntries) {
                 l_success=true;
-                m_txnWriteQ[l_channelId].push_back(newTxn);
+                m_txnWriteQ[l_channelId].push_back(newTxn, m_simCycle);
             }else
                 l_success=false;
         }
@@ -278,13 +565,14 @@ bool c_TxnScheduler::isHit(c_Transaction* x_txn)
             l_queue = &m_txnWriteQ.at(l_channelId);
         }
 
-        //traverse the transaction queue in reverse order
-        for (TxnQueue::reverse_iterator l_txnItr = l_queue->rbegin(); l_txnItr != l_queue->rend(); ++l_txnItr) {
-            c_Transaction *l_txn = *l_txnItr;
-
-            if (l_txn->isWrite() && (l_txn->getAddress() == x_txn->getAddress())) {
-                l_isHit = true;
-                break;
+        //look for a write among the queued transactions to the same address
+        const TxnQueue::StampSet* l_stamps = l_queue->getAddress(x_txn->getAddress());
+        if (l_stamps != nullptr) {
+            for (auto l_stampItr = l_stamps->rbegin(); l_stampItr != l_stamps->rend(); ++l_stampItr) {
+                if (l_queue->at(*l_stampItr)->isWrite()) {
+                    l_isHit = true;
+                    break;
+                }
             }
         }
     }
@@ -295,7 +583,6 @@ bool c_TxnScheduler::isHit(c_Transaction* x_txn)
 bool c_TxnScheduler::hasDependancy(c_Transaction *x_txn, int x_ch)
 {
     TxnQueue* l_queue= nullptr;
-    bool l_hasDependancy = false;
 
     if(!k_isReadFirstScheduling)
         l_queue=&m_txnQ[x_ch];
@@ -307,8 +594,27 @@ bool c_TxnScheduler::hasDependancy(c_Transaction *x_txn, int x_ch)
             l_queue= &m_txnReadQ[x_ch];
     }
 
-    for(auto &l_txn: *l_queue)
+    //when arrival order and sequence order agree, the transactions before the first one with a
+    //sequence number not smaller than x_txn's are exactly the older ones, so the oldest queued
+    //transaction to the same address decides
+    if(l_queue->isSeqOrdered())
     {
+        c_Transaction* l_oldest = l_queue->oldestWithAddress(x_txn->getAddress());
+        return l_oldest != nullptr && l_oldest->getSeqNum() < x_txn->getSeqNum();
+    }
+
+    return hasDependancyScan(*l_queue, x_txn);
+}
+
+
+bool c_TxnScheduler::hasDependancyScan(TxnQueue& x_queue, c_Transaction* x_txn)
+{
+    bool l_hasDependancy = false;
+
+    for(auto &l_entry: x_queue.entries())
+    {
+        c_Transaction* l_txn = l_entry.second;
+
         if(l_txn->getAddress()==x_txn->getAddress()
            && l_txn->getSeqNum()<x_txn->getSeqNum())
             l_hasDependancy = true;
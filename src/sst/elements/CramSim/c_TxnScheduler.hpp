@@ -32,6 +32,7 @@
 #define C_TXNSCHEDULER_HPP
 
 #include "c_Transaction.hpp"
+#include "c_TxnQueue.hpp"
 #include "c_TxnConverter.hpp"
 #include "c_Controller.hpp"
 
@@ -42,8 +43,8 @@ namespace SST {
         class c_TxnConverter;
         class c_Controller;
 
-        enum class e_txnSchedulingPolicy {FCFS, FRFCFS};
-        typedef std::list<c_Transaction*> TxnQueue;
+        enum class e_txnSchedulingPolicy {FCFS, FRFCFS, BLISS, ATLAS};
+        typedef c_TxnQueue TxnQueue;
 
         class c_TxnScheduler: public SubComponent{
         public:
@@ -60,11 +61,18 @@ namespace SST {
             )
 
             SST_ELI_DOCUMENT_PARAMS(
-                {"txnSchedulingPolicy", "Transaction scheduling policy", "FCFS"},
+                {"txnSchedulingPolicy", "Transaction scheduling policy (FCFS, FRFCFS, BLISS or ATLAS)", "FCFS"},
                 {"numTxnQEntries", "The number of transaction queue entries", "32"},
                 {"boolReadFirstTxnScheduling", "", "0"},
                 {"maxPendingWriteThreshold", "", "1.0"},
                 {"minPendingWriteThreshold", "", "0.2"},
+                {"sourceIdPos", "Bit position of the source (core/thread) id in the transaction address, \"end:start\". BLISS and ATLAS treat all transactions as one source when it is not set", ""},
+                {"blissBlacklistThreshold", "BLISS: a source served more than this many times in a row on a channel is blacklisted", "4"},
+                {"blissClearingInterval", "BLISS: cycles between clearings of the blacklist", "10000"},
+                {"atlasQuantum", "ATLAS: cycles per quantum, sources are re-ranked at the end of each quantum", "1000000"},
+                {"atlasHistoryWeight", "ATLAS: weight of the attained service of past quanta when ranking", "0.875"},
+                {"atlasStarvationThreshold", "ATLAS: transactions waiting for more than this many cycles are served first", "100000"},
+                {"checkFRFCFS", "FRFCFS: check every choice against a scan of the whole queue in arrival order and stop on a mismatch (slow, for testing)", "0"},
             )
 
             SST_ELI_DOCUMENT_PORTS(
@@ -87,6 +95,24 @@ namespace SST {
             virtual bool hasDependancy(c_Transaction* x_txn, int x_ch);
             virtual void popTxn(TxnQueue& x_queue, c_Transaction* x_txn);
 
+            //** true if the command queue of the bank has room for the commands of a transaction
+            bool isBankIssuable(const TxnQueue& x_queue, const TxnQueue::StampSet& x_bankStamps);
+            //** true if x_txn accesses the open row of its bank
+            bool isRowHit(c_Transaction* x_txn);
+            //** first issuable transaction hitting an open row, otherwise the youngest issuable one
+            c_Transaction* getNextTxnFRFCFS(TxnQueue& x_queue, int x_ch);
+            //** the same choice made by scanning the whole queue, used by checkFRFCFS
+            c_Transaction* getNextTxnFRFCFSScan(TxnQueue& x_queue, int x_ch);
+            //** hasDependancy() by scanning the whole queue
+            bool hasDependancyScan(TxnQueue& x_queue, c_Transaction* x_txn);
+            //** issuable transaction with the lowest getPriority(), the oldest among equals
+            c_Transaction* getNextTxnByPriority(TxnQueue& x_queue, int x_ch);
+            //** priority of x_txn under BLISS or ATLAS, lower values are served first
+            uint64_t getPriority(const TxnQueue& x_queue, c_Transaction* x_txn, bool x_isHit);
+            unsigned getSourceId(c_Transaction* x_txn);
+            void updatePolicyState(SimTime_t x_cycle);
+            void recordService(c_Transaction* x_txn, int x_ch);
+
             //**transaction converter
             c_TxnConverter* m_txnConverter;
             //**command Scheduler
@@ -111,6 +137,31 @@ namespace SST {
             float k_maxPendingWriteThreshold;
             float k_minPendingWriteThreshold;
             bool k_isReadFirstScheduling;
+            bool k_checkFRFCFS;
+
+            //source id bit field, used by BLISS and ATLAS
+            unsigned k_sourceIdStart;
+            uint64_t k_sourceIdMask;
+            unsigned k_numSources;
+
+            //BLISS
+            unsigned k_blissBlacklistThreshold;
+            SimTime_t k_blissClearingInterval;
+            std::vector<bool> m_blacklisted;
+            std::vector<unsigned> m_lastSource;   // per channel
+            std::vector<unsigned> m_sourceStreak; // per channel
+            SimTime_t m_lastBlacklistClear;
+
+            //ATLAS
+            SimTime_t k_atlasQuantum;
+            double k_atlasHistoryWeight;
+            SimTime_t k_atlasStarvationThreshold;
+            std::vector<uint64_t> m_attainedService;  // in the current quantum
+            std::vector<double> m_totalService;       // weighted over past quanta
+            std::vector<unsigned> m_sourceRank;       // 0 is served first
+            SimTime_t m_quantumStart;
+
+            SimTime_t m_simCycle;
 
         };
     }
@@ -4,6 +4,7 @@ from sst_unittest import *
 from sst_unittest_support import *
 
 import os
+import re
 import shutil
 
 ################################################################################
@@ -80,6 +81,22 @@ class testcase_CramSim_Component(SSTTestCase):
     def test_CramSim_6_W(self):
         self.CramSim_test_template("6_W")
 
+    # Random traffic from the transaction generator through each of the
+    # scheduling policies that reorder transactions. checkFRFCFS makes the
+    # scheduler stop if FRFCFS ever picks a different transaction than the
+    # original scan of the whole queue.
+    def test_CramSim_txngen_FRFCFS(self):
+        self.CramSim_txngen_template("FRFCFS", "checkFRFCFS=1")
+
+    def test_CramSim_txngen_FRFCFS_readFirst(self):
+        self.CramSim_txngen_template("FRFCFS", "checkFRFCFS=1 boolReadFirstTxnScheduling=1", "_readFirst")
+
+    def test_CramSim_txngen_BLISS(self):
+        self.CramSim_txngen_template("BLISS", "sourceIdPos=8:7 blissBlacklistThreshold=4 blissClearingInterval=10000")
+
+    def test_CramSim_txngen_ATLAS(self):
+        self.CramSim_txngen_template("ATLAS", "sourceIdPos=8:7 atlasQuantum=10000 atlasStarvationThreshold=5000")
+
 #####
 
     def CramSim_test_template(self, testcase):
@@ -137,6 +154,42 @@ class testcase_CramSim_Component(SSTTestCase):
         else:
             self.assertTrue(cmp_result, "Output file {0} does not match Reference File {1}".format(outfile, reffile))
 
+    def CramSim_txngen_template(self, policy, overrides="", suffix=""):
+
+        # Get the path to the test files
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        CramSimElementDir = os.path.abspath("{0}/../".format(test_path))
+
+        # Set the various file paths
+        testDataFileName="test_CramSim_txngen_{0}{1}".format(policy, suffix)
+
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        sdlfile = "{0}/test_txngen.py".format(test_path)
+        configfile = "{0}/ddr4_2400.cfg".format(CramSimElementDir)
+        otherargs = '--model-options=\"--configfile={0} mode=rand txnSchedulingPolicy={1} {2}\"'.format(configfile, policy, overrides)
+
+        # Run SST
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles)
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("CramSim test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        # There are no reference files for these, check that the run completed
+        # (FRFCFS orders are checked in the simulation) and that the scheduler
+        # let reads and writes through
+        with open(outfile, 'r') as fp:
+            output = fp.read()
+        self.assertTrue("Simulation is complete" in output, "Output file {0} does not contain a simulation complete message".format(outfile))
+        for stat in ("readTxnsCompleted", "writeTxnsCompleted"):
+            match = re.search(r"TxnGen\.{0} : Accumulator : Sum\.u64 = (\d+);".format(stat), output)
+            self.assertTrue(match is not None and int(match.group(1)) > 0,
+                            "Output file {0} shows no {1} with txnSchedulingPolicy {2}".format(outfile, stat, policy))
+
 #####
 
     def _setupCramSimTestFiles(self):
@@ -52,6 +52,10 @@ GNA::GNA(ComponentId_t id, Params& params) :
     if (BWPpTic <= 0) {
         out.fatal(CALL_INFO, -1,"MaxOutMem invalid\n");
     }
+    maxSpikeDelay = params.find<int>("MaxSpikeDelay", 15);
+    if (maxSpikeDelay <= 0 || maxSpikeDelay >= (1u << 16)) {
+        out.fatal(CALL_INFO, -1,"MaxSpikeDelay invalid\n");
+    }
 
     //set our clock
     std::string clockFreq = params.find<std::string>("clock", "1GHz");
@@ -96,8 +100,12 @@ void GNA::init(unsigned int phase) {
         STSUnits.push_back(STS(this,i));
     }
 
-    // initialize neurons
-    neurons = new neuron[numNeurons];
+    // initialize neurons, with a spike buffer covering the longest delay
+    uint depth = 1;
+    while (depth <= maxSpikeDelay) {
+        depth <<= 1;
+    }
+    neurons.resize(numNeurons, depth);
 
     SST::RNG::MarsagliaRNG rng(1,13);
 
@@ -119,7 +127,7 @@ void GNA::init(unsigned int phase) {
 #else
     for (int nrn_num=0;nrn_num<numNeurons;nrn_num++) {
         uint16_t trig = rng.generateNextUInt32() % 100 + 350;
-        neurons[nrn_num].configure((T_NctFl){float(trig),0.0,float(trig/10.)});
+        neurons.configure(nrn_num, (T_NctFl){float(trig),0.0,float(trig/10.)});
     }
 #endif
 
@@ -142,7 +150,7 @@ void GNA::init(unsigned int phase) {
         }
 
         countLinks += numCon;
-        neurons[n].setWML(startAddr,numCon);
+        neurons.setWML(n,startAddr,numCon);
         for (int nn=0; nn<numCon; ++nn) {
 
             uint16_t targ;
@@ -239,11 +247,13 @@ void GNA::handleEvent(Interfaces::SimpleMem::Request * req)
 void GNA::deliver(float val, int targetN, int time) {
     // AFR: should really throttle this in some way
     numDeliveries++;
-    if(targetN < numNeurons) {
-        neurons[targetN].deliverSpike(val, time);
-        //printf("deliver %f to %d @ %d\n", val, targetN, time);
-    } else {
+    if(targetN >= numNeurons) {
         out.fatal(CALL_INFO, -1,"Invalid Neuron Address\n");
+    } else if (!neurons.inWindow(now, time)) {
+        out.fatal(CALL_INFO, -1,"Spike for t=%d delivered at t=%u exceeds MaxSpikeDelay (%u)\n", time, now, maxSpikeDelay);
+    } else {
+        neurons.deliverSpike(targetN, val, time);
+        //printf("deliver %f to %d @ %d\n", val, targetN, time);
     }
 }
 
@@ -317,13 +327,7 @@ void GNA::processFire() {
 
 // run LIF on all neurons
 void GNA::lifAll() {
-    for (uint n = 0; n < numNeurons; ++n) {
-        bool fired = neurons[n].lif(now);
-        if (fired) {
-            //printf(" %d fired\n", n);
-            firedNeurons.push_back(n);
-        }
-    }
+    neurons.lif(now, firedNeurons);
 }
 
 bool GNA::clockTic( Cycle_t )
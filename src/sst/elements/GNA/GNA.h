@@ -52,6 +52,7 @@ public:
             {"STSDispatch",               "Max # spikes that can be dispatched to the STS in a clock cycle","2"},
             {"STSParallelism",               "Max # spikes the STS can process in parallelism ","2"},
             {"MaxOutMem", "Maximum # of outgoing memory requests per cycle","STSParallelism"},
+            {"MaxSpikeDelay", "Maximum temporal offset, in timesteps, of a spike delivery","15"},
             {"neurons",                  "(uint) number of neurons", "32"}
                             )
 
@@ -68,7 +69,7 @@ public:
 
 public:
     void deliver(float val, int targetN, int time);
-    neuron* getNeuron(int n) {return &neurons[n];}
+    const neuronArray& getNeurons() const {return neurons;}
     void readMem(Interfaces::SimpleMem::Request *req, STS *requestor) {
         // queue the request to send later
         outgoingReqs.push(req);
@@ -99,12 +100,13 @@ private:
     uint STSDispatch;
     uint STSParallelism;
     uint maxOutMem;
+    uint maxSpikeDelay;
     uint now;
     uint numFirings;
     uint numDeliveries;
     queue<SST::Interfaces::SimpleMem::Request *> outgoingReqs;
 
-    neuron *neurons;
+    neuronArray neurons;
     vector<STS> STSUnits;
 
     typedef multimap<const uint, Ctrl_And_Stat_Types::T_BwpFl> BWPBuf_t;
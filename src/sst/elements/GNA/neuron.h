@@ -16,7 +16,9 @@
 #ifndef _NEURON_H
 #define _NEURON_H
 
-#include <map>
+#include <stdint.h>
+#include <deque>
+#include <vector>
 #include "gna_lib.h"
 
 namespace SST {
@@ -24,65 +26,101 @@ namespace GNAComponent {
 
 using namespace std;
 
-class neuron {
+// State of all the neurons of a GNA, kept as a structure of arrays so
+// that the LIF update of a timestep is a single pass over contiguous
+// floats which the compiler can vectorize.
+//
+// Incoming spikes are summed into a circular buffer of 'depth'
+// timesteps per neuron. The buffer is stored timestep-major, so the row
+// for 'now' is contiguous and LIF reads and clears it in the same pass.
+// Spikes may therefore only be delivered up to depth-1 timesteps ahead.
+class neuronArray {
 public:
-    void configure(const Neuron_Loader_Types::T_NctFl &in) {
-        config = in;
-    }
-    void deliverSpike(float str, uint when) {
-        temporalBuffer[when] += str;
-        //printf(" got %f @ %d\n", str, when);
+    neuronArray() : numNeurons(0), depthMask(0) {;}
+
+    // depth must be a power of two
+    void resize(uint n, uint depth) {
+        numNeurons = n;
+        depthMask = depth - 1;
+        potential.assign(n, 0);
+        threshold.assign(n, 0);
+        minimum.assign(n, 0);
+        leakage.assign(n, 0);
+        fired.assign(n, 0);
+        WMLAddr.assign(n, 0);
+        WMLLen.assign(n, 0);
+        temporalBuffer.assign((size_t)n * depth, 0);
     }
-    // performs Leaky Integrate and Fire. Returns true if fired.
-    bool lif(const uint now) {
-        // Leak
-        value -= config.NrnLkg;
+    uint size() const {return numNeurons;}
+    uint depth() const {return depthMask + 1;}
 
-        // Bound?
-        // AFR: is this right?
-        if (value < config.NrnMin) {
-            value = 0;
-        }
+    void configure(uint n, const Neuron_Loader_Types::T_NctFl &in) {
+        threshold[n] = in.NrnThr;
+        minimum[n] = in.NrnMin;
+        leakage[n] = in.NrnLkg;
+    }
+    // true if a spike for timestep 'when' fits in the buffer at 'now'
+    bool inWindow(uint now, uint when) const {
+        return (when - now) <= depthMask;
+    }
+    void deliverSpike(uint n, float str, uint when) {
+        temporalBuffer[(size_t)(when & depthMask) * numNeurons + n] += str;
+    }
+    // performs Leaky Integrate and Fire on every neuron. Appends the
+    // neurons which fired to firedNeurons, in neuron order.
+    void lif(const uint now, std::deque<uint> &firedNeurons) {
+        const uint count = numNeurons;
+        const uint8_t *f = fired.data();
 
-        // Integrate
-        value += getCurrentSpikes(now);
+        lifKernel(count, potential.data(), &temporalBuffer[(size_t)(now & depthMask) * count],
+                  threshold.data(), minimum.data(), leakage.data(), fired.data());
 
-        // Fire?
-        if (value > config.NrnThr) {
-            value = config.NrnMin;
-            return true;
-        } else {
-            return false;
+        for (uint n = 0; n < count; ++n) {
+            if (f[n]) {
+                firedNeurons.push_back(n);
+            }
         }
     }
-    void setWML(uint64_t addr, uint32_t entries) {
-        WMLAddr = addr;
-        WMLLen = entries;
+    void setWML(uint n, uint64_t addr, uint32_t entries) {
+        WMLAddr[n] = addr;
+        WMLLen[n] = entries;
     }
-    uint32_t getWMLLen() const {return WMLLen;}
-    uint32_t getWMLAddr() const {return WMLAddr;}
+    uint32_t getWMLLen(uint n) const {return WMLLen[n];}
+    uint64_t getWMLAddr(uint n) const {return WMLAddr[n];}
 private:
-    Neuron_Loader_Types::T_NctFl config;
-    float value;
-    // temporal buffer
-    typedef map<const uint, float> tBuf_t;
-    tBuf_t temporalBuffer;
-    // Neuron's white matter list
-    uint64_t WMLAddr; // start
-    uint32_t WMLLen; // number of entries in WML
-
-    // get any current spike values
-    float getCurrentSpikes(const int now) {
-        tBuf_t::iterator i = temporalBuffer.find(now);
-        if (i != temporalBuffer.end()) {
-            float val = i->second;
-            temporalBuffer.erase(i);
-            //printf(" got current spike %f @ %d\n", val, now);
-            return val;
-        } else {
-            return 0;
+    // The arrays never overlap; saying so lets the loop vectorize without
+    // run-time alias checks.
+    static void lifKernel(const uint count, float * __restrict value, float * __restrict spikes,
+                          const float * __restrict thr, const float * __restrict min,
+                          const float * __restrict lkg, uint8_t * __restrict f) {
+        for (uint n = 0; n < count; ++n) {
+            // Leak
+            float v = value[n] - lkg[n];
+            // Bound?
+            // AFR: is this right?
+            v = (v < min[n]) ? 0.0f : v;
+            // Integrate
+            v += spikes[n];
+            spikes[n] = 0;
+            // Fire?
+            bool fire = v > thr[n];
+            value[n] = fire ? min[n] : v;
+            f[n] = fire;
         }
     }
+
+    uint numNeurons;
+    uint depthMask;
+    vector<float> potential;
+    vector<float> threshold;
+    vector<float> minimum;
+    vector<float> leakage;
+    vector<uint8_t> fired;
+    // temporal buffer, depth rows of numNeurons
+    vector<float> temporalBuffer;
+    // Neurons' white matter lists
+    vector<uint64_t> WMLAddr; // start
+    vector<uint32_t> WMLLen; // number of entries in WML
 };
 
 }
@@ -21,9 +21,9 @@ using namespace SST;
 using namespace SST::GNAComponent;
 
 void STS::assign(int neuronNum) {
-    const neuron *spiker = myGNA->getNeuron(neuronNum);
-    numSpikes = spiker->getWMLLen();
-    uint64_t listAddr = spiker->getWMLAddr();
+    const neuronArray &spikers = myGNA->getNeurons();
+    numSpikes = spikers.getWMLLen(neuronNum);
+    uint64_t listAddr = spikers.getWMLAddr(neuronNum);
 
     // for each link, request the WML structure
     for (int i = 0; i < numSpikes; ++i) {
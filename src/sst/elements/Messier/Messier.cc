@@ -193,8 +193,16 @@ Messier::Messier(SST::ComponentId_t id, SST::Params& params): Component(id) {
 	TimeConverter* tc = getTimeConverter(cpu_clock);
         event_link->setDefaultTimeBase(tc);
 
+	idle_fastforward = params.find<bool>("idle_fastforward", false);
 
-	registerClock( cpu_clock, new Clock::Handler<Messier>(this, &Messier::tick ) );
+	clock_handler = new Clock::Handler<Messier>(this, &Messier::tick );
+	clock_tc = registerClock( cpu_clock, clock_handler );
+	clock_on = true;
+	last_cycle = 0;
+
+	wake_link = configureSelfLink("wake", clock_tc, new Event::Handler<Messier>(this, &Messier::handleWakeup));
+
+	DIMM->setEnableClockHandler(std::bind(&Messier::turnClockOn, this));
 
 }
 
@@ -211,9 +219,47 @@ Messier::Messier() : Component(-1)
 bool Messier::tick(SST::Cycle_t x)
 {
 
+	last_cycle = x;
+
 	// We tick the MMU hierarchy of each core
 //	for(uint32_t i = 0; i < core_count; ++i)
-	DIMM->tick();
+	bool idle = DIMM->tick();
+
+	if(!idle || !idle_fastforward)
+		return false;
+
+	// Nothing can issue before the wake cycle; the wakeup arrives the cycle before so the clock is back on in time
+	long long int wake = DIMM->getWakeDelay();
+	if(wake == 1)
+		return false;
+
+	if(wake > 1)
+		wake_link->send(wake - 1, nullptr);
+
+	clock_on = false;
+	return true;
+}
+
+
+// The cycles the clock was off for are accounted to the controller as idle ticks
+void Messier::turnClockOn()
+{
+
+	if(clock_on)
+		return;
+
+	SST::Cycle_t cycle = reregisterClock(clock_tc, clock_handler);
+	cycle--;
+
+	DIMM->skipCycles(cycle - last_cycle);
+	last_cycle = cycle;
+	clock_on = true;
+}
+
+
+// Wakeups may be stale if the clock was turned on and off again since
+void Messier::handleWakeup(SST::Event* event)
+{
 
-	return false;
+	turnClockOn();
 }
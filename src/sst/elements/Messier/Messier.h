@@ -98,7 +98,8 @@ namespace SST {
                     {"write_cancel", "This indicates that the write cancellation optimization: 0 means not enabled", "0"},
                     {"write_cancel_th", "This indicates that the write cancellation threshold: 0 means dynamic", "0"},
                     {"group_size", "This indicates the number of banks in each group, to be locked when draining", "0"},
-                    {"lock_period", "This indicates the period of locking a group in cycles", "10000"}
+                    {"lock_period", "This indicates the period of locking a group in cycles", "10000"},
+                    {"idle_fastforward", "Stop clocking the controller while no request can be issued, and wake it when one can.", "false"}
                 )
 
                 SST_ELI_DOCUMENT_STATISTICS(
@@ -118,6 +119,10 @@ namespace SST {
 				void handleEvent(SST::Event* event) {};
 				bool tick(SST::Cycle_t x);
 
+				// Restart the clock after the controller went idle
+				void turnClockOn();
+				void handleWakeup(SST::Event* event);
+
 				void parser(NVM_PARAMS * nvm, SST::Params& params);
 
 
@@ -132,6 +137,14 @@ namespace SST {
 
 				SST::Link * event_link; // Note that this is a self-link for events
 
+				SST::Link * wake_link; // Self-link to restart the clock when the controller can issue again
+
+				bool idle_fastforward;
+				bool clock_on;
+				SST::Cycle_t last_cycle; // The last cycle the controller was ticked, or accounted for while idle
+				TimeConverter * clock_tc;
+				Clock::HandlerBase * clock_handler;
+
 				NVM_PARAMS * nvm_params;
 				NVM_DIMM * DIMM;
 
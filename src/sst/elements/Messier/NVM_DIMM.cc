@@ -72,7 +72,7 @@ NVM_DIMM::NVM_DIMM(ComponentId_t id, NVM_PARAMS par) : ComponentExtension(id)
 	reads = registerStatistic<uint64_t>( "reads");
 	writes = registerStatistic<uint64_t>( "writes");
 
-	WB = new NVM_WRITE_BUFFER(params->write_buffer_size, 0, 64 /*write buffer granularity, now assume 64B */, params->flush_th, params->flush_th_low);
+	WB = new NVM_WRITE_BUFFER(params->write_buffer_size, 0, 64 /*write buffer granularity, now assume 64B */, params->flush_th, params->flush_th_low, params->num_ranks*params->num_banks);
 
 
 	if(params->cache_enabled)
@@ -95,6 +95,12 @@ NVM_DIMM::NVM_DIMM(ComponentId_t id, NVM_PARAMS par) : ComponentExtension(id)
 	curr_reads = 0;
 	curr_writes = 0;
 
+	next_seq = 0;
+	num_transactions = 0;
+	outstanding = 0;
+	progress = false;
+	bank_reads.resize(params->num_ranks*params->num_banks);
+
 	gs = params->group_size;
 	lg = group_locked;
 
@@ -132,25 +138,16 @@ bool NVM_DIMM::tick()
 
 
 	if(!enabled)
-		return false;
+		return true;
 
 
 	// Incrementing the cycles count
 
 	cycles++;
 
+	progress = false;
 
-	if(READS_COMPLETE.find(cycles)!=READS_COMPLETE.end())
-	{
-		curr_reads = curr_reads - READS_COMPLETE[cycles];
-		READS_COMPLETE.erase(cycles);
-	}
-
-	if(WRITES_COMPLETE.find(cycles)!=WRITES_COMPLETE.end())
-	{
-		curr_writes = curr_writes - WRITES_COMPLETE[cycles];
-		WRITES_COMPLETE.erase(cycles);
-	}
+	retire_completions();
 
 
 
@@ -179,7 +176,7 @@ bool NVM_DIMM::tick()
 			else
 			{
 				// Checking if there is any pending requests
-				if(!transactions.empty())
+				if(num_transactions != 0)
 				{
 
 					// Try to submit a request to a free bank and rank
@@ -203,7 +200,7 @@ bool NVM_DIMM::tick()
 	else
 	{
 
-		if(!transactions.empty())
+		if(num_transactions != 0)
 		{
 			submit_request_opt();
 		}
@@ -216,8 +213,248 @@ bool NVM_DIMM::tick()
 
 
 
-	return false;
+	return !progress;
+
+
+}
+
+
+void NVM_DIMM::retire_completions()
+{
+
+	while(!READS_COMPLETE.empty() && READS_COMPLETE.top() <= cycles)
+	{
+		curr_reads--;
+		READS_COMPLETE.pop();
+	}
+
+	while(!WRITES_COMPLETE.empty() && WRITES_COMPLETE.top() <= cycles)
+	{
+		curr_writes--;
+		WRITES_COMPLETE.pop();
+	}
+
+}
+
+
+// Nothing issued this tick, so nothing will until a rank or bank frees up, a read or write completes (which lowers the current
+// drawn), or an event arrives. Events wake the controller by themselves
+long long int NVM_DIMM::getWakeDelay()
+{
+
+	if(num_transactions == 0 && WB->empty() && ready_at_NVM.empty())
+		return 0;
+
+	// The write cancellation window moves every cycle
+	if(params->write_cancel && num_transactions != 0)
+		return 1;
+
+	long long int wake = 0;
+
+	for(int i = 0; i < params->num_ranks; i++)
+	{
+		long long int free_at = ranks[i]->getBusyUntil() + 1;
+		if(free_at > cycles && (wake == 0 || free_at < wake))
+			wake = free_at;
+
+		for(int j = 0; j < params->num_banks; j++)
+		{
+			free_at = ranks[i]->getBank(j)->getBusyUntil() + 1;
+			if(free_at > cycles && (wake == 0 || free_at < wake))
+				wake = free_at;
+		}
+	}
+
+	if(!READS_COMPLETE.empty() && (wake == 0 || READS_COMPLETE.top() < wake))
+		wake = READS_COMPLETE.top();
+
+	if(!WRITES_COMPLETE.empty() && (wake == 0 || WRITES_COMPLETE.top() < wake))
+		wake = WRITES_COMPLETE.top();
+
+	return wake == 0 ? 0 : wake - cycles;
+
+}
+
+
+// The skipped ticks would not have issued anything, they only count cycles
+void NVM_DIMM::skipCycles(long long int n)
+{
+
+	if(!enabled)
+		return;
+
+	cycles += n;
+
+	if(params->modulo && WB->empty())
+		read_count += n;
+
+}
+
+
+void NVM_DIMM::add_transaction(NVM_Request * req)
+{
+
+	req->seq = next_seq++;
+	req->queue = BankIndex(req->Address);
+	num_transactions++;
+	TRANS_ID[req->req_ID] = req;
+
+	if(req->Read)
+	{
+		bank_reads[req->queue].push_back(req);
+		reads_by_block[WB->block(req->Address)].push_back(req);
+
+		if((HOLD.find(req->req_ID)==HOLD.end()) && (WB->find_entry(req->Address)!=NULL))
+			wb_hits[req->seq] = req;
+	}
+	else
+		pending_writes.push_back(req);
+
+	if(SQUASHED.find(req->req_ID)!=SQUASHED.end())
+		squashed_trans[req->seq] = req;
+
+}
+
+
+void NVM_DIMM::remove_transaction(NVM_Request * req)
+{
+
+	num_transactions--;
+
+	std::unordered_map<long long int, NVM_Request *>::iterator id = TRANS_ID.find(req->req_ID);
+	if(id != TRANS_ID.end() && id->second == req)
+		TRANS_ID.erase(id);
+
+	squashed_trans.erase(req->seq);
+
+	std::list<NVM_Request *> & queue = req->Read ? bank_reads[req->queue] : pending_writes;
+	for(std::list<NVM_Request *>::iterator it = queue.begin(); it != queue.end(); it++)
+	{
+		if(*it == req)
+		{
+			queue.erase(it);
+			break;
+		}
+	}
+
+	if(req->Read)
+	{
+		wb_hits.erase(req->seq);
+
+		std::unordered_map<long long int, std::vector<NVM_Request *> >::iterator block = reads_by_block.find(WB->block(req->Address));
+		std::vector<NVM_Request *> & reads = block->second;
+		for(unsigned int i = 0; i < reads.size(); i++)
+		{
+			if(reads[i] == req)
+			{
+				reads.erase(reads.begin() + i);
+				break;
+			}
+		}
+
+		if(reads.empty())
+			reads_by_block.erase(block);
+	}
+
+}
+
+
+void NVM_DIMM::squash(long long int req_ID)
+{
+
+	SQUASHED[req_ID] = 1;
+
+	std::unordered_map<long long int, NVM_Request *>::iterator id = TRANS_ID.find(req_ID);
+	if(id != TRANS_ID.end())
+		squashed_trans[id->second->seq] = id->second;
+
+}
+
+
+void NVM_DIMM::release_hold(long long int req_ID)
+{
+
+	HOLD.erase(req_ID);
+
+	std::unordered_map<long long int, NVM_Request *>::iterator id = TRANS_ID.find(req_ID);
+	if(id != TRANS_ID.end() && id->second->Read && (WB->find_entry(id->second->Address)!=NULL))
+		wb_hits[id->second->seq] = id->second;
+
+}
+
+
+bool NVM_DIMM::wb_insert(NVM_Request * req)
+{
+
+	bool present = (WB->find_entry(req->Address)!=NULL);
+
+	if(!WB->insert_write_request(req, BankIndex(req->Address)))
+		return false;
+
+	// The buffered reads of the block now hit in the write buffer
+	if(!present)
+	{
+		std::unordered_map<long long int, std::vector<NVM_Request *> >::iterator block = reads_by_block.find(WB->block(req->Address));
+		if(block != reads_by_block.end())
+			for(unsigned int i = 0; i < block->second.size(); i++)
+				if(HOLD.find(block->second[i]->req_ID)==HOLD.end())
+					wb_hits[block->second[i]->seq] = block->second[i];
+	}
+
+	return true;
+
+}
+
+
+void NVM_DIMM::wb_erase(NVM_Request * req)
+{
+
+	WB->erase_entry(req);
+
+	// Erasing an entry drops its block from the write buffer index, even if another entry has the same block
+	std::unordered_map<long long int, std::vector<NVM_Request *> >::iterator block = reads_by_block.find(WB->block(req->Address));
+	if(block != reads_by_block.end())
+		for(unsigned int i = 0; i < block->second.size(); i++)
+			wb_hits.erase(block->second[i]->seq);
+
+}
+
+
+// The oldest of two requests, either can be NULL
+static NVM_Request * older(NVM_Request * a, NVM_Request * b)
+{
+
+	if(a == NULL)
+		return b;
+	if(b == NULL)
+		return a;
+
+	return (a->seq < b->seq) ? a : b;
+
+}
+
+
+NVM_Request * NVM_DIMM::first_read(int bank_index, bool row_hit, NVM_Request * best)
+{
+
+	BANK * bank = ranks[bank_index/params->num_banks]->getBank(bank_index%params->num_banks);
 
+	std::list<NVM_Request *>::iterator st, en;
+	st = bank_reads[bank_index].begin();
+	en = bank_reads[bank_index].end();
+
+	for(; st != en; st++)
+	{
+		NVM_Request * temp = *st;
+
+		if(best != NULL && temp->seq > best->seq)
+			break;
+
+		if((HOLD.find(temp->req_ID)==HOLD.end()) && (!row_hit || row_buffer_hit(temp->Address, bank->getRB())))
+			return older(best, temp);
+	}
+
+	return best;
 
 }
 
@@ -258,6 +495,7 @@ void NVM_DIMM::schedule_delivery()
 				(st_1->first)->meta_data = EventType::READ_COMPLETION;
                                 m_EventChan->send(params->tCMD + params->tCL + params->tBURST, new MessierEvent(st_1->first, EventType::READ_COMPLETION));
 				ready_at_NVM.erase(st_1);
+				progress = true;
 				break;
 			}
 
@@ -295,69 +533,52 @@ bool NVM_DIMM::try_flush_wb()
 //	bool pull_idle = false;
 	int MAX_WRITES = params->max_writes;
 
-	if(WB->flush() || (transactions.empty() && !WB->empty()) || (params->modulo && !WB->empty()))
+	if(WB->flush() || (num_transactions == 0 && !WB->empty()) || (params->modulo && !WB->empty()))
 		flush_write = true;
 
 	if(flush_write)
 	{
 
+		// The limits on concurrent writes and current are the same for all buffered writes
+		if(!((MAX_WRITES > curr_writes) && ((params->write_weight*curr_writes + params->read_weight*curr_reads) <= (params->max_current_weight - params->write_weight))))
+			return false;
 
-		std::list<NVM_Request *> writes_list = WB->getList();
-
-		std::list<NVM_Request *>::iterator st_wl, en_wl;
-
-		st_wl = writes_list.begin();
-		en_wl = writes_list.end();
+		// Find the oldest buffered write whose rank and bank are free; only the head of each bank's queue can be it
+		NVM_Request * temp = NULL;
 
-		while(st_wl != en_wl)
+		for(int i = 0; i < WB->numQueues(); i++)
 		{
+			NVM_Request * head = WB->getOldest(i);
 
-			NVM_Request * temp = *st_wl;
-
-
-			long long int add = temp->Address;
-			bool ready = false;
-			bool removed = false;
-
-			BANK * temp_bank;
-			temp_bank = getBank(temp->Address);
-
-			if(temp_bank == NULL)
-			{
-				std::cout<<"Errrror"<<std::endl;
-				return false;
-
-			}
+			if(head == NULL || (params->adaptive_writes && (group_locked!=((i%params->num_banks)/params->group_size))))
+				continue;
 
-			if (getRank(add)->getBusyUntil() < cycles)
-			{
-				if(temp_bank->getBusyUntil() < cycles)
-				{
-					ready = true;
-				}
-			}
-			// Occupy the rank for the write time
-			if((!params->adaptive_writes || (group_locked==(WhichBank(temp->Address)/params->group_size))) && ready && (MAX_WRITES > curr_writes) && ((params->write_weight*curr_writes + params->read_weight*curr_reads) <= (params->max_current_weight - params->write_weight)))
-			{
+			RANK * temp_rank = ranks[i/params->num_banks];
+			BANK * temp_bank = temp_rank->getBank(i%params->num_banks);
 
+			if((temp_rank->getBusyUntil() < cycles) && (temp_bank->getBusyUntil() < cycles))
+				temp = older(temp, head);
+		}
 
-				removed = true;
-				WB->erase_entry(temp);
-				// Note that the rank will be busy for the time of sending the data to the bank, in addition to sending the command
-				getRank(add)->setBusyUntil(cycles + params->tCMD + params->tBURST);
-				(temp_bank)->setBusyUntil(cycles + params->tCMD + params->tCL_W + params->tBURST);
-				temp_bank->set_last(false); // setting it to write
-				temp_bank->set_last_address(temp->Address);
-				curr_writes++;
-				WRITES_COMPLETE[cycles + params->tCMD + params->tCL_W + params->tBURST]++;
+		if(temp != NULL)
+		{
 
-				delete temp;
+			long long int add = temp->Address;
+			BANK * temp_bank = getBank(add);
 
-				return true;
+			wb_erase(temp);
+			// Note that the rank will be busy for the time of sending the data to the bank, in addition to sending the command
+			getRank(add)->setBusyUntil(cycles + params->tCMD + params->tBURST);
+			(temp_bank)->setBusyUntil(cycles + params->tCMD + params->tCL_W + params->tBURST);
+			temp_bank->set_last(false); // setting it to write
+			temp_bank->set_last_address(temp->Address);
+			curr_writes++;
+			WRITES_COMPLETE.push(cycles + params->tCMD + params->tCL_W + params->tBURST);
 
-			}
+			delete temp;
 
-			st_wl++;
+			progress = true;
+			return true;
 
 		}
 
@@ -430,49 +651,52 @@ bool NVM_DIMM::row_buffer_hit(long long int add, long long int bank_add)
 bool NVM_DIMM::pop_optimal()
 {
 
-	std::list<NVM_Request *>::iterator st, en;
-	st = transactions.begin();
-	en = transactions.end();
+	// The requests buffer is served in arrival order: find the oldest request that is either squashed, or a read
+	// that hits in the row buffer of a free bank
+	NVM_Request * temp = squashed_trans.empty() ? NULL : squashed_trans.begin()->second;
 
 	long long time_ready;
 
-	while(st!=en)
+	if(outstanding < params->max_outstanding)
 	{
-		NVM_Request * temp = *st;
-		if(SQUASHED.find(temp->req_ID)!=SQUASHED.end())
+		for(int i = 0; i < (int) bank_reads.size(); i++)
 		{
-			SQUASHED.erase(temp->req_ID);
-			transactions.erase(st);
-			delete NVM_EVENT_MAP[temp->req_ID];
-			delete temp;
-			break;
-		}
+			if(bank_reads[i].empty() || (params->adaptive_writes && (group_locked==((i%params->num_banks)/params->group_size))))
+				continue;
 
+			RANK * corresp_rank = ranks[i/params->num_banks];
+			BANK * corresp_bank = corresp_rank->getBank(i%params->num_banks);
+			if ((corresp_rank->getBusyUntil() < cycles) && (corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked())
+				temp = first_read(i, true, temp);
+		}
+	}
 
-		RANK * corresp_rank = getRank(temp->Address);
-		BANK * corresp_bank = getBank(temp->Address);
-		if ((!params->adaptive_writes || group_locked!=(WhichBank(temp->Address)/params->group_size)) &&  (HOLD.find(temp->req_ID)==HOLD.end()) && temp->Read && (corresp_rank->getBusyUntil() < cycles) && (corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked() && (outstanding.size() < params->max_outstanding))
-		{
+	if(temp == NULL)
+		return false;
 
-			if ( row_buffer_hit(temp->Address, corresp_bank->getRB()))
-			{
-				time_ready = cycles + 1;
-				outstanding.push_back(temp);
-				transactions.erase(st);
-				// Lock the bank so no other request comes in and try to activate another row while waiting for the activation
-
-				corresp_bank->setLocked(true, cycles);
-				temp->meta_data = EventType::DEVICE_READY;
-				m_EventChan->send(time_ready-cycles, new MessierEvent(temp, EventType::DEVICE_READY));
-				return true;
-			}
+	if(SQUASHED.find(temp->req_ID)!=SQUASHED.end())
+	{
+		SQUASHED.erase(temp->req_ID);
+		remove_transaction(temp);
+		delete NVM_EVENT_MAP[temp->req_ID];
+		NVM_EVENT_MAP.erase(temp->req_ID);
+		delete temp;
+		progress = true;
+		return false;
+	}
 
-		}
+	BANK * corresp_bank = getBank(temp->Address);
 
-		st++;
-	}
+	time_ready = cycles + 1;
+	outstanding++;
+	remove_transaction(temp);
+	// Lock the bank so no other request comes in and try to activate another row while waiting for the activation
 
-	return false;
+	corresp_bank->setLocked(true, cycles);
+	temp->meta_data = EventType::DEVICE_READY;
+	m_EventChan->send(time_ready-cycles, new MessierEvent(temp, EventType::DEVICE_READY));
+	progress = true;
+	return true;
 
 }
 
@@ -491,147 +715,144 @@ bool NVM_DIMM::submit_request_opt()
 	else
 	{
 
-		std::list<NVM_Request *>::iterator st, en;
-		st = transactions.begin();
-		en = transactions.end();
-
+		// Find the oldest request that can make progress: a squashed request, a write while the write buffer has room,
+		// a read that hits in the write buffer, or a read whose rank and bank can take it
+		temp = squashed_trans.empty() ? NULL : squashed_trans.begin()->second;
 
-		while(st!=en)
-		{
-
-			temp = *st;
+		if(!pending_writes.empty() && !WB->full())
+			temp = older(temp, pending_writes.front());
 
-			// First check if this is a write request and the write buffer is not full
-			removed = false;
+		if(!wb_hits.empty())
+			temp = older(temp, wb_hits.begin()->second);
 
+		if(outstanding < params->max_outstanding)
+		{
+			// Without enough current to activate a row, only row buffer hits can issue
+			bool activate = (params->write_weight*curr_writes + params->read_weight*curr_reads) <= (params->max_current_weight - params->read_weight);
 
-			if(SQUASHED.find(temp->req_ID)!=SQUASHED.end())
+			for(int i = 0; i < (int) bank_reads.size(); i++)
 			{
-				SQUASHED.erase(temp->req_ID);
-				transactions.erase(st);
-				delete NVM_EVENT_MAP[temp->req_ID];
-				delete temp;
-				break;
+				if(bank_reads[i].empty() || (params->adaptive_writes && (group_locked==((i%params->num_banks)/params->group_size))))
+					continue;
+
+				RANK * corresp_rank = ranks[i/params->num_banks];
+				BANK * corresp_bank = corresp_rank->getBank(i%params->num_banks);
+				if ((corresp_rank->getBusyUntil() < cycles) && (((corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked()) || (params->write_cancel && !WB->flush() && !corresp_bank->read() &&(corresp_bank->getBusyUntil() - cycles < (100-4*WB->getSize())*1.0*params->tCL_W/100.0 ))))
+					temp = first_read(i, !activate, temp);
 			}
+		}
 
+		if(temp == NULL)
+			return false;
 
-			if((!temp->Read))
-			{
-				if(!WB->full())
-				{
 
-					last_write = cycles;
+		if(SQUASHED.find(temp->req_ID)!=SQUASHED.end())
+		{
+			SQUASHED.erase(temp->req_ID);
+			remove_transaction(temp);
+			delete NVM_EVENT_MAP[temp->req_ID];
+			NVM_EVENT_MAP.erase(temp->req_ID);
+			delete temp;
+			progress = true;
+			return false;
+		}
 
-					NVM_Request * write_req = new NVM_Request();
-					write_req->req_ID = 0;
-					write_req->Read = false;
-					write_req->Address = temp->Address;
 
+		if((!temp->Read))
+		{
 
-					WB->insert_write_request(write_req);
-					transactions.erase(st);
+			last_write = cycles;
 
-					MemRespEvent *respEvent = new MemRespEvent(
-							NVM_EVENT_MAP[temp->req_ID]->getReqId(), NVM_EVENT_MAP[temp->req_ID]->getAddr(), NVM_EVENT_MAP[temp->req_ID]->getFlags() );
+			NVM_Request * write_req = new NVM_Request();
+			write_req->req_ID = 0;
+			write_req->Read = false;
+			write_req->Address = temp->Address;
 
-					m_memChan->send(respEvent);
-					bank_hist[WhichBank(temp->Address)]--;
 
-					if(cache!=NULL)
-						if(!cache->check_hit(temp->Address))
-						{
-							cache->insert_block(temp->Address, true);
-							cache->update_lru(temp->Address);
-						}
+			remove_transaction(temp);
+			wb_insert(write_req);
 
+			MemRespEvent *respEvent = new MemRespEvent(
+					NVM_EVENT_MAP[temp->req_ID]->getReqId(), NVM_EVENT_MAP[temp->req_ID]->getAddr(), NVM_EVENT_MAP[temp->req_ID]->getFlags() );
 
-					delete NVM_EVENT_MAP[temp->req_ID];
+			m_memChan->send(respEvent);
+			bank_hist[WhichBank(temp->Address)]--;
 
-					NVM_EVENT_MAP.erase(temp->req_ID);
-					delete temp;
-					removed = true;
-					break;
+			if(cache!=NULL)
+				if(!cache->check_hit(temp->Address))
+				{
+					cache->insert_block(temp->Address, true);
+					cache->update_lru(temp->Address);
 				}
-			}
-			else  if(temp->Read)// if read request
-			{
-				// Check if in the write buffer
 
-				if(HOLD.find(temp->req_ID)==HOLD.end())
-					removed = find_in_wb(temp);
 
-				if(removed)
-				{
-					transactions.erase(st);
-					break;
-				}
-				else //if(!removed)
-				{
-					// First find out the corresponding bank to the read request and check if busy
-					RANK * corresp_rank = getRank(temp->Address);
-					BANK * corresp_bank = getBank(temp->Address);
+			delete NVM_EVENT_MAP[temp->req_ID];
 
-					// Check if the rank is not busy
-					if ((!params->adaptive_writes || group_locked!=(WhichBank(temp->Address)/params->group_size)) && (HOLD.find(temp->req_ID)==HOLD.end()) &&   (corresp_rank->getBusyUntil() < cycles) && (((corresp_bank->getBusyUntil() < cycles) && !corresp_bank->getLocked()) || (params->write_cancel && !WB->flush() && !corresp_bank->read() &&(corresp_bank->getBusyUntil() - cycles < (100-4*WB->getSize())*1.0*params->tCL_W/100.0 ))) && (outstanding.size() < params->max_outstanding))
-					{
+			NVM_EVENT_MAP.erase(temp->req_ID);
+			delete temp;
+			removed = true;
+		}
+		else if((HOLD.find(temp->req_ID)==HOLD.end()) && (WB->find_entry(temp->Address)!=NULL))
+		{
+			// The read is served from the write buffer
+			remove_transaction(temp);
+			removed = find_in_wb(temp);
+		}
+		else
+		{
+			// First find out the corresponding bank to the read request, which can take it
+			RANK * corresp_rank = getRank(temp->Address);
+			BANK * corresp_bank = getBank(temp->Address);
 
 
-						// If this comes here due to write cancellation: do the right business
-						if(params->write_cancel &&  (corresp_bank->getBusyUntil() >= cycles) && !corresp_bank->read() && !WB->flush() && (corresp_bank->getBusyUntil() - cycles < (100-4*WB->getSize())*1.0*params->tCL_W/100.0 ))
-						{
-						// Write cancellation business
-						corresp_bank->setLocked(false, cycles);
-						// Put the request back in the write buffer
-						NVM_Request * evicted = new NVM_Request();
-                                                evicted->req_ID = 0;
-                                                evicted->Read = false;
-                                                evicted->Address = corresp_bank->get_last_address();;
+			// If this comes here due to write cancellation: do the right business
+			if(params->write_cancel &&  (corresp_bank->getBusyUntil() >= cycles) && !corresp_bank->read() && !WB->flush() && (corresp_bank->getBusyUntil() - cycles < (100-4*WB->getSize())*1.0*params->tCL_W/100.0 ))
+			{
+			// Write cancellation business
+			corresp_bank->setLocked(false, cycles);
+			// Put the request back in the write buffer
+			NVM_Request * evicted = new NVM_Request();
+                        evicted->req_ID = 0;
+                        evicted->Read = false;
+                        evicted->Address = corresp_bank->get_last_address();;
 
-                                                WB->insert_write_request(evicted);
+                        wb_insert(evicted);
 
-						}
+			}
 
 
-						long long int time_ready;
-						// Check if row buffer hit
-						bool issued=false;
-						if ( row_buffer_hit(temp->Address, corresp_bank->getRB()))
-						{
-							time_ready = cycles + 1;
-							issued = true;
-						}
-						else if((params->write_weight*curr_writes + params->read_weight*curr_reads) <= (params->max_current_weight - params->read_weight))
-						{
+			long long int time_ready;
+			// Check if row buffer hit
+			if ( row_buffer_hit(temp->Address, corresp_bank->getRB()))
+			{
+				time_ready = cycles + 1;
+			}
+			else
+			{
 
 
-							// Allocate the Rank circuitary to submit the command
-							corresp_rank->setBusyUntil(cycles + params->tCMD);
-							// Set the bank busy until we read it
-							corresp_bank->setBusyUntil(cycles + params->tCMD + params->tRCD);
-							corresp_bank->set_last(true);
-							time_ready = cycles + params->tRCD + params->tCMD;
-							curr_reads++;
-							READS_COMPLETE[cycles + params->tRCD + params->tCMD]++;
-							corresp_bank->setRB(temp->Address/params->row_buffer_size);
-							issued = true;
-						}
-						if(issued)
-						{
-							outstanding.push_back(temp);
-							transactions.erase(st);
-							removed=true;
-							// Lock the bank so no other request comes in and try to activate another row while waiting for the activation
-							corresp_bank->setLocked(true, cycles);
-							temp->meta_data = EventType::DEVICE_READY;
-							m_EventChan->send(time_ready-cycles, new MessierEvent(temp, EventType::DEVICE_READY));
-							break;
-						}
-					}
-				}
+				// Allocate the Rank circuitary to submit the command
+				corresp_rank->setBusyUntil(cycles + params->tCMD);
+				// Set the bank busy until we read it
+				corresp_bank->setBusyUntil(cycles + params->tCMD + params->tRCD);
+				corresp_bank->set_last(true);
+				time_ready = cycles + params->tRCD + params->tCMD;
+				curr_reads++;
+				READS_COMPLETE.push(cycles + params->tRCD + params->tCMD);
+				corresp_bank->setRB(temp->Address/params->row_buffer_size);
 			}
-			st++;
+
+			outstanding++;
+			remove_transaction(temp);
+			removed=true;
+			// Lock the bank so no other request comes in and try to activate another row while waiting for the activation
+			corresp_bank->setLocked(true, cycles);
+			temp->meta_data = EventType::DEVICE_READY;
+			m_EventChan->send(time_ready-cycles, new MessierEvent(temp, EventType::DEVICE_READY));
 		}
 
+		progress = true;
+
 	}
 
 
@@ -665,6 +886,9 @@ NVM_Request * NVM_DIMM::pop_request()
 void NVM_DIMM::handleEvent( SST::Event* e )
 {
 
+	// The clock may be off while waiting for this event
+	if(enable_clock)
+		enable_clock();
 
 
 	MessierEvent * temp_ptr =  dynamic_cast<MessierComponent::MessierEvent*> (e);
@@ -736,7 +960,7 @@ void NVM_DIMM::handleEvent( SST::Event* e )
 								evicted->Read = false;
 								evicted->Address = evicted_address;
 
-								WB->insert_write_request(evicted);
+								wb_insert(evicted);
 								cache->insert_block(temp->Address, true);
 								cache->update_lru(temp->Address);
 
@@ -755,7 +979,7 @@ void NVM_DIMM::handleEvent( SST::Event* e )
 
 			(getBank(req->Address))->setLocked(false, cycles);
 			ready_trans.erase(req);
-			outstanding.remove(req);
+			outstanding--;
 			delete req;
 
 		}
@@ -794,16 +1018,16 @@ void NVM_DIMM::handleEvent( SST::Event* e )
 				m_memChan->send((SST::Event *) respEvent);
 				cache->update_lru(temp->Address);
 				if(params->cache_persistent)
-					HOLD.erase(temp->req_ID);
+					release_hold(temp->req_ID);
 
-				SQUASHED[temp->req_ID] = 1;
+				squash(temp->req_ID);
 
 
 			}
 			else
 			{
 				if(params->cache_persistent)
-					HOLD.erase(temp->req_ID);
+					release_hold(temp->req_ID);
 
 			}
 		}
@@ -828,7 +1052,7 @@ void NVM_DIMM::handleEvent( SST::Event* e )
 						evicted->Read = false;
 						evicted->Address = evicted_address;
 
-						WB->insert_write_request(evicted);
+						wb_insert(evicted);
 
 						MemRespEvent *respEvent = new MemRespEvent(
 								NVM_EVENT_MAP[temp->req_ID]->getReqId(), NVM_EVENT_MAP[temp->req_ID]->getAddr(), NVM_EVENT_MAP[temp->req_ID]->getFlags() );
@@ -918,6 +1142,9 @@ void NVM_DIMM::handleEvent( SST::Event* e )
 void NVM_DIMM::handleRequest(SST::Event* e)
 {
 
+	if(enable_clock)
+		enable_clock();
+
 	enabled = true;
 
 
@@ -27,6 +27,10 @@
 #include <sst/elements/memHierarchy/memEvent.h>
 #include <map>
 #include <list>
+#include <queue>
+#include <vector>
+#include <unordered_map>
+#include <functional>
 #include "Rank.h"
 #include "WriteBuffer.h"
 #include "NVM_Params.h"
@@ -52,16 +56,43 @@ namespace SST { namespace MessierComponent{
 		NVM_PARAMS * params;
 
 		// This is the requests buffer, where all transactions are buffered before being processed by the controller
-		std::list<NVM_Request *> transactions;
+		// Each transaction gets an arrival sequence number, and the controller serves the oldest one that can make progress.
+		// The transactions are indexed by what they wait for, so only the ones that can make progress are looked at
+		uint64_t next_seq;
+		int num_transactions;
 
-		// This tracks the currently outstanding requests
-		std::list<NVM_Request *> outstanding;
+		// Reads waiting for their bank, one queue per (rank, bank), in arrival order
+		std::vector<std::list<NVM_Request *> > bank_reads;
 
-		// This is used to quickly track the number of writes complete at a specific cycle to remove them from the currently executed writes
-		std::map<long long int, int> WRITES_COMPLETE;
+		// Writes waiting for room in the write buffer, in arrival order
+		std::list<NVM_Request *> pending_writes;
 
-		// This is used to quickly track the number of reads complete at a specific cycle to remove them from the currently executed reads
-		std::map<long long int, int> READS_COMPLETE;
+		// The buffered transactions by req_ID, to find the ones squashed by a cache hit
+		std::unordered_map<long long int, NVM_Request *> TRANS_ID;
+
+		// Buffered transactions squashed by a cache hit, in arrival order
+		std::map<uint64_t, NVM_Request *> squashed_trans;
+
+		// Buffered reads (not on hold) whose block is in the write buffer, in arrival order
+		std::map<uint64_t, NVM_Request *> wb_hits;
+
+		// Buffered reads by write buffer block, to keep wb_hits up to date as the write buffer changes
+		std::unordered_map<long long int, std::vector<NVM_Request *> > reads_by_block;
+
+		// This tracks the number of currently outstanding requests
+		int outstanding;
+
+		// This is used to quickly track the cycles at which writes complete to remove them from the currently executed writes (earliest first)
+		std::priority_queue<long long int, std::vector<long long int>, std::greater<long long int> > WRITES_COMPLETE;
+
+		// This is used to quickly track the cycles at which reads complete to remove them from the currently executed reads (earliest first)
+		std::priority_queue<long long int, std::vector<long long int>, std::greater<long long int> > READS_COMPLETE;
+
+		// Set whenever the current tick issues, completes or drops a request
+		bool progress;
+
+		// Called to get ticked again after tick() returned true
+		std::function<void()> enable_clock;
 
                 // Deterministic sort function for NVM_Request pointers
                 struct NVMReqPtrCompare {
@@ -123,9 +154,17 @@ namespace SST { namespace MessierComponent{
 		// This is the constructor for the NVM-based DIMM
 		NVM_DIMM(SST::ComponentId_t id, NVM_PARAMS par);
 
-		// This is the clock of the near memory controller
+		// This is the clock of the near memory controller, returns true if nothing can be issued until getWakeDelay() cycles from now or a new event arrives
 		bool tick();
 
+		// The number of cycles until a tick may issue something without a new event arriving (0 if only an event can unblock the controller)
+		long long int getWakeDelay();
+
+		// Account for cycles that were not ticked because the controller was idle
+		void skipCycles(long long int n);
+
+		void setEnableClockHandler(std::function<void()> func) { enable_clock = func; }
+
 		void finish(){}
 
 		RANK * getRank(long long int add){ return ranks[WhichRank(add)]; }
@@ -140,9 +179,27 @@ namespace SST { namespace MessierComponent{
 		// This determines the location of the block (in which bank), based on the interleaving policy
 		int WhichBank(long long int add);
 
+		// The index of the (rank, bank) queue of an address
+		int BankIndex(long long int add) { return WhichRank(add)*params->num_banks + WhichBank(add); }
+
 		//bool push_request(NVM_Request * req) { if(transactions.size() >= params->max_requests) return false; else {transactions.push_back(req); return true; }}
 
-		bool push_request(NVM_Request * req) { transactions.push_back(req);  if(req->Read) TIME_STAMP[req]= cycles; return true;}
+		bool push_request(NVM_Request * req) { add_transaction(req);  if(req->Read) TIME_STAMP[req]= cycles; return true;}
+
+		// Add and remove a request from the requests buffer and its indices
+		void add_transaction(NVM_Request * req);
+		void remove_transaction(NVM_Request * req);
+
+		// Update the indices when the cache squashes a request or releases its hold
+		void squash(long long int req_ID);
+		void release_hold(long long int req_ID);
+
+		// The oldest read of a bank queue that is not on hold (and hits in the row buffer if row_hit), or best if that one is older
+		NVM_Request * first_read(int bank_index, bool row_hit, NVM_Request * best);
+
+		// Insert and erase write buffer entries, keeping wb_hits up to date
+		bool wb_insert(NVM_Request * req);
+		void wb_erase(NVM_Request * req);
 
 		// This is the optimized version that basiclly tries to find out if there is any possibility to achieve a row buffer hit from the current transactions
 		bool submit_request_opt();
@@ -153,6 +210,9 @@ namespace SST { namespace MessierComponent{
 		// This schedule a deliver for data ready at the NVM Chips
 		void schedule_delivery();
 
+		// Remove the reads and writes that complete by now from the currently executed ones
+		void retire_completions();
+
 		// Try to flush the write buffer
 		bool try_flush_wb();
 
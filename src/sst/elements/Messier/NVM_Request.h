@@ -43,6 +43,10 @@ class NVM_Request
 		long long int Address;
 		int meta_data;
 
+		// Arrival order and queue (rank and bank) of the request in the controller queue or write buffer currently holding it
+		uint64_t seq;
+		int queue;
+
 };
 
 }}
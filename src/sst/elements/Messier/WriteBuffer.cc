@@ -44,7 +44,7 @@ bool NVM_WRITE_BUFFER::flush()
 }
 
 // Insert a write request entry in the write buffer
-bool NVM_WRITE_BUFFER::insert_write_request(NVM_Request * req)
+bool NVM_WRITE_BUFFER::insert_write_request(NVM_Request * req, int queue)
 {
 
 
@@ -53,14 +53,12 @@ bool NVM_WRITE_BUFFER::insert_write_request(NVM_Request * req)
 	{
 
 		ADD_REQ[req->Address/entry_size]=req;
-		mem_reqs.push_back(req);
+		req->seq = next_seq++;
+		req->queue = queue;
+		queues[queue].push_back(req);
 		curr_entries++;
 
 
-		if(mem_reqs.size() != curr_entries)
-			std::cout<<"Massive error 1"<<std::endl;
-
-
 		if( curr_entries >= (flush_th*1.0*max_size/100.0) )
 			still_flushing=true;
 
@@ -79,29 +77,33 @@ NVM_Request * NVM_WRITE_BUFFER::find_entry(long long int address)
 {
 
 	// Fast path: note that this is the common case where there is no entry in WB, hence speeding up SST time
-	if(ADD_REQ.find(address/entry_size) == ADD_REQ.end())
+	std::unordered_map<long long int, NVM_Request *>::iterator it = ADD_REQ.find(address/entry_size);
+	if(it == ADD_REQ.end())
 		return NULL;
 	else
-		return ADD_REQ[address/entry_size];
+		return it->second;
+
+}
+
+// The oldest entry is at the head of one of the queues
+NVM_Request * NVM_WRITE_BUFFER::getFront()
+{
+	NVM_Request * front = NULL;
+	for(unsigned int i = 0; i < queues.size(); i++)
+		if(!queues[i].empty() && (front == NULL || queues[i].front()->seq < front->seq))
+			front = queues[i].front();
 
+	return front;
 }
 
 // Popping up the first entry in the write buffer, this is called by the NVM memory controller when it is idle or the flush signal is triggered in the write buffer
 NVM_Request * NVM_WRITE_BUFFER::pop_entry()
 {
-	if(mem_reqs.empty())
+	NVM_Request * TEMP = getFront();
+	if(TEMP == NULL)
 		return NULL;
 
-	NVM_Request * TEMP = mem_reqs.front();
-	ADD_REQ.erase(TEMP->Address/entry_size);
-	mem_reqs.pop_front();
-	curr_entries--;
-
-		if(mem_reqs.size() != curr_entries)
-			std::cout<<"Massive error 2"<<std::endl;
-
-	if(curr_entries <= (flush_th_low*1.0*max_size/100.0) )
-		still_flushing=false;
+	erase_entry(TEMP);
 
 	return TEMP;
 }
@@ -112,11 +114,18 @@ void NVM_WRITE_BUFFER::erase_entry(NVM_Request * TEMP)
 {
 
 	ADD_REQ.erase(TEMP->Address/entry_size);
-	mem_reqs.remove(TEMP);
-	curr_entries--;
 
-		if(mem_reqs.size() != curr_entries)
-			std::cout<<"Massive error 3  curr_entrie="<<curr_entries<<"  mem_reqs.size()= "<<mem_reqs.size()<<std::endl;
+	// Entries are normally erased from the head of their queue. An entry that is not in the buffer leaves the entry count as it is
+	std::list<NVM_Request *> & queue = queues[TEMP->queue];
+	for(std::list<NVM_Request *>::iterator it = queue.begin(); it != queue.end(); it++)
+	{
+		if(*it == TEMP)
+		{
+			queue.erase(it);
+			curr_entries--;
+			break;
+		}
+	}
 
 	 if(curr_entries <= (flush_th_low*1.0*max_size/100.0) )
                 still_flushing=false;
@@ -24,8 +24,9 @@
 #include <sst/core/component.h>
 #include <sst/core/timeConverter.h>
 #include <sst/elements/memHierarchy/memEvent.h>
-#include<map>
 #include<list>
+#include<unordered_map>
+#include<vector>
 #include "NVM_Request.h"
 
 using namespace SST;
@@ -51,12 +52,14 @@ class NVM_WRITE_BUFFER
 	// the current number of entries
 	unsigned int curr_entries;
 
-	// This tracks them in order
-	std::list<NVM_Request *> mem_reqs;
+	// This tracks them in order, with one queue per (rank, bank) so the controller only looks at the oldest write of each bank
+	std::vector<std::list<NVM_Request *> > queues;
 
+	// The arrival order of the entries across all queues
+	uint64_t next_seq;
 
-	// This is used to speed up returning the memory requests in case of finding the request in the write buffer
-	std::map<long long int, NVM_Request *> ADD_REQ;
+	// This is used to speed up returning the memory requests in case of finding the request in the write buffer (hashed by block)
+	std::unordered_map<long long int, NVM_Request *> ADD_REQ;
 
 	int entry_size; // this determines the granularity of the write requests, ideally this should be similar to cache line size
 
@@ -67,13 +70,13 @@ class NVM_WRITE_BUFFER
 
 
 	// Constructor
-	NVM_WRITE_BUFFER(int Size, int Sched_mode, int Entry_size, int Flush_th, int low_th){ flush_th_low = low_th; max_size = Size; sched_mode = Sched_mode; flush_th = Flush_th; entry_size = Entry_size; still_flushing=false; curr_entries = 0;}
+	NVM_WRITE_BUFFER(int Size, int Sched_mode, int Entry_size, int Flush_th, int low_th, int Num_queues) : queues(Num_queues) { flush_th_low = low_th; max_size = Size; sched_mode = Sched_mode; flush_th = Flush_th; entry_size = Entry_size; still_flushing=false; curr_entries = 0; next_seq = 0; ADD_REQ.reserve(Size);}
 
 	// This checks if the writebuffer is in the flush mode (entries exceed threshold)
 	bool flush();
 
-	// Get the list size
-	int ListSize() { return mem_reqs.size();}
+	// The block an address maps to, i.e., the granularity of the entries
+	long long int block(long long int address) { return address/entry_size; }
 
 	// Check if empty
 	bool empty() { if (curr_entries == 0) return true; else return false;}
@@ -85,8 +88,8 @@ class NVM_WRITE_BUFFER
 	// Check if full or not
 	bool full() { if(curr_entries == max_size) return true; else return false;}
 
-	// Insert an entry (returns false if it fails, otherwise it return true)
-	bool insert_write_request(NVM_Request * req);
+	// Insert an entry in the given queue (returns false if it fails, otherwise it return true)
+	bool insert_write_request(NVM_Request * req, int queue);
 
         // This enables searching if a request exists on the write buffer (this is important for correctness and not to break memory consistency)
         NVM_Request * find_entry(long long int address);
@@ -94,11 +97,15 @@ class NVM_WRITE_BUFFER
 	// This removes an entry (returns NULL if empty)
 	NVM_Request * pop_entry();
 
-	NVM_Request * getFront() { return mem_reqs.front();}
+	// The oldest entry in the write buffer (NULL if empty)
+	NVM_Request * getFront();
 
 	void erase_entry(NVM_Request *);
 
-	std::list<NVM_Request *> getList() { return mem_reqs;}
+	int numQueues() { return queues.size(); }
+
+	// The oldest entry of a queue (NULL if the queue is empty)
+	NVM_Request * getOldest(int queue) { return queues[queue].empty() ? NULL : queues[queue].front(); }
 
 
 };
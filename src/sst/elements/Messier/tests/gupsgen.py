@@ -1,4 +1,5 @@
 import sst
+import sys
 
 # Define SST core options
 sst.setProgramOption("timebase", "1ps")
@@ -92,6 +93,9 @@ messier_inst.addParams({
       "max_writes" : 4
 })
 
+idle_fastforward = 1 if "--idle_fastforward=1" in sys.argv else 0
+messier_inst.addParam("idle_fastforward", idle_fastforward)
+
 
 #nvm_memory.addParams({
  #     "coherence_protocol" : "MESI",
@@ -58,9 +58,20 @@ class testcase_Messier_Component(SSTTestCase):
     def test_Messier_streambench_messier(self):
         self.Messier_test_template("streambench_messier")
 
+    # The reference files were made with the NVM DIMM clocked every cycle,
+    # idle fast-forward must give the same output
+    def test_Messier_gupsgen_idleFastForward(self):
+        self.Messier_test_template("gupsgen", idle_fastforward=True)
+
+    def test_Messier_gupsgen_2RANKS_idleFastForward(self):
+        self.Messier_test_template("gupsgen_2RANKS", idle_fastforward=True)
+
+    def test_Messier_gupsgen_fastNVM_idleFastForward(self):
+        self.Messier_test_template("gupsgen_fastNVM", idle_fastforward=True)
+
 #####
 
-    def Messier_test_template(self, testcase, testtimeout=240):
+    def Messier_test_template(self, testcase, testtimeout=240, idle_fastforward=False):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -71,13 +82,19 @@ class testcase_Messier_Component(SSTTestCase):
 
         sdlfile = "{0}/{1}.py".format(test_path, testcase)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+
+        otherargs = ""
+        if idle_fastforward:
+            otherargs = '--model-options "--idle_fastforward=1"'
+            testDataFileName = "{0}_idleFastForward".format(testDataFileName)
+
         outfile = "{0}/{1}.out".format(outdir, testDataFileName)
         errfile = "{0}/{1}.err".format(outdir, testDataFileName)
         mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
         newreffile = "{0}/refFiles/{1}.newref".format(outdir, testDataFileName)
         newoutfile = "{0}/{1}.newout".format(outdir, testDataFileName)
 
-        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
+        self.run_sst(sdlfile, outfile, errfile, other_args=otherargs, mpi_out_files=mpioutfiles, timeout_sec=testtimeout)
 
         testing_remove_component_warning_from_file(outfile)
 
@@ -91,7 +108,7 @@ class testcase_Messier_Component(SSTTestCase):
         #       TESTS & RESULT FILES ARE STILL VALID
 
         # Perform the test
-        cmp_result = testing_compare_sorted_diff(testcase, outfile, reffile)
+        cmp_result = testing_compare_sorted_diff(testDataFileName, outfile, reffile)
 
         # Special case handling of stencil3dbench_messier
         if not cmp_result and testcase == "stencil3dbench_messier":
@@ -106,6 +123,6 @@ class testcase_Messier_Component(SSTTestCase):
 
         else:
             if (cmp_result == False):
-                diffdata = testing_get_diff_data(testcase)
+                diffdata = testing_get_diff_data(testDataFileName)
                 log_failure(diffdata)
             self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
@@ -103,9 +103,16 @@ Opal::Opal(SST::ComponentId_t id, SST::Params& params): Component(id) {
 		sprintf(subID, "%" PRIu32, i);
 		nodeInfo[i]->statLocalMemUsage = registerStatistic<uint64_t>("local_mem_usage", subID );
 		nodeInfo[i]->statSharedMemUsage = registerStatistic<uint64_t>("shared_mem_usage", subID );
+		nodeInfo[i]->statLocalMemFragmentation = registerStatistic<uint64_t>("local_mem_fragmentation", subID );
 		free(subID);
 	}
 
+	for(uint32_t i = 0; i < num_shared_mempools; i++) {
+		memset(buffer, 0 , 256);
+		sprintf(buffer, "%" PRIu32, i);
+		sharedMemoryInfo[i]->statFragmentation = registerStatistic<uint64_t>("shared_mem_fragmentation", buffer );
+	}
+
 	free(buffer);
 
 	/* registering clock */
@@ -545,11 +552,15 @@ bool Opal::tick(SST::Cycle_t x)
 
 void Opal::finish()
 {
-	for(uint32_t i = 0; i < num_nodes; i++ )
+	for(uint32_t i = 0; i < num_nodes; i++ ) {
+	  nodeInfo[i]->statLocalMemFragmentation->addData(nodeInfo[i]->pool->fragmentation());
 	  nodeInfo[i]->pool->finish();
+	}
 
-	for(uint32_t i = 0; i < num_shared_mempools; i++ )
+	for(uint32_t i = 0; i < num_shared_mempools; i++ ) {
+	  sharedMemoryInfo[i]->statFragmentation->addData(sharedMemoryInfo[i]->pool->fragmentation());
 	  sharedMemoryInfo[i]->pool->finish();
+	}
 
 }
 
@@ -90,7 +90,9 @@ namespace SST
 
 				Pool* pool;
 
-				MemoryPrivateInfo() { }
+				Statistic<uint64_t>* statFragmentation; // registered for shared memory pools only
+
+				MemoryPrivateInfo() : statFragmentation(nullptr) { }
 
 				MemoryPrivateInfo(OpalBase *base, uint32_t _id, Params params)
 				{
@@ -98,6 +100,7 @@ namespace SST
 					opalBase = base;
 					latency = (uint32_t) params.find<uint32_t>("latency", 1);
 					pool = new Pool(params, SST::OpalComponent::MemType::SHARED, _id);
+					statFragmentation = nullptr;
 				}
 
 				~MemoryPrivateInfo() {
@@ -195,6 +198,7 @@ namespace SST
 
 				Statistic<uint64_t>* statLocalMemUsage;
 				Statistic<uint64_t>* statSharedMemUsage;
+				Statistic<uint64_t>* statLocalMemFragmentation;
 
 				NodePrivateInfo(OpalBase *base, uint32_t node, Params params)
 				{
@@ -337,6 +341,8 @@ namespace SST
 					SST_ELI_DOCUMENT_STATISTICS(
 							{ "local_mem_usage", "Number of pages allocated in local memory", "requests", 1},
 							{ "shared_mem_usage", "Number of pages allocated in shared memory", "requests", 1},
+							{ "local_mem_fragmentation", "Percentage of free local memory frames outside completely free large (512-frame) frames, at the end of simulation", "percent", 1},
+							{ "shared_mem_fragmentation", "Percentage of free frames of a shared memory pool outside completely free large (512-frame) frames, at the end of simulation", "percent", 1},
 							)
 
 					SST_ELI_DOCUMENT_PORTS(
@@ -79,24 +79,113 @@ Pool::Pool(Params params, SST::OpalComponent::MemType mem_type, int id)
 
 }
 
+const uint64_t Pool::large_frame;
+const uint64_t Pool::huge_frame;
+
+void FrameBitmap::init(uint64_t n, bool value)
+{
+	levels.clear();
+	do {
+		uint64_t words = (n + 63) / 64;
+		std::vector<uint64_t> level(std::max<uint64_t>(words, 1), 0);
+		if(value) {
+			for(uint64_t w = 0; w < n / 64; w++)
+				level[w] = ~(uint64_t) 0;
+			if(n & 63)
+				level[words - 1] = ((uint64_t) 1 << (n & 63)) - 1;
+		}
+		levels.push_back(level);
+		n = words;
+	} while(n > 1);
+}
+
+void FrameBitmap::set(uint64_t i)
+{
+	for(size_t l = 0; l < levels.size(); l++) {
+		uint64_t & word = levels[l][i >> 6];
+		bool was_empty = (word == 0);
+		word |= (uint64_t) 1 << (i & 63);
+		if(!was_empty)
+			return;
+		i >>= 6;
+	}
+}
+
+void FrameBitmap::clear(uint64_t i)
+{
+	for(size_t l = 0; l < levels.size(); l++) {
+		uint64_t & word = levels[l][i >> 6];
+		word &= ~((uint64_t) 1 << (i & 63));
+		if(word != 0)
+			return;
+		i >>= 6;
+	}
+}
+
+void FrameBitmap::assign_words(uint64_t first_word, uint64_t words, bool value)
+{
+	for(uint64_t w = first_word; w < first_word + words; w++) {
+		levels[0][w] = value ? ~(uint64_t) 0 : 0;
+		propagate(w);
+	}
+}
+
+void FrameBitmap::propagate(uint64_t w)
+{
+	for(size_t l = 1; l < levels.size(); l++) {
+		uint64_t & word = levels[l][w >> 6];
+		bool was_empty = (word == 0);
+		if(levels[l-1][w] != 0)
+			word |= (uint64_t) 1 << (w & 63);
+		else
+			word &= ~((uint64_t) 1 << (w & 63));
+		if(was_empty == (word == 0))
+			return;
+		w >>= 6;
+	}
+}
+
+int64_t FrameBitmap::find_first() const
+{
+	uint64_t i = 0;
+	for(size_t l = levels.size(); l > 0; l--) {
+		uint64_t word = levels[l-1][i];
+		if(word == 0)
+			return -1;
+		i = i*64 + __builtin_ctzll(word);
+	}
+	return i;
+}
+
 //Create free frames of size framesize, note that the size is in KB
 void Pool::build_mem()
 {
-	int i=0;
 	num_frames = ceil(size/frsize);
 	real_size = num_frames * frsize;
 
-	//std::vector<int> numbers;
-	//for(int i=0; i<num_frames; i++)       // add 0-99 to the vector
-    //	numbers.push_back(i);
+	free_frames.init(num_frames, true);
 
-    // random allocation of frames
-	//unsigned seed = std::chrono::system_clock::now().time_since_epoch().count();
-	//std::shuffle(numbers.begin(), numbers.end(), std::default_random_engine(seed));
+	// Only large/huge frames that lie entirely inside the pool can be handed out whole
+	uint64_t larges = (num_frames + large_frame - 1) / large_frame;
+	uint64_t huges = (num_frames + huge_frame - 1) / huge_frame;
+	num_free_large = num_frames / large_frame;
+	num_free_huge = num_frames / huge_frame;
 
-	for(i=0; i< num_frames; i++) {
-		freelist.push_back(((uint64_t) i*frsize*1024) + start);
-	}
+	large_free_count.assign(larges, large_frame);
+	huge_free_count.assign(huges, huge_frame);
+	if(num_frames % large_frame)
+		large_free_count[larges - 1] = num_frames % large_frame;
+	if(num_frames % huge_frame)
+		huge_free_count[huges - 1] = num_frames % huge_frame;
+
+	free_large.init(num_free_large, true);
+	free_huge.init(num_free_huge, true);
+
+	large_whole.assign(larges, false);
+	huge_whole.assign(huges, false);
+
+	free_queue.clear();
+	free_queue.push_back(FrameRun(0, num_frames));
 
 	available_frames = num_frames;
 
@@ -104,86 +193,212 @@ void Pool::build_mem()
 
 }
 
+int64_t Pool::frame_number(uint64_t address)
+{
+	uint64_t frame_bytes = (uint64_t) frsize*1024;
+	if(address < start || (address - start) % frame_bytes)
+		return -1;
+
+	uint64_t frame = (address - start) / frame_bytes;
+	return (frame < (uint64_t) num_frames) ? (int64_t) frame : -1;
+}
+
+uint64_t Pool::next_free()
+{
+	while(true) {
+		FrameRun & run = free_queue.front();
+		uint64_t frame = run.first++;
+		if(--run.count == 0)
+			free_queue.pop_front();
+
+		if(frame_free(frame))
+			return frame;
+	}
+}
+
+void Pool::take(uint64_t frame)
+{
+	free_frames.clear(frame);
+	available_frames--;
+
+	uint64_t large = frame / large_frame;
+	if(large_free_count[large]-- == large_frame) {
+		free_large.clear(large);
+		num_free_large--;
+	}
+
+	uint64_t huge = frame / huge_frame;
+	if(huge_free_count[huge]-- == huge_frame) {
+		free_huge.clear(huge);
+		num_free_huge--;
+	}
+}
+
+void Pool::give(uint64_t frame)
+{
+	split(frame);
+
+	free_frames.set(frame);
+	available_frames++;
+
+	uint64_t large = frame / large_frame;
+	if(++large_free_count[large] == large_frame) {
+		free_large.set(large);
+		num_free_large++;
+	}
+
+	uint64_t huge = frame / huge_frame;
+	if(++huge_free_count[huge] == huge_frame) {
+		free_huge.set(huge);
+		num_free_huge++;
+	}
+
+	// Freed frames go to the back of the hand-out order
+	if(!free_queue.empty() && free_queue.back().first + free_queue.back().count == frame)
+		free_queue.back().count++;
+	else
+		free_queue.push_back(FrameRun(frame, 1));
+}
+
+// The free counts of a large/huge frame allocated whole are left as they were, it was completely free
+void Pool::take_large(uint64_t large)
+{
+	large_whole[large] = true;
+	free_large.clear(large);
+	num_free_large--;
+	available_frames -= large_frame;
+
+	uint64_t huge = large * large_frame / huge_frame;
+	if(huge_free_count[huge] == huge_frame) {
+		free_huge.clear(huge);
+		num_free_huge--;
+	}
+	huge_free_count[huge] -= large_frame;
+}
+
+void Pool::give_large(uint64_t large)
+{
+	large_whole[large] = false;
+	free_large.set(large);
+	num_free_large++;
+	available_frames += large_frame;
+
+	uint64_t huge = large * large_frame / huge_frame;
+	huge_free_count[huge] += large_frame;
+	if(huge_free_count[huge] == huge_frame) {
+		free_huge.set(huge);
+		num_free_huge++;
+	}
+
+	free_queue.push_back(FrameRun(large * large_frame, large_frame));
+}
+
+void Pool::take_huge(uint64_t huge)
+{
+	huge_whole[huge] = true;
+	free_huge.clear(huge);
+	num_free_huge--;
+	available_frames -= huge_frame;
+
+	// The large frames inside are no longer completely free
+	free_large.assign_words(huge * (huge_frame / large_frame) / 64, huge_frame / large_frame / 64, false);
+	num_free_large -= huge_frame / large_frame;
+}
+
+void Pool::give_huge(uint64_t huge)
+{
+	huge_whole[huge] = false;
+	free_huge.set(huge);
+	num_free_huge++;
+	available_frames += huge_frame;
+
+	free_large.assign_words(huge * (huge_frame / large_frame) / 64, huge_frame / large_frame / 64, true);
+	num_free_large += huge_frame / large_frame;
+
+	free_queue.push_back(FrameRun(huge * huge_frame, huge_frame));
+}
+
+void Pool::split(uint64_t frame)
+{
+	uint64_t huge = frame / huge_frame;
+	if(huge_whole[huge]) {
+		uint64_t first_large = huge * (huge_frame / large_frame);
+		free_frames.assign_words(huge * huge_frame / 64, huge_frame / 64, false);
+		std::fill(large_free_count.begin() + first_large, large_free_count.begin() + first_large + huge_frame / large_frame, 0);
+		huge_free_count[huge] = 0;
+		huge_whole[huge] = false;
+	}
+
+	uint64_t large = frame / large_frame;
+	if(large_whole[large]) {
+		free_frames.assign_words(large * large_frame / 64, large_frame / 64, false);
+		large_free_count[large] = 0;
+		large_whole[large] = false;
+	}
+}
+
 REQRESPONSE Pool::allocate_frames(int pages)
 {
 
 	REQRESPONSE response;
 	response.status =0;
 
-	if(available_frames < pages) {
+	if(available_frames < pages || pages < 1) {
 		return response;
 	}
 
-	int frames = pages;
-	std::list<Frame*> frames_allocated;
-
 	// Fixme: Shuffle memory to make continuous memory available
-	while(frames) {
-		// Make sure pool has free frames in the requested memory pool type. If not deallocate allocated frames (if number of frames to be allocated are > 1)
-		if(freelist.empty()) {
-			while(!frames_allocated.empty()) {
-				Frame *frame = frames_allocated.front();
-				freelist.push_back(frame->starting_address);
-				alloclist.erase(frame->starting_address);
-				frames_allocated.pop_front();
-				available_frames++;
-				delete frame;
-			}
-			break;
-		}
-		else
-		{
-			uint64_t frameAddr = freelist.front();
-			freelist.erase(freelist.begin());
-			Frame *frame = new Frame(frameAddr,0);
-			alloclist[frame->starting_address] = frame;
-			frames_allocated.push_back(frame);
-			available_frames--;
-		}
-		frames--;
-
+	for(int i = 0; i < pages; i++) {
+		uint64_t frame = next_free();
+		take(frame);
+		if(i == 0)
+			response.address = frame_address(frame);
 	}
 
-	if(!frames_allocated.empty()) {
-		response.address = (frames_allocated.front())->starting_address;
-		response.pages = pages;
-		response.status = 1;
-	}
+	response.pages = pages;
+	response.status = 1;
 
 	return response;
 
 }
 
-// Allocate N contigiuous frames, returns the starting address if successfull, or -1 if it fails!
+// Allocate N contigiuous frames, returns status 0 if it fails!
 REQRESPONSE Pool::allocate_frame(int N)
 {
 
 	REQRESPONSE response;
 	response.status = 0;
 
+	uint64_t first;
 
-	// Make sure we have free frames first
-	if(freelist.empty())
-		return response;
-
-	// For now, we will assume you can only allocate 1 frame, TODO: We will implemenet a buddy-allocator style that enables allocating contigous physical spaces
-	if(N>1)
-		return response;
-
+	// Pick the next free frame, or the lowest completely free large/huge frame
+	if(N == 1) {
+		if(available_frames == 0)
+			return response;
+		first = next_free();
+		take(first);
+	}
+	else if(N == (int) large_frame) {
+		int64_t large = free_large.find_first();
+		if(large < 0)
+			return response;
+		take_large(large);
+		first = large * large_frame;
+	}
+	else if(N == (int) huge_frame) {
+		int64_t huge = free_huge.find_first();
+		if(huge < 0)
+			return response;
+		take_huge(huge);
+		first = huge * huge_frame;
+	}
 	else
-	{
-		// Simply, pop the first free frame and assign it
-		uint64_t frameAddr = freelist.front();
-		freelist.erase(freelist.begin());
-		Frame *temp = new Frame(frameAddr,0);
-		alloclist[temp->starting_address] = temp;
-		available_frames--;
-		response.address = temp->starting_address;
-		response.pages = 1;
-		response.status = 1;
 		return response;
 
-	}
+	response.address = frame_address(first);
+	response.pages = N;
+	response.status = 1;
+	return response;
 
 }
 
@@ -196,21 +411,12 @@ REQRESPONSE Pool::deallocate_frames(int pages, uint64_t starting_pAddress)
 	REQRESPONSE response;
 	int frames = pages;
 	uint64_t pAddress = starting_pAddress;
-	uint64_t frame_number;
 
 	while(frames) {
 
 		// If we can find the frame to be free in the allocated list
-		std::map<uint64_t, Frame*>::iterator it;
-		it = alloclist.find(pAddress);
-		if (it != alloclist.end())
-		{
-			//Remove from allocation map and add to free list
-			Frame *temp = it->second;
-			freelist.push_back(temp->starting_address);
-			alloclist.erase(pAddress);
-			delete temp;
-		}
+		if(isAllocated(pAddress))
+			give(frame_number(pAddress));
 		else
 		{
 			response.address = pAddress; //physical address of the frame which failed to deallocate.
@@ -219,8 +425,7 @@ REQRESPONSE Pool::deallocate_frames(int pages, uint64_t starting_pAddress)
 			return response;
 		}
 
-		frame_number = (pAddress - start) / frsize * 1024;
-		pAddress += ((uint64_t) (frame_number+1)*frsize*1024) + start; //to get the next frame physical address
+		pAddress += (uint64_t) frsize*1024; //to get the next frame physical address
 		frames--;
 	}
 
@@ -228,44 +433,50 @@ REQRESPONSE Pool::deallocate_frames(int pages, uint64_t starting_pAddress)
 	return response;
 }
 
-// Freeing N frames starting from Address X, this will return -1 if we find that these frames were not allocated
+// Freeing N contiguous frames starting from Address X, this will return status 0 if we find that these frames were not allocated
 REQRESPONSE Pool::deallocate_frame(uint64_t X, int N)
 {
 
 	REQRESPONSE response;
 	response.status = 0;
 
-
-	// For now, we will assume you can free only 1 frame, TODO: We will implemenet a buddy-allocator style that enables allocating and freeing contigous physical spaces
-	if(N>1)
+	int64_t first = frame_number(X);
+	if(first < 0 || N < 1 || first + N > num_frames)
 		return response;
-	else
-	{
-		// If we can find the frame to be free in the allocated list
-		if(alloclist.find(X)!=alloclist.end())
-		{
-			// Remove from allocation map and add to free list
-			Frame * temp = alloclist[X];
-			freelist.push_back(temp->starting_address);
-			alloclist.erase(X);
-			delete temp;
-			available_frames++;
-			response.status = 1;
-		}
-		else // Means we couldn't find an allocated frame that is being unmapped
-			response.status = 0;
 
+	// A large/huge frame allocated whole is freed whole without visiting its frames
+	if(N == (int) huge_frame && first % huge_frame == 0 && huge_whole[first / huge_frame]) {
+		give_huge(first / huge_frame);
+	}
+	else if(N == (int) large_frame && first % large_frame == 0 && large_whole[first / large_frame]) {
+		give_large(first / large_frame);
+	}
+	else {
+		// Means we couldn't find an allocated frame that is being unmapped
+		for(int i = 0; i < N; i++)
+			if(frame_free(first + i))
+				return response;
+
+		for(int i = 0; i < N; i++)
+			give(first + i);
 	}
 
+	response.status = 1;
 	return response;
 }
 
 bool Pool::isAllocated(uint64_t address)
 {
-	if(alloclist.find(address)==alloclist.end())
-		return false;
+	int64_t frame = frame_number(address);
+	return frame >= 0 && !frame_free(frame);
+}
+
+uint64_t Pool::fragmentation()
+{
+	if(available_frames == 0)
+		return 0;
 
-	return true;
+	return 100 * (available_frames - num_free_large*large_frame) / available_frames;
 }
 
 /*REQRESPONSE Pool::allocate_frame_address(uint64_t address)
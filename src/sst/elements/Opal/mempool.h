@@ -20,8 +20,8 @@
 
 #include "Opal_Event.h"
 
-#include <list>
-#include <map>
+#include <vector>
+#include <deque>
 #include <cmath>
 
 
@@ -33,30 +33,49 @@ typedef struct reqresponse {
 }REQRESPONSE;
 
 
-// This defines a physical frame of size 4KB by default
-class Frame{
+// Tracks a set of indices with one bit each, e.g., the free frames of a pool.
+// Each summary level has a bit per word of the level below that is set when that word is non-zero,
+// so finding the lowest set index takes one word scan per level regardless of the number of indices.
+class FrameBitmap{
 
 	public:
-		// Constructor
-		Frame() { starting_address = 0; metadata = 0;}
 
-		// Constructor with paramteres
-		Frame(uint64_t st, uint64_t md) { starting_address = st; metadata = 0;}
+		FrameBitmap() { }
 
-		~Frame(){}
+		// Size the bitmap for n indices, all set or all clear
+		void init(uint64_t n, bool value);
 
-		// The starting address of the frame
-		uint64_t starting_address;
+		bool test(uint64_t i) const { return (levels[0][i >> 6] >> (i & 63)) & 1; }
 
-		// This will be used to store information about current allocation
-		int metadata;
+		void set(uint64_t i);
 
-		int frame_number;
+		void clear(uint64_t i);
+
+		// Set or clear the indices of 'words' whole words starting at word 'first_word'
+		void assign_words(uint64_t first_word, uint64_t words, bool value);
+
+		// The lowest set index, or -1 if none is set
+		int64_t find_first() const;
+
+	private:
+
+		// levels[0] holds the bits themselves, the last level is a single word
+		std::vector<std::vector<uint64_t> > levels;
+
+		// Update the summary bits above word w of levels[0] after it was overwritten
+		void propagate(uint64_t w);
 
 };
 
 
 // This class defines a memory pool
+//
+// Single frames are handed out in the order they became free, starting with all frames in address order,
+// the same as a FIFO free list. Besides single frames, a pool can hand out naturally aligned large frames
+// of 512 frames and huge frames of 512*512 frames (2MB and 1GB with the default 4KB frame size).
+// Per frame, the pool keeps a free bit. Per large and huge frame it keeps the number of free frames inside
+// it, a bitmap of the ones that are completely free and a flag for the ones allocated whole, so allocating
+// or freeing a whole large/huge frame does not touch its frames.
 
 class Pool{
 
@@ -65,29 +84,21 @@ class Pool{
 		//Constructor for pool
 		Pool(Params parmas, SST::OpalComponent::MemType mem_type, int id);
 
-		~Pool() {
-/*			while(!freelist.empty()) {
-				Frame* frame = freelist.front();
-				freelist.erase(freelist.begin());
-				delete frame;
-			}
-*/
-			std::map<uint64_t, Frame*>::iterator it;
-			for(it=alloclist.begin();it!=alloclist.end();it++) {
-				Frame* frame = it->second;
-				delete frame;
-			}
-		}
+		~Pool() { }
 
 		void finish() {}
 
+		// Frames in a large frame and in a huge frame
+		static const uint64_t large_frame = 512;
+		static const uint64_t huge_frame = 512*512;
+
 		// The size of the memory pool in KBs
 		uint32_t size;
 
 		// The starting address of the memory pool
 		uint64_t start;
 
-		// Allocate N contigiuous frames, returns the starting address if successfull, or -1 if it fails!
+		// Allocate N contigiuous frames, N can be 1, large_frame or huge_frame. Returns status 0 if it fails!
 		REQRESPONSE allocate_frame(int N);
 
 		// Allocate 'size' contigiuous memory, returns a structure with starting address and number of frames allocated
@@ -95,7 +106,7 @@ class Pool{
 
 		REQRESPONSE allocate_frame_address(uint64_t address, int N);
 
-		// Freeing N frames starting from Address X, this will return -1 if we find that these frames were not allocated
+		// Freeing N contiguous frames starting from Address X, this will return status 0 if we find that these frames were not allocated
 		REQRESPONSE deallocate_frame(uint64_t X, int N);
 
 		// Deallocate 'size' contigiuous memory starting from physical address 'starting_pAddress', returns a structure which indicates success or not
@@ -104,7 +115,14 @@ class Pool{
 		bool isAllocated(uint64_t address);
 
 		// Current number of free frames
-		int freeframes() { return freelist.size(); }
+		int freeframes() { return available_frames; }
+
+		// Number of large and huge frames that are completely free
+		uint64_t free_large_frames() { return num_free_large; }
+		uint64_t free_huge_frames() { return num_free_huge; }
+
+		// Percentage of the free frames that are outside completely free large frames, i.e., that can only be used as single frames
+		uint64_t fragmentation();
 
 		// Frame size in KBs
 		int frsize;
@@ -147,13 +165,53 @@ class Pool{
 		//Memory technology
 		SST::OpalComponent::MemTech memTech;
 
-		// The list of free frames
-		std::list<uint64_t> freelist;
-
-		//std::map<uint64_t, int> freelist_index;
-
-		// The list of allocated frames --- the key is the starting physical address
-		std::map<uint64_t, Frame*> alloclist;
+		// One bit per frame, set if the frame is free. The frames of a large/huge frame allocated whole keep
+		// their bits, the flags below mark them allocated.
+		FrameBitmap free_frames;
+
+		// The order single frames are handed out in, as runs of consecutive frames.
+		// Entries for frames that were allocated by other means since they were queued are skipped.
+		struct FrameRun {
+			uint64_t first;
+			uint64_t count;
+			FrameRun(uint64_t f, uint64_t c) : first(f), count(c) { }
+		};
+		std::deque<FrameRun> free_queue;
+
+		// Large/huge frames allocated whole
+		std::vector<bool> large_whole;
+		std::vector<bool> huge_whole;
+
+		// Free frames inside each large/huge frame, and which of them are completely free
+		std::vector<uint16_t> large_free_count;
+		std::vector<uint32_t> huge_free_count;
+		FrameBitmap free_large;
+		FrameBitmap free_huge;
+		uint64_t num_free_large;
+		uint64_t num_free_huge;
+
+		uint64_t frame_address(uint64_t frame) { return (frame*frsize*1024) + start; }
+
+		// Frame number of a frame's starting address, -1 if the address is not one
+		int64_t frame_number(uint64_t address);
+
+		bool frame_free(uint64_t frame) { return free_frames.test(frame) && !large_whole[frame / large_frame] && !huge_whole[frame / huge_frame]; }
+
+		// The next free frame in hand-out order, there must be one
+		uint64_t next_free();
+
+		// Mark a single free frame allocated, or an allocated one free
+		void take(uint64_t frame);
+		void give(uint64_t frame);
+
+		// Allocate or free a whole large/huge frame
+		void take_large(uint64_t large);
+		void give_large(uint64_t large);
+		void take_huge(uint64_t huge);
+		void give_huge(uint64_t huge);
+
+		// Turn the large/huge frame allocated whole that holds 'frame', if any, into individually allocated frames
+		void split(uint64_t frame);
 
 };
 
@@ -106,16 +106,14 @@ void OpalMemNIC::processInitMemRtrEvent(MemHierarchy::MemNICBase::InitMemRtrEven
 }
 
 
-std::string OpalMemNIC::findTargetDestination(MemHierarchy::Addr addr) {
-    for (std::set<MemHierarchy::MemLinkBase::EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
-        if (it->region.contains(addr)) return it->name;
-    }
+const std::string& OpalMemNIC::findTargetDestination(MemHierarchy::Addr addr) {
+    const std::string& dst = MemNICBase::findTargetDestination(addr);
+    if (dst != "") return dst;
 
     if (enable && localMemSize) {
         MemHierarchy::Addr tempAddr = addr & (localMemSize-1);
-        for (std::set<MemHierarchy::MemLinkBase::EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
-            if(it->region.contains(tempAddr)) return it->name;
-        }
+        const std::string& localDst = MemNICBase::findTargetDestination(tempAddr);
+        if (localDst != "") return localDst;
     }
 
     /* Build error string */
@@ -126,5 +124,5 @@ std::string OpalMemNIC::findTargetDestination(MemHierarchy::Addr addr) {
         error << it->name << " " << it->region.toString() << endl;
     }
     dbg.fatal(CALL_INFO, -1, "%s", error.str().c_str());
-    return "";
+    return dst;
 }
@@ -0,0 +1,184 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#ifndef _H_SST_SAMBA_PAGE_TABLE
+#define _H_SST_SAMBA_PAGE_TABLE
+
+#include <stdint.h>
+#include <string.h>
+#include <map>
+
+typedef uint64_t Address_t;
+
+namespace SST { namespace SambaComponent{
+
+	// A four-level x86-64 style radix page table.
+	//
+	// Levels are numbered like the page table walk caches: 0 is the PTE (4KB pages), 1 the PMD (2MB),
+	// 2 the PUD (1GB) and 3 the PGD (512GB). Each table is a 512-entry array indexed by 9 bits of the
+	// virtual address, so a lookup is at most four array indexing steps rather than a tree search.
+	//
+	// Every entry holds the physical address installed by the page fault handler plus three flags:
+	// PRESENT (the entry has been filled), MAPPED (the page at that level's granularity can be
+	// translated without faulting) and PENDING (a page fault covering the entry is in flight).
+	// Tables are created on demand, so a PENDING entry may exist in a table whose parent is not PRESENT yet.
+	//
+	// Virtual addresses wider than 48 bits get their own PGD, looked up by the upper bits. Callers that
+	// want the confined (48-bit wrapped) view of the address space mask the address with confine() first.
+	class PageTable
+	{
+		public:
+
+		static const int levels = 4;
+		static const int entries = 512;
+
+		enum EntryFlag : uint8_t { PRESENT = 0x1, MAPPED = 0x2, PENDING = 0x4 };
+
+		PageTable() : root(new Table(levels-1)) { }
+
+		~PageTable()
+		{
+			delete root;
+			for(auto & r : upper_roots)
+				delete r.second;
+		}
+
+		PageTable(const PageTable&) = delete;
+		PageTable& operator=(const PageTable&) = delete;
+
+		// Drop the upper 16 bits of the virtual address
+		static Address_t confine(Address_t vaddr) { return vaddr & (((Address_t) 1 << 48) - 1); }
+
+		// Physical address held by the entry covering vaddr at the given level, 0 if never filled
+		Address_t frame(int level, Address_t vaddr) const
+		{
+			const Table * t = find(level, vaddr);
+			return t == nullptr ? 0 : t->frame[index(level, vaddr)];
+		}
+
+		// Fill the entry covering vaddr at the given level
+		void map(int level, Address_t vaddr, Address_t paddr)
+		{
+			Table * t = lookup(level, vaddr);
+			int i = index(level, vaddr);
+			t->frame[i] = paddr;
+			t->flags[i] |= PRESENT;
+		}
+
+		bool present(int level, Address_t vaddr) const { return test(level, vaddr, PRESENT); }
+
+		// Is vaddr covered by a mapped 4KB, 2MB or 1GB page
+		bool mapped(Address_t vaddr) const
+		{
+			return test(0, vaddr, MAPPED) || test(1, vaddr, MAPPED) || test(2, vaddr, MAPPED);
+		}
+
+		void setMapped(int level, Address_t vaddr) { set(level, vaddr, MAPPED); }
+
+		bool pending(int level, Address_t vaddr) const { return test(level, vaddr, PENDING); }
+
+		void setPending(int level, Address_t vaddr) { set(level, vaddr, PENDING); }
+
+		void clearPending(int level, Address_t vaddr)
+		{
+			Table * t = const_cast<Table*>(find(level, vaddr));
+			if(t != nullptr)
+				t->flags[index(level, vaddr)] &= ~PENDING;
+		}
+
+		private:
+
+		struct Table
+		{
+			Address_t frame[entries];
+			uint8_t flags[entries];
+			Table ** next; // tables one level down, nullptr for PTE tables
+
+			Table(int level) : next(nullptr)
+			{
+				memset(frame, 0, sizeof(frame));
+				memset(flags, 0, sizeof(flags));
+				if(level > 0)
+				{
+					next = new Table*[entries];
+					memset(next, 0, sizeof(Table*) * entries);
+				}
+			}
+
+			~Table()
+			{
+				if(next == nullptr)
+					return;
+				for(int i = 0; i < entries; i++)
+					delete next[i];
+				delete [] next;
+			}
+		};
+
+		Table * root; // PGD for the canonical 48-bit address space
+		std::map<Address_t, Table*> upper_roots; // PGDs for addresses beyond 48 bits, keyed by vaddr >> 48
+
+		static int index(int level, Address_t vaddr) { return (vaddr >> (12 + 9*level)) & (entries - 1); }
+
+		// Walk down to the table holding vaddr's entry at the given level, creating tables as needed
+		Table * lookup(int level, Address_t vaddr)
+		{
+			Address_t upper = vaddr >> 48;
+			Table * t = root;
+			if(upper != 0)
+			{
+				Table *& r = upper_roots[upper];
+				if(r == nullptr)
+					r = new Table(levels-1);
+				t = r;
+			}
+
+			for(int l = levels-1; l > level; l--)
+			{
+				Table *& n = t->next[index(l, vaddr)];
+				if(n == nullptr)
+					n = new Table(l-1);
+				t = n;
+			}
+			return t;
+		}
+
+		// Same as lookup, but returns nullptr instead of creating missing tables
+		const Table * find(int level, Address_t vaddr) const
+		{
+			Address_t upper = vaddr >> 48;
+			const Table * t = root;
+			if(upper != 0)
+			{
+				auto r = upper_roots.find(upper);
+				if(r == upper_roots.end())
+					return nullptr;
+				t = r->second;
+			}
+
+			for(int l = levels-1; l > level && t != nullptr; l--)
+				t = t->next[index(l, vaddr)];
+			return t;
+		}
+
+		bool test(int level, Address_t vaddr, uint8_t flag) const
+		{
+			const Table * t = find(level, vaddr);
+			return t != nullptr && (t->flags[index(level, vaddr)] & flag);
+		}
+
+		void set(int level, Address_t vaddr, uint8_t flag) { lookup(level, vaddr)->flags[index(level, vaddr)] |= flag; }
+	};
+
+}}
+
+#endif
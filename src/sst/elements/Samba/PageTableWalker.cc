@@ -26,10 +26,6 @@ using namespace SST;
 
 
 
-// This is and ID used to merely identify page walking requests
-long long int mmu_id=0;
-
-
 int max(int a, int b)
 {
 
@@ -41,17 +37,6 @@ int max(int a, int b)
 
 }
 
-int abs_int_Samba(int x)
-{
-
-	if(x<0)
-		return -1*x;
-	else
-		return x;
-
-}
-
-
 PageTableWalker::PageTableWalker(ComponentId_t id, int Page_size, int Assoc, PageTableWalker * Next_level, int Size) : ComponentExtension(id)
 {
 
@@ -110,13 +95,7 @@ PageTableWalker::PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker *
 	statPageTableWalkerMisses = registerStatistic<uint64_t>( "tlb_misses", subID );
 
 
-	size = new int[sizes];
-	assoc = new int[sizes];
 	page_size = new uint64_t[sizes];
-	sets = new int[sizes];
-	tags = new Address_t**[sizes];
-	valid = new bool**[sizes];
-	lru = new int **[sizes];
 
 
 	// page table offsets
@@ -128,44 +107,20 @@ PageTableWalker::PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker *
 	for(int i=0; i < sizes; i++)
 	{
 
-		size[i] =  ((uint32_t) params.find<uint32_t>("size"+std::to_string(i+1) + "_PTWC", 1));
+		int size =  ((uint32_t) params.find<uint32_t>("size"+std::to_string(i+1) + "_PTWC", 1));
 
-		assoc[i] =  ((uint32_t) params.find<uint32_t>("assoc"+std::to_string(i+1) +  "_PTWC", 1));
+		int assoc =  ((uint32_t) params.find<uint32_t>("assoc"+std::to_string(i+1) +  "_PTWC", 1));
 
-		// We define the number of sets for that structure of page size number i
-		sets[i] = size[i]/assoc[i];
+		// Entries start out invalid
+		ptwc.emplace_back(page_size[i], size, assoc, false);
 
 	}
 
 	hits=misses=0;
 
+	pending_misses = 0;
 
-
-	for(int id=0; id< sizes; id++)
-	{
-
-		tags[id] = new Address_t*[sets[id]];
-
-		valid[id] = new bool*[sets[id]];
-
-		lru[id] = new int*[sets[id]];
-
-		for(int i=0; i < sets[id]; i++)
-		{
-			tags[id][i]=new Address_t[assoc[id]];
-			valid[id][i]=new bool[assoc[id]];
-			lru[id][i]=new int[assoc[id]];
-			for(int j=0; j<assoc[id];j++)
-			{
-				tags[id][i][j]=-1;
-				valid[id][i][j]=false;
-				lru[id][i][j]=j;
-			}
-		}
-
-	}
-
-
+	page_table = nullptr;
 
 }
 
@@ -184,7 +139,7 @@ void PageTableWalker::handleEvent( SST::Event* e )
 
 
 
-	//// ******** Important, for each level, we will update MAPPED_PAGE_SIZE** and PGD/PMD/PUD/PTE so the actual physical address is used later
+	//// ******** Important, for each level, we will fill the page table entry and mark the page mapped so the actual physical address is used later
 	SambaEvent * temp_ptr =  dynamic_cast<SambaComponent::SambaEvent*> (e);
 
 	if(temp_ptr==nullptr)
@@ -194,33 +149,21 @@ void PageTableWalker::handleEvent( SST::Event* e )
 	{
 
 		// Send request to page fault handler starting from the first unmapped level (L4/CR3 if first fault in system)
-
-		if(!ptw_confined)
-		{
-			//if((*CR3) == -1)
-			if(!(*cr3_init))
-				fault_level = 4;
-			else if((*PGD).find(temp_ptr->getAddress()/page_size[3]) == (*PGD).end())
-				fault_level = 3;
-			else if((*PUD).find(temp_ptr->getAddress()/page_size[2]) == (*PUD).end())
-				fault_level = 2;
-			else if((*PMD).find(temp_ptr->getAddress()/page_size[1]) == (*PMD).end())
-				fault_level = 1;
-			else if((*PTE).find(temp_ptr->getAddress()/page_size[0]) == (*PTE).end())
-				fault_level = 0;
-			else
-				output->fatal(CALL_INFO, -1, "MMU: DANGER!!\n");
-		}
+		Address_t fault_addr = pt_addr(temp_ptr->getAddress());
+
+		//if((*CR3) == -1)
+		if(!(*cr3_init))
+			fault_level = 4;
+		else if(!page_table->present(3, fault_addr))
+			fault_level = 3;
+		else if(!page_table->present(2, fault_addr))
+			fault_level = 2;
+		else if(!page_table->present(1, fault_addr))
+			fault_level = 1;
+		else if(!page_table->present(0, fault_addr))
+			fault_level = 0;
 		else
-		{
-			uint64_t offset = (uint64_t)512*512*512*512;
-			if(!(*cr3_init)) fault_level = 4;
-			else if((*PGD).find((temp_ptr->getAddress()/page_size[3])%512) == (*PGD).end()) fault_level = 3;
-			else if((*PUD).find((temp_ptr->getAddress()/page_size[2])%(512*512)) == (*PUD).end()) fault_level = 2;
-			else if((*PMD).find((temp_ptr->getAddress()/page_size[1])%(512*512*512)) == (*PMD).end()) fault_level = 1;
-			else if((*PTE).find((temp_ptr->getAddress()/page_size[0])%offset) == (*PTE).end()) fault_level = 0;
-	 		else output->fatal(CALL_INFO, -1, "MMU: DANGER!!\n");
-		}
+			output->fatal(CALL_INFO, -1, "MMU: DANGER!!\n");
 
 		if(!(*cr3_init)) {
 			*cr3_init = 1;
@@ -238,6 +181,9 @@ void PageTableWalker::handleEvent( SST::Event* e )
 		// Update the page tables to reflect new page table entries/tables, then issue a new page fault handler request to build next level
 
 		// For now, just assume only the page will be mappe and requested from page fault handler
+		static const char * level_names[] = { "PTE", "PMD", "PUD", "PGD" };
+		Address_t addr = pt_addr(stall_addr);
+
 		if(fault_level == 4)
 		{
 			// We are building the first page in the page table!
@@ -247,101 +193,35 @@ void PageTableWalker::handleEvent( SST::Event* e )
 			fault_level--;
 			pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
 		}
-		else if(fault_level == 3)
-		{
-			if(!ptw_confined)
-				(*PGD)[stall_addr/page_size[3]] = temp_ptr->getPaddress();
-			else
-			{
-				if((*PGD).find((stall_addr/page_size[3])%512) != (*PGD).end())
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PGD!!\n");
-				(*PGD)[(stall_addr/page_size[3])%512] = temp_ptr->getPaddress();
-				(*PENDING_PAGE_FAULTS_PGD).erase((stall_addr/page_size[3])%(512));
-			}
-			fault_level--;
-			pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
-
-		}
-		else if(fault_level == 2)
+		else
 		{
-			if(!ptw_confined)
-				(*PUD)[stall_addr/page_size[2]] = temp_ptr->getPaddress();
-			else
-			{
-				if((*PUD).find((stall_addr/page_size[2])%(512*512)) != (*PUD).end())
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PUD!!\n");
-				(*PUD)[(stall_addr/page_size[2])%(512*512)] = temp_ptr->getPaddress();
-				(*PENDING_PAGE_FAULTS_PUD).erase((stall_addr/page_size[2])%(512*512));
-			}
-			//if(temp_ptr->getSize() == page_size[2]) {
-			//	(*MAPPED_PAGE_SIZE1GB)[temp_ptr->getAddress()/page_size[2]] = 0;
-			//	fault_level = 0;
-			//	stall = false;
-			//	*hold = 0;
-
-			//} else {
-				fault_level--;
-				pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
+			if(ptw_confined && page_table->present(fault_level, addr))
+				output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same %s!!\n", level_names[fault_level]);
 
-			//}
+			page_table->map(fault_level, addr, temp_ptr->getPaddress());
 
-		}
-
-		else if(fault_level == 1)
-		{
-			if(!ptw_confined)
-				(*PMD)[stall_addr/page_size[1]] = temp_ptr->getPaddress();
-			else
+			if(fault_level > 0)
 			{
-				uint64_t offset = 512*512*512;
-				if((*PMD).find((stall_addr/page_size[1])%offset) != (*PMD).end())
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PMD!!\n");
-				(*PMD)[(stall_addr/page_size[1])%offset] = temp_ptr->getPaddress();
-				(*PENDING_PAGE_FAULTS_PMD).erase((stall_addr/page_size[1])%offset);
-			}
-			//if(temp_ptr->getSize() == page_size[1]) {
-			//	(*MAPPED_PAGE_SIZE2MB)[temp_ptr->getAddress()/page_size[1]] = 0;
-			//	fault_level = 0;
-			//	stall = false;
-			//	*hold = 0;
+				if(ptw_confined)
+					page_table->clearPending(fault_level, addr);
 
-			//} else {
+				// Large pages are not handed out yet; otherwise this is where a 2MB/1GB mapping would end the fault
 				fault_level--;
 				pageFaultHandler->allocatePage(coreId,fault_level,stall_addr/page_size[fault_level],4096);
-
-			//}
-
-		}
-		else if(fault_level == 0)
-		{
-			if(!ptw_confined)
-				(*PTE)[stall_addr/page_size[0]] = temp_ptr->getPaddress();
+			}
 			else
 			{
-				uint64_t offset = (uint64_t)512*512*512*512;
-				if((*PTE).find((stall_addr/page_size[0])%offset) != (*PTE).end())
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER.. same PTE!!\n");
-				(*PTE)[(stall_addr/page_size[0])%offset] = temp_ptr->getPaddress();
+				SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT_SERVED);
+				s_EventChan->send(tse);
 			}
-			SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT_SERVED);
-			s_EventChan->send(tse);
 		}
 
 
 	}
 	else if(temp_ptr->getType() == EventType::PAGE_FAULT_SERVED)
 	{
-		if(!ptw_confined)
-		{
-			(*MAPPED_PAGE_SIZE4KB)[stall_addr/page_size[0]] = 0;
-			(*PENDING_PAGE_FAULTS).erase(stall_addr/page_size[0]);
-		}
-		else
-		{
-			uint64_t offset = (uint64_t)512*512*512*512;
-			(*MAPPED_PAGE_SIZE4KB)[(stall_addr/page_size[0])%offset] = 0;
-			(*PENDING_PAGE_FAULTS_PTE).erase((stall_addr/page_size[0])%offset);
-		}
+		page_table->setMapped(0, pt_addr(stall_addr));
+		page_table->clearPending(0, pt_addr(stall_addr));
 	}
 	delete temp_ptr;
 
@@ -369,35 +249,51 @@ bool PageTableWalker::recvPageFaultResp(PageFaultHandler::PageFaultHandlerPacket
 	return true;
 }
 
+// Physical address of the page table entry covering vaddr in the table at the given level (4 = CR3/PGD table, 1 = PTE table)
+Address_t PageTableWalker::entry_address(Address_t vaddr, int level)
+{
+	if(level < 1 || level > 4)
+		output->fatal(CALL_INFO, -1, "MMU: PTW DANGER!!\n");
+
+	Address_t table = (level == 4) ? (*CR3) : page_table->frame(level, pt_addr(vaddr));
+
+	return table + ((vaddr/page_size[level-1])%512)*8;
+}
+
+
 void PageTableWalker::recvResp(SST::Event * event)
 {
 
 
 	MemEvent * ev = static_cast<MemEvent*>(event);
 
-
-	long long int pw_id;
+	std::map<id_type, TranslationRequest*>::iterator walk;
 	if(!self_connected)
-		pw_id = MEM_REQ[ev->getResponseToID()];
+		walk = MEM_REQ.find(ev->getResponseToID());
 	else
-		pw_id = MEM_REQ[ev->getID()];
+		walk = MEM_REQ.find(ev->getID());
+
+	if(walk == MEM_REQ.end())
+		output->fatal(CALL_INFO, -1, "MMU: PTW received a response to an unknown page walk request\n");
 
-    //WID_Add[] is virtual address, WSR_PT_LEVEL[] is level of page table
-	insert_way(WID_Add[pw_id], find_victim_way(WID_Add[pw_id], WSR_PT_LEVEL[pw_id]), WSR_PT_LEVEL[pw_id]);
+	TranslationRequest * req = walk->second;
+	MEM_REQ.erase(walk);
 
-	Address_t addr = WID_Add[pw_id];
+	// req->vaddr is the virtual address, req->walk_level is the level of page table
+	Address_t addr = req->vaddr;
 
-	WSR_READY[pw_id]=true;
+	insert_way(addr, find_victim_way(addr, req->walk_level), req->walk_level);
 
 	// Avoiding memory leak by deleting the newly generated dummy requests
-	MEM_REQ.erase(ev->getID());
 	delete ev;
 
-	if(WSR_PT_LEVEL[pw_id]==0)
+	if(req->walk_level==0)
 	{
-		ready_by[WID_EV[pw_id]] =  currTime + latency + 2*upper_link_latency;
+		req->ready_by = currTime + latency + 2*upper_link_latency;
 
-		ready_by_size[WID_EV[pw_id]] = os_page_size; // FIXME: This hardcoded for now assuming the OS maps virtual pages to 4KB pages only
+		req->page_size = os_page_size; // FIXME: This hardcoded for now assuming the OS maps virtual pages to 4KB pages only
+
+		ready_by.push_back(req);
 	}
 	else
 	{
@@ -410,42 +306,19 @@ void PageTableWalker::recvResp(SST::Event * event)
 		{
 			if(!ptw_confined)
 			{
-				Address_t page_table_start = 0;
-				if(WSR_PT_LEVEL[pw_id]==4)
-					page_table_start = (*PGD)[addr/page_size[3]];
-				else if(WSR_PT_LEVEL[pw_id]==3)
-					page_table_start = (*PUD) [addr/page_size[2]];
-				else if(WSR_PT_LEVEL[pw_id]==2)
-					page_table_start = (*PMD) [addr/page_size[1]];
-				else if (WSR_PT_LEVEL[pw_id] == 1)
-					page_table_start = (*PTE) [addr/page_size[0]];
-
-				dummy_add = page_table_start + (addr/page_size[WSR_PT_LEVEL[pw_id]-1])%512;
+				Address_t page_table_start = page_table->frame(req->walk_level-1, addr);
+
+				dummy_add = page_table_start + (addr/page_size[req->walk_level-1])%512;
 			}
 			else
-			{
-				if(WSR_PT_LEVEL[pw_id]==4) {
-					dummy_add = (*CR3) + ((addr/page_size[3])%512)*8;
-				}
-				else if(WSR_PT_LEVEL[pw_id]==3) {
-					dummy_add = (*PGD)[(addr/page_size[3])%512] + ((addr/page_size[2])%512)*8;
-				}
-				else if(WSR_PT_LEVEL[pw_id]==2) {
-					dummy_add = (*PUD)[(addr/page_size[2])%(512*512)] + ((addr/page_size[1])%512)*8;}
-				else if(WSR_PT_LEVEL[pw_id]==1) {
-					uint64_t offset = (uint64_t)512*512*512;
-					dummy_add = (*PMD)[(addr/page_size[1])%offset] + ((addr/page_size[0])%512)*8;
-				}
-				else
-					output->fatal(CALL_INFO, -1, "MMU: PTW DANGER!!\n");
-			}
+				dummy_add = entry_address(addr, req->walk_level);
 		}
 		Address_t dummy_base_add = dummy_add & ~(line_size - 1);
 		MemEvent *e = new MemEvent(getName(), dummy_add, dummy_base_add, Command::GetS);
 		e->setVirtualAddress(addr);
 
-		WSR_PT_LEVEL[pw_id]--;
-		MEM_REQ[e->getID()]=pw_id;
+		req->walk_level--;
+		MEM_REQ[e->getID()]=req;
 		to_mem->send(e);
 
 
@@ -468,53 +341,33 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 		if(!ptw_confined)
 		{
 			//std::cout<< getName().c_str() << " Core: " << coreId << " stalled with stall address: " << stall_addr << std::endl;
-			if((*PENDING_PAGE_FAULTS).find(stall_addr/page_size[0])==(*PENDING_PAGE_FAULTS).end()) {
+			if(!page_table->pending(0, stall_addr)) {
 				stall = false;
 				*hold = 0;
 			}
 		}
 		else
 		{
-			uint64_t offset = (uint64_t)512*512*512*512;
+			Address_t addr = pt_addr(stall_addr);
 			int release = 0;
 			switch(stall_at_levels) {
 			case 4:
-			{
-				if((*PENDING_PAGE_FAULTS_PGD).find((stall_addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end() &&
-					(*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end() &&
-					(*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-					(*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
-				{
-					release = 1;
-				}
-
-			}
-				break;
 			case 3:
-			{
-				if((*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end() &&
-					(*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-					(*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
-				{
-					release = 1;
-				}
-			}
-				break;
 			case 2:
 			{
-				if((*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end() &&
-					(*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end())
-				{
-					release = 1;
-				}
+				// All levels below the first missing one must have been filled
+				release = 1;
+				for(int l = 0; l < stall_at_levels; l++)
+					if(page_table->pending(l, addr))
+						release = 0;
 			}
 				break;
 			case 1:
 			{
-				if(stall_at_PGD) {if((*PENDING_PAGE_FAULTS_PGD).find((stall_addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end()) release = 1;}
-				else if(stall_at_PUD) {if((*PENDING_PAGE_FAULTS_PUD).find((stall_addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end()) release = 1;}
-				else if(stall_at_PMD) {if((*PENDING_PAGE_FAULTS_PMD).find((stall_addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end()) release = 1;}
-				else if(stall_at_PTE) {if((*PENDING_PAGE_FAULTS_PTE).find((stall_addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) release = 1;}
+				if(stall_at_PGD) {if(!page_table->pending(3, addr)) release = 1;}
+				else if(stall_at_PUD) {if(!page_table->pending(2, addr)) release = 1;}
+				else if(stall_at_PMD) {if(!page_table->pending(1, addr)) release = 1;}
+				else if(stall_at_PTE) {if(!page_table->pending(0, addr)) release = 1;}
 				else output->fatal(CALL_INFO, -1, "MMU: PTW DANGER!!.. stall at level not recognized..\n");
 			}
 				break;
@@ -533,9 +386,8 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 
 
 	// The actual dipatching process... here we take a request and place it in the right queue based on being miss or hit and the number of pending misses
-	std::vector<MemHierarchy::MemEventBase *>::iterator st_1,en_1;
+	std::vector<TranslationRequest *>::iterator st_1;
 	st_1 = not_serviced.begin();
-	en_1 = not_serviced.end();
 
 	int dispatched=0;
 	for(;st_1!=not_serviced.end() && !(*shootdown) && !(*hold); st_1++)
@@ -546,142 +398,61 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 		if(dispatched > max_width)
 			break;
 
-                MemHierarchy::MemEventBase* ev = *st_1;
-		Address_t addr = ((MemEvent*) ev)->getVirtualAddress();
+		TranslationRequest * req = *st_1;
+		Address_t addr = req->vaddr;
 
 		// A sneak-peak if the access is going to cause a page fault
-		if(emulate_faults==1)
+		if(emulate_faults==1 && !page_table->mapped(pt_addr(addr)))
 		{
 
-			bool fault = true;
 			if(!ptw_confined)
 			{
-				if((*MAPPED_PAGE_SIZE4KB).find(addr/page_size[0])!=(*MAPPED_PAGE_SIZE4KB).end() || (*MAPPED_PAGE_SIZE2MB).find(addr/page_size[1])!=(*MAPPED_PAGE_SIZE2MB).end() || (*MAPPED_PAGE_SIZE1GB).find(addr/page_size[2])!=(*MAPPED_PAGE_SIZE1GB).end())
-					fault = false;
+				stall_addr = addr;
+				if(!page_table->pending(0, addr)) {
+					page_table->setPending(0, addr);
+					SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
+					//std::cout<< getName().c_str() << " Core id: " << coreId << " Fault at address "<<addr<<std::endl;
+					tse->setResp(addr,0,4096);
+					s_EventChan->send(10, tse);
 
-				if(fault)
-				{
-					stall_addr = addr;
-					if((*PENDING_PAGE_FAULTS).find(addr/page_size[0])==(*PENDING_PAGE_FAULTS).end()) {
-						(*PENDING_PAGE_FAULTS)[addr/page_size[0]] = 0;
-						SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
-						//std::cout<< getName().c_str() << " Core id: " << coreId << " Fault at address "<<addr<<std::endl;
-						tse->setResp(addr,0,4096);
-						s_EventChan->send(10, tse);
-
-					}
-
-					stall = true;
-					*hold = 1;
-	//				(*MAPPED_PAGE_SIZE4KB)[addr/page_size[0]] = 0; // FIXME: Hack to avoid propogating faulting VA through all events, only for initial testing
-					return false;
 				}
+
+				stall = true;
+				*hold = 1;
+				return false;
 			}
 			else
 			{
-				uint64_t offset = (uint64_t)512*512*512*512;
-				if((*MAPPED_PAGE_SIZE4KB).find((addr/page_size[0])%offset)!=(*MAPPED_PAGE_SIZE4KB).end() || (*MAPPED_PAGE_SIZE2MB).find((addr/page_size[1])%(512*512*512))!=(*MAPPED_PAGE_SIZE2MB).end() || (*MAPPED_PAGE_SIZE1GB).find((addr/page_size[2])%(512*512))!=(*MAPPED_PAGE_SIZE1GB).end())
- 					fault = false;
-
-	 			if(fault)
-	 			{
-					stall_addr = addr;
-					if(to_mem!=NULL) {
-					if((*PGD).find((addr/page_size[3])%512) == (*PGD).end()) {
-						stall_at_levels = 1;
-						stall_at_PGD = 1;
-						stall_at_PUD = 0;
-						stall_at_PMD = 0;
-						stall_at_PTE = 0;
-						if((*PENDING_PAGE_FAULTS_PGD).find((addr/page_size[3])%(512))==(*PENDING_PAGE_FAULTS_PGD).end()) {
-							(*PENDING_PAGE_FAULTS_PGD)[(addr/page_size[3])%512] = 0;
-							(*PENDING_PAGE_FAULTS_PUD)[(addr/page_size[2])%(512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
-							stall_at_levels += 3;
-							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
-							tse->setResp(addr,0,4096);
-							s_EventChan->send(tse);
-						}
-						else {
-							return false;
-						}
-					}
-					else if((*PUD).find((addr/page_size[2])%(512*512)) == (*PUD).end()) {
-						stall_at_levels = 1;
-						stall_at_PGD = 0;
-						stall_at_PUD = 1;
-						stall_at_PMD = 0;
-						stall_at_PTE = 0;
-						if((*PENDING_PAGE_FAULTS_PUD).find((addr/page_size[2])%(512*512))==(*PENDING_PAGE_FAULTS_PUD).end()) {
-							(*PENDING_PAGE_FAULTS_PUD)[(addr/page_size[2])%(512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
-							stall_at_levels += 2;
-							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
-							tse->setResp(addr,0,4096);
-							s_EventChan->send(tse);
-						}
-						else {
-							return false;
-						}
-					}
-					else if((*PMD).find((addr/page_size[1])%(512*512*512)) == (*PMD).end()) {
-						stall_at_levels = 1;
-						stall_at_PGD = 0;
-						stall_at_PUD = 0;
-						stall_at_PMD = 1;
-						stall_at_PTE = 0;
-						if((*PENDING_PAGE_FAULTS_PMD).find((addr/page_size[1])%(512*512*512))==(*PENDING_PAGE_FAULTS_PMD).end()) {
-							(*PENDING_PAGE_FAULTS_PMD)[(addr/page_size[1])%(512*512*512)] = 0;
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
-							stall_at_levels += 1;
-							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
-							tse->setResp(addr,0,4096);
-							s_EventChan->send(tse);
-						}
-						else {
-							return false;
-						}
-					}
-					else if((*PTE).find((addr/page_size[0])%(offset)) == (*PTE).end()) {
-						stall_at_levels = 1;
-						stall_at_PGD = 0;
-						stall_at_PUD = 0;
-						stall_at_PMD = 0;
-						stall_at_PTE = 1;
-						if((*PENDING_PAGE_FAULTS_PTE).find((addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) {
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
-							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
-							tse->setResp(addr,0,4096);
-							s_EventChan->send(tse);
-						}
-						else {
-							return false;
-						}
-					}
-					else {
+				Address_t pt_key = pt_addr(addr);
+				stall_addr = addr;
+
+				// The fault starts at the first page table level without an entry for this address,
+				// without a memory link only the PTE is built
+				int fault_at = 0;
+				if(to_mem!=NULL) {
+					for(fault_at = 3; fault_at >= 0 && page_table->present(fault_at, pt_key); fault_at--);
+					if(fault_at < 0)
 						return false;
-					}
-					}
-					else {
-						stall_at_levels = 1;
-						stall_at_PGD = 0;
-						stall_at_PUD = 0;
-						stall_at_PMD = 0;
-						stall_at_PTE = 1;
-						if((*PENDING_PAGE_FAULTS_PTE).find((addr/page_size[0])%(offset))==(*PENDING_PAGE_FAULTS_PTE).end()) {
-							(*PENDING_PAGE_FAULTS_PTE)[(addr/page_size[0])%(offset)] = 0;
-							SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
-							tse->setResp(addr,0,4096);
-							s_EventChan->send(tse);
-						}
-						else {
-							return false;
-						}
-					}
-	 				return false;
-	 			}
+				}
+
+				stall_at_levels = 1;
+				stall_at_PGD = (fault_at == 3);
+				stall_at_PUD = (fault_at == 2);
+				stall_at_PMD = (fault_at == 1);
+				stall_at_PTE = (fault_at == 0);
+
+				// Another walker is already building these tables
+				if(page_table->pending(fault_at, pt_key))
+					return false;
+
+				for(int l = fault_at; l >= 0; l--)
+					page_table->setPending(l, pt_key);
+				stall_at_levels += fault_at;
+				SambaEvent * tse = new SambaEvent(EventType::PAGE_FAULT);
+				tse->setResp(addr,0,4096);
+				s_EventChan->send(tse);
+
+	 			return false;
 			}
 
 		}
@@ -707,12 +478,13 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 			hits++;
 			statPageTableWalkerHits->addData(1);
 			if(parallel_mode)
-				ready_by[ev] = x;
+				req->ready_by = x;
 			else
-				ready_by[ev] = x + latency;
+				req->ready_by = x + latency;
 
 			// Tracking the hit request size
-			ready_by_size[ev] = os_page_size; //page_size[hit_id]/1024;
+			req->page_size = os_page_size; //page_size[hit_id]/1024;
+			ready_by.push_back(req);
 
 			st_1 = not_serviced.erase(st_1);
 		}
@@ -728,16 +500,15 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 				k = max(k-2, 1);
 
 
-			if((int) pending_misses.size() < (int) max_outstanding)
+			if(pending_misses < max_outstanding)
 			{
 				statPageTableWalkerMisses->addData(1);
 				misses++;
-				pending_misses.push_back(*st_1);
+				req->pending_at |= 1;
+				pending_misses++;
 				if(to_mem!=nullptr)
 				{
 
-					WID_EV[++mmu_id] = (*st_1);
-
 					Address_t dummy_add = rand()%10000000;
 
 					// Use actual page table base to start the walking if we have real page tables
@@ -746,37 +517,18 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 						if(!ptw_confined)
 							dummy_add = (*CR3) + (addr/page_size[2])%512;
 						else
-						{
-							if(k==4) {
-								dummy_add = (*CR3) + ((addr/page_size[3])%512)*8;
-							}
-							else if(k==3) {
-								dummy_add = (*PGD)[(addr/page_size[3])%512] + ((addr/page_size[2])%512)*8;
-							}
-							else if(k==2) {
-								dummy_add = (*PUD)[(addr/page_size[2])%(512*512)] + ((addr/page_size[1])%512)*8;
-							}
-							else if (k==1) {
-								uint64_t offset = (uint64_t)512*512*512;
-								dummy_add = (*PMD)[(addr/page_size[1])%offset] + ((addr/page_size[0])%512)*8;
-							}
-							else
-								output->fatal(CALL_INFO, -1, "MMU: PTW DANGER!!\n");
-						}
+							dummy_add = entry_address(addr, k);
 					}
 
 					Address_t dummy_base_add = dummy_add & ~(line_size - 1);
 					MemEvent *e = new MemEvent(getName(), dummy_add, dummy_base_add, Command::GetS);
 
-                    // Record this walk request into WSR_ and WID_ structs
-					WSR_PT_LEVEL[mmu_id] = k-1;
-					//		WID_EV[mmu_id] = e;
-					WID_Add[mmu_id] = addr;
+					// Record the level this walk access refers to
+					req->walk_level = k-1;
 					e->setVirtualAddress(addr);
-					WSR_READY[mmu_id] = false;
 
 					// Add it to the tracking structure
-					MEM_REQ[e->getID()]=mmu_id;
+					MEM_REQ[e->getID()]=req;
 
 					//					std::cout<<"Sending a new request with address "<<std::hex<<dummy_add<<std::endl;
 					// Actually send the event to the cache
@@ -792,9 +544,11 @@ bool PageTableWalker::tick(SST::Cycle_t x)
                     // JVOROBY: We don't actually have a memory link, so instead just wait for an appropriate latency
 
 
-					ready_by[ev] = x + latency + 2*upper_link_latency + page_walk_latency;  // the upper link latency is substituted for sending the miss request and reciving it, Note this is hard coded for the last-level as memory access walk latency, this ****definitely**** needs to change
+					req->ready_by = x + latency + 2*upper_link_latency + page_walk_latency;  // the upper link latency is substituted for sending the miss request and reciving it, Note this is hard coded for the last-level as memory access walk latency, this ****definitely**** needs to change
 
-					ready_by_size[ev] = os_page_size; // FIXME: This hardcoded for now assuming the OS maps virtual pages to 4KB pages only
+					req->page_size = os_page_size; // FIXME: This hardcoded for now assuming the OS maps virtual pages to 4KB pages only
+
+					ready_by.push_back(req);
 
 					st_1 = not_serviced.erase(st_1);
 				}
@@ -809,88 +563,39 @@ bool PageTableWalker::tick(SST::Cycle_t x)
 	}
 
 
-	std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare>::iterator st, en;
-	st = ready_by.begin();
-	en = ready_by.end();
+	// Pass back every request that has finished by this cycle, in event id order
+	completed.clear();
+	TranslationRequest::collectReady(ready_by, completed, x);
 
-	while(st!=en)
+	for(TranslationRequest * req : completed)
 	{
 
-		bool deleted=false;
-		if(st->second <= x) // if this event is ready
-		{
-
-			Address_t addr = ((MemEvent*) st->first)->getVirtualAddress();
-
-			// Double checking that we actually still don't have it inserted
-			//std::cout<<"The address is"<<addr<<std::endl;
-			if(!check_hit(addr, 0))
-			{
-				insert_way(addr, find_victim_way(addr, 0), 0);
-				update_lru(addr, 0);
-			}
-			else
-				update_lru(addr, 0);
-
-
-			service_back->push_back(st->first);
-
-
-			if(emulate_faults)
-			{
-				if(!ptw_confined)
-				{
-					if((*PTE).find(addr/4096)==(*PTE).end())
-                	{
-						std::cout << "******* Major issue is in Page Table Walker **** " << std::endl;
-						std::cout << "The address is "<< hex << addr << " (" << addr / 4096 << ")" << std::endl;
-                    }
-                }
-                else
-                {
-                	uint64_t offset = (uint64_t)512*512*512*512;
-					if((*PTE).find((addr/4096)%offset)==(*PTE).end())
-                    {
- 						std::cout << "******* Major issue is in Page Table Walker **** " << std::endl;
- 						std::cout << "The address is "<< hex << addr << " (" << addr / 4096 << ")" << std::endl;
-					}
-                }
-            }
-
-			(*service_back_size)[st->first]=ready_by_size[st->first];
-
-
-			ready_by_size.erase(st->first);
-
+		Address_t addr = req->vaddr;
 
+		// Double checking that we actually still don't have it inserted
+		//std::cout<<"The address is"<<addr<<std::endl;
+		if(!check_hit(addr, 0))
+			insert_way(addr, find_victim_way(addr, 0), 0);
 
+		update_lru(addr, 0);
 
-			deleted = true;
 
+		service_back->push_back(req);
 
-			// Deleting it from pending requests
-			std::vector<MemHierarchy::MemEventBase *>::iterator st2, en2;
-			st2 = pending_misses.begin();
-			en2 = pending_misses.end();
 
+		if(emulate_faults && !page_table->present(0, pt_addr(addr)))
+		{
+			std::cout << "******* Major issue is in Page Table Walker **** " << std::endl;
+			std::cout << "The address is "<< hex << addr << " (" << addr / 4096 << ")" << std::endl;
+		}
 
-			while(st2!=en2)
-			{
-				if(*st2 == st->first)
-				{
-					pending_misses.erase(st2);
-					break;
-				}
-				st2++;
-			}
-
-			ready_by.erase(st);
 
+		// Deleting it from pending requests
+		if(req->pending_at & 1)
+		{
+			req->pending_at &= ~1u;
+			pending_misses--;
 		}
-		if(deleted)
-			st=ready_by.begin();
-		else
-			st++;
 
 	}
 
@@ -926,11 +631,7 @@ void PageTableWalker::initaitePageMigration(Address_t vaddress, Address_t paddre
 
 void PageTableWalker::insert_way(Address_t vaddr, int way, int struct_id)
 {
-
-	int set=abs_int_Samba((vaddr/page_size[struct_id])%sets[struct_id]);
-	tags[struct_id][set][way]=vaddr/page_size[struct_id];
-	valid[struct_id][set][way]=true;
-
+	ptwc[struct_id].insert_way(vaddr, way);
 }
 
 
@@ -947,15 +648,7 @@ void PageTableWalker::invalidate(Address_t vadd, int id)
 {
 
 	for(int id=0; id<sizes; id++)
-	{
-		int set= abs_int_Samba((vadd*page_size[0]/page_size[id])%sets[id]);
-		for(int i=0; i<assoc[id]; i++) {
-			if(tags[id][set][i]==vadd*page_size[0]/page_size[id] && valid[id][set][i]) {
-				valid[id][set][i] = false;
-				break;
-			}
-		}
-	}
+		ptwc[id].invalidate(vadd*page_size[0]/page_size[id]);
 
 }
 
@@ -971,53 +664,17 @@ void PageTableWalker::sendShootdownAck(int sd_delay, int page_swapping_delay)
 // Find if it exists
 bool PageTableWalker::check_hit(Address_t vadd, int struct_id)
 {
-
-
-	int set= abs_int_Samba((vadd/page_size[struct_id])%sets[struct_id]);
-
-	for(int i=0; i<assoc[struct_id];i++)
-		if(tags[struct_id][set][i]==vadd/page_size[struct_id])
-			return valid[struct_id][set][i];
-
-	return false;
+	return ptwc[struct_id].check_hit(vadd);
 }
 
 // To insert the translaiton
 int PageTableWalker::find_victim_way(Address_t vadd, int struct_id)
 {
-
-	int set= abs_int_Samba((vadd/page_size[struct_id])%sets[struct_id]);
-
-	for(int i=0; i<assoc[struct_id]; i++)
-		if(lru[struct_id][set][i]==(assoc[struct_id]-1))
-			return i;
-
-
-	return 0;
+	return ptwc[struct_id].find_victim_way(vadd);
 }
 
 // This function updates the LRU policy for a given address
 void PageTableWalker::update_lru(Address_t vaddr, int struct_id)
 {
-
-	int lru_place=assoc[struct_id]-1;
-
-	int set= abs_int_Samba((vaddr/page_size[struct_id])%sets[struct_id]);
-	for(int i=0; i<assoc[struct_id];i++)
-		if(tags[struct_id][set][i]==vaddr/page_size[struct_id])
-		{
-			lru_place = lru[struct_id][set][i];
-			break;
-		}
-	for(int i=0; i<assoc[struct_id];i++)
-	{
-		if(lru[struct_id][set][i]==lru_place)
-			lru[struct_id][set][i]=0;
-		else if(lru[struct_id][set][i]<lru_place)
-			lru[struct_id][set][i]++;
-	}
-
-
+	ptwc[struct_id].update_lru(vaddr);
 }
-
-
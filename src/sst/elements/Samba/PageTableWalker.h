@@ -31,11 +31,13 @@
 
 #include "utils.h"
 #include "PageFaultHandler.h"
+#include "PageTable.h"
+#include "TLBArray.h"
+#include "TranslationRequest.h"
 
 // This file defines the page table walker and
 
 typedef std::pair<uint64_t, int> id_type;
-typedef uint64_t Address_t;
 enum PageMigrationType { NONE, FTP};
 // FTP: First touch policy
 
@@ -77,15 +79,9 @@ namespace SST { namespace SambaComponent{
 		uint64_t * page_size; // By default, lets assume 4KB pages
         
 
-        //=== Page table walk cache parameters, for each level of PTWC:
-		int* size;  // Number of entries in i-th level PTWC (param)
-		int* assoc; // associativity of i-th PTWC (param)
-		int* sets;  // number of sets in i-th PTWC (calculated)
-
-        // === PTWC data: arranged like so: [PTWC_level][set][ent_in_set]
-		Address_t *** tags; 
-		bool *** valid; 
-		int *** lru; // lru positions
+        // === PTWC data: one set-associative structure for each level of PTWC, sized by
+        //     the size<i>_PTWC and assoc<i>_PTWC params
+		std::vector<TLBArray> ptwc;
 
 
         // == Stats
@@ -126,25 +122,15 @@ namespace SST { namespace SambaComponent{
 		Address_t *CR3;
 		int *cr3_init;
 
-		// Holds the PGD, PUD, PMT, PTE physical pointers
-		std::map<Address_t, Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
-		std::map<Address_t, Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
-		std::map<Address_t, Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
-		std::map<Address_t, Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)         
-                                              // PTE should give you the exact physical address of the page
-
+		// Holds the PGD, PUD, PMD and PTE entries, which tables are mapped, and which have page faults pending.
+		// In ptw_confined mode the page table is indexed by the low 48 bits of the virtual address only.
+		PageTable * page_table;
 
-		// The structures below are used to quickly check if the page is mapped or not
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
+		// Virtual address as used to index the page table
+		Address_t pt_addr(Address_t vaddr) const { return ptw_confined ? PageTable::confine(vaddr) : vaddr; }
 
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
-//		std::map<Address_t,int> *PENDING_SHOOTDOWN_EVENTS;
+		// Physical address of the entry for vaddr in the page table at the given level, used in ptw_confined mode
+		Address_t entry_address(Address_t vaddr, int level);
 
 
 
@@ -200,25 +186,19 @@ namespace SST { namespace SambaComponent{
 
 
         // === Holds incoming requests, "input queue"
-        std::vector<MemHierarchy::MemEventBase *> not_serviced;
-
-		std::vector<MemHierarchy::MemEventBase *> * service_back; // This is used to pass ready requests back to the previous level
-		std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * service_back_size; // This is used to pass the size of the  requests back to the previous level
-
-
-        // === Holds requests that have gotten the data they need, but we need to wait the duration of the latency before returning
-        std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare> ready_by; 
-        std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> ready_by_size; // keeps track of requests' sizes inside this structure
+        std::vector<TranslationRequest *> not_serviced;
 
+		std::vector<TranslationRequest *> * service_back; // This is used to pass ready requests back to the previous level
 
 
-		std::vector<MemHierarchy::MemEventBase *> pending_misses; // This the number of pending misses, only erased when pushed back from next level
+        // === Holds requests that have gotten the data they need, but we need to wait until req->ready_by before returning
+        std::vector<TranslationRequest *> ready_by;
 
+		// Scratch buffer for requests completing on the current cycle
+		std::vector<TranslationRequest *> completed;
 
 
-        //==== JVOROBY: these appear to be unused? There's no lower-level TLB below the PTW, so noone to push-back to us
-		// std::vector<MemHierarchy::MemEventBase *> pushed_back; // This is what we got returned from other structures
-		// std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> pushed_back_size; // This is the sizes of the translations we got returned from other structures
+		int pending_misses; // This the number of pending misses, only decremented once the walk completes
 
 
 
@@ -233,24 +213,10 @@ namespace SST { namespace SambaComponent{
 		PageTableWalker(ComponentId_t id, int page_size, int assoc, PageTableWalker * next_level, int size);
 		PageTableWalker(ComponentId_t id, int tlb_id, PageTableWalker * Next_level,int level, SST::Params& params);
 
-		void setPageTablePointers( Address_t * cr3, std::map<Address_t, Address_t> * pgd,  std::map<Address_t, Address_t> * pud,  std::map<Address_t, Address_t> * pmd, std::map<Address_t, Address_t> * pte,
-				std::map<Address_t,int> * gb,  std::map<Address_t,int> * mb,  std::map<Address_t,int> * kb, std::map<Address_t,int> * pr, int *cr3I, std::map<Address_t,int> *pf_pgd,  std::map<Address_t,int> *pf_pud,
-				std::map<Address_t,int> *pf_pmd, std::map<Address_t,int> * pf_pte)
+		void setPageTablePointers( Address_t * cr3, PageTable * pt, int *cr3I)
 		{
 			CR3 = cr3;
-			PGD = pgd;
-			PUD = pud;
-			PMD = pmd;
-			PTE = pte;
-			MAPPED_PAGE_SIZE4KB = kb;
-			MAPPED_PAGE_SIZE2MB = mb;
-			MAPPED_PAGE_SIZE1GB = gb;
-			PENDING_PAGE_FAULTS = pr;
-			PENDING_PAGE_FAULTS_PGD = pf_pgd;
-			PENDING_PAGE_FAULTS_PUD = pf_pud;
-			PENDING_PAGE_FAULTS_PMD = pf_pmd;
-			PENDING_PAGE_FAULTS_PTE = pf_pte;
-
+			page_table = pt;
 			cr3_init = cr3I;
 		}
 
@@ -285,7 +251,7 @@ namespace SST { namespace SambaComponent{
         // ====== Wire-up methods
         // (for parent obj to set out pointers to their versions of the objects)
 
-		void setServiceBack( std::vector<MemHierarchy::MemEventBase *> * x) { service_back = x;}
+		void setServiceBack( std::vector<TranslationRequest *> * x) { service_back = x;}
 		void setHold(int * tmp) { hold = tmp; }
 		void setShootDownEvents(int * sd, int *iva, std::vector<std::pair<Address_t, int> > * x) 
                 { shootdown = sd; hasInvalidAddrs = iva; invalid_addrs = x;}
@@ -307,7 +273,6 @@ namespace SST { namespace SambaComponent{
 
 		bool recvPageFaultResp(PageFaultHandler::PageFaultHandlerPacket pkt);
 
-		void setServiceBackSize( std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * x) { service_back_size = x;}
 
 
         //==== JVOROBY: these appear to be unused? There's no lower-level TLB below the PTW, so noone to push-back to us
@@ -320,19 +285,10 @@ namespace SST { namespace SambaComponent{
         // which 
         //
 
-        //Autoincrementing ID, used to index events held in the `WSR_` and `WID_` maps
-		long long int mmu_id=0;
-
-        // For a given page-walk memory request:
-		std::map<long long int, int> WSR_PT_LEVEL; // what level of the PT does it refer to (0 = PTE, 3 = PGD)
-		std::map<long long int, bool> WSR_READY;
-
-		std::map<long long int, Address_t> WID_Add;
-		std::map<long long int, MemHierarchy::MemEventBase*> WID_EV;
-
-        // Each Walk request generates a MemEvent that is sent out;
-        // This maps `memevent->getID()` to the corresponding `mmu_id`  used in the WSR_ and WID_ objects
-		std::map<id_type, long long int> MEM_REQ;
+        // Each walk request generates a MemEvent that is sent out;
+        // This maps `memevent->getID()` to the translation being walked, whose walk_level field
+        // tells what level of the PT the access refers to (0 = PTE, 3 = PGD)
+		std::map<id_type, TranslationRequest*> MEM_REQ;
 
         //=== Etc
 
@@ -349,7 +305,7 @@ namespace SST { namespace SambaComponent{
 
 
 		// This one is to push a request to this structure
-		void push_request(MemHierarchy::MemEventBase * x) {not_serviced.push_back(x);}
+		void push_request(TranslationRequest * x) {not_serviced.push_back(x);}
 
 		bool tick(SST::Cycle_t x);
 
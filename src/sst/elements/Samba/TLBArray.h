@@ -0,0 +1,119 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#ifndef _H_SST_SAMBA_TLB_ARRAY
+#define _H_SST_SAMBA_TLB_ARRAY
+
+#include <stdint.h>
+#include <vector>
+
+namespace SST { namespace SambaComponent{
+
+	// One set-associative translation structure (a TLB for a single page size, or one level of the
+	// page table walk cache) with LRU replacement.
+	//
+	// Tags, valid bits and LRU positions are kept in flat arrays indexed by set*assoc + way, so the
+	// ways of a set are contiguous in memory. Tags are virtual page numbers, i.e., vaddr/page_size.
+	class TLBArray
+	{
+		uint64_t page_size; // in bytes
+		int sets;
+		int assoc;
+
+		std::vector<uint64_t> tags;
+		std::vector<uint8_t> valid;
+		std::vector<int> lru; // 0 is the most recently used way of the set
+
+		int set_of(uint64_t vpn) const { return (int) (vpn % sets); }
+
+		// Index of the first way in the set whose tag matches, -1 if none does
+		int find(uint64_t vpn) const
+		{
+			int base = set_of(vpn)*assoc;
+			for(int i = base; i < base + assoc; i++)
+				if(tags[i] == vpn)
+					return i;
+			return -1;
+		}
+
+		public:
+
+		TLBArray(uint64_t Page_size, int Size, int Assoc, bool initially_valid) :
+			page_size(Page_size), sets(Size/Assoc), assoc(Assoc),
+			tags(Size/Assoc*Assoc, (uint64_t) -1), valid(Size/Assoc*Assoc, initially_valid), lru(Size/Assoc*Assoc)
+		{
+			for(int i = 0; i < (int) lru.size(); i++)
+				lru[i] = i % assoc;
+		}
+
+		uint64_t getPageSize() const { return page_size; }
+
+		// Find if the translation exists
+		bool check_hit(uint64_t vaddr) const
+		{
+			int i = find(vaddr/page_size);
+			return i >= 0 && valid[i];
+		}
+
+		// The least recently used way of vaddr's set
+		int find_victim_way(uint64_t vaddr) const
+		{
+			int base = set_of(vaddr/page_size)*assoc;
+			for(int i = 0; i < assoc; i++)
+				if(lru[base + i] == assoc - 1)
+					return i;
+			return 0;
+		}
+
+		void insert_way(uint64_t vaddr, int way)
+		{
+			uint64_t vpn = vaddr/page_size;
+			int i = set_of(vpn)*assoc + way;
+			tags[i] = vpn;
+			valid[i] = true;
+		}
+
+		// Move vaddr's way to the MRU position, or age the whole set if vaddr is not present
+		void update_lru(uint64_t vaddr)
+		{
+			uint64_t vpn = vaddr/page_size;
+			int base = set_of(vpn)*assoc;
+			int hit = find(vpn);
+			int lru_place = hit < 0 ? assoc - 1 : lru[hit];
+
+			for(int i = base; i < base + assoc; i++)
+			{
+				if(lru[i] == lru_place)
+					lru[i] = 0;
+				else if(lru[i] < lru_place)
+					lru[i]++;
+			}
+		}
+
+		// Invalidate the entry holding vpn (a page number of this array's page size)
+		void invalidate(uint64_t vpn)
+		{
+			int base = set_of(vpn)*assoc;
+			for(int i = base; i < base + assoc; i++)
+			{
+				if(tags[i] == vpn && valid[i])
+				{
+					valid[i] = false;
+					break;
+				}
+			}
+		}
+	};
+
+}}
+
+#endif
@@ -23,18 +23,6 @@
 using namespace SST::MemHierarchy;
 using namespace SST;
 
-// Find the absoulute value
-int abs_int(int x)
-{
-
-	if(x<0)
-		return -1*x;
-	else
-		return x;
-
-}
-
-
 // Not needed for now, probably will be removed soon, if doesn't cause any compaitability issues
 TLB::TLB(ComponentId_t id, int Page_size, int Assoc, TLB * Next_level, int Size) : ComponentExtension(id)
 {
@@ -101,58 +89,23 @@ TLB::TLB(ComponentId_t id, int tlb_id, TLB * Next_level, int Level, SST::Params&
 
 
     // === Per page-size params =======================================
-    
-    
-    // params
-	size = new int[sizes];
-	assoc = new int[sizes];
-	page_size = new uint64_t[sizes];
-	sets = new int[sizes];
-
-    // data arrays `foo[page_sizes][set][way]`
-	tags  = new Address_t**[sizes];
-	valid = new bool**[sizes];
-	lru   = new int **[sizes];
-
-    //Loop over each supported page size, getting params
+
+	pending_misses = 0;
+
+    //Loop over each supported page size, getting params and building its tag array
 	for(int i=0; i < sizes; i++)
 	{
 
-		size[i] =  ((uint32_t) params.find<uint32_t>("size"+std::to_string(i+1) + "_L"+LEVEL, 1));
-		assoc[i] =  ((uint32_t) params.find<uint32_t>("assoc"+std::to_string(i+1) +  "_L"+LEVEL, 1));
-		page_size[i] = 1024 * ((uint64_t) params.find<uint64_t>("page_size"+ std::to_string(i+1) + "_L" + LEVEL, 4));
+		int size =  ((uint32_t) params.find<uint32_t>("size"+std::to_string(i+1) + "_L"+LEVEL, 1));
+		int assoc =  ((uint32_t) params.find<uint32_t>("assoc"+std::to_string(i+1) +  "_L"+LEVEL, 1));
+		uint64_t page_size = 1024 * ((uint64_t) params.find<uint64_t>("page_size"+ std::to_string(i+1) + "_L" + LEVEL, 4));
 
 
 		// Here we add the supported page size and the structure index
-		SIZE_LOOKUP[page_size[i]/1024]=i;
-
-		// We define the number of sets for that structure of page size number i
-		sets[i] = size[i]/assoc[i];
-
-	}
-
-
-    //Loop over each supported page size, initializing subarrays for tags/valid/lru
-	for(int id=0; id< sizes; id++)
-	{
-
-		tags[id]  = new Address_t*[sets[id]];
-		valid[id] = new bool*[sets[id]];
-		lru[id]   = new int*[sets[id]];
-
-		for(int i=0; i < sets[id]; i++)
-		{
-			tags[id][i]  = new Address_t[assoc[id]];
-			valid[id][i] = new bool[assoc[id]];
-			lru[id][i]   = new int[assoc[id]];
+		SIZE_LOOKUP[page_size/1024]=i;
 
-			for(int j=0; j<assoc[id];j++)
-			{
-				tags [id][i][j] = -1;
-				valid[id][i][j] = true;
-				lru  [id][i][j] = j;
-			}
-		}
+		// Entries start out valid with an invalid tag
+		arrays.emplace_back(page_size, size, assoc, true);
 
 	}
 
@@ -168,6 +121,15 @@ void TLB::setPTW(PageTableWalker * Next_level) {
     PTW=Next_level;
 }
 
+void TLB::clear_pending(TranslationRequest * req)
+{
+	if(req->pending_at & (1u << level))
+	{
+		req->pending_at &= ~(1u << level);
+		pending_misses--;
+	}
+}
+
 // This is the most important function, which works like the heart of the TLBUnit, 
 // called on every cycle to check if any completed requests or new requests at this cycle.
 bool TLB::tick(SST::Cycle_t x)
@@ -179,9 +141,9 @@ bool TLB::tick(SST::Cycle_t x)
 	{
 
 
-        MemHierarchy::MemEventBase * ev = pushed_back.back();
+		TranslationRequest * req = pushed_back.back();
 
-		Address_t addr = ((MemEvent*) ev)->getVirtualAddress();
+		Address_t addr = req->vaddr;
 
 
 		// Double checking that we actually still don't have it inserted
@@ -192,7 +154,7 @@ bool TLB::tick(SST::Cycle_t x)
 		lu_en=SIZE_LOOKUP.end();
 		while(lu_st!=lu_en)
 		{
-			if(pushed_back_size[ev] >= lu_st->first)
+			if(req->page_size >= lu_st->first)
 			{
 				if(!check_hit(addr, lu_st->second))
 				{
@@ -206,48 +168,32 @@ bool TLB::tick(SST::Cycle_t x)
 		}
 
 		// Deleting it from pending requests
-		std::vector<SST::MemHierarchy::MemEventBase *>::iterator st, en;
-		st = pending_misses.begin();
-		en = pending_misses.end();
-
-
-		while(st!=en)
-		{
-			if(*st == ev)
-			{
-				pending_misses.erase(st);
-				break;
-			}
-			st++;
-		}
+		clear_pending(req);
 
 		// Note that here we are substituting for latency of checking the tag before proceeding 
-        // to the next level, we also add the upper link latency for the round trip
-		ready_by[ev]= x + latency + 2*upper_link_latency;
-
-		// We also track the size of tthe ready request
-		ready_by_size[ev]= pushed_back_size[ev];
+        // to the next level, we also add the upper link latency for the round trip, the size of the
+		// translation returned from below stays in req->page_size
+		req->ready_by = x + latency + 2*upper_link_latency;
+		ready_by.push_back(req);
 
 
 		// Check if there are other misses that were going to the same translation and waiting for the response of this miss
-		if((level==1) && (SAME_MISS.find(addr/4096)!=SAME_MISS.end()))
+		if(level==1)
 		{
-		  std::map< MemHierarchy::MemEventBase*, int>::iterator same_st, same_en;
-		  same_st = SAME_MISS[addr/4096].begin();
-    		  same_en = SAME_MISS[addr/4096].end();
-   		   while(same_st!=same_en)
-		    {
-
-	    		ready_by[same_st->first] = x + latency + 2*upper_link_latency;
-	    		ready_by_size[same_st->first] = pushed_back_size[ev];
-			same_st++;
-		    }
-		  SAME_MISS.erase(addr/4096);
-		 // PENDING_MISS.erase(addr/4096);
+			std::map< Address_t, std::vector<TranslationRequest*> >::iterator same = SAME_MISS.find(addr/4096);
+			if(same != SAME_MISS.end())
+			{
+				for(TranslationRequest * waiting : same->second)
+				{
+					waiting->ready_by = x + latency + 2*upper_link_latency;
+					waiting->page_size = req->page_size;
+					ready_by.push_back(waiting);
+				}
+				SAME_MISS.erase(same);
+			}
 		}
 		PENDING_MISS.erase(addr/4096);
 
-		pushed_back_size.erase(ev);
 		pushed_back.pop_back();
 
 	}
@@ -256,9 +202,8 @@ bool TLB::tick(SST::Cycle_t x)
 
 	// The actual dispatching process... here we take a request and place it 
     // in the right queue based on being miss or hit and the number of pending misses
-	std::vector<MemHierarchy::MemEventBase*>::iterator st_1,en_1;
+	std::vector<TranslationRequest*>::iterator st_1;
 	st_1 = not_serviced.begin();
-	en_1 = not_serviced.end();
 
 	int dispatched=0;
 
@@ -271,8 +216,8 @@ bool TLB::tick(SST::Cycle_t x)
 		if(dispatched > max_width)
 			break;
 
-        MemHierarchy::MemEventBase * ev = *st_1;
-		Address_t addr = ((MemEvent*) ev)->getVirtualAddress();
+		TranslationRequest * req = *st_1;
+		Address_t addr = req->vaddr;
 
 
 		// Those track if any hit in one of the supported pages' structures
@@ -296,12 +241,13 @@ bool TLB::tick(SST::Cycle_t x)
 			hits++;
 			statTLBHits->addData(1);
 			if(parallel_mode)
-				ready_by[ev] = x;
+				req->ready_by = x;
 			else
-				ready_by[ev] = x + latency;
+				req->ready_by = x + latency;
 
 			// Tracking the hit request size
-			ready_by_size[ev] = page_size[hit_id]/1024;
+			req->page_size = arrays[hit_id].getPageSize()/1024;
+			ready_by.push_back(req);
 
 			st_1 = not_serviced.erase(st_1);
 		}
@@ -309,7 +255,7 @@ bool TLB::tick(SST::Cycle_t x)
 		{
 
 			// Making sure we have a room for an additional miss, i.e., less than the maximum outstanding misses
-			if((int) pending_misses.size() < (int) max_outstanding)
+			if(pending_misses < max_outstanding)
 			{
 
 				// Check if the miss is not currently being handled
@@ -317,7 +263,7 @@ bool TLB::tick(SST::Cycle_t x)
 				if((level==1) && (PENDING_MISS.find(addr/4096) != PENDING_MISS.end()))
 				{
 
-					SAME_MISS[addr/4096][ev]=1; // Just adding it to the 2D map, so we later hand it back once the master miss is complete
+					SAME_MISS[addr/4096].push_back(req); // We later hand it back once the master miss is complete
 					currently_handled = true;
 				}
 				else if(level==1)
@@ -333,25 +279,17 @@ bool TLB::tick(SST::Cycle_t x)
 				if(!currently_handled)
 				{
 
-					pending_misses.push_back(*st_1);
+					req->pending_at |= (1u << level);
+					pending_misses++;
 					// Check if the last level TLB or not, if last-level, pass the request to the page table walker
 					if(next_level!=nullptr)
-					{
-
-						next_level->push_request(ev);
-						st_1 = not_serviced.erase(st_1);
-					}
+						next_level->push_request(req);
 					else // Pass it to the page table walker
-					{
-						PTW->push_request(ev);
-						st_1 = not_serviced.erase(st_1);
-					}
-				}
-				else
-				{
-					st_1 = not_serviced.erase(st_1);
+						PTW->push_request(req);
 				}
 
+				st_1 = not_serviced.erase(st_1);
+
 			}
 
 		}
@@ -362,71 +300,29 @@ bool TLB::tick(SST::Cycle_t x)
 	}
 
 
-	std::map<MemHierarchy::MemEventBase *, SST::Cycle_t>::iterator st, en;
-	st = ready_by.begin();
-	en = ready_by.end();
+	// Pass back every request that has finished by this cycle, in event id order
+	completed.clear();
+	TranslationRequest::collectReady(ready_by, completed, x);
 
-	// We iterate over the list of being serviced request to see if any has finished by this cycle
-	while(st!=en)
+	for(TranslationRequest * req : completed)
 	{
 
-		bool deleted=false;
-		if(st->second <= x)
-		{
-
-			//	std::cout<<"The request was read at "<<st->second<<" The time now is "<<x<<std::endl;
-
-			Address_t addr = ((MemEvent*) st->first)->getVirtualAddress();
-
-
-			if(SIZE_LOOKUP.find(ready_by_size[st->first])!= SIZE_LOOKUP.end())
-			{
-				// Double checking that we actually still don't have it inserted
-				if(!check_hit(addr, SIZE_LOOKUP[ready_by_size[st->first]]))
-				{
-					insert_way(addr, find_victim_way(addr, SIZE_LOOKUP[ready_by_size[st->first]]), SIZE_LOOKUP[ready_by_size[st->first]]);
-					update_lru(addr, SIZE_LOOKUP[ready_by_size[st->first]]);
-				}
-				else
-					update_lru(addr, SIZE_LOOKUP[ready_by_size[st->first]]);
-			}
-
-
-
-			service_back->push_back(st->first);
-
-			(*service_back_size)[st->first]=ready_by_size[st->first];
-
-
-
-			ready_by_size.erase(st->first);
-
-			deleted = true;
-
-
-			// Deleting it from pending requests
-			std::vector<MemHierarchy::MemEventBase *>::iterator st2, en2;
-			st2 = pending_misses.begin();
-			en2 = pending_misses.end();
+		Address_t addr = req->vaddr;
 
+		std::map<long long int, int>::iterator size_id = SIZE_LOOKUP.find(req->page_size);
+		if(size_id != SIZE_LOOKUP.end())
+		{
+			// Double checking that we actually still don't have it inserted
+			if(!check_hit(addr, size_id->second))
+				insert_way(addr, find_victim_way(addr, size_id->second), size_id->second);
 
-			while(st2!=en2)
-			{
-				if(*st2 == st->first)
-				{
-					pending_misses.erase(st2);
-					break;
-				}
-				st2++;
-			}
+			update_lru(addr, size_id->second);
+		}
 
-			ready_by.erase(st);
+		service_back->push_back(req);
 
-		}
-		if(deleted)
-			st=ready_by.begin();
-		else
-			st++;
+		// Deleting it from pending requests
+		clear_pending(req);
 
 	}
 
@@ -439,11 +335,7 @@ bool TLB::tick(SST::Cycle_t x)
 // Used to insert a new translation on a specific way of the TLB structure
 void TLB::insert_way(Address_t vaddr, int way, int struct_id)
 {
-
-	int set=abs_int((vaddr/page_size[struct_id])%sets[struct_id]);
-	tags[struct_id][set][way]=vaddr/page_size[struct_id];
-	valid[struct_id][set][way]=true;
-
+	arrays[struct_id].insert_way(vaddr, way);
 }
 
 
@@ -462,17 +354,7 @@ void TLB::invalidate(Address_t vadd, int id)
 {
 
 	for(int id=0; id<sizes; id++)
-	{
-		//std::cout << getName().c_str() << " TLB " << coreId << " id: " << id << " invalidate address: " << vadd << " index: " << vadd*page_size[0]/page_size[id] << std::endl;
-		int set= abs_int((vadd*page_size[0]/page_size[id])%sets[id]);
-		for(int i=0; i<assoc[id]; i++) {
-			if(tags[id][set][i]==vadd*page_size[0]/page_size[id] && valid[id][set][i]) {
-				//std::cout << getName().c_str() << " TLB " << coreId << " invalidate address: " << vadd << " index: " << vadd*page_size[0]/page_size[id] << " found" << std::endl;
-				valid[id][set][i] = false;
-				break;
-			}
-		}
-	}
+		arrays[id].invalidate(vadd*arrays[0].getPageSize()/arrays[id].getPageSize());
 
 	statTLBShootdowns->addData(1);
 }
@@ -482,52 +364,17 @@ void TLB::invalidate(Address_t vadd, int id)
 // Find if the translation  exists on structure struct_id
 bool TLB::check_hit(Address_t vadd, int struct_id)
 {
-
-
-	int set= abs_int((vadd/page_size[struct_id])%sets[struct_id]);
-	for(int i=0; i<assoc[struct_id];i++)
-		if(tags[struct_id][set][i]==vadd/page_size[struct_id])
-			return valid[struct_id][set][i];
-
-	return false;
+	return arrays[struct_id].check_hit(vadd);
 }
 
 // To insert the translaiton
 int TLB::find_victim_way(Address_t vadd, int struct_id)
 {
-
-	int set= abs_int((vadd/page_size[struct_id])%sets[struct_id]);
-
-	for(int i=0; i<assoc[struct_id]; i++)
-		if(lru[struct_id][set][i]==(assoc[struct_id]-1))
-			return i;
-
-
-	return 0;
+	return arrays[struct_id].find_victim_way(vadd);
 }
 
 // This function updates the LRU position for a given address of a specific structure
 void TLB::update_lru(Address_t vaddr, int struct_id)
 {
-
-	int lru_place=assoc[struct_id]-1;
-
-	int set= abs_int((vaddr/page_size[struct_id])%sets[struct_id]);
-	for(int i=0; i<assoc[struct_id];i++)
-		if(tags[struct_id][set][i]==vaddr/page_size[struct_id])
-		{
-			lru_place = lru[struct_id][set][i];
-			break;
-		}
-	for(int i=0; i<assoc[struct_id];i++)
-	{
-		if(lru[struct_id][set][i]==lru_place)
-			lru[struct_id][set][i]=0;
-		else if(lru[struct_id][set][i]<lru_place)
-			lru[struct_id][set][i]++;
-	}
-
-
+	arrays[struct_id].update_lru(vaddr);
 }
-
-
@@ -22,6 +22,8 @@
 #include <sst/core/timeConverter.h>
 #include <sst/elements/memHierarchy/memEvent.h>
 #include "PageTableWalker.h"
+#include "TLBArray.h"
+#include "TranslationRequest.h"
 #include <map>
 #include <vector>
 #include "utils.h"
@@ -50,19 +52,9 @@ class TLB : public ComponentExtension
 	int parallel_mode;      // very specific case for L1 TLB in case of overlapping with accessing the cache
 	int page_walk_latency;  // this is really nothing other than the page walk latency in case of having no walkers
 
-    // === Per page-type params (set separately for each separate type of huge-page of huge-pages)
-	uint64_t * page_size; // for each [pg-type], size of that page in bytes (so the standard 4k/2M/1G would be 1024 * [4,2048,1048576]
-
-	int * size;  // Number of TLB entries, indexed by [pg-type]
-	int * assoc; // associativity of entries, for     [pg-type]
-	int * sets;  // stores the number of sets, by     [pg-type]
-
     // === Cache data for TLB entries
-    // - separate cache for each size of page
-    // - accessed as `tags[page_size][set][way]`
-	Address_t *** tags;
-	bool ***valid; // status of the tags
-	int *** lru;   // lru positions
+    // - separate set-associative structure for each size of page, indexed by [pg-type]
+	std::vector<TLBArray> arrays;
 
 
     // === Counters
@@ -78,7 +70,7 @@ class TLB : public ComponentExtension
     // === ???
 	std::map<long long int, int> SIZE_LOOKUP; // This structure checks if a size is supported inside the structure, and its index structure
 
-	std::map< Address_t, std::map< MemHierarchy::MemEventBase *, int, MemEventPtrCompare>> SAME_MISS; // This tracks the misses for the same location and deduplicates them
+	std::map< Address_t, std::vector<TranslationRequest*> > SAME_MISS; // This tracks the misses for the same location and deduplicates them
 	std::map<Address_t, int> PENDING_MISS; // This tracks the addresses of the current master misses (other contained misses are tracked in SAME_MISS)
 
 
@@ -88,19 +80,18 @@ class TLB : public ComponentExtension
     //
     //=======================================================================
 
-    //  note: the _size buffers holds the size of the relevant page,
-    //  i.e 1 for 4k, 2 for 2M, 3 for 1GB (if using standard page sizes)
+    //  note: the page size of a request's translation is carried in TranslationRequest::page_size,
+    //  in KB, i.e 4 for 4k, 2048 for 2M (if using standard page sizes)
 
     // === Holds incoming requests, "input queue"
-	std::vector<MemHierarchy::MemEventBase *> not_serviced;
+	std::vector<TranslationRequest *> not_serviced;
 
-    // === Holds a copy of requests that have missed in this level, and have been sent into the next level down.
-    //  events are erased when they are fulfilled, and returned into `this->pushed_back`
-	std::vector<MemHierarchy::MemEventBase *> pending_misses; 
+    // === Number of requests that have missed in this level, and have been sent into the next level down.
+    //  decremented when they are fulfilled, and returned into `this->pushed_back`
+	int pending_misses;
 
-    // === Holds requests that have gotten the data they need, but we need to wait the duration of the latency before returning
-	std::map<MemHierarchy::MemEventBase *, SST::Cycle_t, MemEventPtrCompare> ready_by; 
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> ready_by_size; // keeps track of requests' sizes inside this structure
+    // === Holds requests that have gotten the data they need, but we need to wait until req->ready_by before returning
+	std::vector<TranslationRequest *> ready_by;
 
 
     // === Buffers for sending requests up/down TLB hierarchy:
@@ -108,13 +99,17 @@ class TLB : public ComponentExtension
     // When we miss, we send requests to next level down through `next_level->push_request()` or `PTW->push_request()`
     
     // completed requests from deeper in TLB hierarchy will be returned into `this->pushed_back`
-	std::vector<MemHierarchy::MemEventBase *> pushed_back; // translation for requests, returned from lower-level structures
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> pushed_back_size; // page_sizes of the returned translations
+	std::vector<TranslationRequest *> pushed_back; // translation for requests, returned from lower-level structures
 
     // when we're finished with a request, we send it back up the hierarchy by inserting into `service_back`
     // - pointer is wired up to `pushed_back` buffers of the next level up at TLB in constructor of TLBHierarchy
-	std::vector<MemHierarchy::MemEventBase *> * service_back; // used to pass ready requests back to the previous level
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * service_back_size; // page_size of ready requests for next level up
+	std::vector<TranslationRequest *> * service_back; // used to pass ready requests back to the previous level
+
+	// Scratch buffer for requests completing on the current cycle
+	std::vector<TranslationRequest *> completed;
+
+	// Clear this level's outstanding-miss mark on a request, if set
+	void clear_pending(TranslationRequest * req);
 
 
 
@@ -142,12 +137,10 @@ class TLB : public ComponentExtension
 
     // === Called by parent to wire up TLB levels to each other
     // this TLB will push completed requests into service_back (sending them back up the levels towards core)
-	void setServiceBack( std::vector<MemHierarchy::MemEventBase *> * x) { service_back = x;}
-	void setServiceBackSize( std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * x) { service_back_size = x;}
+	void setServiceBack( std::vector<TranslationRequest *> * x) { service_back = x;}
 
     // lower-levels will return answered requests into this->pushed_back
-	std::vector<MemHierarchy::MemEventBase *> * getPushedBack(){return & pushed_back;}
-	std::map<MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> * getPushedBackSize(){return & pushed_back_size;}
+	std::vector<TranslationRequest *> * getPushedBack(){return & pushed_back;}
 
 	void update_lru(Address_t vaddr, int struct_id);
 
@@ -165,7 +158,7 @@ class TLB : public ComponentExtension
 	void insert_way(Address_t vaddr, int way, int struct_id);
 
 	// This one is to push a request to this structure
-	void push_request(MemHierarchy::MemEventBase * x) { not_serviced.push_back(x);}
+	void push_request(TranslationRequest * x) { not_serviced.push_back(x);}
 
 	bool tick(SST::Cycle_t x);
 
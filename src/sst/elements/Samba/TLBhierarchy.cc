@@ -54,6 +54,8 @@ TLBhierarchy::TLBhierarchy(ComponentId_t id, int tlb_id, int Levels, Params& par
 
 	shootdown = 0;  // is set to 1 by the page table walker due to shootdown
 
+	page_table = nullptr; // set through setPageTablePointers when page faults are emulated
+
 	std::string LEVEL = std::to_string(1);
 	std::string cpu_clock = params.find<std::string>("clock", "1GHz");
 
@@ -123,21 +125,17 @@ TLBhierarchy::TLBhierarchy(ComponentId_t id, int tlb_id, int Levels, Params& par
 		for(int level=2; level <=levels; level++)
 		{
 			TLB_CACHE[level]->setServiceBack(TLB_CACHE[level-1]->getPushedBack());
-			TLB_CACHE[level]->setServiceBackSize(TLB_CACHE[level-1]->getPushedBackSize());
 
 		}
 
 		timeStamp = 0;
 		PTW->setServiceBack(TLB_CACHE[levels]->getPushedBack());
-		PTW->setServiceBackSize(TLB_CACHE[levels]->getPushedBackSize());
 
 		TLB_CACHE[1]->setServiceBack(&mem_reqs);
-		TLB_CACHE[1]->setServiceBackSize(&mem_reqs_sizes);
 	}
 	else
 	{
 		PTW->setServiceBack(&mem_reqs);
-		PTW->setServiceBackSize(&mem_reqs_sizes);
 	}
 
 	PTW->setHold(&hold);
@@ -178,9 +176,8 @@ void TLBhierarchy::handleEvent_CACHE( SST::Event * ev )
 void TLBhierarchy::handleEvent_CPU(SST::Event* event)
 {
 	// Push the request to the L1 TLB and time-stamp it
-	time_tracker[event]= curr_time;
         MemEventBase* mEvent = static_cast<MemEventBase*>(event);
-	TLB_CACHE[1]->push_request(mEvent);
+	TLB_CACHE[1]->push_request(request_pool.allocate(mEvent, ((MemEvent*) mEvent)->getVirtualAddress(), curr_time));
 
 
 }
@@ -237,61 +234,34 @@ bool TLBhierarchy::tick(SST::Cycle_t x)
 	// Step 1, check if not empty, then propogate it to L1 cache
 	while(!mem_reqs.empty() && !shootdown && !hold)
 	{
-            MemHierarchy::MemEventBase * event= mem_reqs.back();
-
-		if(time_tracker.find(event) == time_tracker.end())
-		{
-			std::cout << "Danger! Something is terribly wrong..." << std::endl;
-			mem_reqs_sizes.erase(event);
-			mem_reqs.pop_back();
-			continue;
-		}
+		TranslationRequest * req = mem_reqs.back();
+		MemHierarchy::MemEventBase * event = req->ev;
 
 		// Here we override the physical address provided by ariel memory manage by the one provided by page fault handler
 		if(emulate_faults)
 		{
-			Address_t vaddr = ((MemEvent*) event)->getVirtualAddress();
-			if(!ptw_confined)
-			{
-				if((*PTE).find(vaddr/4096)==(*PTE).end())
-					std::cout<<"Error: That page has never been mapped:  " << vaddr / 4096 << std::endl;
+			Address_t vaddr = req->vaddr;
+			Address_t pt_vaddr = ptw_confined ? PageTable::confine(vaddr) : vaddr;
 
-				((MemEvent*) event)->setAddr((((*PTE)[vaddr / 4096] + vaddr % 4096) / 64) * 64);
-				((MemEvent*) event)->setBaseAddr((((*PTE)[vaddr / 4096] + vaddr % 4096) / 64) * 64);
-			}
-			else
-			{
-				uint64_t offset = (uint64_t)512*512*512*512;
-				if((*PTE).find((vaddr/4096)%offset)==(*PTE).end())
+			if(!page_table->present(0, pt_vaddr))
 				std::cout<<"Error: That page has never been mapped:  " << vaddr / 4096 << std::endl;
 
-				((MemEvent*) event)->setAddr((((*PTE)[(vaddr / 4096)%offset] + vaddr % 4096)));
-				((MemEvent*) event)->setBaseAddr((((*PTE)[(vaddr / 4096)%offset] + vaddr % 4096) / 64) * 64);
-			}
-
-			/*if(page_placement) {
-				if((*PTE)[vaddr / 4096] < memory_size ) {
-					//if((*PTR_map).find((*PTE)[vaddr / 4096]) == (*PTR_map).end())
-					//	std::cout<<"Error: page reference is not mapped, vaddress:" << vaddr / 4096 << " physical page: " << (*PTE)[vaddr / 4096] << " PTE " << std::endl;
-
-					//std::cerr << Owner->getName().c_str() << " Page table reference update address: " << (*PTR)[(*PTR_map)[(*PTE)[vaddr / 4096]]].first << " index: " <<
-					//		(*PTR_map)[(*PTE)[vaddr / 4096]] << " PTE " << std::endl;
-					PTW->updatePTR((*PTE)[vaddr / 4096]);
-
-					//(*PTR)[(*PTE)[vaddr / 4096]] = 1;
-				}
-			}*/
+			Address_t paddr = page_table->frame(0, pt_vaddr) + vaddr % 4096;
+			if(!ptw_confined)
+				((MemEvent*) event)->setAddr((paddr / 64) * 64);
+			else
+				((MemEvent*) event)->setAddr(paddr);
+			((MemEvent*) event)->setBaseAddr((paddr / 64) * 64);
 
 		}
 
-		uint64_t time_diff = (uint64_t ) x - time_tracker[event];
-		time_tracker.erase(event);
+		uint64_t time_diff = (uint64_t ) x - req->issue_time;
 		total_waiting->addData(time_diff);
 
 		to_cache->send(event);
 
-		// We remove the size of that translation, we might for future versions use the translation size to obtain statistics
-		mem_reqs_sizes.erase(event);
+		// We are done with the translation state of that request, we might for future versions use the translation size to obtain statistics
+		request_pool.release(req);
 		mem_reqs.pop_back();
 	}
 
@@ -33,6 +33,8 @@
 #include "TLBentry.h"
 #include "TLBUnit.h"
 #include "PageTableWalker.h"
+#include "PageTable.h"
+#include "TranslationRequest.h"
 
 #include<map>
 #include<vector>
@@ -95,12 +97,11 @@ namespace SST { namespace SambaComponent{
 
         //======== Event buffers?
 
-		std::vector<SST::MemHierarchy::MemEventBase *> mem_reqs; // holds the current requests to be translated
+		std::vector<TranslationRequest *> mem_reqs; // holds the requests whose translation is complete
 
 		std::vector<std::pair<Address_t, int> > invalid_addrs;  // holds the invalidation requests
-		std::map<SST::MemHierarchy::MemEventBase *, long long int, MemEventPtrCompare> mem_reqs_sizes;
-                                                        // holds the current requests to be translated
-		std::map<SST::Event *, uint64_t> time_tracker;   // used to track time spent on translating each request
+
+		TranslationRequestPool request_pool; // per-request translation state, including the time each request arrived
 		
 		// This represents the maximum number of outstanding requests for this structure
 		//int max_outstanding; //TODO: TEMP JVOROBY 2021.11: i think this is unused? will try to rebuild without it
@@ -111,24 +112,8 @@ namespace SST { namespace SambaComponent{
 		// Holds CR3 value of current context (i.e. base of page table)
 		Address_t *CR3;
 
-		// Holds the PGD, PUD, PMT, PTE physical pointers
-		std::map<Address_t, Address_t> * PGD; // key is 9 bits 39-47, i.e., VA/(4096*512*512*512)
-		std::map<Address_t, Address_t> * PUD; // key is 9 bits 30-38, i.e., VA/(4096*512*512)
-		std::map<Address_t, Address_t> * PMD; // key is 9 bits 21-29, i.e., VA/(4096*512)
-		std::map<Address_t, Address_t> * PTE; // key is 9 bits 12-20, i.e., VA/(4096)         
-                                              // PTE should give you the exact physical address of the page
-
-		// The structures below are used to quickly check if the page is mapped or not
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE4KB;
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE2MB;
-		std::map<Address_t,int> * MAPPED_PAGE_SIZE1GB;
-
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PGD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PUD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PMD;
-		std::map<Address_t,int> *PENDING_PAGE_FAULTS_PTE;
-		std::map<Address_t,int> *PENDING_SHOOTDOWN_EVENTS;
+		// The page table shared by all cores of this Samba unit
+		PageTable * page_table;
 
 
 		public:
@@ -142,38 +127,13 @@ namespace SST { namespace SambaComponent{
 		void handleEvent_CPU(SST::Event * event);
 
 
-		void setPageTablePointers(  Address_t * cr3, 
-                                    std::map<Address_t, Address_t> * pgd,  
-                                    std::map<Address_t, Address_t> * pud,  
-                                    std::map<Address_t, Address_t> * pmd, 
-                                    std::map<Address_t, Address_t> * pte,
-                                    std::map<Address_t,int> * gb,  
-                                    std::map<Address_t,int> * mb,  
-                                    std::map<Address_t,int> * kb, 
-                                    std::map<Address_t,int> * pr, 
-                                    int *cr3I, 
-                                    std::map<Address_t,int> *pf_pgd,
-                                    std::map<Address_t,int> *pf_pud,  
-                                    std::map<Address_t,int> *pf_pmd, 
-                                    std::map<Address_t,int> * pf_pte)
+		void setPageTablePointers( Address_t * cr3, PageTable * pt, int *cr3I)
 		{
-                        CR3 = cr3;
-                        PGD = pgd;
-                        PUD = pud;
-                        PMD = pmd;
-                        PTE = pte;
-                        MAPPED_PAGE_SIZE4KB = kb;
-                        MAPPED_PAGE_SIZE2MB = mb;
-                        MAPPED_PAGE_SIZE1GB = gb;
-                        PENDING_PAGE_FAULTS = pr;
-                        PENDING_PAGE_FAULTS_PGD = pf_pgd;
-						PENDING_PAGE_FAULTS_PUD = pf_pud;
-						PENDING_PAGE_FAULTS_PMD = pf_pmd;
-						PENDING_PAGE_FAULTS_PTE = pf_pte;
+			CR3 = cr3;
+			page_table = pt;
 
 			if(PTW!=nullptr)
-				//PTW->setPageTablePointers(cr3, pgd, pud, pmd, pte, gb, mb, kb, pr, sr);
-				PTW->setPageTablePointers(cr3, pgd, pud, pmd, pte, gb, mb, kb, pr, cr3I, pf_pgd, pf_pud, pf_pmd, pf_pte);
+				PTW->setPageTablePointers(cr3, pt, cr3I);
 
 		}
 		// Constructor for component
@@ -0,0 +1,98 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+//
+
+#ifndef _H_SST_SAMBA_TRANSLATION_REQUEST
+#define _H_SST_SAMBA_TRANSLATION_REQUEST
+
+#include <sst/core/sst_types.h>
+#include <sst/elements/memHierarchy/memEventBase.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace SST { namespace SambaComponent{
+
+	// Translation state of one CPU request while it travels down and back up a TLB hierarchy.
+	// The same object is handed between the TLB levels and the page table walker, so each unit
+	// reads and writes its fields directly instead of keeping its own maps keyed by the event.
+	struct TranslationRequest
+	{
+		MemHierarchy::MemEventBase * ev;
+		uint64_t vaddr;
+		SST::Cycle_t issue_time; // cycle the TLB hierarchy received the request
+		SST::Cycle_t ready_by;   // cycle the unit currently holding the request may pass it back up
+		long long int page_size; // size in KB of the translation being returned
+		uint32_t pending_at;     // bit i is set while the request is an outstanding miss of unit i (0 is the page table walker)
+		int walk_level;          // page table level the next walk access refers to
+
+		// Order in which requests that become ready on the same cycle are passed back, i.e., by event id
+		static bool idOrder(const TranslationRequest * a, const TranslationRequest * b)
+		{
+			return a->ev->getID() < b->ev->getID();
+		}
+
+		// Move requests ready by cycle x from in_flight to the end of ready, in id order
+		static void collectReady(std::vector<TranslationRequest*> & in_flight, std::vector<TranslationRequest*> & ready, SST::Cycle_t x)
+		{
+			size_t first = ready.size();
+			size_t kept = 0;
+			for(size_t i = 0; i < in_flight.size(); i++)
+			{
+				if(in_flight[i]->ready_by <= x)
+					ready.push_back(in_flight[i]);
+				else
+					in_flight[kept++] = in_flight[i];
+			}
+			in_flight.resize(kept);
+			std::sort(ready.begin() + first, ready.end(), idOrder);
+		}
+	};
+
+	// Recycles TranslationRequest objects so that steady-state translation does not allocate
+	class TranslationRequestPool
+	{
+		std::vector<std::unique_ptr<TranslationRequest>> storage;
+		std::vector<TranslationRequest*> free_list;
+
+		public:
+
+		TranslationRequest * allocate(MemHierarchy::MemEventBase * ev, uint64_t vaddr, SST::Cycle_t now)
+		{
+			TranslationRequest * req;
+			if(free_list.empty())
+			{
+				storage.emplace_back(new TranslationRequest());
+				req = storage.back().get();
+			}
+			else
+			{
+				req = free_list.back();
+				free_list.pop_back();
+			}
+
+			req->ev = ev;
+			req->vaddr = vaddr;
+			req->issue_time = now;
+			req->ready_by = 0;
+			req->page_size = 0;
+			req->pending_at = 0;
+			req->walk_level = 0;
+			return req;
+		}
+
+		void release(TranslationRequest * req) { free_list.push_back(req); }
+	};
+
+}}
+
+#endif
@@ -0,0 +1,100 @@
+# Performance check for Samba translation
+# A Miranda GUPS generator makes random updates over a large virtual range,
+# so nearly every access misses in the TLBs and goes to the page table walker.
+# Compare wall-clock time between builds, e.g.,
+#   time sst perfGupsMMU.py
+#   time sst perfGupsMMU.py 4096        (virtual range in MB)
+import sys
+import sst
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stopAtCycle", "0 ns")
+
+range_mb = 64 * 1024
+if len(sys.argv) > 1:
+    range_mb = int(sys.argv[1])
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "miranda.BaseCPU")
+comp_cpu.addParams({
+	"verbose" : 0,
+	"max_reqs_cycle" : 4,
+})
+cpugen = comp_cpu.setSubComponent("generator", "miranda.GUPSGenerator")
+cpugen.addParams({
+	"verbose" : 0,
+	"count" : 1000000,
+	"max_address" : range_mb * 1024 * 1024,
+})
+
+comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+comp_l1cache.addParams({
+      "access_latency_cycles" : "2",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "4",
+      "cache_line_size" : "64",
+      "L1" : "1",
+      "cache_size" : "8KB",
+})
+
+comp_memctrl = sst.Component("memory", "memHierarchy.MemController")
+comp_memctrl.addParams({
+      "clock" : "1GHz",
+      "backing" : "none",
+})
+memory = comp_memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50 ns",
+    "mem_size" : str(range_mb * 1024 * 1024) + "B",
+})
+
+mmu = sst.Component("mmu0", "Samba")
+mmu.addParams({
+        "os_page_size": 4,
+        "corecount": 1,
+        "sizes_L1": 1,
+        "page_size1_L1": 4,
+        "assoc1_L1": 4,
+        "size1_L1": 64,
+        "sizes_L2": 1,
+        "page_size1_L2": 4,
+        "assoc1_L2": 12,
+        "size1_L2": 1536,
+        "clock": "2 Ghz",
+        "levels": 2,
+        "max_width_L1": 3,
+        "max_outstanding_L1": 8,
+        "latency_L1": 4,
+        "parallel_mode_L1": 1,
+        "max_outstanding_L2": 8,
+        "max_width_L2": 4,
+        "latency_L2": 10,
+        "parallel_mode_L2": 0,
+        "self_connected" : 1,
+        "page_walk_latency": 30,
+        "size1_PTWC": 32,
+        "assoc1_PTWC": 4,
+        "size2_PTWC": 32,
+        "assoc2_PTWC": 4,
+        "size3_PTWC": 32,
+        "assoc3_PTWC": 4,
+        "size4_PTWC": 32,
+        "assoc4_PTWC": 4,
+        "latency_PTWC": 10,
+        "max_outstanding_PTWC": 8,
+});
+
+# Define the simulation links
+link_cpu_mmu_link = sst.Link("link_cpu_mmu_link")
+link_cpu_mmu_link.connect( (comp_cpu, "cache_link", "50ps"), (mmu, "cpu_to_mmu0", "50ps") )
+link_cpu_mmu_link.setNoCut()
+
+link_mmu_cache_link = sst.Link("link_mmu_cache_link")
+link_mmu_cache_link.connect( (mmu, "mmu_to_cache0", "50ps"), (comp_l1cache, "high_network_0", "50ps") )
+link_mmu_cache_link.setNoCut()
+
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (comp_l1cache, "low_network_0", "50ps"), (comp_memctrl, "direct_link", "50ps") )
@@ -27,6 +27,8 @@
  */
 
 #include <inttypes.h>
+#include <stddef.h>
+#include <string.h>
 
 #include <sst/core/interprocess/tunneldef.h>
 #include "ariel_inst_class.h"
@@ -180,6 +182,39 @@ struct ArielCommand {
     };
 };
 
+/*
+ * Commands travel through the tunnel packed into fixed-size blocks. Each
+ * command is an ArielPackedCommand header followed by only the fields it
+ * uses, padded to 8 bytes: 16 bytes for instruction markers, 24 for a read
+ * or a write without payload. Each producer thread fills a block of its own
+ * and hands it over when the next command does not fit, so a block write
+ * carries many commands. Commands outside the instruction stream (exit,
+ * allocations, CUDA calls, ...) are handed over right away.
+ */
+#ifdef HAVE_CUDA
+#define ARIEL_COMMAND_BLOCK_SIZE 2048
+#else
+#define ARIEL_COMMAND_BLOCK_SIZE 512
+#endif
+
+struct ArielPackedCommand {
+    uint8_t  command;
+    uint8_t  instClass;
+    uint8_t  simdElemCount;  // saturates at 255
+    uint8_t  payloadLen;     // write payload bytes following the address
+    uint32_t size;           // access size, or body length of other commands
+    uint64_t instPtr;
+};
+
+struct ArielCommandBlock {
+    uint32_t used;
+    uint32_t count;
+    uint8_t  data[ARIEL_COMMAND_BLOCK_SIZE - 2 * sizeof(uint32_t)];
+};
+
+// Room for the largest instruction: start, read, write with a full payload and end
+#define ARIEL_MAX_PACKED_INSTRUCTION (4 * sizeof(ArielPackedCommand) + 2 * sizeof(uint64_t) + ARIEL_MAX_PAYLOAD_SIZE)
+
 struct ArielSharedData {
     size_t numCores;
     uint64_t simTime;
@@ -188,27 +223,35 @@ struct ArielSharedData {
     uint8_t __pad[ 256 - sizeof(uint32_t) - sizeof(size_t) - sizeof(uint64_t) - sizeof(uint64_t)];
 };
 
-class ArielTunnel : public SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommand>
+class ArielTunnel : public SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommandBlock>
 {
 public:
     /**
      * Create a new Ariel Tunnel
      */
     ArielTunnel(size_t numCores, size_t bufferSize, uint32_t expectedChildren = 1) :
-        SST::Core::Interprocess::TunnelDef<ArielSharedData,ArielCommand>(numCores, bufferSize, expectedChildren) { }
+        SST::Core::Interprocess::TunnelDef<ArielSharedData,ArielCommandBlock>(numCores, bufferSize, expectedChildren),
+        writeBlocks(NULL), readBlocks(NULL), readOffsets(NULL), maxBlockCommands(0) { }
 
     /**
      * Attach to an existing Ariel Tunnel (Created in another process)
      */
     ArielTunnel(void* sPtr) :
-        SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommand>(sPtr) { }
+        SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommandBlock>(sPtr),
+        writeBlocks(NULL), readBlocks(NULL), readOffsets(NULL), maxBlockCommands(0) { }
+
+    virtual ~ArielTunnel() {
+        delete [] writeBlocks;
+        delete [] readBlocks;
+        delete [] readOffsets;
+    }
 
     /**
      * Initialize tunnel
      * None of the data structures (e.g., sharedData) are available until this function call
      */
     virtual uint32_t initialize(void* sPtr) {
-        uint32_t childnum = SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommand>::initialize(sPtr);
+        uint32_t childnum = SST::Core::Interprocess::TunnelDef<ArielSharedData, ArielCommandBlock>::initialize(sPtr);
         if (isMaster()) {
             sharedData->numCores = getNumBuffers();
             sharedData->simTime = 0;
@@ -218,9 +261,95 @@ public:
             /* Ideally, this would be done atomically, but we'll only have 1 child */
             sharedData->child_attached++;
         }
+
+        writeBlocks = new ArielCommandBlock[getNumBuffers()];
+        readBlocks = new ArielCommandBlock[getNumBuffers()];
+        readOffsets = new uint32_t[getNumBuffers()];
+        for (size_t i = 0; i < getNumBuffers(); i++) {
+            writeBlocks[i].used = 0;
+            writeBlocks[i].count = 0;
+            readBlocks[i].used = 0;
+            readBlocks[i].count = 0;
+            readOffsets[i] = 0;
+        }
         return childnum;
     }
 
+    /**
+     * Queue a command on a core's buffer. Only one thread may write to a buffer.
+     * payloadLen is the number of bytes of ac.inst.payload to send with a write.
+     */
+    void writeCommand(size_t core, const ArielCommand& ac, uint32_t payloadLen = 0) {
+        ArielCommandBlock* block = &writeBlocks[core];
+
+        // Keep an instruction and its memory operations in one block so that
+        // the reader never waits for the rest of an instruction
+        uint32_t reserve = packedSize(ac, payloadLen);
+        if (ac.command == ARIEL_START_INSTRUCTION)
+            reserve = ARIEL_MAX_PACKED_INSTRUCTION;
+
+        if (block->used + reserve > sizeof(block->data))
+            flushCommands(core);
+
+        block->used += packCommand(&block->data[block->used], ac, payloadLen);
+        block->count++;
+
+        if (!isStreamCommand(ac.command))
+            flushCommands(core);
+        else if (maxBlockCommands > 0 && block->count >= maxBlockCommands && !isInstructionBody(ac.command))
+            flushCommands(core);
+    }
+
+    /**
+     * Bound the number of commands a partly filled block may hold before it is
+     * handed to the reader, 0 only flushes full blocks. The bound is checked
+     * between instructions so an instruction never straddles two blocks.
+     */
+    void setMaxBlockCommands(uint32_t commands) {
+        maxBlockCommands = commands;
+    }
+
+    /** Hand the commands queued on a core's buffer to the reader */
+    void flushCommands(size_t core) {
+        ArielCommandBlock* block = &writeBlocks[core];
+        if (block->used == 0)
+            return;
+
+        writeMessage(core, *block);
+        block->used = 0;
+        block->count = 0;
+    }
+
+    /** Hand the commands queued on every buffer to the reader */
+    void flushAllCommands() {
+        for (size_t i = 0; i < getNumBuffers(); i++)
+            flushCommands(i);
+    }
+
+    /** Read the next command of a core, returns false if none is available */
+    bool readCommandNB(size_t core, ArielCommand* ac) {
+        if (readOffsets[core] >= readBlocks[core].used) {
+            if (!readMessageNB(core, &readBlocks[core]))
+                return false;
+            readOffsets[core] = 0;
+        }
+
+        readOffsets[core] += unpackCommand(&readBlocks[core].data[readOffsets[core]], ac);
+        return true;
+    }
+
+    /** Read the next command of a core, waiting for it if needed */
+    ArielCommand readCommand(size_t core) {
+        if (readOffsets[core] >= readBlocks[core].used) {
+            readBlocks[core] = readMessage(core);
+            readOffsets[core] = 0;
+        }
+
+        ArielCommand ac;
+        readOffsets[core] += unpackCommand(&readBlocks[core].data[readOffsets[core]], &ac);
+        return ac;
+    }
+
     void waitForChild(void) {
         while ( sharedData->child_attached == 0 ) ;
     }
@@ -253,6 +382,166 @@ public:
         tp->tv_nsec = cTime - (tp->tv_sec * 1e9);
     }
 
+    /** Bytes taken by a packed command, header and padding included */
+    static uint32_t packedSize(const ArielCommand& ac, uint32_t payloadLen) {
+        return sizeof(ArielPackedCommand) + ((packedBodySize(ac, payloadLen) + 7) & ~7u);
+    }
+
+    /** Bytes taken by the packed command starting with header pc */
+    static uint32_t packedSize(const ArielPackedCommand* pc) {
+        uint32_t bodyLen;
+        switch (pc->command) {
+            case ARIEL_PERFORM_WRITE:
+                bodyLen = sizeof(uint64_t) + pc->payloadLen;
+                break;
+            case ARIEL_PERFORM_READ:
+                bodyLen = sizeof(uint64_t);
+                break;
+            case ARIEL_START_INSTRUCTION:
+                bodyLen = 0;
+                break;
+            default:
+                bodyLen = pc->size;
+                break;
+        }
+        return sizeof(ArielPackedCommand) + ((bodyLen + 7) & ~7u);
+    }
+
+    /**
+     * Pack a command at dst, which must have room for packedSize(ac, payloadLen)
+     * bytes. Returns the number of bytes written.
+     * The same encoding is used by the tunnel and by recorded command traces.
+     */
+    static uint32_t packCommand(uint8_t* dst, const ArielCommand& ac, uint32_t payloadLen) {
+        const uint32_t bodyLen = packedBodySize(ac, payloadLen);
+
+        ArielPackedCommand* pc = (ArielPackedCommand*) dst;
+        pc->command = (uint8_t) ac.command;
+        pc->instPtr = ac.instPtr;
+        pc->instClass = 0;
+        pc->simdElemCount = 0;
+        pc->payloadLen = 0;
+
+        uint8_t* body = (uint8_t*) (pc + 1);
+        switch (ac.command) {
+            case ARIEL_PERFORM_WRITE:
+                pc->payloadLen = (uint8_t) (bodyLen - sizeof(uint64_t));
+                memcpy(body + sizeof(uint64_t), ac.inst.payload, pc->payloadLen);
+                // fall through
+            case ARIEL_PERFORM_READ:
+                memcpy(body, &ac.inst.addr, sizeof(uint64_t));
+                // fall through
+            case ARIEL_START_INSTRUCTION:
+                pc->size = ac.inst.size;
+                pc->instClass = (uint8_t) ac.inst.instClass;
+                pc->simdElemCount = (uint8_t) (ac.inst.simdElemCount > 255 ? 255 : ac.inst.simdElemCount);
+                break;
+            default:
+                pc->size = bodyLen;
+                memcpy(body, &ac.inst, bodyLen);
+                break;
+        }
+
+        return sizeof(ArielPackedCommand) + ((bodyLen + 7) & ~7u);
+    }
+
+    /** Unpack the command packed at src. Returns the number of bytes read. */
+    static uint32_t unpackCommand(const uint8_t* src, ArielCommand* ac) {
+        const ArielPackedCommand* pc = (const ArielPackedCommand*) src;
+        const uint8_t* body = (const uint8_t*) (pc + 1);
+        uint32_t bodyLen = 0;
+
+        ac->command = (ArielShmemCmd_t) pc->command;
+        ac->instPtr = pc->instPtr;
+
+        switch (ac->command) {
+            case ARIEL_PERFORM_WRITE:
+                memcpy(ac->inst.payload, body + sizeof(uint64_t), pc->payloadLen);
+                bodyLen += pc->payloadLen;
+                // fall through
+            case ARIEL_PERFORM_READ:
+                memcpy(&ac->inst.addr, body, sizeof(uint64_t));
+                bodyLen += sizeof(uint64_t);
+                // fall through
+            case ARIEL_START_INSTRUCTION:
+                ac->inst.size = pc->size;
+                ac->inst.instClass = pc->instClass;
+                ac->inst.simdElemCount = pc->simdElemCount;
+                break;
+            default:
+                bodyLen = pc->size;
+                memcpy(&ac->inst, body, bodyLen);
+                break;
+        }
+
+        return sizeof(ArielPackedCommand) + ((bodyLen + 7) & ~7u);
+    }
+
+private:
+    /** Commands that open an instruction or belong to its body */
+    static bool isInstructionBody(ArielShmemCmd_t command) {
+        return command == ARIEL_START_INSTRUCTION || command == ARIEL_PERFORM_READ ||
+            command == ARIEL_PERFORM_WRITE;
+    }
+
+    /** Commands that belong to the instruction stream and may wait in a partly filled block */
+    static bool isStreamCommand(ArielShmemCmd_t command) {
+        switch (command) {
+            case ARIEL_START_INSTRUCTION:
+            case ARIEL_END_INSTRUCTION:
+            case ARIEL_PERFORM_READ:
+            case ARIEL_PERFORM_WRITE:
+            case ARIEL_NOOP:
+            case ARIEL_FLUSHLINE_INSTRUCTION:
+            case ARIEL_FENCE_INSTRUCTION:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /** Bytes following the header of a packed command, before padding */
+    static uint32_t packedBodySize(const ArielCommand& ac, uint32_t payloadLen) {
+        switch (ac.command) {
+            case ARIEL_START_INSTRUCTION:
+            case ARIEL_END_INSTRUCTION:
+            case ARIEL_NOOP:
+            case ARIEL_FENCE_INSTRUCTION:
+            case ARIEL_PERFORM_EXIT:
+            case ARIEL_OUTPUT_STATS:
+                return 0;
+            case ARIEL_PERFORM_READ:
+                return sizeof(uint64_t);
+            case ARIEL_PERFORM_WRITE:
+                return sizeof(uint64_t) + (payloadLen < ARIEL_MAX_PAYLOAD_SIZE ? payloadLen : ARIEL_MAX_PAYLOAD_SIZE);
+            case ARIEL_FLUSHLINE_INSTRUCTION:
+                return sizeof(ac.flushline);
+            case ARIEL_ISSUE_TLM_MAP:
+                return sizeof(ac.mlm_map);
+            case ARIEL_ISSUE_TLM_MMAP:
+                return sizeof(ac.mlm_mmap);
+            case ARIEL_ISSUE_TLM_MUNMAP:
+                return sizeof(ac.mlm_munmap);
+            case ARIEL_ISSUE_TLM_FENCE:
+                return sizeof(ac.mlm_fence);
+            case ARIEL_ISSUE_TLM_FREE:
+                return sizeof(ac.mlm_free);
+            case ARIEL_SWITCH_POOL:
+                return sizeof(ac.switchPool);
+            case ARIEL_START_DMA:
+                return sizeof(ac.dma_start);
+            default:
+                // Anything else (e.g., CUDA calls) carries the whole union
+                return sizeof(ArielCommand) - offsetof(ArielCommand, inst);
+        }
+    }
+
+    // Blocks being filled by the writer and drained by the reader, per buffer
+    ArielCommandBlock* writeBlocks;
+    ArielCommandBlock* readBlocks;
+    uint32_t* readOffsets;
+    uint32_t maxBlockCommands;
+
 };
 
 #ifdef HAVE_CUDA
@@ -0,0 +1,137 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "arielcmdtrace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+using namespace SST::ArielComponent;
+
+std::string SST::ArielComponent::getCommandTraceName(const std::string& prefix, uint32_t core) {
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), "-%" PRIu32 ".cmds.gz", core);
+    return prefix + suffix;
+}
+
+ArielCommandTraceWriter::ArielCommandTraceWriter(const std::string& prefix, uint32_t core) :
+    commandCount(0), bufferUsed(0) {
+
+    traceFile = gzopen(getCommandTraceName(prefix, core).c_str(), "wb");
+
+    if(NULL != traceFile) {
+        ArielCommandTraceHeader header;
+        memcpy(header.magic, ARIEL_CMD_TRACE_MAGIC, sizeof(header.magic));
+        header.version = ARIEL_CMD_TRACE_VERSION;
+        header.core = core;
+
+        memcpy(buffer, &header, sizeof(header));
+        bufferUsed = sizeof(header);
+    }
+}
+
+ArielCommandTraceWriter::~ArielCommandTraceWriter() {
+    if(NULL != traceFile) {
+        flush();
+        gzclose(traceFile);
+    }
+}
+
+void ArielCommandTraceWriter::flush() {
+    if(NULL != traceFile && bufferUsed > 0) {
+        gzwrite(traceFile, buffer, bufferUsed);
+    }
+
+    bufferUsed = 0;
+}
+
+ArielCommandTraceReader::ArielCommandTraceReader(const std::string& prefix, uint32_t core) :
+    traceName(getCommandTraceName(prefix, core)), truncated(false), bufferStart(0), bufferEnd(0) {
+
+    traceFile = gzopen(traceName.c_str(), "rb");
+
+    if(NULL == traceFile) {
+        return;
+    }
+
+    gzbuffer(traceFile, 131072);
+
+    // Refuse anything but a command trace recorded by this core
+    ArielCommandTraceHeader header;
+    if(!fill(sizeof(header))) {
+        gzclose(traceFile);
+        traceFile = NULL;
+        return;
+    }
+
+    memcpy(&header, &buffer[bufferStart], sizeof(header));
+    bufferStart += sizeof(header);
+
+    if(0 != memcmp(header.magic, ARIEL_CMD_TRACE_MAGIC, sizeof(header.magic)) ||
+        ARIEL_CMD_TRACE_VERSION != header.version || core != header.core) {
+        gzclose(traceFile);
+        traceFile = NULL;
+    }
+}
+
+ArielCommandTraceReader::~ArielCommandTraceReader() {
+    if(NULL != traceFile) {
+        gzclose(traceFile);
+    }
+}
+
+bool ArielCommandTraceReader::fill(uint32_t needed) {
+    if(bufferEnd - bufferStart >= needed) {
+        return true;
+    }
+
+    // Keep the partial command at the front and decompress behind it
+    memmove(buffer, &buffer[bufferStart], bufferEnd - bufferStart);
+    bufferEnd -= bufferStart;
+    bufferStart = 0;
+
+    while(bufferEnd < needed) {
+        const int count = gzread(traceFile, &buffer[bufferEnd], sizeof(buffer) - bufferEnd);
+        if(count <= 0) {
+            return false;
+        }
+
+        bufferEnd += count;
+    }
+
+    return true;
+}
+
+bool ArielCommandTraceReader::read(ArielCommand* ac, uint32_t* payloadLen) {
+    if(NULL == traceFile || !fill(sizeof(ArielPackedCommand))) {
+        truncated = (bufferEnd != bufferStart);
+        return false;
+    }
+
+    const ArielPackedCommand* pc = (const ArielPackedCommand*) &buffer[bufferStart];
+    const uint32_t length = ArielTunnel::packedSize(pc);
+
+    if(length > sizeof(ArielPackedCommand) + sizeof(ArielCommand) || !fill(length)) {
+        truncated = true;
+        return false;
+    }
+
+    // fill() may have moved the command
+    *payloadLen = ((const ArielPackedCommand*) &buffer[bufferStart])->payloadLen;
+    bufferStart += ArielTunnel::unpackCommand(&buffer[bufferStart], ac);
+    return true;
+}
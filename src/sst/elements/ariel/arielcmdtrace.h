@@ -0,0 +1,113 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_CMD_TRACE
+#define _H_SST_ARIEL_CMD_TRACE
+
+#include <stdint.h>
+
+#include <string>
+
+#include "zlib.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * A command trace holds the commands one core read from the tunnel, in the
+ * order it read them, so that the run can be replayed without Pin. It is a
+ * gzip-compressed ArielCommandTraceHeader followed by the commands in the
+ * packed encoding of the tunnel (see ArielTunnel::packCommand).
+ */
+#define ARIEL_CMD_TRACE_MAGIC "ARIELCMD"
+#define ARIEL_CMD_TRACE_VERSION 1
+
+struct ArielCommandTraceHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t core;
+};
+
+/** Name of the command trace of a core, <prefix>-<core>.cmds.gz */
+std::string getCommandTraceName(const std::string& prefix, uint32_t core);
+
+class ArielCommandTraceWriter {
+
+    public:
+        ArielCommandTraceWriter(const std::string& prefix, uint32_t core);
+        ~ArielCommandTraceWriter();
+
+        bool isOpen() const { return NULL != traceFile; }
+        uint64_t getCommandCount() const { return commandCount; }
+
+        /** Append a command, payloadLen bytes of a write's payload are kept */
+        void write(const ArielCommand& ac, uint32_t payloadLen) {
+            if(bufferUsed + sizeof(ArielPackedCommand) + sizeof(ArielCommand) > sizeof(buffer)) {
+                flush();
+            }
+
+            bufferUsed += ArielTunnel::packCommand(&buffer[bufferUsed], ac, payloadLen);
+            commandCount++;
+        }
+
+        /** Compress and write out the buffered commands */
+        void flush();
+
+    private:
+        // First, so that the packed commands are 8-byte aligned
+        uint8_t buffer[65536];
+        gzFile traceFile;
+        uint64_t commandCount;
+        uint32_t bufferUsed;
+
+};
+
+class ArielCommandTraceReader {
+
+    public:
+        ArielCommandTraceReader(const std::string& prefix, uint32_t core);
+        ~ArielCommandTraceReader();
+
+        /** False if the trace could not be opened or is not a command trace of this core */
+        bool isOpen() const { return NULL != traceFile; }
+        const std::string& getName() const { return traceName; }
+
+        /**
+         * Read the next command, and the length of its write payload.
+         * Returns false at the end of the trace.
+         */
+        bool read(ArielCommand* ac, uint32_t* payloadLen);
+
+        /** True if the trace ended in the middle of a command */
+        bool isTruncated() const { return truncated; }
+
+    private:
+        bool fill(uint32_t needed);
+
+        uint8_t buffer[65536];
+        std::string traceName;
+        gzFile traceFile;
+        bool truncated;
+        uint32_t bufferStart;
+        uint32_t bufferEnd;
+
+};
+
+}
+}
+
+#endif
@@ -34,7 +34,7 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
             Output* out, uint32_t maxIssuePerCyc,
             uint32_t maxQLen, uint64_t cacheLineSz,
             ArielMemoryManager* memMgr, const uint32_t perform_address_checks, Params& params) :
-            ComponentExtension(id), output(out), tunnel(tunnel),
+            ComponentExtension(id), output(out), tunnel(tunnel), frontend(NULL),
 #ifdef HAVE_CUDA
             tunnelR(tunnelR), tunnelD(tunnelD),
 #endif
@@ -55,10 +55,25 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
     memmgr = memMgr;
 
     writePayloads = params.find<int>("writepayloadtrace") == 0 ? false : true;
-    coreQ = new std::queue<ArielEvent*>();
+    coreQ = new ArielEventQueue(maxQLength);
     pendingTransactions = new std::unordered_map<SimpleMem::Request::id_t, SimpleMem::Request*>();
+    pendingTransactions->reserve(maxPendingTransactions);
     pending_transaction_count = 0;
 
+    // A refill adds up to a queue of events, and every pending transaction holds a request
+    for(uint32_t i = 0; i < maxQLength; i++) {
+        freeReadEvents.push_back(new ArielReadEvent(0, 0));
+        freeWriteEvents.push_back(new ArielWriteEvent(0, 0, NULL));
+        freeNoOpEvents.push_back(new ArielNoOpEvent());
+    }
+
+    for(uint32_t i = 0; i < maxPendingTransactions; i++) {
+        freeRequests.push_back(new SimpleMem::Request(SimpleMem::Request::Read, 0, 0));
+    }
+
+    issuedInstructions = 0;
+    issuedNoOps = 0;
+
 #ifdef HAVE_CUDA
     midTransfer = false;
     remainingTransfer = 0;
@@ -120,6 +135,23 @@ ArielCore::ArielCore(ComponentId_t id, ArielTunnel *tunnel,
         traceGen->setCoreID(coreID);
     }
 
+    std::string recordPrefix = params.find<std::string>("recordprefix", "");
+#ifdef HAVE_LIBZ
+    recorder = NULL;
+    if("" != recordPrefix) {
+        recorder = new ArielCommandTraceWriter(recordPrefix, coreID);
+
+        if(!recorder->isOpen()) {
+            output->fatal(CALL_INFO, -1, "Unable to open command trace \"%s\" for recording\n",
+                    getCommandTraceName(recordPrefix, coreID).c_str());
+        }
+    }
+#else
+    if("" != recordPrefix) {
+        output->fatal(CALL_INFO, -1, "Error: recordprefix is set but Ariel was built without zlib, command traces cannot be recorded\n");
+    }
+#endif
+
     currentCycles = 0;
 }
 
@@ -131,12 +163,85 @@ ArielCore::~ArielCore() {
     if(enableTracing && traceGen) {
         delete traceGen;
     }
+
+#ifdef HAVE_LIBZ
+    delete recorder;
+#endif
+
+    for(size_t i = 0; i < freeReadEvents.size(); i++) {
+        delete freeReadEvents[i];
+    }
+
+    for(size_t i = 0; i < freeWriteEvents.size(); i++) {
+        delete freeWriteEvents[i];
+    }
+
+    for(size_t i = 0; i < freeNoOpEvents.size(); i++) {
+        delete freeNoOpEvents[i];
+    }
+
+    for(size_t i = 0; i < freeRequests.size(); i++) {
+        delete freeRequests[i];
+    }
 }
 
 void ArielCore::setCacheLink(SimpleMem* newLink) {
     cacheLink = newLink;
 }
 
+void ArielCore::releaseEvent(ArielEvent* ev) {
+    switch(ev->getEventType()) {
+        case READ_ADDRESS:
+            freeReadEvents.push_back(static_cast<ArielReadEvent*>(ev));
+            break;
+        case WRITE_ADDRESS:
+            freeWriteEvents.push_back(static_cast<ArielWriteEvent*>(ev));
+            break;
+        case NOOP:
+            freeNoOpEvents.push_back(static_cast<ArielNoOpEvent*>(ev));
+            break;
+        default:
+            delete ev;
+            break;
+    }
+}
+
+SimpleMem::Request* ArielCore::createRequest(SimpleMem::Request::Command cmd, uint64_t addr, uint32_t length) {
+    if(freeRequests.empty()) {
+        return new SimpleMem::Request(cmd, addr, length);
+    }
+
+    // A recycled request keeps its id, which is unique among the requests in flight
+    // since it only came back once its response was handled
+    SimpleMem::Request* req = freeRequests.back();
+    freeRequests.pop_back();
+
+    req->cmd = cmd;
+    req->addrs.assign(1, addr);
+    req->size = length;
+    req->data.clear();
+    req->flags = 0;
+    req->memFlags = 0;
+    req->setVirtualAddress(0);
+    return req;
+}
+
+void ArielCore::releaseRequest(SimpleMem::Request* req) {
+    freeRequests.push_back(req);
+}
+
+void ArielCore::flushIssueStatistics() {
+    if(issuedInstructions > 0) {
+        statInstructionCount->addDataNTimes(issuedInstructions, 1);
+        issuedInstructions = 0;
+    }
+
+    if(issuedNoOps > 0) {
+        statNoopCount->addDataNTimes(issuedNoOps, 1);
+        issuedNoOps = 0;
+    }
+}
+
 #ifdef HAVE_CUDA
 void ArielCore::setGpuLink(Link* gpulink) {
 
@@ -159,7 +264,7 @@ void ArielCore::printTraceEntry(const bool isRead,
 void ArielCore::commitReadEvent(const uint64_t address,
             const uint64_t virtAddress, const uint32_t length) {
     if(length > 0) {
-        SimpleMem::Request *req = new SimpleMem::Request(SimpleMem::Request::Read, address, length);
+        SimpleMem::Request *req = createRequest(SimpleMem::Request::Read, address, length);
         req->setVirtualAddress(virtAddress);
 #ifdef HAVE_CUDA
         if(isGpuEx()){
@@ -185,7 +290,7 @@ void ArielCore::commitWriteEvent(const uint64_t address,
         const uint64_t virtAddress, const uint32_t length, const uint8_t* payload) {
 
     if(length > 0) {
-        SimpleMem::Request *req = new SimpleMem::Request(SimpleMem::Request::Write, address, length);
+        SimpleMem::Request *req = createRequest(SimpleMem::Request::Write, address, length);
         req->setVirtualAddress(virtAddress);
 
         if( writePayloads ) {
@@ -233,7 +338,7 @@ void ArielCore::commitFlushEvent(const uint64_t address,
 
     if(length > 0) {
         /*  Todo: should the request specify the physical address, or the virtual address? */
-        SimpleMem::Request *req = new SimpleMem::Request(SimpleMem::Request::FlushLineInv, address, length);
+        SimpleMem::Request *req = createRequest(SimpleMem::Request::FlushLineInv, address, length);
         req->addAddress(address);
         pending_transaction_count++;
         pendingTransactions->insert( std::pair<SimpleMem::Request::id_t, SimpleMem::Request*>(req->id, req) );
@@ -486,7 +591,7 @@ void ArielCore::handleEvent(SimpleMem::Request* event) {
         } else {
                 output->fatal(CALL_INFO, -4, "Memory event response to core: %" PRIu32 " was not found in pending list.\n", coreID);
         }
-    delete event;
+    releaseRequest(event);
 }
 
 bool ArielCore::handleInterrupt(ArielMemoryManager::InterruptAction action) {
@@ -512,6 +617,14 @@ void ArielCore::finishCore() {
         delete traceGen;
         traceGen = NULL;
     }
+
+#ifdef HAVE_LIBZ
+    if(NULL != recorder) {
+        output->verbose(CALL_INFO, 1, 0, "Core %" PRIu32 " recorded %" PRIu64 " commands\n", coreID, recorder->getCommandCount());
+        delete recorder;
+        recorder = NULL;
+    }
+#endif
 }
 
 void ArielCore::halt(){
@@ -631,14 +744,27 @@ void ArielCore::createSwitchPoolEvent(uint32_t newPool) {
 }
 
 void ArielCore::createNoOpEvent() {
-    ArielNoOpEvent* ev = new ArielNoOpEvent();
+    ArielNoOpEvent* ev;
+    if(freeNoOpEvents.empty()) {
+        ev = new ArielNoOpEvent();
+    } else {
+        ev = freeNoOpEvents.back();
+        freeNoOpEvents.pop_back();
+    }
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a No Op event on core %" PRIu32 "\n", coreID));
 }
 
 void ArielCore::createReadEvent(uint64_t address, uint32_t length) {
-    ArielReadEvent* ev = new ArielReadEvent(address, length);
+    ArielReadEvent* ev;
+    if(freeReadEvents.empty()) {
+        ev = new ArielReadEvent(address, length);
+    } else {
+        ev = freeReadEvents.back();
+        freeReadEvents.pop_back();
+        ev->reset(address, length);
+    }
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a READ event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
@@ -668,7 +794,14 @@ void ArielCore::createFreeEvent(uint64_t vAddr) {
 }
 
 void ArielCore::createWriteEvent(uint64_t address, uint32_t length, const uint8_t* payload) {
-    ArielWriteEvent* ev = new ArielWriteEvent(address, length, payload);
+    ArielWriteEvent* ev;
+    if(freeWriteEvents.empty()) {
+        ev = new ArielWriteEvent(address, length, payload);
+    } else {
+        ev = freeWriteEvents.back();
+        freeWriteEvents.pop_back();
+        ev->reset(address, length, payload);
+    }
     coreQ->push(ev);
 
     ARIEL_CORE_VERBOSE(4, output->verbose(CALL_INFO, 4, 0, "Generated a WRITE event, addr=%" PRIu64 ", length=%" PRIu32 "\n", address, length));
@@ -781,6 +914,36 @@ bool ArielCore::hasDrainCompleted() const {
         return false;
 }
 
+bool ArielCore::readCommand(ArielCommand* ac) {
+    bool avail = tunnel->readCommandNB(coreID, ac);
+
+    // Some frontends (e.g., replay) know more commands are coming, wait for them
+    // rather than letting the core idle for a cycle
+    while(!avail && NULL != frontend && frontend->waitForCommands(coreID)) {
+        avail = tunnel->readCommandNB(coreID, ac);
+    }
+
+    if(avail) {
+        recordCommand(*ac);
+    }
+
+    return avail;
+}
+
+void ArielCore::recordCommand(const ArielCommand& ac) {
+#ifdef HAVE_LIBZ
+    if(NULL != recorder) {
+        // The core only uses write payloads when they are traced
+        uint32_t payloadLen = 0;
+        if(writePayloads && ARIEL_PERFORM_WRITE == ac.command) {
+            payloadLen = std::min(ac.inst.size, (uint32_t) ARIEL_MAX_PAYLOAD_SIZE);
+        }
+
+        recorder->write(ac, payloadLen);
+    }
+#endif
+}
+
 bool ArielCore::refillQueue() {
     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Refilling event queue for core %" PRIu32 "...\n", coreID));
 
@@ -789,7 +952,7 @@ bool ArielCore::refillQueue() {
                             coreID, (uint32_t) coreQ->size(), (uint32_t) maxQLength));
 
         ArielCommand ac;
-        const bool avail = tunnel->readMessageNB(coreID, &ac);
+        const bool avail = readCommand(&ac);
 
         if ( !avail ) {
                 ARIEL_CORE_VERBOSE(32, output->verbose(CALL_INFO, 32, 0, "Tunnel claims no data on core: %" PRIu32 "\n", coreID));
@@ -801,6 +964,7 @@ bool ArielCore::refillQueue() {
         // There is data on the pipe
         switch(ac.command) {
             case ARIEL_OUTPUT_STATS:
+                flushIssueStatistics();
                 fprintf(stdout, "Performing statistics output at simulation time = %" PRIu64 " cycles\n", getCurrentSimTimeNano());
                 performGlobalStatisticOutput();
                 break;
@@ -831,7 +995,8 @@ bool ArielCore::refillQueue() {
                 }
 
                 while(ac.command != ARIEL_END_INSTRUCTION) {
-                        ac = tunnel->readMessage(coreID);
+                        ac = tunnel->readCommand(coreID);
+                        recordCommand(ac);
 
                         switch(ac.command) {
                             case ARIEL_PERFORM_READ:
@@ -1336,9 +1501,9 @@ bool ArielCore::processNextEvent() {
     switch(nextEvent->getEventType()) {
         case NOOP:
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is NOOP\n", coreID));
-                statInstructionCount->addData(1);
+                issuedInstructions++;
                 inst_count++;
-                statNoopCount->addData(1);
+                issuedNoOps++;
                 removeEvent = true;
                 break;
 
@@ -1348,10 +1513,10 @@ bool ArielCore::processNextEvent() {
                 //  if(pendingTransactions->size() < maxPendingTransactions) {
                 if(pending_transaction_count < maxPendingTransactions) {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a read event, fewer pending transactions than permitted so will process...\n"));
-                    statInstructionCount->addData(1);
+                    issuedInstructions++;
                     inst_count++;
                     removeEvent = true;
-                    handleReadRequest(dynamic_cast<ArielReadEvent*>(nextEvent));
+                    handleReadRequest(static_cast<ArielReadEvent*>(nextEvent));
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1364,10 +1529,10 @@ bool ArielCore::processNextEvent() {
                 //  if(pendingTransactions->size() < maxPendingTransactions) {
                 if(pending_transaction_count < maxPendingTransactions) {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a write event, fewer pending transactions than permitted so will process...\n"));
-                    statInstructionCount->addData(1);
+                    issuedInstructions++;
                     inst_count++;
                             removeEvent = true;
-                    handleWriteRequest(dynamic_cast<ArielWriteEvent*>(nextEvent));
+                    handleWriteRequest(static_cast<ArielWriteEvent*>(nextEvent));
                 } else {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Pending transaction queue is currently full for core %" PRIu32 ", core will stall for new events\n", coreID));
                     break;
@@ -1419,7 +1584,7 @@ bool ArielCore::processNextEvent() {
                 ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Core %" PRIu32 " next event is a FLUSH\n", coreID));
                 if(pending_transaction_count < maxPendingTransactions) {
                     ARIEL_CORE_VERBOSE(16, output->verbose(CALL_INFO, 16, 0, "Found a FLUSH event, fewer pending transactions than permitted so will process..\n"));
-                    statInstructionCount->addData(1);
+                    issuedInstructions++;
                     inst_count++;
                     handleFlushEvent(dynamic_cast<ArielFlushEvent*>(nextEvent));
                     removeEvent = true;
@@ -1455,7 +1620,7 @@ bool ArielCore::processNextEvent() {
                             (uint32_t) coreQ->size()));
         coreQ->pop();
 
-        delete nextEvent;
+        releaseEvent(nextEvent);
         return true;
     } else {
         ARIEL_CORE_VERBOSE(8, output->verbose(CALL_INFO, 8, 0, "Event removal was not requested, pending transaction queue length=%" PRIu32 ", maximum transactions: %" PRIu32 "\n",
@@ -1475,18 +1640,19 @@ void ArielCore::tick() {
         updateCycle = false;
 
         if(!isStalled) {
-                for(uint32_t i = 0; i < maxIssuePerCycle; ++i) {
-                    bool didProcess = processNextEvent();
-
-                    // If we didnt process anything in the call or we have halted then
-                    // we stop the ticking and return
-                    if( (!didProcess) || isHalted || isStalled ) {
+                // Issue a batch of up to maxIssuePerCycle events, stopping early if we
+                // did not process anything or have halted or stalled
+                uint32_t issued = 0;
+                while(issued < maxIssuePerCycle && processNextEvent()) {
+                    issued++;
+                    started = true;
+
+                    if( isHalted || isStalled ) {
                             break;
                     }
-
-                    if(didProcess)
-                            started = true;
                 }
+
+                flushIssueStatistics();
         }
 
         currentCycles++;
@@ -34,10 +34,12 @@
 
 #include <string>
 #include <queue>
+#include <vector>
 #include <unordered_map>
 
 #include "arielmemmgr.h"
 #include "arielevent.h"
+#include "arieleventqueue.h"
 #include "arielreadev.h"
 #include "arielwriteev.h"
 #include "arielexitev.h"
@@ -49,8 +51,13 @@
 #include "arielswitchpool.h"
 
 #include "ariel_shmem.h"
+#include "arielfrontend.h"
 #include "arieltracegen.h"
 
+#ifdef HAVE_LIBZ
+#include "arielcmdtrace.h"
+#endif
+
 #ifdef HAVE_CUDA
 #include "arielgpuev.h"
 #endif
@@ -136,6 +143,7 @@ class ArielCore : public ComponentExtension {
       }
 
         void setCacheLink(SimpleMem* newCacheLink);
+        void setFrontend(ArielFrontend* newFrontend) { frontend = newFrontend; }
 
 #ifdef HAVE_CUDA
         void createGpuEvent(GpuApi_t API, CudaArguments CA);
@@ -175,6 +183,13 @@ class ArielCore : public ComponentExtension {
     private:
         bool processNextEvent();
         bool refillQueue();
+        bool readCommand(ArielCommand* ac);
+        void recordCommand(const ArielCommand& ac);
+
+        void releaseEvent(ArielEvent* ev);
+        SimpleMem::Request* createRequest(SimpleMem::Request::Command cmd, uint64_t addr, uint32_t length);
+        void releaseRequest(SimpleMem::Request* req);
+        void flushIssueStatistics();
 
         bool writePayloads;
         uint32_t coreID;
@@ -199,13 +214,14 @@ class ArielCore : public ComponentExtension {
 #endif
 
         Output* output;
-        std::queue<ArielEvent*>* coreQ;
+        ArielEventQueue* coreQ;
         bool isStalled;
         bool isHalted;
         bool isFenced;
 
         SimpleMem* cacheLink;
         ArielTunnel *tunnel;
+        ArielFrontend* frontend;
 
 #ifdef HAVE_CUDA
         Link* GpuLink;
@@ -215,6 +231,18 @@ class ArielCore : public ComponentExtension {
 #endif
 
         std::unordered_map<SimpleMem::Request::id_t, SimpleMem::Request*>* pendingTransactions;
+
+        // Events and requests of the frequent memory operations are recycled rather than
+        // allocated for every operation, these hold the ones not currently in use
+        std::vector<ArielReadEvent*> freeReadEvents;
+        std::vector<ArielWriteEvent*> freeWriteEvents;
+        std::vector<ArielNoOpEvent*> freeNoOpEvents;
+        std::vector<SimpleMem::Request*> freeRequests;
+
+        // Instructions issued during the current tick, added to the statistics once per tick
+        uint64_t issuedInstructions;
+        uint64_t issuedNoOps;
+
         uint32_t maxIssuePerCycle;
         uint32_t maxQLength;
         uint64_t cacheLineSize;
@@ -234,6 +262,11 @@ class ArielCore : public ComponentExtension {
 
         ArielTraceGenerator* traceGen;
 
+#ifdef HAVE_LIBZ
+        // Records the commands read from the tunnel, NULL unless recording
+        ArielCommandTraceWriter* recorder;
+#endif
+
         Statistic<uint64_t>* statReadRequests;
         Statistic<uint64_t>* statWriteRequests;
         Statistic<uint64_t>* statFlushRequests;
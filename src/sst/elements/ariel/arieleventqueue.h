@@ -0,0 +1,98 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_ARIEL_EVENT_QUEUE
+#define _H_SST_ARIEL_EVENT_QUEUE
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "arielevent.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/*
+ * FIFO of the events waiting in a core, a ring over a fixed array so that
+ * pushing and popping never allocate. The ring doubles if it fills up,
+ * which only happens when an instruction with several memory operations
+ * is read just below the core's maximum queue length.
+ */
+class ArielEventQueue {
+
+    public:
+        ArielEventQueue(uint32_t minCapacity) : head(0), tail(0) {
+                uint32_t capacity = 1;
+                while(capacity < minCapacity) {
+                        capacity <<= 1;
+                }
+
+                slots.resize(capacity);
+                mask = capacity - 1;
+        }
+
+        bool empty() const {
+                return head == tail;
+        }
+
+        size_t size() const {
+                return tail - head;
+        }
+
+        ArielEvent* front() const {
+                return slots[head & mask];
+        }
+
+        void pop() {
+                head++;
+        }
+
+        void push(ArielEvent* ev) {
+                if(size() == slots.size()) {
+                        grow();
+                }
+
+                slots[tail & mask] = ev;
+                tail++;
+        }
+
+    private:
+        void grow() {
+                std::vector<ArielEvent*> larger(slots.size() * 2);
+                const uint64_t count = size();
+
+                for(uint64_t i = 0; i < count; i++) {
+                        larger[i] = slots[(head + i) & mask];
+                }
+
+                slots.swap(larger);
+                mask = slots.size() - 1;
+                head = 0;
+                tail = count;
+        }
+
+        std::vector<ArielEvent*> slots;
+        uint64_t mask;
+        uint64_t head;
+        uint64_t tail;
+
+};
+
+}
+}
+
+#endif
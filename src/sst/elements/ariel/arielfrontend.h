@@ -58,6 +58,14 @@ public:
     virtual void finish() { }
     virtual void emergencyShutdown() { }
 
+    /**
+     * Called by a core that found its buffer empty. Returns true if more
+     * commands are on their way for it, in which case the core waits for
+     * them instead of idling the cycle. Frontends driven by a live
+     * application never ask the core to wait.
+     */
+    virtual bool waitForCommands(uint32_t core) { return false; }
+
 
 };
 
@@ -46,9 +46,15 @@ class ArielReadEvent : public ArielEvent {
                 return readLength;
         }
 
+        // Reuse a pooled event for a new read
+        void reset(uint64_t rAddr, uint32_t length) {
+                readAddress = rAddr;
+                readLength = length;
+        }
+
     private:
-        const uint64_t readAddress;
-        const uint32_t readLength;
+        uint64_t readAddress;
+        uint32_t readLength;
 
 };
 
@@ -28,7 +28,7 @@ class ArielWriteEvent : public ArielEvent {
 
     public:
         ArielWriteEvent(uint64_t wAddr, uint32_t length, const uint8_t* payloadData) :
-                writeAddress(wAddr), writeLength(length) {
+                writeAddress(wAddr), writeLength(length), payloadCapacity(length) {
 
                 payload = new uint8_t[length];
 
@@ -57,10 +57,27 @@ class ArielWriteEvent : public ArielEvent {
         		return payload;
         }
 
+        // Reuse a pooled event for a new write, the payload buffer only grows
+        void reset(uint64_t wAddr, uint32_t length, const uint8_t* payloadData) {
+                writeAddress = wAddr;
+                writeLength = length;
+
+                if( length > payloadCapacity ) {
+                        delete[] payload;
+                        payload = new uint8_t[length];
+                        payloadCapacity = length;
+                }
+
+                for( uint32_t i = 0; i < length; ++i ) {
+                        payload[i] = payloadData[i];
+                }
+        }
+
     private:
-        const uint64_t writeAddress;
-        const uint32_t writeLength;
-              uint8_t* payload;
+        uint64_t writeAddress;
+        uint32_t writeLength;
+        uint32_t payloadCapacity;
+        uint8_t* payload;
 
 };
 
@@ -0,0 +1,175 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "replayfrontend.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+using namespace SST::ArielComponent;
+
+ReplayFrontend::ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t maxCoreQueueLen, uint32_t defMemPool) :
+            ArielFrontend(id, params, cores, maxCoreQueueLen, defMemPool), streamDone(new std::atomic<bool>[cores]),
+            stopProducers(false), commandsSent(0), emptyAfterDone(cores, false), drained(cores, false), exitSent(false) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("ReplayFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    core_count = cores;
+
+    std::string prefix = params.find<std::string>("prefix", "");
+    if ("" == prefix)
+        output->fatal(CALL_INFO, -1, "%s, Error: prefix must name the command traces to replay\n", getName().c_str());
+
+    for (uint32_t i = 0; i < core_count; i++) {
+        readers.push_back(new ArielCommandTraceReader(prefix, i));
+
+        if (!readers[i]->isOpen())
+            output->fatal(CALL_INFO, -1, "%s, Error: unable to open \"%s\" or it is not a command trace of core %" PRIu32 "\n",
+                    getName().c_str(), readers[i]->getName().c_str(), i);
+
+        streamDone[i] = false;
+    }
+
+    // The tunnel lives in this process, the replay threads write to it directly
+    tunnel = new ArielTunnel(core_count, maxCoreQueueLen);
+    tunnelRegion = calloc(1, tunnel->getTunnelSize());
+    if (NULL == tunnelRegion)
+        output->fatal(CALL_INFO, -1, "%s, Error: unable to allocate %zu bytes for the tunnel\n", getName().c_str(), tunnel->getTunnelSize());
+    tunnel->initialize(tunnelRegion);
+
+    output->verbose(CALL_INFO, 1, 0, "Replay frontend: %" PRIu32 " cores replaying %s-<core>.cmds.gz\n", core_count, prefix.c_str());
+}
+
+ReplayFrontend::~ReplayFrontend() {
+    for (std::vector<std::thread>::iterator it = producers.begin(); it != producers.end(); it++) {
+        if (it->joinable())
+            it->join();
+    }
+
+    for (uint32_t i = 0; i < readers.size(); i++)
+        delete readers[i];
+
+    delete tunnel;
+    free(tunnelRegion);
+}
+
+void ReplayFrontend::setup() {
+    startTime = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < core_count; i++)
+        producers.push_back(std::thread(&ReplayFrontend::replay, this, i));
+}
+
+void ReplayFrontend::replay(uint32_t core) {
+    ArielCommandTraceReader* reader = readers[core];
+    ArielCommand ac;
+    uint32_t payloadLen;
+    bool inInstruction = false;
+    uint64_t sent = 0;
+
+    while (!stopProducers.load(std::memory_order_relaxed) && reader->read(&ac, &payloadLen)) {
+        // The exit is sent once every core is done, see waitForCommands()
+        if (ARIEL_PERFORM_EXIT == ac.command)
+            continue;
+
+        if (ARIEL_START_INSTRUCTION == ac.command)
+            inInstruction = true;
+        else if (ARIEL_END_INSTRUCTION == ac.command)
+            inInstruction = false;
+
+        tunnel->writeCommand(core, ac, payloadLen);
+        sent++;
+    }
+
+    // A truncated trace may stop inside an instruction, the core would wait for its end forever
+    if (inInstruction) {
+        memset(&ac, 0, sizeof(ac));
+        ac.command = ARIEL_END_INSTRUCTION;
+        tunnel->writeCommand(core, ac);
+    }
+
+    tunnel->flushCommands(core);
+    commandsSent += sent;
+    streamDone[core] = true;
+}
+
+bool ReplayFrontend::waitForCommands(uint32_t core) {
+    if (!streamDone[core].load()) {
+        std::this_thread::yield();
+        return true;
+    }
+
+    // The last block may have been handed over just after the core's previous read
+    if (!emptyAfterDone[core]) {
+        emptyAfterDone[core] = true;
+        return true;
+    }
+
+    if (0 == core && !exitSent) {
+        // Like the main thread joining the others, idle until every core has finished
+        for (uint32_t i = 1; i < core_count; i++) {
+            if (!drained[i])
+                return false;
+        }
+
+        ArielCommand ac;
+        memset(&ac, 0, sizeof(ac));
+        ac.command = ARIEL_PERFORM_EXIT;
+        tunnel->writeCommand(0, ac);
+        exitSent = true;
+        return true;
+    }
+
+    drained[core] = true;
+    return false;
+}
+
+void ReplayFrontend::finish() {
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    // The simulation may end before everything was replayed (e.g., max_insts), drain
+    // the buffers so that replay threads waiting for room can see the stop and exit
+    stopProducers = true;
+    ArielCommandBlock block;
+    for (uint32_t i = 0; i < producers.size(); i++) {
+        while (!streamDone[i].load()) {
+            while (tunnel->readMessageNB(i, &block)) ;
+            std::this_thread::yield();
+        }
+    }
+
+    for (uint32_t i = 0; i < readers.size(); i++) {
+        if (readers[i]->isTruncated())
+            output->output("Replay frontend: warning, %s is truncated, its last command was dropped\n", readers[i]->getName().c_str());
+    }
+
+    output->output("Replay frontend: %" PRIu64 " commands replayed in %.3f s (%.3f M commands/s)\n",
+            commandsSent.load(), elapsed, elapsed > 0 ? commandsSent.load() / elapsed / 1e6 : 0.0);
+}
+
+ArielTunnel* ReplayFrontend::getTunnel() {
+    return tunnel;
+}
+
+void ReplayFrontend::emergencyShutdown() {
+    // Replay threads blocked on a full buffer will never be drained
+    stopProducers = true;
+    for (std::vector<std::thread>::iterator it = producers.begin(); it != producers.end(); it++)
+        it->detach();
+    producers.clear();
+}
@@ -0,0 +1,96 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_REPLAY_FRONTEND
+#define _H_REPLAY_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/component.h>
+#include <sst/core/params.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "arielfrontend.h"
+#include "arielcmdtrace.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/** Replays the command traces recorded by the cores of an earlier run
+ * (see the ariel "recordprefix" parameter) without Pin. One thread per
+ * core decodes its trace into an in-process tunnel ahead of the core.
+ *
+ * Replay is deterministic: a core never idles for a command that is
+ * still being decoded, and core 0 only exits once every other core has
+ * consumed its whole trace, as the application's main thread joining its
+ * workers would.
+ */
+class ReplayFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(ReplayFrontend, "ariel", "frontend.replay", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend replaying recorded command traces, without Pin", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"prefix", "Prefix of the command traces, the recordprefix of the recording run. Core n replays <prefix>-<n>.cmds.gz", ""})
+
+        ReplayFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+        ~ReplayFrontend();
+        virtual void emergencyShutdown();
+        virtual void init(unsigned int phase) { }
+        virtual void setup();
+        virtual void finish();
+        virtual ArielTunnel* getTunnel();
+        virtual bool waitForCommands(uint32_t core);
+
+    private:
+
+        void replay(uint32_t core);
+
+        SST::Output* output;
+
+        uint32_t core_count;
+        ArielTunnel* tunnel;
+        void* tunnelRegion;
+
+        std::vector<ArielCommandTraceReader*> readers;
+        std::vector<std::thread> producers;
+
+        // Set by a producer once its whole trace is in the tunnel
+        std::unique_ptr<std::atomic<bool>[]> streamDone;
+        std::atomic<bool> stopProducers;
+        std::atomic<uint64_t> commandsSent;
+
+        // Simulation thread only: cores that read an empty buffer after their trace was done
+        std::vector<bool> emptyAfterDone;
+        std::vector<bool> drained;
+        bool exitSent;
+
+        std::chrono::steady_clock::time_point startTime;
+};
+
+}
+}
+
+#endif
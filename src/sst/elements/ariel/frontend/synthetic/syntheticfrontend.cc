@@ -0,0 +1,152 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include <sst_config.h>
+
+#include "syntheticfrontend.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+using namespace SST::ArielComponent;
+
+SyntheticFrontend::SyntheticFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t maxCoreQueueLen, uint32_t defMemPool) :
+            ArielFrontend(id, params, cores, maxCoreQueueLen, defMemPool), producersDone(0), producersExited(0), stopProducers(false), commandsSent(0) {
+
+    int verbosity = params.find<int>("verbose", 0);
+    output = new SST::Output("SyntheticFrontend[@f:@l:@p] ", verbosity, 0, SST::Output::STDOUT);
+
+    core_count = cores;
+
+    instructions = params.find<uint64_t>("instructions", 10000000);
+    writeEvery = params.find<uint64_t>("writeevery", 3);
+    stride = params.find<uint64_t>("stride", 64);
+    footprint = params.find<uint64_t>("footprint", 1048576);
+    accessSize = params.find<uint32_t>("accesssize", 8);
+    writePayload = params.find<bool>("writepayload", false);
+
+    if (footprint == 0 || accessSize == 0 || accessSize > footprint)
+        output->fatal(CALL_INFO, -1, "%s, Error: footprint and accesssize must be non-zero and accesssize at most footprint\n", getName().c_str());
+
+    // The tunnel lives in this process, the producer threads write to it directly
+    tunnel = new ArielTunnel(core_count, maxCoreQueueLen);
+    tunnelRegion = calloc(1, tunnel->getTunnelSize());
+    if (NULL == tunnelRegion)
+        output->fatal(CALL_INFO, -1, "%s, Error: unable to allocate %zu bytes for the tunnel\n", getName().c_str(), tunnel->getTunnelSize());
+    tunnel->initialize(tunnelRegion);
+
+    output->verbose(CALL_INFO, 1, 0, "Synthetic frontend: %" PRIu32 " cores, %" PRIu64 " instructions per core, tunnel of %zu bytes\n",
+            core_count, instructions, tunnel->getTunnelSize());
+}
+
+SyntheticFrontend::~SyntheticFrontend() {
+    for (std::vector<std::thread>::iterator it = producers.begin(); it != producers.end(); it++) {
+        if (it->joinable())
+            it->join();
+    }
+
+    delete tunnel;
+    free(tunnelRegion);
+}
+
+void SyntheticFrontend::setup() {
+    startTime = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < core_count; i++)
+        producers.push_back(std::thread(&SyntheticFrontend::produce, this, i));
+}
+
+void SyntheticFrontend::produce(uint32_t core) {
+    ArielCommand ac;
+    memset(&ac, 0, sizeof(ac));
+
+    const uint64_t base = (uint64_t) core * footprint;
+    const uint64_t span = footprint - accessSize + 1;
+    uint64_t offset = 0;
+    uint64_t sent = 0;
+
+    for (uint64_t i = 0; i < instructions && !stopProducers.load(std::memory_order_relaxed); i++) {
+        ac.instPtr = 0x400000 + ((i & 0xff) << 2);
+        ac.inst.instClass = ARIEL_INST_INT;
+        ac.inst.simdElemCount = 1;
+        ac.inst.size = accessSize;
+
+        ac.command = ARIEL_START_INSTRUCTION;
+        tunnel->writeCommand(core, ac);
+
+        ac.command = ARIEL_PERFORM_READ;
+        ac.inst.addr = base + offset;
+        tunnel->writeCommand(core, ac);
+        sent += 2;
+
+        if (writeEvery != 0 && (i % writeEvery) == 0) {
+            ac.command = ARIEL_PERFORM_WRITE;
+            tunnel->writeCommand(core, ac, writePayload ? accessSize : 0);
+            sent++;
+        }
+
+        ac.command = ARIEL_END_INSTRUCTION;
+        tunnel->writeCommand(core, ac);
+        sent++;
+
+        offset = (offset + stride) % span;
+    }
+
+    tunnel->flushCommands(core);
+    commandsSent += sent;
+    producersDone++;
+
+    // Core 0 ends the simulation once every core has been fed, as the Pin tool does at exit
+    if (core == 0) {
+        while (producersDone.load() != core_count && !stopProducers.load())
+            std::this_thread::yield();
+
+        ac.command = ARIEL_PERFORM_EXIT;
+        ac.instPtr = 0;
+        tunnel->writeCommand(0, ac);
+    }
+
+    producersExited++;
+}
+
+void SyntheticFrontend::finish() {
+    const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    // The simulation may end before everything was consumed (e.g., max_insts), drain
+    // the buffers so that producers waiting for room can see the stop and exit
+    stopProducers = true;
+    ArielCommandBlock block;
+    while (producersExited.load() != producers.size()) {
+        for (uint32_t i = 0; i < core_count; i++) {
+            while (tunnel->readMessageNB(i, &block)) ;
+        }
+        std::this_thread::yield();
+    }
+
+    output->output("Synthetic frontend: %" PRIu64 " commands in %.3f s (%.3f M commands/s)\n",
+            commandsSent.load(), elapsed, elapsed > 0 ? commandsSent.load() / elapsed / 1e6 : 0.0);
+}
+
+ArielTunnel* SyntheticFrontend::getTunnel() {
+    return tunnel;
+}
+
+void SyntheticFrontend::emergencyShutdown() {
+    // Producers blocked on a full buffer will never be drained
+    stopProducers = true;
+    for (std::vector<std::thread>::iterator it = producers.begin(); it != producers.end(); it++)
+        it->detach();
+    producers.clear();
+}
@@ -0,0 +1,92 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_SYNTHETIC_FRONTEND
+#define _H_SYNTHETIC_FRONTEND
+
+#include <sst/core/sst_config.h>
+#include <sst/core/component.h>
+#include <sst/core/params.h>
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "arielfrontend.h"
+#include "ariel_shmem.h"
+
+namespace SST {
+namespace ArielComponent {
+
+/** Feeds Ariel from producer threads generating a synthetic
+ * instruction stream, one thread per core, through an in-process
+ * tunnel. Used to measure how fast commands move through the tunnel
+ * and into the cores without running Pin.
+ */
+class SyntheticFrontend : public ArielFrontend {
+    public:
+
+    /* SST ELI */
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(SyntheticFrontend, "ariel", "frontend.synthetic", SST_ELI_ELEMENT_VERSION(1,0,0), "Ariel frontend generating a synthetic instruction stream, for tunnel throughput measurements", SST::ArielComponent::ArielFrontend)
+
+    SST_ELI_DOCUMENT_PARAMS(
+        {"verbose", "Verbosity for debugging. Increased numbers for increased verbosity.", "0"},
+        {"instructions", "Number of instructions generated per core", "10000000"},
+        {"writeevery", "Every n-th instruction also writes, 0 = reads only", "3"},
+        {"stride", "Stride in bytes between consecutive accesses of a core", "64"},
+        {"footprint", "Bytes accessed by each core before wrapping around", "1048576"},
+        {"accesssize", "Size in bytes of each access", "8"},
+        {"writepayload", "Send write payloads through the tunnel", "0"})
+
+        SyntheticFrontend(ComponentId_t id, Params& params, uint32_t cores, uint32_t qSize, uint32_t memPool);
+        ~SyntheticFrontend();
+        virtual void emergencyShutdown();
+        virtual void init(unsigned int phase) { }
+        virtual void setup();
+        virtual void finish();
+        virtual ArielTunnel* getTunnel();
+
+    private:
+
+        void produce(uint32_t core);
+
+        SST::Output* output;
+
+        uint32_t core_count;
+        ArielTunnel* tunnel;
+        void* tunnelRegion;
+
+        uint64_t instructions;
+        uint64_t writeEvery;
+        uint64_t stride;
+        uint64_t footprint;
+        uint32_t accessSize;
+        bool writePayload;
+
+        std::vector<std::thread> producers;
+        std::atomic<uint32_t> producersDone;
+        std::atomic<uint32_t> producersExited;
+        std::atomic<bool> stopProducers;
+        std::atomic<uint64_t> commandsSent;
+        std::chrono::steady_clock::time_point startTime;
+};
+
+}
+}
+
+#endif
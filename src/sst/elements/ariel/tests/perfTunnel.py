@@ -0,0 +1,72 @@
+# Throughput check for the Ariel tunnel
+# The synthetic frontend feeds every core from a producer thread, without Pin,
+# and reports the commands moved per second when the simulation ends, e.g.,
+#   sst perfTunnel.py
+#   sst perfTunnel.py 8               (8 cores)
+#   sst perfTunnel.py 8 1             (8 cores, with write payloads)
+import sys
+import sst
+
+sst.setProgramOption("timebase", "1ps")
+
+corecount = 1
+if len(sys.argv) > 1:
+    corecount = int(sys.argv[1])
+
+payload = 0
+if len(sys.argv) > 2:
+    payload = int(sys.argv[2])
+
+ariel = sst.Component("a0", "ariel.ariel")
+ariel.addParams({
+        "verbose" : "0",
+        "corecount" : corecount,
+        "maxcorequeue" : "256",
+        "maxissuepercycle" : "2",
+        "pipetimeout" : "0",
+        "writepayloadtrace" : payload,
+})
+
+memmgr = ariel.setSubComponent("memmgr", "ariel.MemoryManagerSimple")
+
+frontend = ariel.setSubComponent("frontend", "ariel.frontend.synthetic")
+frontend.addParams({
+        "instructions" : 2000000,
+        "writeevery" : 3,
+        "stride" : 64,
+        "footprint" : 1048576,
+        "accesssize" : 8,
+        "writepayload" : payload,
+})
+
+# Each core gets a private L1 and memory so that the memory system stays out of the way
+for core in range(corecount):
+    l1cache = sst.Component("l1cache_" + str(core), "memHierarchy.Cache")
+    l1cache.addParams({
+            "cache_frequency" : "2 Ghz",
+            "cache_size" : "64 KB",
+            "coherence_protocol" : "MSI",
+            "replacement_policy" : "lru",
+            "associativity" : "8",
+            "access_latency_cycles" : "1",
+            "cache_line_size" : "64",
+            "L1" : "1",
+    })
+
+    memctrl = sst.Component("memory_" + str(core), "memHierarchy.MemController")
+    memctrl.addParams({
+            "clock" : "1GHz",
+            "addr_range_start" : 0,
+    })
+
+    memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({
+            "access_time" : "10ns",
+            "mem_size" : "2048MiB",
+    })
+
+    cpu_cache_link = sst.Link("cpu_cache_link_" + str(core))
+    cpu_cache_link.connect( (ariel, "cache_link_" + str(core), "50ps"), (l1cache, "high_network_0", "50ps") )
+
+    memory_link = sst.Link("mem_bus_link_" + str(core))
+    memory_link.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
@@ -0,0 +1,85 @@
+# Record and replay of the commands fed to the Ariel cores
+# A recording run writes the commands each core reads to <prefix>-<core>.cmds.gz,
+# a replay run feeds them back without the application (or Pin), e.g.,
+#   sst recordReplay.py record            (records the synthetic frontend)
+#   sst recordReplay.py replay            (replays the recording)
+#   sst recordReplay.py replay 256KiB     (replays against a different L1)
+# Any frontend can be recorded, e.g., the Pin frontend running a real application.
+import sys
+import sst
+
+sst.setProgramOption("timebase", "1ps")
+
+mode = "record"
+if len(sys.argv) > 1:
+    mode = sys.argv[1]
+
+l1size = "64KiB"
+if len(sys.argv) > 2:
+    l1size = sys.argv[2]
+
+corecount = 2
+prefix = "ariel-replay"
+
+ariel = sst.Component("a0", "ariel.ariel")
+ariel.addParams({
+        "verbose" : "1",
+        "corecount" : corecount,
+        "maxcorequeue" : "256",
+        "maxissuepercycle" : "2",
+        "pipetimeout" : "0",
+})
+
+memmgr = ariel.setSubComponent("memmgr", "ariel.MemoryManagerSimple")
+
+if mode == "record":
+    ariel.addParams({ "recordprefix" : prefix })
+
+    frontend = ariel.setSubComponent("frontend", "ariel.frontend.synthetic")
+    frontend.addParams({
+            "instructions" : 200000,
+            "writeevery" : 3,
+            "stride" : 64,
+            "footprint" : 1048576,
+    })
+elif mode == "replay":
+    frontend = ariel.setSubComponent("frontend", "ariel.frontend.replay")
+    frontend.addParams({ "prefix" : prefix })
+else:
+    sys.exit("mode must be 'record' or 'replay'")
+
+for core in range(corecount):
+    l1cache = sst.Component("l1cache_" + str(core), "memHierarchy.Cache")
+    l1cache.addParams({
+            "cache_frequency" : "2 Ghz",
+            "cache_size" : l1size,
+            "coherence_protocol" : "MSI",
+            "replacement_policy" : "lru",
+            "associativity" : "8",
+            "access_latency_cycles" : "1",
+            "cache_line_size" : "64",
+            "L1" : "1",
+    })
+
+    memctrl = sst.Component("memory_" + str(core), "memHierarchy.MemController")
+    memctrl.addParams({
+            "clock" : "1GHz",
+            "addr_range_start" : 0,
+    })
+
+    memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+    memory.addParams({
+            "access_time" : "10ns",
+            "mem_size" : "2048MiB",
+    })
+
+    cpu_cache_link = sst.Link("cpu_cache_link_" + str(core))
+    cpu_cache_link.connect( (ariel, "cache_link_" + str(core), "50ps"), (l1cache, "high_network_0", "50ps") )
+
+    memory_link = sst.Link("mem_bus_link_" + str(core))
+    memory_link.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
+
+# Each core has its own memory, statistics show the effect of the L1 size
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+ariel.enableAllStatistics()
@@ -3,6 +3,7 @@
 from sst_unittest import *
 from sst_unittest_support import *
 import os
+import re
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -74,8 +75,59 @@ class testcase_Ariel(SSTTestCase):
     def test_Ariel_test_snb(self):
         self.ariel_Template("ariel_snb", use_openmp_bin=True, use_memh=False)
 
+    # The synthetic and replay frontends run without PIN
+    libz_missing = not sst_elements_config_include_file_get_value_int("HAVE_LIBZ", default=0, disable_warning=True)
+
+    def test_Ariel_perfTunnel(self):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName = "test_Ariel_perfTunnel"
+        sdlfile = "{0}/perfTunnel.py".format(test_path)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args='--model-options "2 1"')
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        grep_result = os.system(cmd) != 0
+        self.assertTrue(grep_result, "Output file {0} contains the word 'FATAL'...".format(outfile))
+
+    @unittest.skipIf(libz_missing, "Ariel: Record and replay requires zlib")
+    def test_Ariel_recordReplay(self):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        testDataFileName = "test_Ariel_recordReplay"
+        sdlfile = "{0}/recordReplay.py".format(test_path)
+
+        # Both runs share the cwd, the recording is written to and read from it
+        counts = {}
+        for mode in ("record", "replay"):
+            outfile = "{0}/{1}_{2}.out".format(outdir, testDataFileName, mode)
+            errfile = "{0}/{1}_{2}.err".format(outdir, testDataFileName, mode)
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=tmpdir, other_args='--model-options "{0}"'.format(mode))
+            counts[mode] = self._get_ariel_command_counts(outfile)
+
+        self.assertTrue(len(counts["record"]) > 0, "Recording run reported no Ariel statistics")
+        self.assertEqual(counts["record"], counts["replay"],
+                         "Replay command counts differ from the recording")
+
 #####
 
+    def _get_ariel_command_counts(self, outfile):
+        # Sums of the per-core command statistics, cycle counts depend on timing and are left out
+        counts = {}
+        stat_re = re.compile(r"^\s*(a0\.\S+) : Accumulator : Sum\.u64 = (\d+);")
+        with open(outfile) as fp:
+            for line in fp:
+                match = stat_re.match(line)
+                if match and "cycles" not in match.group(1):
+                    counts[match.group(1)] = int(match.group(2))
+        return counts
+
+
     def ariel_Template(self, testcase, use_openmp_bin=False, use_memh=False, testtimeout=480):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
@@ -0,0 +1,263 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#include "sst_config.h"
+#include "rptprefetch.h"
+
+#include <vector>
+
+#include "stdlib.h"
+
+#include "sst/core/params.h"
+
+using namespace SST;
+using namespace SST::Cassini;
+
+void RPTPrefetcher::notifyAccess(const CacheListenerNotification& notify)
+{
+    const NotifyAccessType notifyType = notify.getAccessType();
+
+    if (notifyType != READ && notifyType != WRITE)
+        return;
+
+    const NotifyResultType notifyResType = notify.getResultType();
+    const Addr addr = notify.getPhysicalAddress();
+    const Addr ip = notify.getInstructionPointer();
+
+    notifyResType == MISS ? missEventsProcessed++ : hitEventsProcessed++;
+    accessCount++;
+
+    // Instruction pointers and regions get separate keys so that the two never alias
+    const uint64_t key = (indexByPC && ip != 0) ? ((ip << 1) | 1) : ((addr / regionSize) << 1);
+
+    RPTEntry* entry;
+    if( !lookup(key, entry) )
+    {
+        entry->lastAddress = addr;
+        entry->stride = 0;
+        entry->state = RPT_INITIAL;
+        return;
+    }
+
+    // Update the entry following the state machine of the reference prediction table: the stride is only
+    // replaced when the entry is not steady, and two correct predictions in a row are needed to become steady
+    const int64_t tempStride = (int64_t) (addr - entry->lastAddress);
+    const bool correct = (tempStride == entry->stride);
+
+    switch( entry->state )
+    {
+        case RPT_INITIAL:
+            if( correct )
+                entry->state = RPT_STEADY;
+            else
+            {
+                entry->state = RPT_TRANSIENT;
+                entry->stride = tempStride;
+            }
+            break;
+        case RPT_TRANSIENT:
+            if( correct )
+                entry->state = RPT_STEADY;
+            else
+            {
+                entry->state = RPT_NO_PRED;
+                entry->stride = tempStride;
+            }
+            break;
+        case RPT_STEADY:
+            if( !correct )
+                entry->state = RPT_INITIAL;
+            break;
+        case RPT_NO_PRED:
+            if( correct )
+                entry->state = RPT_TRANSIENT;
+            else
+                entry->stride = tempStride;
+            break;
+    }
+
+    entry->lastAddress = addr;
+
+    if( entry->state == RPT_STEADY && entry->stride != 0 )
+        DispatchRequest(addr, entry->stride);
+}
+
+bool RPTPrefetcher::lookup(uint64_t key, RPTEntry*& entry)
+{
+    RPTEntry* set = &table[(hash(key) >> 32) % tableSets * tableAssoc];
+    RPTEntry* victim = set;
+
+    for( uint32_t i = 0; i < tableAssoc; i++ )
+    {
+        if( set[i].valid && set[i].tag == key )
+        {
+            set[i].lastUse = accessCount;
+            entry = &set[i];
+            return true;
+        }
+
+        if( !set[i].valid )
+            victim = &set[i];
+        else if( victim->valid && set[i].lastUse < victim->lastUse )
+            victim = &set[i];
+    }
+
+    victim->valid = true;
+    victim->tag = key;
+    victim->lastUse = accessCount;
+    entry = victim;
+    return false;
+}
+
+void RPTPrefetcher::DispatchRequest(Addr targetAddress, int64_t stride)
+{
+    const Addr targetLine = targetAddress - (targetAddress % blockSize);
+    const Addr targetAddressPhysPage = targetAddress / pageSize;
+
+    for( uint32_t i = 0; i < prefetchDegree; i++ )
+    {
+        const int64_t offset = stride * (int64_t) (prefetchDistance + i);
+
+        // Do not run below address zero
+        if( offset < 0 && (Addr) (-offset) > targetAddress )
+            break;
+
+        Addr targetPrefetchAddress = targetAddress + offset;
+        targetPrefetchAddress = targetPrefetchAddress - (targetPrefetchAddress % blockSize);
+
+        // Strides smaller than a cache line can land on the line being accessed
+        if( targetPrefetchAddress == targetLine )
+            continue;
+
+        if( !overrunPageBoundary && (targetPrefetchAddress / pageSize) != targetAddressPhysPage )
+        {
+            output->verbose(CALL_INFO, 2, 0, "Cancel prefetch issue, request exceeds physical page limit\n");
+            output->verbose(CALL_INFO, 4, 0, "Target address: %" PRIx64 ", page=%" PRIx64 ", Prefetch address: %" PRIx64 ", page=%" PRIx64 "\n", targetAddress,
+                            targetAddressPhysPage, targetPrefetchAddress, targetPrefetchAddress / pageSize);
+
+            // Prefetches further along the stride are past the boundary too
+            statPrefetchIssueCanceledByPageBoundary->addData(1);
+            break;
+        }
+
+        output->verbose(CALL_INFO, 2, 0, "Issue prefetch, target address: %" PRIx64 ", prefetch address: %" PRIx64 " (stride=%" PRId64 ", distance=%" PRIu32 ")\n",
+                        targetAddress, targetPrefetchAddress, stride, prefetchDistance + i);
+
+        statPrefetchOpportunities->addData(1);
+        IssuePrefetch(targetPrefetchAddress);
+    }
+}
+
+void RPTPrefetcher::IssuePrefetch(Addr prefetchAddress)
+{
+    // A slot holds the last line prefetched among the lines hashing to it, so a repeated prefetch is
+    // caught unless another line evicted it in between
+    uint64_t& filterEntry = prefetchFilter[(hash(prefetchAddress / blockSize) >> 32) % prefetchFilter.size()];
+
+    if( filterEntry == prefetchAddress + 1 )
+    {
+        statPrefetchIssueCanceledByHistory->addData(1);
+        output->verbose(CALL_INFO, 2, 0, "Prefetch canceled - same cache line is found in the recent prefetch history.\n");
+        return;
+    }
+
+    filterEntry = prefetchAddress + 1;
+    statPrefetchEventsIssued->addData(1);
+
+    assert((prefetchAddress % blockSize) == 0);
+
+    // Cycle over each registered call back and notify them that we want to issue a prefetch request
+    for(std::vector<Event::HandlerBase*>::iterator callbackItr = registeredCallbacks.begin(); callbackItr != registeredCallbacks.end(); callbackItr++)
+    {
+        // Create a new read request, we cannot issue a write because the data will get
+        // overwritten and corrupt memory (even if we really do want to do a write)
+        MemEvent* newEv = new MemEvent(getName(), prefetchAddress, prefetchAddress, Command::GetS);
+        newEv->setSize(blockSize);
+        newEv->setPrefetchFlag(true);
+
+        (*(*callbackItr))(newEv);
+    }
+}
+
+
+RPTPrefetcher::RPTPrefetcher(ComponentId_t id, Params& params) : CacheListener(id, params)
+{
+    Simulation::getSimulation()->requireEvent("memHierarchy.MemEvent");
+
+    verbosity = params.find<int>("verbose", 0);
+
+    char* new_prefix = (char*) malloc(sizeof(char) * 128);
+    sprintf(new_prefix, "RPTPrefetcher[%s | @f:@p:@l] ", getName().c_str());
+    output = new Output(new_prefix, verbosity, 0, Output::STDOUT);
+    free(new_prefix);
+
+    blockSize = params.find<uint64_t>("cache_line_size", 64);
+    pageSize = params.find<uint64_t>("page_size", 4096);
+    regionSize = params.find<uint64_t>("region_size", 4096);
+
+    uint32_t tableSize = params.find<uint32_t>("table_size", 256);
+    tableAssoc = params.find<uint32_t>("table_assoc", 4);
+    prefetchDegree = params.find<uint32_t>("degree", 1);
+    prefetchDistance = params.find<uint32_t>("distance", 2);
+    uint32_t filterSize = params.find<uint32_t>("history", 64);
+
+    std::string indexBy = params.find<std::string>("index_by", "pc");
+    if( indexBy == "pc" )
+        indexByPC = true;
+    else if( indexBy == "region" )
+        indexByPC = false;
+    else
+        output->fatal(CALL_INFO, -1, "%s, Error: index_by must be 'pc' or 'region', got '%s'\n", getName().c_str(), indexBy.c_str());
+
+    if( blockSize == 0 || pageSize == 0 )
+        output->fatal(CALL_INFO, -1, "%s, Error: cache_line_size and page_size must be non-zero\n", getName().c_str());
+
+    if( tableAssoc == 0 || tableSize < tableAssoc || regionSize == 0 || filterSize == 0 )
+        output->fatal(CALL_INFO, -1, "%s, Error: table_size must be at least table_assoc, and table_assoc, region_size and history must be non-zero\n", getName().c_str());
+
+    uint32_t overrunPB = params.find<uint32_t>("overrun_page_boundaries", 0);
+    overrunPageBoundary = (overrunPB == 0) ? false : true;
+
+    tableSets = tableSize / tableAssoc;
+    RPTEntry invalidEntry = { 0, 0, 0, 0, RPT_INITIAL, false };
+    table.assign(tableSets * tableAssoc, invalidEntry);
+    prefetchFilter.assign(filterSize, 0);
+
+    output->verbose(CALL_INFO, 1, 0, "RPTPrefetcher created, cache line: %" PRIu64 ", page size: %" PRIu64 ", table: %" PRIu32 " sets x %" PRIu32 " ways\n",
+            blockSize, pageSize, tableSets, tableAssoc);
+
+    accessCount = 0;
+    missEventsProcessed = 0;
+    hitEventsProcessed = 0;
+
+    statPrefetchOpportunities = registerStatistic<uint64_t>("prefetch_opportunities");
+    statPrefetchEventsIssued = registerStatistic<uint64_t>("prefetches_issued");
+    statPrefetchIssueCanceledByPageBoundary = registerStatistic<uint64_t>("prefetches_canceled_by_page_boundary");
+    statPrefetchIssueCanceledByHistory = registerStatistic<uint64_t>("prefetches_canceled_by_history");
+}
+
+RPTPrefetcher::~RPTPrefetcher()
+{
+    delete output;
+}
+
+void RPTPrefetcher::registerResponseCallback(Event::HandlerBase* handler)
+{
+    registeredCallbacks.push_back(handler);
+}
+
+void RPTPrefetcher::printStats(Output &out)
+{
+}
@@ -0,0 +1,139 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// Reference prediction table prefetcher, after Chen and Baer. The table is indexed by the instruction
+/// pointer of the access (or by the address region, when the CPU does not supply instruction pointers or
+/// index_by is "region") and each entry holds the previous address, the stride and a small state machine.
+/// Once the same stride is seen twice in a row the entry is steady and each access issues degree
+/// prefetches, starting distance strides ahead. Recently issued prefetches are filtered with a small
+/// direct-mapped table of cache lines. The table is set associative with LRU replacement, so each
+/// notification does a constant amount of work.
+///
+/// T.-F. Chen and J.-L. Baer. 1995. Effective hardware-based data prefetching for high-performance
+/// processors. IEEE Transactions on Computers 44, 5 (May 1995), 609-623. DOI=http://dx.doi.org/10.1109/12.381947
+/////////////////////////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _H_SST_RPT_PREFETCH
+#define _H_SST_RPT_PREFETCH
+
+#include <vector>
+
+#include <sst/core/event.h>
+#include <sst/core/sst_types.h>
+#include <sst/core/component.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+#include <sst/elements/memHierarchy/memEvent.h>
+#include <sst/elements/memHierarchy/cacheListener.h>
+
+#include <sst/core/output.h>
+
+using namespace SST;
+using namespace SST::MemHierarchy;
+using namespace std;
+
+namespace SST {
+namespace Cassini {
+
+enum RPTState { RPT_INITIAL, RPT_TRANSIENT, RPT_STEADY, RPT_NO_PRED };
+
+struct RPTEntry
+{
+    uint64_t tag;
+    uint64_t lastAddress;
+    int64_t  stride;
+    uint64_t lastUse;
+    RPTState state;
+    bool     valid;
+};
+
+class RPTPrefetcher : public SST::MemHierarchy::CacheListener
+{
+public:
+    RPTPrefetcher(ComponentId_t id, Params& params);
+    ~RPTPrefetcher();
+
+    void notifyAccess(const CacheListenerNotification& notify);
+    void registerResponseCallback(Event::HandlerBase *handler);
+    void printStats(Output &out);
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        RPTPrefetcher,
+            "cassini",
+            "RPTPrefetcher",
+            SST_ELI_ELEMENT_VERSION(1,0,0),
+            "Reference Prediction Table Stride Prefetcher [Chen 1995]",
+            SST::MemHierarchy::CacheListener
+    )
+
+    SST_ELI_DOCUMENT_PARAMS(
+        { "verbose",                     "Controls the verbosity of the cassini components", "0"},
+            { "cache_line_size",             "Controls the cache line size of the cache the prefetcher is attached too", "64"},
+            { "table_size",                  "Number of entries in the reference prediction table", "256"},
+            { "table_assoc",                 "Associativity of the reference prediction table", "4"},
+            { "index_by",                    "Index the table by the instruction pointer (pc) or by the address region (region). pc falls back to region for accesses without an instruction pointer", "pc"},
+            { "region_size",                 "Size in bytes of the address regions used to index the table", "4096"},
+            { "degree",                      "Number of prefetches issued for each access to a steady entry", "1"},
+            { "distance",                    "How many strides ahead of the access the first prefetch is", "2"},
+            { "history",                     "Number of entries in the filter of recently issued prefetches", "64"},
+            { "page_size",                   "Page size for this controller", "4096"},
+            { "overrun_page_boundaries",     "Allow prefetcher to run over page alignment boundaries, default is 0 (false)", "0"}
+    )
+
+    SST_ELI_DOCUMENT_STATISTICS(
+        { "prefetches_issued",			  "Counts number of prefetches issued",	"prefetches", 1 },
+        { "prefetches_canceled_by_page_boundary", "Counts number of prefetches which spanned over page boundaries and so did not issue", "prefetches", 1 },
+        { "prefetches_canceled_by_history",       "Counts number of prefetches which did not get issued because of prefetch history", "prefetches", 1 },
+        { "prefetch_opportunities",               "Counts the number of prefetch opportunities", "prefetches", 1 }
+    )
+
+private:
+    // Find the entry for key, allocating the LRU way of its set on a miss (returns false on a miss)
+    bool     lookup(uint64_t key, RPTEntry*& entry);
+    void     DispatchRequest(Addr targetAddress, int64_t stride);
+    void     IssuePrefetch(Addr prefetchAddress);
+
+    static uint64_t hash(uint64_t key) { return key * 0x9E3779B97F4A7C15ULL; }
+
+    Output* output;
+    std::vector<Event::HandlerBase*> registeredCallbacks;
+    std::vector<RPTEntry> table;
+    std::vector<uint64_t> prefetchFilter; // cache line + 1 of the prefetch last issued in each slot, 0 if empty
+
+    uint64_t pageSize;
+    uint64_t blockSize;
+    uint64_t regionSize;
+
+    bool     overrunPageBoundary;
+    bool     indexByPC;
+    uint32_t tableSets;
+    uint32_t tableAssoc;
+    uint32_t prefetchDegree;
+    uint32_t prefetchDistance;
+    uint64_t accessCount;
+    uint64_t missEventsProcessed;
+    uint64_t hitEventsProcessed;
+    uint32_t verbosity;
+
+    Statistic<uint64_t>* statPrefetchOpportunities;
+    Statistic<uint64_t>* statPrefetchEventsIssued;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByPageBoundary;
+    Statistic<uint64_t>* statPrefetchIssueCanceledByHistory;
+};
+
+} //namespace Cassini
+} //namespace SST
+
+#endif
@@ -0,0 +1,77 @@
+# Performance check for the Cassini prefetchers
+# A Miranda STREAM triad runs through an L1 with the chosen prefetcher attached,
+# so the prefetcher is notified of every load and store. Compare wall-clock time
+# and the l1cache prefetch statistics between prefetchers, e.g.,
+#   time sst perfPrefetchers.py
+#   time sst perfPrefetchers.py StridePrefetcher
+#   time sst perfPrefetchers.py PalaPrefetcher
+#   time sst perfPrefetchers.py NextBlockPrefetcher
+#   time sst perfPrefetchers.py RPTPrefetcher
+#   time sst perfPrefetchers.py none          (no prefetcher, baseline)
+import sys
+import sst
+
+# Define SST core options
+sst.setProgramOption("timebase", "1ps")
+sst.setProgramOption("stopAtCycle", "0 ns")
+
+# Tell SST what statistics handling we want
+sst.setStatisticLoadLevel(4)
+
+prefetcher = "RPTPrefetcher"
+if len(sys.argv) > 1:
+    prefetcher = sys.argv[1]
+
+elements = 4 * 1024 * 1024
+
+# Define the simulation components
+comp_cpu = sst.Component("cpu", "miranda.BaseCPU")
+comp_cpu.addParams({
+	"verbose" : 0,
+	"max_reqs_cycle" : 2,
+})
+cpugen = comp_cpu.setSubComponent("generator", "miranda.STREAMBenchGenerator")
+cpugen.addParams({
+	"verbose" : 0,
+	"n" : elements,
+	"operandwidth" : 8,
+	"start_a" : 0,
+	"start_b" : elements * 8,
+	"start_c" : elements * 16,
+})
+
+iface = comp_cpu.setSubComponent("memory", "memHierarchy.memInterface")
+
+l1_params = {
+      "access_latency_cycles" : "2",
+      "cache_frequency" : "2 Ghz",
+      "replacement_policy" : "lru",
+      "coherence_protocol" : "MESI",
+      "associativity" : "4",
+      "cache_line_size" : "64",
+      "L1" : "1",
+      "cache_size" : "8 KB",
+}
+if prefetcher != "none":
+    l1_params["prefetcher"] = "cassini." + prefetcher
+
+comp_l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+comp_l1cache.addParams(l1_params)
+comp_l1cache.enableAllStatistics({"type":"sst.AccumulatorStatistic"})
+
+comp_memory = sst.Component("memory", "memHierarchy.MemController")
+comp_memory.addParams({
+      "clock" : "1GHz",
+      "backing" : "none",
+})
+backend = comp_memory.setSubComponent("backend", "memHierarchy.simpleMem")
+backend.addParams({
+      "access_time" : "50 ns",
+      "mem_size" : str(elements * 32) + "B",
+})
+
+# Define the simulation links
+link_cpu_cache_link = sst.Link("link_cpu_cache_link")
+link_cpu_cache_link.connect( (iface, "port", "1000ps"), (comp_l1cache, "high_network_0", "1000ps") )
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (comp_l1cache, "low_network_0", "50ps"), (comp_memory, "direct_link", "50ps") )
@@ -2,6 +2,7 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import os
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -55,6 +56,13 @@ class testcase_cassini_prefetch(SSTTestCase):
     def test_cassini_prefetch_nextblock(self):
         self.cassini_prefetch_test_template("nbp")
 
+    @unittest.skipIf(testing_check_get_num_threads() > 3, "cassini_prefetch: test_cassini_prefetch_rpt skipped if threads > 3")
+    def test_cassini_prefetch_rpt(self):
+        reffile = "{0}/refFiles/test_cassini_prefetch_rpt.out".format(self.get_testsuite_dir())
+        if not os.path.isfile(reffile):
+            self.skipTest("cassini_prefetch: test_cassini_prefetch_rpt needs {0}, generate it by running streamcpu-rpt.py".format(reffile))
+        self.cassini_prefetch_test_template("rpt")
+
 #####
 
     def cassini_prefetch_test_template(self, testcase, testtimeout=180):
@@ -0,0 +1,236 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _MEMHIERARCHY_ADDRROUTETABLE_H_
+#define _MEMHIERARCHY_ADDRROUTETABLE_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <limits>
+
+#include "sst/elements/memHierarchy/util.h"
+#include "sst/elements/memHierarchy/memTypes.h"
+
+namespace SST {
+namespace MemHierarchy {
+
+/*
+ * Address -> destination routing table for memory links
+ *
+ * Destinations are interned into dense integer IDs and their (possibly
+ * interleaved) regions are compiled into a sorted list of segments, split at
+ * every region boundary. Within a segment the set of overlapping regions is
+ * fixed, so the destination depends only on the address modulo the regions'
+ * common interleave period; that mapping is precomputed as a slot table.
+ * A lookup is then a binary search over segment starts plus one table index.
+ *
+ * Where regions overlap, the region added first wins, so adding regions in
+ * the order of a std::set<EndpointInfo> gives the same answer as scanning the set.
+ */
+class AddrRouteTable {
+public:
+    static const int NoRoute = -1;
+
+    AddrRouteTable() : dirty(false) { }
+
+    void clear() {
+        names.clear();
+        nameIDs.clear();
+        regions.clear();
+        segments.clear();
+        segmentStarts.clear();
+        dirty = false;
+    }
+
+    /* Add a destination region. The table is recompiled on the next lookup. */
+    void addRegion(const std::string &name, const MemRegion &region) {
+        int id;
+        std::unordered_map<std::string,int>::const_iterator it = nameIDs.find(name);
+        if (it == nameIDs.end()) {
+            id = names.size();
+            names.push_back(name);
+            nameIDs.insert(std::make_pair(name, id));
+        } else {
+            id = it->second;
+        }
+        regions.push_back(std::make_pair(region, id));
+        dirty = true;
+    }
+
+    /* Return the ID of the destination for 'addr' or NoRoute */
+    int lookup(Addr addr) {
+        if (dirty)
+            build();
+
+        std::vector<Addr>::const_iterator it = std::upper_bound(segmentStarts.begin(), segmentStarts.end(), addr);
+        if (it == segmentStarts.begin())
+            return NoRoute;
+
+        const Segment &seg = segments[(it - segmentStarts.begin()) - 1];
+        if (addr > seg.end)
+            return NoRoute;
+        if (!seg.slots.empty())
+            return seg.slots[((addr - seg.start) % seg.period) / seg.granule];
+        if (!seg.scan.empty()) {
+            // Too many slots to tabulate, check the regions in order
+            for (std::vector<int>::const_iterator rt = seg.scan.begin(); rt != seg.scan.end(); rt++) {
+                if (regions[*rt].first.contains(addr))
+                    return regions[*rt].second;
+            }
+            return NoRoute;
+        }
+        return seg.single;
+    }
+
+    /* Name of a destination, for setting event src/dst and debug. NoRoute maps to "". */
+    const std::string& getName(int id) const { return id == NoRoute ? noName : names[id]; }
+
+    size_t getNumDestinations() const { return names.size(); }
+
+private:
+    static const uint64_t maxSlots = 65536;
+
+    struct Segment {
+        Addr start;
+        Addr end;
+        Addr period;            // Common interleave period of the overlapping regions
+        Addr granule;           // Bytes per slot
+        int single;             // Destination when neither slots nor scan is used
+        std::vector<int> slots; // Destination per granule within a period
+        std::vector<int> scan;  // Regions to check in order when the period is too long to tabulate
+    };
+
+    static uint64_t gcd(uint64_t a, uint64_t b) {
+        while (b != 0) {
+            uint64_t t = a % b;
+            a = b;
+            b = t;
+        }
+        return a;
+    }
+
+    // True if a region covers every address between its start and end
+    static bool isDense(const MemRegion &region) {
+        return region.interleaveSize == 0 || region.interleaveSize >= region.interleaveStep;
+    }
+
+    void build() {
+        dirty = false;
+        segments.clear();
+        segmentStarts.clear();
+
+        std::vector<Addr> bounds;
+        for (std::vector<std::pair<MemRegion,int> >::const_iterator it = regions.begin(); it != regions.end(); it++) {
+            if (it->first.start > it->first.end) continue;
+            bounds.push_back(it->first.start);
+            if (it->first.end != std::numeric_limits<Addr>::max())
+                bounds.push_back(it->first.end + 1);
+        }
+        std::sort(bounds.begin(), bounds.end());
+        bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+        for (size_t i = 0; i < bounds.size(); i++) {
+            Segment seg;
+            seg.start = bounds[i];
+            seg.end = (i + 1 < bounds.size()) ? bounds[i + 1] - 1 : std::numeric_limits<Addr>::max();
+
+            // Regions overlapping this segment cover all of it, since segments are split at every boundary
+            std::vector<int> candidates;
+            for (size_t r = 0; r < regions.size(); r++) {
+                if (regions[r].first.start <= seg.start && regions[r].first.end >= seg.end)
+                    candidates.push_back(r);
+            }
+            if (candidates.empty())
+                continue;
+
+            compileSegment(seg, candidates);
+            segments.push_back(seg);
+            segmentStarts.push_back(seg.start);
+        }
+    }
+
+    void compileSegment(Segment &seg, const std::vector<int> &candidates) {
+        seg.single = NoRoute;
+        seg.period = 0;
+        seg.granule = 0;
+
+        // Period is the lcm of the interleave steps of the regions before the first
+        // dense one; granule divides every region's step, size, and offset into the segment
+        uint64_t period = 1;
+        uint64_t granule = 0;
+        size_t last = 0;
+        for (; last < candidates.size(); last++) {
+            const MemRegion &region = regions[candidates[last]].first;
+            if (isDense(region))
+                break;
+            uint64_t offset = (seg.start - region.start) % region.interleaveStep;
+            granule = gcd(granule, gcd(region.interleaveStep, gcd(region.interleaveSize, offset)));
+            uint64_t step = region.interleaveStep / gcd(period, region.interleaveStep);
+            if (period > std::numeric_limits<uint64_t>::max() / step) {
+                period = 0;
+                break;
+            }
+            period *= step;
+        }
+
+        if (period == 0 || (last > 0 && period / granule > maxSlots)) {
+            seg.scan = candidates;
+            return;
+        }
+
+        if (last == 0) {
+            seg.single = regions[candidates[0]].second;
+            return;
+        }
+
+        int dense = (last < candidates.size()) ? regions[candidates[last]].second : NoRoute;
+        bool uniform = true;
+        seg.slots.resize(period / granule, dense);
+        for (uint64_t slot = 0; slot < seg.slots.size(); slot++) {
+            for (size_t c = 0; c < last; c++) {
+                const MemRegion &region = regions[candidates[c]].first;
+                uint64_t offset = (seg.start - region.start + slot * granule) % region.interleaveStep;
+                if (offset < region.interleaveSize) {
+                    seg.slots[slot] = regions[candidates[c]].second;
+                    break;
+                }
+            }
+            uniform = uniform && seg.slots[slot] == seg.slots[0];
+        }
+
+        if (uniform) {
+            seg.single = seg.slots[0];
+            seg.slots.clear();
+        } else {
+            seg.period = period;
+            seg.granule = granule;
+        }
+    }
+
+    std::vector<std::string> names;
+    std::string noName;
+    std::unordered_map<std::string,int> nameIDs;
+    std::vector<std::pair<MemRegion,int> > regions;
+    std::vector<Segment> segments;
+    std::vector<Addr> segmentStarts;
+    bool dirty;
+};
+
+}
+}
+
+#endif
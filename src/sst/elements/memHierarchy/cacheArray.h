@@ -17,6 +17,7 @@
 #define CACHEARRAY_H
 
 #include <vector>
+#include <new>
 
 #include <sst/core/output.h>
 
@@ -25,6 +26,7 @@
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/lineTypes.h"
+#include "sst/elements/memHierarchy/setProbe.h"
 
 using namespace std;
 
@@ -51,10 +53,17 @@ class CacheArray {
         unsigned int    banks_;
         vector<T*>      lines_; // The actual cache
         State* setStates;
-        std::map<unsigned int, std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+        std::vector<std::vector<ReplacementInfo*> > rInfo;   // Lookup a vector of replacementInfo by set ID
+
+        /* Flat layout: lines are allocated in one contiguous block and the
+         * tags are mirrored into a packed array so that a set probe only
+         * touches associativity_ * sizeof(Addr) contiguous bytes */
+        bool            flat_;
+        T*              lineStorage_;   // Contiguous line objects (flat layout only)
+        vector<Addr>    tags_;          // Packed tags, indexed by line index (flat layout only)
     public:
 
-        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash);
+        CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, bool flat = false);
 
         /** Destructor - Delete all cache line objects */
         virtual ~CacheArray();
@@ -86,6 +95,7 @@ class CacheArray {
         void deallocate(T* candidate);
 
     /**** Configuration and output */
+        bool isFlat() { return flat_; }
         void setSliceAware(Addr size, Addr step);
         void setBanked(unsigned int numBanks);
         void printCacheArray(Output &out);
@@ -94,8 +104,9 @@ class CacheArray {
 /************* Function definitions *****************/
 
 template <class T>
-CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash) :
-    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash) {
+CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int associativity, uint32_t lineSize, ReplacementPolicy* replacementMgr, HashFunction* hash, bool flat) :
+    dbg_(dbg), numLines_(numLines), associativity_(associativity), lineSize_(lineSize), replacementMgr_(replacementMgr), hash_(hash),
+    flat_(flat), lineStorage_(nullptr) {
 
     // Error check parameters
     if (numLines_ == 0)
@@ -121,18 +132,26 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
     sliceSize_ = 1;
     banks_ = 1;
 
-    for (unsigned int i = 0; i < numLines_; i++) {
-        lines_[i] = new T(lineSize_, i);
+    if (flat_) {
+        lineStorage_ = static_cast<T*>(::operator new(sizeof(T) * numLines_));
+        for (unsigned int i = 0; i < numLines_; i++) {
+            lines_[i] = new (&lineStorage_[i]) T(lineSize_, i);
+        }
+        tags_.resize(numLines_, 0); // Lines are constructed with address 0
+    } else {
+        for (unsigned int i = 0; i < numLines_; i++) {
+            lines_[i] = new T(lineSize_, i);
+        }
     }
 
     // Construct rInfo
+    rInfo.resize(numSets_);
     for (unsigned int i = 0; i < numSets_; i++) {
-        std::vector<ReplacementInfo*> setInfo;
+        rInfo[i].reserve(associativity_);
         for (unsigned int j = 0; j < associativity; j++)
-            setInfo.push_back(lines_[i*associativity + j]->getReplacementInfo());
-        rInfo.insert(std::make_pair(i, setInfo));
+            rInfo[i].push_back(lines_[i*associativity + j]->getReplacementInfo());
     }
-    ReplacementInfo * info = rInfo.find(0)->second.front();
+    ReplacementInfo * info = rInfo[0].front();
     if (!replacementMgr_->checkCompatibility(info))
         dbg_->fatal(CALL_INFO, -1, "CacheArray, Error: The replacement policy expects cache line state that is not provided by the cache line type of this cache. Check the type of the ReplacementInfo returned by the coherence protocol's line type and the ReplacementInfo type expected by the replacement policy.\n");
 
@@ -141,8 +160,14 @@ CacheArray<T>::CacheArray(Output* dbg, unsigned int numLines, unsigned int assoc
 
 template <class T>
 CacheArray<T>::~CacheArray() {
-    for (size_t i = 0; i < lines_.size(); i++)
-        delete lines_[i];
+    if (flat_) {
+        for (size_t i = 0; i < lines_.size(); i++)
+            lines_[i]->~T();
+        ::operator delete(lineStorage_);
+    } else {
+        for (size_t i = 0; i < lines_.size(); i++)
+            delete lines_[i];
+    }
     delete replacementMgr_;
     delete hash_;
     delete [] setStates;
@@ -163,6 +188,15 @@ T* CacheArray<T>::lookup(const Addr addr, bool updateReplacement) {
     int setBegin = set * associativity_;
     int setEnd = setBegin + associativity_;
 
+    if (flat_) {
+        int way = probeSet(&tags_[setBegin], associativity_, addr);
+        if (way < 0)
+            return nullptr; // Not found
+        if (updateReplacement)
+            replacementMgr_->update(setBegin + way, lines_[setBegin + way]->getReplacementInfo());
+        return lines_[setBegin + way];
+    }
+
     for (int i = setBegin; i < setEnd; i++) {
         if (lines_[i]->getAddr() == addr) {
             if (updateReplacement)
@@ -189,6 +223,8 @@ void CacheArray<T>::replace(Addr addr, T* candidate) {
     replacementMgr_->replaced(index);
     candidate->reset();
     candidate->setAddr(addr);
+    if (flat_)
+        tags_[index] = addr;
     replacementMgr_->update(index, lines_[index]->getReplacementInfo());
 }
 
@@ -14,6 +14,7 @@
 // distribution.
 
 #include <sst_config.h>
+#include <algorithm>
 #include <sst/core/params.h>
 #include <sst/core/simulation.h>
 #include <sst/core/interfaces/stringEvent.h>
@@ -57,7 +58,7 @@ void Cache::handleEvent(SST::Event * ev) {
         fflush(stdout);
     }
     
-    eventBuffer_.push_back(event);
+    eventBuffer_.push_back(std::make_pair(eventSeq_++, event));
 }
 
 /* 
@@ -121,6 +122,12 @@ bool Cache::clockTick(Cycle_t time) {
     // 1. Retry buffer      -> Events that need to be retried, e.g., were stalled due to a pending action that is now resolved
     // 2. Event buffer      -> Incoming (new) events
     // 3. Prefetch buffer   -> Drop any prefetch that can't be handled immediately
+    //
+    // New events that the coherence manager rejects (the MSHR cannot take them) are parked rather
+    // than retried every cycle. They return to the event buffer, in arrival order, when an MSHR
+    // entry is freed or another event for their line is accepted. Until then retrying them cannot succeed.
+    if (!blockedEvents_.empty() && mshr_->getSize() < blockedMSHRSize_)
+        wakeBlockedEvents();
 
     int accepted = 0;
     size_t entries = retryBuffer_.size();
@@ -141,29 +148,37 @@ bool Cache::clockTick(Cycle_t time) {
         } else {
             it++;
         }
+        if (!blockedEvents_.empty() && mshr_->getSize() < blockedMSHRSize_)
+            wakeBlockedEvents();
     }
 
     // Event buffer has both requests and responses
     // Deadlock will not occur because an event cannot indefinitely block another one
     // 1. An event can be accepted, in which case a later response moves up the queue
     // 2. An event can be rejected, in which case we check the next one with no penalty (doesn't block a later response)
-    it = eventBuffer_.begin();
-    while (it != eventBuffer_.end()) {
+    std::list<std::pair<uint64_t, MemEventBase*> >::iterator eit = eventBuffer_.begin();
+    while (eit != eventBuffer_.end()) {
         if (accepted == maxRequestsPerCycle_)
             break;
-        Command cmd = (*it)->getCmd();
-        if (is_debug_event((*it))) {
+        MemEventBase* ev = eit->second;
+        if (is_debug_event(ev)) {
             dbg_->debug(_L3_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:New     (%s)\n",
-                    Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), (*it)->getVerboseString().c_str());
+                    Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), ev->getVerboseString().c_str());
             fflush(stdout);
         }
-        if (processEvent(*it, false)) {
+        if (processEvent(ev, false)) {
             accepted++;
             statRecvEvents->addData(1);
-            it = eventBuffer_.erase(it);
+            eit = eventBuffer_.erase(eit);
+        } else if (eventBlocked_) {
+            std::list<std::pair<uint64_t, MemEventBase*> >::iterator blocked = eit++;
+            blockEvent(blocked);
         } else {
-            it++;
+            eit++;
         }
+        // Events woken here that arrived after this one are handled later this cycle
+        if (!blockedEvents_.empty() && mshr_->getSize() < blockedMSHRSize_)
+            wakeBlockedEvents();
     }
     while (!prefetchBuffer_.empty()) {
         if (is_debug_event(prefetchBuffer_.front())) {
@@ -189,7 +204,7 @@ bool Cache::clockTick(Cycle_t time) {
     idle &= coherenceMgr_->checkIdle();
 
     // Disable lower-level cache clocks if they're idle
-    if (eventBuffer_.empty() && retryBuffer_.empty() && idle) {
+    if (eventBuffer_.empty() && retryBuffer_.empty() && blockedEvents_.empty() && idle) {
         turnClockOff();
         return true;
     }
@@ -230,6 +245,8 @@ void Cache::turnClockOff() {
  *   Returns: whether event was accepted/can be popped off event queue
  */
 bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
+    eventBlocked_ = false;
+
     // Global noncacheable request flag
     if (allNoncacheableRequests_) {
         ev->setFlag(MemEvent::F_NONCACHEABLE);
@@ -346,6 +363,8 @@ bool Cache::processEvent(MemEventBase* ev, bool inMSHR) {
 
     if (accepted)
         updateAccessStatus(addr);
+    else
+        eventBlocked_ = true;
 
     return accepted;
 }
@@ -375,6 +394,56 @@ void Cache::updateAccessStatus(Addr addr) {
         Addr bank = coherenceMgr_->getBank(addr);
         bankStatus_[bank] = true;
     }
+
+    // The line may have changed state, let any events blocked on it try again
+    if (!blockedAddrs_.empty())
+        wakeBlockedEvents(addr);
+}
+
+/* Move a rejected event from the event buffer to the blocked events */
+void Cache::blockEvent(std::list<std::pair<uint64_t, MemEventBase*> >::iterator it) {
+    MemEvent* event = static_cast<MemEvent*>(it->second);
+    blockedEvents_.insert(*it);
+    blockedAddrs_[event->getBaseAddr()].push_back(it->first);
+    if (mshr_->getSize() > blockedMSHRSize_)
+        blockedMSHRSize_ = mshr_->getSize();
+    eventBuffer_.erase(it);
+}
+
+/* Return events blocked on 'addr' to the event buffer */
+void Cache::wakeBlockedEvents(Addr addr) {
+    std::unordered_map<Addr, std::vector<uint64_t> >::iterator it = blockedAddrs_.find(addr);
+    if (it == blockedAddrs_.end())
+        return;
+
+    std::vector<std::pair<uint64_t, MemEventBase*> > woken;
+    for (std::vector<uint64_t>::iterator seq = it->second.begin(); seq != it->second.end(); seq++) {
+        std::map<uint64_t, MemEventBase*>::iterator blocked = blockedEvents_.find(*seq);
+        woken.push_back(*blocked);
+        blockedEvents_.erase(blocked);
+    }
+    blockedAddrs_.erase(it);
+    std::sort(woken.begin(), woken.end());
+    unblockEvents(woken);
+}
+
+/* Return all blocked events to the event buffer */
+void Cache::wakeBlockedEvents() {
+    std::vector<std::pair<uint64_t, MemEventBase*> > woken(blockedEvents_.begin(), blockedEvents_.end());
+    blockedEvents_.clear();
+    blockedAddrs_.clear();
+    blockedMSHRSize_ = 0;
+    unblockEvents(woken);
+}
+
+/* Merge woken events (in arrival order) back into the event buffer so that it stays in arrival order */
+void Cache::unblockEvents(std::vector<std::pair<uint64_t, MemEventBase*> >& woken) {
+    std::list<std::pair<uint64_t, MemEventBase*> >::iterator it = eventBuffer_.begin();
+    for (std::vector<std::pair<uint64_t, MemEventBase*> >::iterator ev = woken.begin(); ev != woken.end(); ev++) {
+        while (it != eventBuffer_.end() && it->first < ev->first)
+            it++;
+        eventBuffer_.insert(it, *ev);
+    }
 }
 
 
@@ -544,7 +613,7 @@ void Cache::finish() {
 void Cache::printStatus(Output &out) {
     out.output("MemHierarchy::Cache %s\n", getName().c_str());
     out.output("  Clock is %s. Last active cycle: %" PRIu64 "\n", clockIsOn_ ? "on" : "off", timestamp_);
-    out.output("  Events in queues: Retry = %zu, Event = %zu, Prefetch = %zu\n", retryBuffer_.size(), eventBuffer_.size(), prefetchBuffer_.size());
+    out.output("  Events in queues: Retry = %zu, Event = %zu, Blocked = %zu, Prefetch = %zu\n", retryBuffer_.size(), eventBuffer_.size(), blockedEvents_.size(), prefetchBuffer_.size());
     if (mshr_) {
         out.output("  MSHR Status:\n");
         mshr_->printStatus(out);
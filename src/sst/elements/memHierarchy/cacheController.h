@@ -18,6 +18,7 @@
 
 #include <queue>
 #include <map>
+#include <unordered_map>
 #include <string>
 #include <sstream>
 
@@ -88,6 +89,7 @@ public:
             {"cache_line_size",         "(uint) Size of a cache line [aka cache block] in bytes.", "64"},
             {"force_noncacheable_reqs", "(bool) Used for verification purposes. All requests are considered to be 'noncacheable'. Options: 0[off], 1[on]", "false"},
             {"min_packet_size",         "(string) Number of bytes in a request/response not including payload (e.g., addr + cmd). Specify in B.", "8B"},
+            {"cache_array_layout",      "(string) Layout of the cache's tag array. Options: pointer[individually allocated lines], flat[contiguous lines with a packed per-set tag array; faster set probes for large, highly associative caches]", "pointer"},
             {"banks",                   "(uint) Number of cache banks: One access per bank per cycle. Use '0' to simulate no bank limits (only limits on bandwidth then are max_requests_per_cycle and *_link_width", "0"},
             /* Old parameters - deprecated or moved */
             {"network_address",             "DEPRECATED - Now auto-detected by link control."}, // Remove 9.0
@@ -247,6 +249,12 @@ private:
     bool arbitrateAccess(Addr addr);
     void updateAccessStatus(Addr addr);
 
+    // Park events rejected by the coherence manager until they might succeed
+    void blockEvent(std::list<std::pair<uint64_t, MemEventBase*> >::iterator it);
+    void wakeBlockedEvents(Addr addr);
+    void wakeBlockedEvents();
+    void unblockEvents(std::vector<std::pair<uint64_t, MemEventBase*> >& woken);
+
     // Process coherence initialization events
     void processInitCoherenceEvent(MemEventInitCoherence* event, bool src);
 
@@ -286,7 +294,12 @@ private:
     std::vector<bool>           bankStatus_;
     std::set<Addr>              addrsThisCycle_;
     std::list<MemEventBase*>    retryBuffer_;
-    std::list<MemEventBase*>    eventBuffer_;
+    std::list<std::pair<uint64_t, MemEventBase*> > eventBuffer_;   // New events, tagged with arrival order
+    uint64_t                    eventSeq_;      // Arrival order of next new event
+    bool                        eventBlocked_;  // Whether the last event processed was rejected by the coherence manager
+    std::map<uint64_t, MemEventBase*> blockedEvents_;    // Rejected events by arrival order, waiting for MSHR space or a change to their line
+    std::unordered_map<Addr, std::vector<uint64_t> > blockedAddrs_; // Blocked events indexed by line address
+    int                         blockedMSHRSize_; // Largest MSHR occupancy at which a blocked event was rejected
     std::queue<MemEventBase*>   prefetchBuffer_;
     std::map<SST::Event::id_type, std::string> noncacheableResponseDst_;
 
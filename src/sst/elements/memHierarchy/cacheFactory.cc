@@ -126,6 +126,12 @@ void Cache::createCoherenceManager(Params &params) {
                 getName().c_str(), itype.c_str(), protStr.c_str());
     }
 
+    // Array layout
+    std::string layout = params.find<std::string>("cache_array_layout", "pointer");
+    to_lower(layout);
+    if (layout != "pointer" && layout != "flat")
+        out_->fatal(CALL_INFO, -1, "%s, Invalid param: cache_array_layout - valid options are 'pointer' or 'flat'. You specified '%s'.\n", getName().c_str(), layout.c_str());
+
     /* Create MSHR */
     uint64_t mshrLatency = createMSHR(params, accessLatency, L1);
 
@@ -155,6 +161,7 @@ void Cache::createCoherenceManager(Params &params) {
     coherenceParams.insert("dlines", params.find<std::string>("noninclusive_directory_entries", "0"));
     coherenceParams.insert("dassoc", params.find<std::string>("noninclusive_directory_associativity", "0"));
     coherenceParams.insert("drpolicy", params.find<std::string>("noninclusive_directory_repl", "lru"));
+    coherenceParams.insert("flat_array", (layout == "flat") ? "true" : "false");
 
     bool prefetch = (statPrefetchRequest != nullptr);
 
@@ -726,6 +733,9 @@ void Cache::createClock(Params &params) {
 
     clockIsOn_ = true;
     timestamp_ = 0;
+    eventSeq_ = 0;
+    eventBlocked_ = false;
+    blockedMSHRSize_ = 0;
     lastActiveClockCycle_ = 0;
 
     // Deadlock timeout
@@ -0,0 +1,173 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_CALENDARQUEUE_H
+#define MEMHIERARCHY_CALENDARQUEUE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+#include <map>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Time-ordered queue for outgoing events
+ *
+ * A timing wheel of FIFO buckets covers the next 'slots' cycles after the
+ * earliest undrained time. Items scheduled outside that window (in the past,
+ * or far in the future) go to an ordered overflow map. Items come out in
+ * (time, insertion order), the same order as a std::multimap keyed on time,
+ * but insert and pop are O(1) for items within the window.
+ *
+ * Usage mirrors draining a multimap:
+ *   while (queue.ready(now)) { T& item = queue.front(); ...; queue.pop(); }
+ * front() may be modified in place (e.g., for partial sends).
+ */
+template <typename T>
+class CalendarQueue {
+public:
+    CalendarQueue(size_t slots = 1024) : base_(0), wheelCount_(0), freeList_(-1), fromOverflow_(false) {
+        size_t size = 1;
+        while (size < slots) size <<= 1;
+        mask_ = size - 1;
+        buckets_.resize(size);
+    }
+
+    bool empty() const { return wheelCount_ == 0 && overflow_.empty(); }
+    size_t size() const { return wheelCount_ + overflow_.size(); }
+
+    void insert(uint64_t time, const T& item) {
+        if (wheelCount_ == 0)
+            base_ = time;   // Wheel is empty, start the window here
+        if (time < base_ || time - base_ > mask_) {
+            overflow_.insert(std::make_pair(time, item));
+            return;
+        }
+        int node = allocNode(time, item);
+        Bucket& bucket = buckets_[time & mask_];
+        if (bucket.head == -1)
+            bucket.head = node;
+        else
+            nodes_[bucket.tail].next = node;
+        bucket.tail = node;
+        wheelCount_++;
+    }
+
+    /* Whether an item with time <= now is waiting. Must be called before front()/pop(). */
+    bool ready(uint64_t now) {
+        if (wheelCount_ == 0) {
+            if (overflow_.empty() || overflow_.begin()->first > now)
+                return false;
+            fromOverflow_ = true;
+            return true;
+        }
+
+        // Skip empty buckets, but not past 'now' so that near-term inserts stay in the wheel
+        while (buckets_[base_ & mask_].head == -1 && base_ <= now)
+            base_++;
+
+        bool wheelReady = buckets_[base_ & mask_].head != -1 && base_ <= now;
+        bool overflowReady = !overflow_.empty() && overflow_.begin()->first <= now;
+
+        // On equal times overflow items were inserted first
+        fromOverflow_ = overflowReady && (!wheelReady || overflow_.begin()->first <= base_);
+        return wheelReady || overflowReady;
+    }
+
+    T& front() {
+        if (fromOverflow_)
+            return overflow_.begin()->second;
+        return nodes_[buckets_[base_ & mask_].head].item;
+    }
+
+    uint64_t frontTime() {
+        if (fromOverflow_)
+            return overflow_.begin()->first;
+        return base_;
+    }
+
+    void pop() {
+        if (fromOverflow_) {
+            overflow_.erase(overflow_.begin());
+            return;
+        }
+        Bucket& bucket = buckets_[base_ & mask_];
+        int node = bucket.head;
+        bucket.head = nodes_[node].next;
+        if (bucket.head == -1)
+            bucket.tail = -1;
+        freeNode(node);
+        wheelCount_--;
+    }
+
+    /* Visit every queued item as f(time, item), for debug output */
+    template <typename F>
+    void forEach(F f) const {
+        typename std::multimap<uint64_t,T>::const_iterator it = overflow_.begin();
+        for (; it != overflow_.end() && it->first < base_; it++)
+            f(it->first, it->second);
+        for (uint64_t time = base_; time <= base_ + mask_; time++) {
+            for (int node = buckets_[time & mask_].head; node != -1; node = nodes_[node].next)
+                f(nodes_[node].time, nodes_[node].item);
+        }
+        for (; it != overflow_.end(); it++)
+            f(it->first, it->second);
+    }
+
+private:
+    struct Bucket {
+        int head;
+        int tail;
+        Bucket() : head(-1), tail(-1) { }
+    };
+
+    struct Node {
+        T item;
+        uint64_t time;
+        int next;
+    };
+
+    int allocNode(uint64_t time, const T& item) {
+        if (freeList_ == -1) {
+            nodes_.push_back(Node{item, time, -1});
+            return nodes_.size() - 1;
+        }
+        int node = freeList_;
+        freeList_ = nodes_[node].next;
+        nodes_[node].item = item;
+        nodes_[node].time = time;
+        nodes_[node].next = -1;
+        return node;
+    }
+
+    void freeNode(int node) {
+        nodes_[node].next = freeList_;
+        freeList_ = node;
+    }
+
+    uint64_t base_;                         // Earliest time that may have items in the wheel
+    uint64_t mask_;                         // Wheel size - 1
+    size_t wheelCount_;
+    std::vector<Bucket> buckets_;
+    std::vector<Node> nodes_;               // Item storage, recycled through freeList_
+    int freeList_;
+    std::multimap<uint64_t,T> overflow_;    // Items outside the wheel's window
+    bool fromOverflow_;                     // Whether front() is the head of overflow_
+};
+
+}}
+
+#endif /* MEMHIERARCHY_CALENDARQUEUE_H */
@@ -656,8 +656,8 @@ void Incoherent::retry(Addr addr) {
             if (!mshr_->getInProgress(addr))
                 retryBuffer_.push_back(mshr_->getFrontEvent(addr));
         } else { // Pointer -> another request is waiting to evict this address
-            std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
-            for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
+            std::vector<Addr>* evictPointers = mshr_->getEvictPointers(addr);
+            for (std::vector<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
                 MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD);
                 retryBuffer_.push_back(ev);
             }
@@ -598,8 +598,8 @@ void IncoherentL1::cleanUpAfterRequest(MemEvent* event, bool inMSHR) {
             if (mshr_->getFrontType(addr) == MSHREntryType::Evict) {
                 if (is_debug_addr(addr))
                     debug->debug(_L5_, "    CleanUpAfterRequest: Waiting Evict in MSHR, retrying eviction(s)\n");
-                std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
-                for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
+                std::vector<Addr>* evictPointers = mshr_->getEvictPointers(addr);
+                for (std::vector<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
                     MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
                     retryBuffer_.push_back(ev);
                 }
@@ -639,8 +639,8 @@ void IncoherentL1::cleanUpAfterResponse(MemEvent* event, bool inMSHR) {
         } else {
             if (is_debug_addr(addr))
                 debug->debug(_L5_, "    CleanUpAfterResponse: Waiting Evict in MSHR, retrying eviction\n");
-            std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
-            for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
+            std::vector<Addr>* evictPointers = mshr_->getEvictPointers(addr);
+            for (std::vector<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
                 MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
                 retryBuffer_.push_back(ev);
             }
@@ -656,8 +656,8 @@ void IncoherentL1::retry(Addr addr) {
         if (mshr_->getFrontType(addr) == MSHREntryType::Event) {
             retryBuffer_.push_back(mshr_->getFrontEvent(addr));
         } else if (!(mshr_->pendingWriteback(addr))) {
-            std::list<Addr>* evictPointers = mshr_->getEvictPointers(addr);
-            for (std::list<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
+            std::vector<Addr>* evictPointers = mshr_->getEvictPointers(addr);
+            for (std::vector<Addr>::iterator it = evictPointers->begin(); it != evictPointers->end(); it++) {
                 MemEvent * ev = new MemEvent(cachename_, addr, *it, Command::NULLCMD, getCurrentSimTimeNano());
                 retryBuffer_.push_back(ev);
             }
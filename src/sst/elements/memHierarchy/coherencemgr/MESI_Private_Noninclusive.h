@@ -229,7 +229,7 @@ public:
 
         ReplacementPolicy * rmgr = createReplacementPolicy(lines, assoc, params, false);
         HashFunction * ht = createHashFunction(params);
-        cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht);
+        cacheArray_ = new CacheArray<PrivateCacheLine>(debug, lines, assoc, lineSize_, rmgr, ht, params.find<bool>("flat_array", false));
         cacheArray_->setBanked(params.find<uint64_t>("banks", 0));
 
         stat_evict[I] =      registerStatistic<uint64_t>("evict_I");
@@ -332,14 +332,15 @@ bool CoherenceController::sendOutgoingEvents() {
 
     // Check for ready events in outgoing 'down' queue
     uint64_t bytesLeft = maxBytesDown;
-    while (!outgoingEventQueueDown_.empty() && outgoingEventQueueDown_.front().deliveryTime <= timestamp_) {
-        MemEventBase *outgoingEvent = outgoingEventQueueDown_.front().event;
+    while (outgoingEventQueueDown_.ready(timestamp_)) {
+        Response& head = outgoingEventQueueDown_.front();
+        MemEventBase *outgoingEvent = head.event;
         if (maxBytesDown != 0) {
             if (bytesLeft == 0) break;
-            if (bytesLeft >= outgoingEventQueueDown_.front().size) {
-                bytesLeft -= outgoingEventQueueDown_.front().size;  // Send this many bytes
+            if (bytesLeft >= head.size) {
+                bytesLeft -= head.size;  // Send this many bytes
             } else {
-                outgoingEventQueueDown_.front().size -= bytesLeft;
+                head.size -= bytesLeft;
                 break;
             }
         }
@@ -351,20 +352,21 @@ bool CoherenceController::sendOutgoingEvents() {
         }
 
         linkDown_->send(outgoingEvent);
-        outgoingEventQueueDown_.pop_front();
+        outgoingEventQueueDown_.pop();
 
     }
 
     // Check for ready events in outgoing 'up' queue
     bytesLeft = maxBytesUp;
-    while (!outgoingEventQueueUp_.empty() && outgoingEventQueueUp_.front().deliveryTime <= timestamp_) {
-        MemEventBase * outgoingEvent = outgoingEventQueueUp_.front().event;
+    while (outgoingEventQueueUp_.ready(timestamp_)) {
+        Response& head = outgoingEventQueueUp_.front();
+        MemEventBase * outgoingEvent = head.event;
         if (maxBytesUp != 0) {
             if (bytesLeft == 0) break;
-            if (bytesLeft >= outgoingEventQueueUp_.front().size) {
-                bytesLeft -= outgoingEventQueueUp_.front().size;
+            if (bytesLeft >= head.size) {
+                bytesLeft -= head.size;
             } else {
-                outgoingEventQueueUp_.front().size -= bytesLeft;
+                head.size -= bytesLeft;
                 break;
             }
         }
@@ -381,7 +383,7 @@ bool CoherenceController::sendOutgoingEvents() {
         }
 
         linkUp_->send(outgoingEvent);
-        outgoingEventQueueUp_.pop_front();
+        outgoingEventQueueUp_.pop();
     }
 
     // Return whether it's ok for the cache to turn off the clock - we need it on to be able to send waiting events
@@ -400,15 +402,15 @@ void CoherenceController::forwardByAddress(MemEventBase * event) {
 
 void CoherenceController::forwardByAddress(MemEventBase * event, Cycle_t ts) {
     event->setSrc(cachename_);
-    std::string dst = linkDown_->findTargetDestination(event->getRoutingAddress());
+    const std::string& dst = linkDown_->findTargetDestination(event->getRoutingAddress());
     if (dst != "") { /* Common case */
         event->setDst(dst);
         Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
         addToOutgoingQueue(fwdReq);
     } else {
-        dst = linkUp_->findTargetDestination(event->getRoutingAddress());
-        if (dst != "") {
-            event->setDst(dst);
+        const std::string& dstUp = linkUp_->findTargetDestination(event->getRoutingAddress());
+        if (dstUp != "") {
+            event->setDst(dstUp);
             Response fwdReq = {event, ts, packetHeaderBytes + event->getPayloadSize()};
             addToOutgoingQueueUp(fwdReq);
         } else {
@@ -723,15 +725,15 @@ void CoherenceController::printDataValue(Addr addr, vector<uint8_t> * data, bool
 void CoherenceController::printStatus(Output& out) {
     out.output("  Begin MemHierarchy::CoherenceController %s\n", getName().c_str());
 
+    auto printResponse = [&out](uint64_t time, const Response& resp) {
+        out.output("      Time: %" PRIu64 ", Event: %s\n", time, resp.event->getVerboseString().c_str());
+    };
+
     out.output("    Events waiting in outgoingEventQueueDown: %zu\n", outgoingEventQueueDown_.size());
-    for (list<Response>::iterator it = outgoingEventQueueDown_.begin(); it!= outgoingEventQueueDown_.end(); it++) {
-        out.output("      Time: %" PRIu64 ", Event: %s\n", (*it).deliveryTime, (*it).event->getVerboseString().c_str());
-    }
+    outgoingEventQueueDown_.forEach(printResponse);
 
     out.output("    Events waiting in outgoingEventQueueUp: %zu\n", outgoingEventQueueUp_.size());
-    for (list<Response>::iterator it = outgoingEventQueueUp_.begin(); it!= outgoingEventQueueUp_.end(); it++) {
-        out.output("      Time: %" PRIu64 ", Event: %s\n", (*it).deliveryTime, (*it).event->getVerboseString().c_str());
-    }
+    outgoingEventQueueUp_.forEach(printResponse);
 
     out.output("  End MemHierarchy::CoherenceController\n");
 }
@@ -748,24 +750,14 @@ void CoherenceController::printStatus(Output& out) {
  * a block and then re-request it, the requests can get inverted.
  */
 void CoherenceController::addToOutgoingQueue(Response& resp) {
-    list<Response>::reverse_iterator rit;
-    for (rit = outgoingEventQueueDown_.rbegin(); rit!= outgoingEventQueueDown_.rend(); rit++) {
-        if (resp.deliveryTime >= (*rit).deliveryTime) break;
-        if (resp.event->getRoutingAddress() == (*rit).event->getRoutingAddress()) break;
-    }
-    outgoingEventQueueDown_.insert(rit.base(), resp);
+    outgoingEventQueueDown_.insert(resp.deliveryTime, resp.event->getRoutingAddress(), resp);
 }
 
 /* Add a new event to the outgoing queue up (towards memory)
  * Again, to do not reorder events to the same address
  */
 void CoherenceController::addToOutgoingQueueUp(Response& resp) {
-    list<Response>::reverse_iterator rit;
-    for (rit = outgoingEventQueueUp_.rbegin(); rit != outgoingEventQueueUp_.rend(); rit++) {
-        if (resp.deliveryTime >= (*rit).deliveryTime) break;
-        if (resp.event->getRoutingAddress() == (*rit).event->getRoutingAddress()) break;
-    }
-    outgoingEventQueueUp_.insert(rit.base(), resp);
+    outgoingEventQueueUp_.insert(resp.deliveryTime, resp.event->getRoutingAddress(), resp);
 }
 
 
@@ -32,6 +32,7 @@
 #include "sst/elements/memHierarchy/memLinkBase.h"
 #include "sst/elements/memHierarchy/replacementManager.h"
 #include "sst/elements/memHierarchy/hash.h"
+#include "sst/elements/memHierarchy/outgoingQueue.h"
 
 namespace SST { namespace MemHierarchy {
 using namespace std;
@@ -318,8 +319,8 @@ protected:
 
 private:
     /* Outgoing event queues - events are stalled here to account for access latencies */
-    list<Response> outgoingEventQueueDown_;
-    list<Response> outgoingEventQueueUp_;
+    OutgoingQueue<Response> outgoingEventQueueDown_;
+    OutgoingQueue<Response> outgoingEventQueueUp_;
 
     MemLinkBase * linkUp_;
     MemLinkBase * linkDown_;
@@ -58,6 +58,9 @@ void CoherentMemController::init(unsigned int phase) {
 
     /* Inherit region from our source(s) */
     if (!phase) {
+        if (!snapshotIn_.empty())
+            loadBackingSnapshot();
+
         /* Announce our presence on link */
         link_->sendInitData(new MemEventInitCoherence(getName(), Endpoint::Memory, true, false, memBackendConvertor_->getRequestWidth(), true));
         link_->sendInitData(new MemEventInitEndpoint(getName(), Endpoint::Memory, region_, true));
@@ -106,8 +109,8 @@ bool CoherentMemController::clock(Cycle_t cycle) {
     timestamp_++;
 
     bool debug = false;
-    while (!msgQueue_.empty() && msgQueue_.begin()->first < timestamp_) {
-        MemEventBase * sendEv = msgQueue_.begin()->second;
+    while (msgQueue_.ready(timestamp_ - 1)) {
+        MemEventBase * sendEv = msgQueue_.front();
 
         if (is_debug_event(sendEv)) {
             if (!debug) dbg.debug(_L4_, "\n");
@@ -116,7 +119,7 @@ bool CoherentMemController::clock(Cycle_t cycle) {
         }
 
         link_->send(sendEv);
-        msgQueue_.erase(msgQueue_.begin());
+        msgQueue_.pop();
     }
 
     /* Unclock if nothing is in clocked queues anywhere (link, backend, here) */
@@ -126,8 +129,7 @@ bool CoherentMemController::clock(Cycle_t cycle) {
     bool unclockBack = memBackendConvertor_->clock(cycle); /* OK to unclock backend? */
 
     if (unclockLink && unclockBack && msgQueue_.empty()) {
-        memBackendConvertor_->turnClockOff();
-        clockOn_ = false;
+        turnClockOff(cycle);
         return true;
     }
 
@@ -430,7 +432,7 @@ void CoherentMemController::handleNack(MemEvent * ev) {
         uint64_t backoff = (0x1 << retries);
         nackedEvent->incrementRetries();
 
-        msgQueue_.insert(std::make_pair(timestamp_ + backoff, nackedEvent));
+        msgQueue_.insert(timestamp_ + backoff, nackedEvent);
     } else {
         delete nackedEvent;
     }
@@ -485,7 +487,7 @@ bool CoherentMemController::doShootdown(Addr addr, MemEventBase * ev) {
         inv->setRqstr(ev->getRqstr());
         inv->setDst(ev->getSrc());
 
-        msgQueue_.insert(std::make_pair(timestamp_, inv)); /* Send on next clock. TODO timing needed? */
+        msgQueue_.insert(timestamp_, inv); /* Send on next clock. TODO timing needed? */
         return true;
     }
     return false;
@@ -2094,7 +2094,7 @@ bool DirectoryController::retrieveDirEntry(DirEntry* entry, MemEvent* event, boo
     uint64_t deliveryTime = timestamp + accessLatency;
 
     // Bypass destination lookup 
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
+    memMsgQueue.insert(deliveryTime, MemMsg(me, true));
 
     return true;
 }
@@ -2197,7 +2197,7 @@ void DirectoryController::sendEntryToMemory(DirEntry *entry) {
 
     uint64_t deliveryTime = timestamp + accessLatency;
     me->setDst(memLink->getTargetDestination(0));
-    memMsgQueue.insert(std::make_pair(deliveryTime, MemMsg(me, true)));
+    memMsgQueue.insert(deliveryTime, MemMsg(me, true));
 }
 
 /****************************
@@ -2370,8 +2370,8 @@ void DirectoryController::sendNACK(MemEvent * event) {
 void DirectoryController::sendOutgoingEvents() {
 
     bool debugLine = false;
-    while (!cpuMsgQueue.empty() && cpuMsgQueue.begin()->first <= timestamp) {
-        MemEventBase * ev = cpuMsgQueue.begin()->second;
+    while (cpuMsgQueue.ready(timestamp)) {
+        MemEventBase * ev = cpuMsgQueue.front();
 
         if (is_debug_event(ev)) {
             dbg.debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
@@ -2386,18 +2386,18 @@ void DirectoryController::sendOutgoingEvents() {
         }
         stat_eventSent[(int)ev->getCmd()]->addData(1);
         cpuLink->send(ev);
-        cpuMsgQueue.erase(cpuMsgQueue.begin());
+        cpuMsgQueue.pop();
     }
 
-    while (!memMsgQueue.empty() && memMsgQueue.begin()->first <= timestamp) {
-        MemEventBase * ev = memMsgQueue.begin()->second.event;
+    while (memMsgQueue.ready(timestamp)) {
+        MemEventBase * ev = memMsgQueue.front().event;
 
         if (is_debug_event(ev)) {
             dbg.debug(_L4_, "E: %-20" PRIu64 " %-20" PRIu64 " %-20s Event:Send    (%s)\n",
                     Simulation::getSimulation()->getCurrentSimCycle(), timestamp, getName().c_str(), ev->getBriefString().c_str());
         }
 
-        if (memMsgQueue.begin()->second.dirAccess) {
+        if (memMsgQueue.front().dirAccess) {
             if (ev->getCmd() == Command::GetS)
                 stat_dirEntryReads->addData(1);
             else
@@ -2406,7 +2406,7 @@ void DirectoryController::sendOutgoingEvents() {
             stat_eventSent[(int)ev->getCmd()]->addData(1);
         }
         memLink->send(ev);
-        memMsgQueue.erase(memMsgQueue.begin());
+        memMsgQueue.pop();
     }
 
 }
@@ -2415,15 +2415,15 @@ void DirectoryController::sendOutgoingEvents() {
  * dirAccess has default value of false
  */
 void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool dirAccess) {
-    std::string dst = memLink->findTargetDestination(ev->getRoutingAddress());
+    const std::string& dst = memLink->findTargetDestination(ev->getRoutingAddress());
     if (dst != "") { /* Common case */
         ev->setDst(dst);
-        memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
+        memMsgQueue.insert(ts, MemMsg(ev, dirAccess));
     } else {
-        dst = cpuLink->findTargetDestination(ev->getRoutingAddress());
-        if (dst != "") {
-            ev->setDst(dst);
-            cpuMsgQueue.insert(std::make_pair(ts, ev));
+        const std::string& dstUp = cpuLink->findTargetDestination(ev->getRoutingAddress());
+        if (dstUp != "") {
+            ev->setDst(dstUp);
+            cpuMsgQueue.insert(ts, ev);
         } else {
             std::string availableDests = "cpulink:\n" + cpuLink->getAvailableDestinationsAsString();
             if (cpuLink != memLink) availableDests = availableDests + "memlink:\n" + memLink->getAvailableDestinationsAsString();
@@ -2438,9 +2438,9 @@ void DirectoryController::forwardByAddress(MemEventBase * ev, Cycle_t ts, bool d
  */
 void DirectoryController::forwardByDestination(MemEventBase* ev, Cycle_t ts, bool dirAccess) {
     if (cpuLink->isReachable(ev->getDst())) {
-        cpuMsgQueue.insert(std::make_pair(ts, ev));
+        cpuMsgQueue.insert(ts, ev);
     } else if (memLink->isReachable(ev->getDst())) {
-        memMsgQueue.insert(std::make_pair(ts, MemMsg(ev, dirAccess)));
+        memMsgQueue.insert(ts, MemMsg(ev, dirAccess));
     } else {
         out.fatal(CALL_INFO, -1, "%s, Error: Destination %s appears unreachable on both links. Event: %s\n",
                 getName().c_str(), ev->getDst().c_str(), ev->getVerboseString().c_str());
@@ -37,6 +37,7 @@
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/mshr.h"
+#include "sst/elements/memHierarchy/calendarQueue.h"
 
 using namespace std;
 
@@ -405,8 +406,8 @@ private:
     void forwardByDestination(MemEventBase* ev, Cycle_t timestamp, bool dirAccess = false);
     void forwardByAddress(MemEventBase* ev, Cycle_t timestamp, bool dirAccess = false);
 
-    std::multimap<uint64_t,MemEventBase*>   cpuMsgQueue;
-    std::multimap<uint64_t,MemMsg>   memMsgQueue;
+    CalendarQueue<MemEventBase*>   cpuMsgQueue;
+    CalendarQueue<MemMsg>   memMsgQueue;
 
     uint64_t    entryCacheMaxSize;
     uint64_t    entryCacheSize;
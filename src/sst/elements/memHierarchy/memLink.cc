@@ -38,6 +38,8 @@ MemLink::MemLink(ComponentId_t id, Params &params, TimeConverter* tc) : MemLinkB
     if (!link)
         dbg.fatal(CALL_INFO, -1, "%s, Error: unable to configure link on port '%s'\n", getName().c_str(), port.c_str());
 
+    remoteRoutesStale = false;
+
     dbg.debug(_L10_, "%s memLink info is: Name: %s, addr: %" PRIu64 ", id: %" PRIu32 "\n",
             getName().c_str(), info.name.c_str(), info.addr, info.id);
 }
@@ -91,7 +93,7 @@ void MemLink::init(unsigned int phase) {
     
     // Attempt to drain send Q
     for (auto it = initSendQ.begin(); it != initSendQ.end(); ) {
-        std::string dst = findTargetDestination((*it)->getRoutingAddress());
+        const std::string& dst = findTargetDestination((*it)->getRoutingAddress());
         if (dst != "") {
             dbg.debug(_L10_, "%s sending init message: %s\n", getName().c_str(), (*it)->getVerboseString().c_str());
             (*it)->setDst(dst);
@@ -126,7 +128,7 @@ void MemLink::setup() {
  */
 void MemLink::sendInitData(MemEventInit * event, bool broadcast) {
     if (!broadcast) {
-        std::string dst = findTargetDestination(event->getRoutingAddress());
+        const std::string& dst = findTargetDestination(event->getRoutingAddress());
         if (dst == "") {
             /* Stall this until address is known */
             initSendQ.insert(event);
@@ -153,6 +155,7 @@ MemEventInit * MemLink::recvInitData() {
 void MemLink::addRemote(EndpointInfo info) {
     remotes.insert(info);
     remoteNames.insert(info.name);
+    remoteRoutesStale = true;
 }
 
 void MemLink::addEndpoint(EndpointInfo info) {
@@ -195,8 +198,8 @@ MemEventBase * MemLink::recv() {
     return nullptr;
 }
 
-std::string MemLink::getTargetDestination(Addr addr) {
-    std::string dst = findTargetDestination(addr);
+const std::string& MemLink::getTargetDestination(Addr addr) {
+    const std::string& dst = findTargetDestination(addr);
     if ("" != dst) {
         return dst;
     }
@@ -207,14 +210,18 @@ std::string MemLink::getTargetDestination(Addr addr) {
         error << it->name << " " << it->region.toString() << endl;
     }
     dbg.fatal(CALL_INFO, -1, "%s", error.str().c_str());
-    return "";
+    return dst;
 }
 
-std::string MemLink::findTargetDestination(Addr addr) {
-    for (std::set<EndpointInfo>::const_iterator it = remotes.begin(); it != remotes.end(); it++) {
-        if (it->region.contains(addr)) return it->name;
+const std::string& MemLink::findTargetDestination(Addr addr) {
+    if (remoteRoutesStale) {
+        remoteRoutes.clear();
+        for (std::set<EndpointInfo>::const_iterator it = remotes.begin(); it != remotes.end(); it++) {
+            remoteRoutes.addRegion(it->name, it->region);
+        }
+        remoteRoutesStale = false;
     }
-    return "";
+    return remoteRoutes.getName(remoteRoutes.lookup(addr));
 }
 
 bool MemLink::isReachable(std::string dst) {
@@ -101,8 +101,8 @@ public:
     virtual std::set<EndpointInfo>* getDests();
     virtual bool isDest(std::string UNUSED(str));
     virtual bool isSource(std::string UNUSED(str));
-    virtual std::string findTargetDestination(Addr addr);
-    virtual std::string getTargetDestination(Addr addr);
+    virtual const std::string& findTargetDestination(Addr addr);
+    virtual const std::string& getTargetDestination(Addr addr);
     virtual bool isReachable(std::string dst);
 
     /* Send and receive functions for MemLink */
@@ -128,6 +128,8 @@ protected:
     std::set<EndpointInfo> remotes;             // Tracks remotes immediately accessible on the other side of our link
     std::set<EndpointInfo> endpoints;           // Tracks endpoints in the system with info on how to get there
     std::set<std::string> remoteNames;          // Tracks remote names for faster lookup than iteratinv via remotes
+    AddrRouteTable remoteRoutes;                // Compiled from remotes for per-event routing
+    bool remoteRoutesStale;                     // Set whenever remotes changes
     
     // For events that require destination names during init
     std::set<MemEventInit*> initSendQ;
@@ -30,6 +30,7 @@
 #include "sst/elements/memHierarchy/memEventBase.h"
 #include "sst/elements/memHierarchy/util.h"
 #include "sst/elements/memHierarchy/memTypes.h"
+#include "sst/elements/memHierarchy/addrRouteTable.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -159,8 +160,8 @@ public:
     void recvNotify(SST::Event * ev) { (*recvHandler)(ev); }
 
     /* Functions for managing communication according to address */
-    virtual std::string findTargetDestination(Addr addr) =0;    /* Return destination and return "" if none found */
-    virtual std::string getTargetDestination(Addr addr) =0;     /* Return destination and error if none found */
+    virtual const std::string& findTargetDestination(Addr addr) =0;    /* Return destination and return "" if none found */
+    virtual const std::string& getTargetDestination(Addr addr) =0;     /* Return destination and error if none found */
     
     /* Check if a request address maps to our region */
     virtual bool isRequestAddressValid(Addr addr) { return info.region.contains(addr); }
@@ -114,7 +114,7 @@ class MemNICBase : public MemLinkBase {
         // Init functions
         virtual void sendInitData(MemEventInit * ev, bool broadcast = true) {
             if (!broadcast) {
-                std::string dst = findTargetDestination(ev->getRoutingAddress());
+                const std::string& dst = findTargetDestination(ev->getRoutingAddress());
                 if (dst == "") {
                     // Hold this request until we know the right address
                     initWaitForDst.insert(ev);
@@ -159,15 +159,19 @@ class MemNICBase : public MemLinkBase {
         virtual std::set<EndpointInfo>* getSources() { return &sourceEndpointInfo; }
         virtual std::set<EndpointInfo>* getDests() { return &destEndpointInfo; }
         
-        virtual std::string findTargetDestination(Addr addr) {
-            for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
-                if (it->region.contains(addr)) return it->name;
+        virtual const std::string& findTargetDestination(Addr addr) {
+            if (destRoutesStale) {
+                destRoutes.clear();
+                for (std::set<EndpointInfo>::const_iterator it = destEndpointInfo.begin(); it != destEndpointInfo.end(); it++) {
+                    destRoutes.addRegion(it->name, it->region);
+                }
+                destRoutesStale = false;
             }
-            return "";
+            return destRoutes.getName(destRoutes.lookup(addr));
         }
 
-        virtual std::string getTargetDestination(Addr addr) {
-            std::string dst = findTargetDestination(addr);
+        virtual const std::string& getTargetDestination(Addr addr) {
+            const std::string& dst = findTargetDestination(addr);
             if (dst != "") {
                 return dst;
             }
@@ -179,7 +183,7 @@ class MemNICBase : public MemLinkBase {
                 error << it->name << " " << it->region.toString() << endl;
             }
             dbg.fatal(CALL_INFO, -1, "%s", error.str().c_str());
-            return "";
+            return dst;
         }
 
         virtual bool isReachable(std::string dst) {
@@ -202,6 +206,7 @@ class MemNICBase : public MemLinkBase {
         }
         virtual void addDest(EndpointInfo info) { 
             destEndpointInfo.insert(info); 
+            destRoutesStale = true;
             reachableNames.insert(info.name);
         }
 
@@ -237,7 +242,7 @@ class MemNICBase : public MemLinkBase {
                 }
 
                 for (auto it = initWaitForDst.begin(); it != initWaitForDst.end();) {
-                    std::string dst = findTargetDestination((*it)->getRoutingAddress());
+                    const std::string& dst = findTargetDestination((*it)->getRoutingAddress());
                     if (dst != "") {
                         (*it)->setDst(dst);
                         MemRtrEvent * mre = new MemRtrEvent(*it);
@@ -356,6 +361,7 @@ class MemNICBase : public MemLinkBase {
                 }
             }
             destEndpointInfo = newDests;
+            destRoutesStale = true;
             
             int stopAfter = 20; // This is error checking, if it takes too long, stop
             for (auto et = destEndpointInfo.begin(); et != destEndpointInfo.end(); et++) {
@@ -482,6 +488,8 @@ class MemNICBase : public MemLinkBase {
         std::set<EndpointInfo> destEndpointInfo;
         std::set<EndpointInfo> endpointInfo;
         std::set<std::string> reachableNames;
+        AddrRouteTable destRoutes;  // Compiled from destEndpointInfo for per-event routing
+        bool destRoutesStale;       // Set whenever destEndpointInfo changes
 
         // Init queues
         std::queue<MemRtrEvent*> initQueue; // Queue for received init events
@@ -541,6 +549,7 @@ class MemNICBase : public MemLinkBase {
                     destIDs.insert(info.id + 1);
             }
             initMsgSent = false;
+            destRoutesStale = false;
 
             dbg.debug(_L10_, "%s memNICBase info is: Name: %s, group: %" PRIu32 "\n",
                     getName().c_str(), info.name.c_str(), info.id);
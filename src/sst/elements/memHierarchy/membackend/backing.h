@@ -18,12 +18,62 @@
 
 #include <fcntl.h>
 #include <unistd.h>
+#include <sys/mman.h>
+#include <cstring>
+#include <algorithm>
+#include <map>
+#include <vector>
 #include "sst/elements/memHierarchy/util.h"
 
 namespace SST {
 namespace MemHierarchy {
 namespace Backend {
 
+/* Bitmap of the 4KiB pages of a store that have been written */
+class TouchedPages {
+public:
+    static const unsigned int shift = 12;
+
+    void resize(size_t size) {
+        m_bits.assign(((size >> shift) + 64) / 64, 0);
+    }
+
+    void mark(Addr offset, size_t size) {
+        if (size == 0) return;
+        for (Addr page = offset >> shift; page <= (offset + size - 1) >> shift; page++)
+            m_bits[page / 64] |= (uint64_t)1 << (page % 64);
+    }
+
+    /* Return the first touched page at or after 'page', or a page past the end if there is none */
+    size_t next(size_t page) const {
+        size_t word = page / 64;
+        if (word >= m_bits.size())
+            return m_bits.size() * 64;
+        uint64_t bits = m_bits[word] & (~(uint64_t)0 << (page % 64));
+        while (bits == 0) {
+            if (++word == m_bits.size())
+                return m_bits.size() * 64;
+            bits = m_bits[word];
+        }
+        return word * 64 + __builtin_ctzll(bits);
+    }
+
+private:
+    std::vector<uint64_t> m_bits;
+};
+
+/*
+ * A contiguous range of backing storage starting at address 'addr'.
+ * If 'touched' is set, pages it does not mark have never been written and
+ * read as zero. Otherwise any page may hold data.
+ */
+struct BackingRegion {
+    Addr addr;
+    size_t size;
+    const uint8_t* data;
+    const TouchedPages* touched;
+};
+
 class Backing {
 public:
     Backing( ) { }
@@ -34,6 +84,12 @@ public:
 
     virtual uint8_t get( Addr addr) = 0;
     virtual void get( Addr addr, size_t size, std::vector<uint8_t>& data) = 0;
+
+    /* Append the regions that may hold data, in address order. Used to snapshot the store. */
+    virtual void getRegions( std::vector<BackingRegion>& regions ) = 0;
+
+    /* Whether 'size' bytes at 'addr' lie inside the store */
+    virtual bool contains( Addr addr, size_t size ) = 0;
 };
 
 class BackingMMAP : public Backing {
@@ -53,6 +109,7 @@ public:
         if ( m_buffer == MAP_FAILED) {
             throw 2;
         }
+        m_touched.resize(size);
     }
 
     ~BackingMMAP() {
@@ -64,11 +121,12 @@ public:
 
     void set( Addr addr, uint8_t value ) {
         m_buffer[addr - m_offset ] = value;
+        m_touched.mark(addr - m_offset, 1);
     }
 
     void set (Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            m_buffer[addr + i] = data[i];
+        memcpy(m_buffer + (addr - m_offset), data.data(), size);
+        m_touched.mark(addr - m_offset, size);
     }
 
     uint8_t get( Addr addr ) {
@@ -76,97 +134,199 @@ public:
     }
 
     void get( Addr addr, size_t size, std::vector<uint8_t> &data) {
-        for (size_t i = 0; i < size; i++)
-            data[i] = m_buffer[addr + i];
+        memcpy(data.data(), m_buffer + (addr - m_offset), size);
+    }
+
+    /* Pages of a memory file hold data without being written */
+    void getRegions( std::vector<BackingRegion>& regions ) {
+        regions.push_back({m_offset, m_size, m_buffer, m_fd < 0 ? &m_touched : nullptr});
+    }
+
+    bool contains( Addr addr, size_t size ) {
+        return addr >= m_offset && addr - m_offset <= m_size && size <= m_size - (addr - m_offset);
     }
 
 private:
     uint8_t* m_buffer;
+    TouchedPages m_touched;
     int m_fd;
-    int m_size;
+    size_t m_size;
     size_t m_offset;
 };
 
+/*
+ * Anonymous backing store that reserves, but does not commit, the whole
+ * simulated address range. The OS supplies zero-filled pages as they are
+ * first touched so untouched memory costs nothing and every access is a
+ * single offset computation. Transparent huge pages can be requested to cut
+ * TLB misses on large memories. Throws 2 if the range cannot be reserved.
+ */
+class BackingSparse : public Backing {
+public:
+    BackingSparse(size_t size, bool hugePages = false, size_t offset = 0) : Backing(), m_size(size), m_offset(offset) {
+        m_buffer = (uint8_t*)mmap(NULL, size, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANON|MAP_NORESERVE, -1, 0);
+
+        if ( m_buffer == MAP_FAILED) {
+            throw 2;
+        }
+#ifdef MADV_HUGEPAGE
+        if (hugePages)
+            madvise(m_buffer, size, MADV_HUGEPAGE); /* Advisory only, ignore failure */
+#endif
+        m_touched.resize(size);
+    }
+
+    ~BackingSparse() {
+        munmap( m_buffer, m_size );
+    }
+
+    void set( Addr addr, uint8_t value ) {
+        m_buffer[addr - m_offset] = value;
+        m_touched.mark(addr - m_offset, 1);
+    }
+
+    void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+        memcpy(m_buffer + (addr - m_offset), data.data(), size);
+        m_touched.mark(addr - m_offset, size);
+    }
+
+    uint8_t get( Addr addr ) {
+        return m_buffer[addr - m_offset];
+    }
+
+    void get( Addr addr, size_t size, std::vector<uint8_t> &data ) {
+        memcpy(data.data(), m_buffer + (addr - m_offset), size);
+    }
+
+    void getRegions( std::vector<BackingRegion>& regions ) {
+        regions.push_back({m_offset, m_size, m_buffer, &m_touched});
+    }
+
+    bool contains( Addr addr, size_t size ) {
+        return addr >= m_offset && addr - m_offset <= m_size && size <= m_size - (addr - m_offset);
+    }
+
+private:
+    uint8_t* m_buffer;
+    TouchedPages m_touched;
+    size_t m_size;
+    size_t m_offset;
+};
+
+/*
+ * Backing store built from 'size'-byte chunks allocated on first touch.
+ * Chunks are found through leaf tables of 4096 chunk pointers. The leaf
+ * tables are kept in a map, so sparse use of a very large address space
+ * stays cheap, and the last leaf table used is cached so that most lookups
+ * are two array indexes rather than a map lookup.
+ */
 class BackingMalloc : public Backing {
 public:
-    BackingMalloc(size_t size) {
+    BackingMalloc(size_t size, size_t memSize) {
         m_allocUnit = size;
+        m_memSize = memSize;
         /* Alloc unit needs to be pwr-2 */
         if (!isPowerOfTwo(m_allocUnit)) {
             Output out("", 1, 0, Output::STDOUT);
             out.fatal(CALL_INFO, -1, "BackingMalloc: Error - size must be a power of two. Got: %zu\n", size);
         }
         m_shift = log2Of(m_allocUnit);
+        m_lastTop = 0;
+        m_lastLeaves = nullptr;
+    }
+
+    ~BackingMalloc() {
+        for (std::map<Addr, uint8_t**>::iterator it = m_buffer.begin(); it != m_buffer.end(); it++) {
+            for (size_t j = 0; j < leafSize; j++)
+                free(it->second[j]);
+            delete [] it->second;
+        }
     }
 
     void set( Addr addr, uint8_t value ) {
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        m_buffer[bAddr][offset] = value;
+        Addr offset = addr & (m_allocUnit - 1);
+        chunk(addr >> m_shift)[offset] = value;
     }
 
     void set( Addr addr, size_t size, std::vector<uint8_t> &data ) {
         /* Account for size exceeding alloc unit size */
         Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
+        Addr offset = addr & (m_allocUnit - 1);
         size_t dataOffset = 0;
 
-        allocIfNeeded(bAddr);
-
         while (dataOffset != size) {
-            m_buffer[bAddr][offset] = data[dataOffset];
-            offset++;
-            dataOffset++;
-
-            if (offset == m_allocUnit) {
-                offset = 0;
-                bAddr++;
-                allocIfNeeded(bAddr);
-            }
+            size_t copy = std::min(size - dataOffset, (size_t)(m_allocUnit - offset));
+            memcpy(chunk(bAddr) + offset, data.data() + dataOffset, copy);
+            dataOffset += copy;
+            offset = 0;
+            bAddr++;
         }
     }
 
     void get (Addr addr, size_t size, std::vector<uint8_t> &data) {
         Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
+        Addr offset = addr & (m_allocUnit - 1);
         size_t dataOffset = 0;
 
-        allocIfNeeded(bAddr);
-
         while (dataOffset != size) {
-            data[dataOffset] = m_buffer[bAddr][offset];
-            offset++;
-            dataOffset++;
-            if (offset == m_allocUnit) {
-                bAddr++;
-                offset = 0;
-                allocIfNeeded(bAddr);
-            }
+            size_t copy = std::min(size - dataOffset, (size_t)(m_allocUnit - offset));
+            memcpy(data.data() + dataOffset, chunk(bAddr) + offset, copy);
+            dataOffset += copy;
+            offset = 0;
+            bAddr++;
         }
     }
 
     uint8_t get( Addr addr ) {
-        Addr bAddr = addr >> m_shift;
-        Addr offset = addr - (bAddr << m_shift);
-        allocIfNeeded(bAddr);
-        return m_buffer[bAddr][offset];
+        Addr offset = addr & (m_allocUnit - 1);
+        return chunk(addr >> m_shift)[offset];
+    }
+
+    void getRegions( std::vector<BackingRegion>& regions ) {
+        for (std::map<Addr, uint8_t**>::iterator it = m_buffer.begin(); it != m_buffer.end(); it++) {
+            for (size_t j = 0; j < leafSize; j++) {
+                if (it->second[j] != nullptr)
+                    regions.push_back({((it->first << leafBits) + j) << m_shift, m_allocUnit, it->second[j], nullptr});
+            }
+        }
+    }
+
+    bool contains( Addr addr, size_t size ) {
+        return addr <= m_memSize && size <= m_memSize - addr;
     }
 
 private:
-    void allocIfNeeded(Addr bAddr) {
-        if (m_buffer.find(bAddr) == m_buffer.end()) {
-            uint8_t* data = (uint8_t*) malloc(sizeof(uint8_t)*m_allocUnit);
+    static const unsigned int leafBits = 12;
+    static const size_t leafSize = (size_t)1 << leafBits;
+
+    /* Return the chunk holding chunk number 'bAddr', allocating it if needed */
+    uint8_t* chunk(Addr bAddr) {
+        Addr top = bAddr >> leafBits;
+        Addr leaf = bAddr & (leafSize - 1);
+        if (m_lastLeaves == nullptr || top != m_lastTop) {
+            uint8_t**& leaves = m_buffer[top];
+            if (leaves == nullptr)
+                leaves = new uint8_t*[leafSize]();
+            m_lastTop = top;
+            m_lastLeaves = leaves;
+        }
+        uint8_t* data = m_lastLeaves[leaf];
+        if (data == nullptr) {
+            data = (uint8_t*) calloc(m_allocUnit, sizeof(uint8_t));
             if (!data) {
                 Output out("", 1, 0, Output::STDOUT);
                 out.fatal(CALL_INFO, -1, "BackingMalloc: Error - malloc failed.\n");
             }
-            m_buffer[bAddr] = data;
+            m_lastLeaves[leaf] = data;
         }
+        return data;
     }
 
-    std::unordered_map<Addr,uint8_t*> m_buffer;
-    unsigned int m_allocUnit;
+    std::map<Addr, uint8_t**> m_buffer;
+    Addr m_lastTop;
+    uint8_t** m_lastLeaves;
+    size_t m_allocUnit;
+    size_t m_memSize;
     unsigned int m_shift;
 };
 
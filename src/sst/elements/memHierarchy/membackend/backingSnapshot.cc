@@ -0,0 +1,200 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+
+#include <sst_config.h>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+
+#ifdef HAVE_LIBZ
+#include <zlib.h>
+#endif
+
+#include "sst/elements/memHierarchy/membackend/backingSnapshot.h"
+
+using namespace SST::MemHierarchy::Backend;
+
+static const char snapshotMagic[8] = { 'M', 'H', 'S', 'N', 'A', 'P', 0, 1 };
+static const uint32_t snapshotVersion = 1;
+
+namespace {
+
+struct PageEntry {
+    uint64_t addr;
+    uint64_t offset;
+    uint32_t size;      // Bytes of memory in the page
+    uint32_t length;    // Bytes stored in the file
+};
+
+/* Closes the file on every exit path, including throws */
+class SnapshotFile {
+public:
+    SnapshotFile(const std::string& name, const char* mode) {
+        fp = fopen(name.c_str(), mode);
+        if (!fp)
+            throw 1;
+    }
+    ~SnapshotFile() { fclose(fp); }
+
+    void write(const void* data, size_t size) {
+        if (size && fwrite(data, 1, size, fp) != size)
+            throw 2;
+    }
+    void read(void* data, size_t size) {
+        if (size && fread(data, 1, size, fp) != size)
+            throw 3;
+    }
+    uint64_t tell() {
+        long pos = ftell(fp);
+        if (pos < 0)
+            throw 2;
+        return pos;
+    }
+    void seek(uint64_t pos) {
+        if (fseek(fp, pos, SEEK_SET) != 0)
+            throw 3;
+    }
+
+    FILE* fp;
+};
+
+bool isZero(const uint8_t* data, size_t size) {
+    static const uint8_t zeros[256] = { 0 };
+    while (size >= sizeof(zeros)) {
+        if (memcmp(data, zeros, sizeof(zeros)) != 0)
+            return false;
+        data += sizeof(zeros);
+        size -= sizeof(zeros);
+    }
+    return memcmp(data, zeros, size) == 0;
+}
+
+}
+
+uint64_t SST::MemHierarchy::Backend::saveSnapshot(Backing* backing, const std::string& file, uint32_t pageSize) {
+    std::vector<BackingRegion> regions;
+    backing->getRegions(regions);
+
+    SnapshotFile out(file, "wb");
+    uint64_t pageCount = 0;
+    uint64_t indexOffset = 0;
+
+    /* Header is rewritten with the page count and index offset once the pages are out */
+    out.write(snapshotMagic, sizeof(snapshotMagic));
+    out.write(&snapshotVersion, sizeof(snapshotVersion));
+    out.write(&pageSize, sizeof(pageSize));
+    out.write(&pageCount, sizeof(pageCount));
+    out.write(&indexOffset, sizeof(indexOffset));
+
+    std::vector<PageEntry> index;
+#ifdef HAVE_LIBZ
+    std::vector<uint8_t> compressed(compressBound(pageSize));
+#endif
+
+    for (std::vector<BackingRegion>::iterator it = regions.begin(); it != regions.end(); it++) {
+        for (size_t off = 0; off < it->size; off += pageSize) {
+            /* Jump over pages never written without reading them, which would fault them in */
+            if (it->touched) {
+                size_t next = it->touched->next(off >> TouchedPages::shift) << TouchedPages::shift;
+                if (next >= it->size)
+                    break;
+                off = std::max(off, next / pageSize * pageSize);
+            }
+
+            const uint8_t* page = it->data + off;
+            uint32_t length = std::min((size_t)pageSize, it->size - off);
+            if (isZero(page, length))
+                continue;
+
+            PageEntry entry = { it->addr + off, out.tell(), length, length };
+            const uint8_t* payload = page;
+#ifdef HAVE_LIBZ
+            uLongf clen = compressed.size();
+            if (compress2(compressed.data(), &clen, page, length, Z_BEST_SPEED) == Z_OK && clen < length) {
+                entry.length = clen;
+                payload = compressed.data();
+            }
+#endif
+            out.write(payload, entry.length);
+            index.push_back(entry);
+        }
+    }
+
+    indexOffset = out.tell();
+    for (std::vector<PageEntry>::iterator it = index.begin(); it != index.end(); it++) {
+        out.write(&it->addr, sizeof(it->addr));
+        out.write(&it->offset, sizeof(it->offset));
+        out.write(&it->size, sizeof(it->size));
+        out.write(&it->length, sizeof(it->length));
+    }
+
+    pageCount = index.size();
+    if (fseek(out.fp, sizeof(snapshotMagic) + sizeof(snapshotVersion) + sizeof(pageSize), SEEK_SET) != 0)
+        throw 2;
+    out.write(&pageCount, sizeof(pageCount));
+    out.write(&indexOffset, sizeof(indexOffset));
+    return pageCount;
+}
+
+uint64_t SST::MemHierarchy::Backend::loadSnapshot(Backing* backing, const std::string& file) {
+    SnapshotFile in(file, "rb");
+
+    char magic[sizeof(snapshotMagic)];
+    uint32_t version, pageSize;
+    uint64_t pageCount, indexOffset;
+    in.read(magic, sizeof(magic));
+    in.read(&version, sizeof(version));
+    in.read(&pageSize, sizeof(pageSize));
+    in.read(&pageCount, sizeof(pageCount));
+    in.read(&indexOffset, sizeof(indexOffset));
+    if (memcmp(magic, snapshotMagic, sizeof(magic)) != 0 || version != snapshotVersion || pageSize == 0)
+        throw 3;
+
+    std::vector<PageEntry> index(pageCount);
+    in.seek(indexOffset);
+    for (uint64_t i = 0; i < pageCount; i++) {
+        in.read(&index[i].addr, sizeof(index[i].addr));
+        in.read(&index[i].offset, sizeof(index[i].offset));
+        in.read(&index[i].size, sizeof(index[i].size));
+        in.read(&index[i].length, sizeof(index[i].length));
+        if (index[i].size > pageSize || index[i].length > index[i].size)
+            throw 3;
+        if (!backing->contains(index[i].addr, index[i].size))
+            throw 5;
+    }
+
+    std::vector<uint8_t> page(pageSize);
+    std::vector<uint8_t> stored(pageSize);
+    for (uint64_t i = 0; i < pageCount; i++) {
+        in.seek(index[i].offset);
+        if (index[i].length == index[i].size) {
+            in.read(page.data(), index[i].size);
+        } else {
+#ifdef HAVE_LIBZ
+            in.read(stored.data(), index[i].length);
+            uLongf plen = index[i].size;
+            if (uncompress(page.data(), &plen, stored.data(), index[i].length) != Z_OK || plen != index[i].size)
+                throw 3;
+#else
+            throw 4;
+#endif
+        }
+        backing->set(index[i].addr, index[i].size, page);
+    }
+    return pageCount;
+}
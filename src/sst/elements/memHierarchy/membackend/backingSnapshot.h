@@ -0,0 +1,62 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef __SST_MEMH_BACKEND_BACKING_SNAPSHOT
+#define __SST_MEMH_BACKEND_BACKING_SNAPSHOT
+
+#include <string>
+#include "sst/elements/memHierarchy/membackend/backing.h"
+
+namespace SST {
+namespace MemHierarchy {
+namespace Backend {
+
+/*
+ * Snapshots of a functional backing store
+ *
+ * A snapshot holds only the pages of the store that contain non-zero data.
+ * Each page is compressed independently (zlib, when available) and located
+ * through a page index at the end of the file so that a snapshot can be
+ * loaded into any backing type and any memory size that covers its pages.
+ *
+ * Only the backing store is captured. Lines that caches above the memory
+ * controller hold dirty are not written back for the snapshot, so a snapshot
+ * taken while they are in the caches has the older memory copy of them.
+ *
+ * File layout (host byte order):
+ *   header: char magic[8], uint32 version, uint32 pageSize, uint64 pageCount, uint64 indexOffset
+ *   pages:  page data, back to back
+ *   index:  pageCount x { uint64 addr, uint64 fileOffset, uint32 size, uint32 length }
+ * 'size' is the number of bytes of memory in the page and 'length' the number
+ * stored in the file; a page whose length equals its size is uncompressed.
+ *
+ * Errors are reported by throwing: 1 - file could not be opened,
+ * 2 - I/O error, 3 - not a valid snapshot, 4 - snapshot is compressed but
+ * zlib support was not built in, 5 - snapshot has pages outside the backing
+ * store. Pages are checked before any is loaded.
+ */
+
+/* Write the non-zero pages of 'backing' to 'file'. Returns the number of pages written. */
+uint64_t saveSnapshot(Backing* backing, const std::string& file, uint32_t pageSize = 4096);
+
+/* Load the pages in 'file' into 'backing'. Returns the number of pages loaded. */
+uint64_t loadSnapshot(Backing* backing, const std::string& file);
+
+}
+}
+}
+
+#endif
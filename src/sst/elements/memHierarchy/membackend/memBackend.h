@@ -45,6 +45,7 @@ public:
             {"debug_location",  "(uint) 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE", "0"},\
             {"max_requests_per_cycle", "(int) Maximum number of requests to accept each cycle. Use 0 or -1 for unlimited.", "-1"},\
             {"request_width", "(int) Maximum size, in bytes, for a request", "64"},\
+            {"idle_fastforward", "(bool) For backends that support it (simpleDRAM, timingDRAM, reorderByRow), stop clocking the backend while it is idle or only waiting on in-flight requests, and wake it when it next has work.", "false"},\
             {"mem_size", "(string) Size of memory with units (SI ok). E.g., '2GiB'.", NULL}
 
     typedef MemBackendConvertor::ReqId ReqId;
@@ -59,6 +60,7 @@ public:
         m_maxReqPerCycle = params.find<>("max_requests_per_cycle",-1);
         if (m_maxReqPerCycle == 0) m_maxReqPerCycle = -1;
         m_reqWidth = params.find<uint32_t>("request_width",64);
+        m_idleFastForward = params.find<bool>("idle_fastforward", false);
 
         bool found;
         UnitAlgebra backendRamSize = UnitAlgebra(params.find<std::string>("mem_size", "0B", found));
@@ -87,6 +89,25 @@ public:
     /* Called by parent's clock() function */
     virtual bool clock(Cycle_t UNUSED(cycle)) { return true; }
 
+    /* Idle fast-forward
+     * A backend that can fast-forward may return true from clock() while requests are in flight,
+     * and a request it rejects is not retried every cycle. In return, its state must not change
+     * until one of:
+     *  - the cycle returned by getWakeCycle() (same numbering as clock(), 0 for none)
+     *  - a new request is issued to it
+     *  - it sends a response or calls enableClock()
+     * So clock() must not return true on a cycle that made room for a request it had rejected.
+     * The parent reports the number of clock() calls it skipped via skipCycles() before the next
+     * clock() or request.
+     */
+    virtual bool canFastForward() { return false; }
+    virtual Cycle_t getWakeCycle() { return 0; }
+    virtual void skipCycles(Cycle_t UNUSED(cycles)) { }
+
+    virtual void setEnableClockHandler( std::function<void()> func ) {
+        m_enableClockFunc = func;
+    }
+
     /* Interface to parent */
     virtual size_t getMemSize() { return m_memSize; }
     virtual uint32_t getRequestWidth() { return m_reqWidth; }
@@ -100,12 +121,20 @@ public:
     virtual std::string getBackendConvertorType() = 0; /* Backend must return the compatible convertor type */
 
 protected:
+    /* Restart the parent's clock, e.g., when a bank frees up for a rejected request */
+    void enableClock() {
+        if (m_enableClockFunc)
+            m_enableClockFunc();
+    }
+
     Output*         output;
     int32_t         m_maxReqPerCycle;
     size_t          m_memSize;
     uint32_t        m_reqWidth;
+    bool            m_idleFastForward;
 
     std::function<const std::string(ReqId)> m_getRequestor;
+    std::function<void()> m_enableClockFunc;
 };
 
 /* MemBackend - timing only */
@@ -40,6 +40,7 @@ MemBackendConvertor::MemBackendConvertor(ComponentId_t id, Params& params, MemBa
 
     using std::placeholders::_1;
     m_backend->setGetRequestorHandler( std::bind( &MemBackendConvertor::getRequestor, this, _1 )  );
+    m_backend->setEnableClockHandler( std::bind( &MemBackendConvertor::enableClock, this ) );
 
     m_frontendRequestWidth =  request_width;
     m_backendRequestWidth = static_cast<SimpleMemBackend*>(m_backend)->getRequestWidth();
@@ -99,6 +100,7 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
 
     int reqsThisCycle = 0;
     bool cycleWithIssue = false;
+    bool rejected = false;
     while ( !m_requestQueue.empty()) {
         if ( reqsThisCycle == m_backend->getMaxReqPerCycle() ) {
             break;
@@ -111,6 +113,7 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
             cycleWithIssue = true;
         } else {
             cycleWithIssue = false;
+            rejected = true;
             stat_cyclesAttemptIssueButRejected->addData(1);
             break;
         }
@@ -135,25 +138,50 @@ bool MemBackendConvertor::clock(Cycle_t cycle) {
 
     // Can turn off the clock if:
     // 1) backend says it's ok
-    // 2) requestQueue is empty
+    // 2) requestQueue is empty, or the backend rejected the head and will wake us when it can take it
     if (unclock && m_requestQueue.empty())
         return true;
 
+    if (unclock && rejected && m_backend->canFastForward())
+        return true;
+
     return false;
 }
 
 /*
  * Called by MemController to turn the clock back on
  * cycle = current cycle
+ * Statistics are updated as if clock() had been called on each cycle the clock was off
  */
 void MemBackendConvertor::turnClockOn(Cycle_t cycle) {
     Cycle_t cyclesOff = cycle - m_cycleCount;
     for (Cycle_t i = 0; i < cyclesOff; i++)
         stat_outstandingReqs->addData( m_pendingRequests.size() );
+
+    // Only a fast-forwarding backend leaves requests waiting while the clock is off; each
+    // skipped cycle would have been another rejected attempt
+    if (!m_requestQueue.empty()) {
+        for (Cycle_t i = 0; i < cyclesOff; i++)
+            stat_cyclesAttemptIssueButRejected->addData(1);
+    }
+
+    if (m_clockBackend && cyclesOff != 0)
+        m_backend->skipCycles(cyclesOff);
+
     m_cycleCount = cycle;
     m_clockOn = true;
 }
 
+/*
+ * Called by the backend to restart the clock
+ */
+void MemBackendConvertor::enableClock() {
+    if (!m_clockOn) {
+        Cycle_t cycle = m_enableClock();
+        turnClockOn(cycle);
+    }
+}
+
 /*
  * Called by MemController to turn the clock off
  */
@@ -164,10 +192,7 @@ void MemBackendConvertor::turnClockOff() {
 void MemBackendConvertor::doResponse( ReqId reqId, uint32_t flags ) {
 
     /* If clock is not on, turn it back on */
-    if (!m_clockOn) {
-        Cycle_t cycle = m_enableClock();
-        turnClockOn(cycle);
-    }
+    enableClock();
 
     uint32_t id = BaseReq::getBaseId(reqId);
     MemEvent* resp = NULL;
@@ -241,3 +266,11 @@ size_t MemBackendConvertor::getMemSize() {
 uint32_t MemBackendConvertor::getRequestWidth() {
     return m_backend->getRequestWidth();
 }
+
+/*
+ * Cycle at which a fast-forwarding backend needs the clock again, 0 if it doesn't
+ * Valid when clock() returns true
+ */
+Cycle_t MemBackendConvertor::getWakeCycle() {
+    return m_backend->getWakeCycle();
+}
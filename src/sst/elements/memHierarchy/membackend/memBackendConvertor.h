@@ -156,6 +156,7 @@ class MemBackendConvertor : public SubComponent {
     virtual void handleCustomEvent( CustomCmdInfo* );
     virtual uint32_t getRequestWidth();
     virtual bool isBackendClocked() { return m_clockBackend; }
+    virtual Cycle_t getWakeCycle();
 
     virtual const std::string getRequestor( ReqId reqId ) {
         uint32_t id = BaseReq::getBaseId(reqId);
@@ -180,6 +181,7 @@ class MemBackendConvertor : public SubComponent {
     }
 
     void doResponse( ReqId reqId, uint32_t flags = 0 );
+    void enableClock();
     inline void sendResponse( SST::Event::id_type id, uint32_t flags );
 
     MemBackend* m_backend;
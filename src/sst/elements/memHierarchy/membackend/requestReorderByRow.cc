@@ -94,9 +94,9 @@ bool RequestReorderRow::issueRequest(ReqId id, Addr addr, bool isWrite, unsigned
  */
 bool RequestReorderRow::clock(Cycle_t cycle) {
 
+    int reqsIssuedThisCycle = 0;
     if (!requestQueue.empty()) {
 
-        int reqsIssuedThisCycle = 0;
         int reqsSearchedThisCycle = 0;
         // For current bank
         unsigned int bank = nextBank;
@@ -151,6 +151,11 @@ bool RequestReorderRow::clock(Cycle_t cycle) {
     }
 
     bool unclock = backend->clock(cycle);
+
+    // Anything left in the queues was rejected by the backend, which will wake us when it can take more
+    if (canFastForward())
+        return unclock && reqsIssuedThisCycle == 0;
+
     return false;
 }
 
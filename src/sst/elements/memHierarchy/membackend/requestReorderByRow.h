@@ -51,6 +51,15 @@ public:
     void finish();
     bool clock(Cycle_t cycle);
 
+    /* Fast-forward if our backend can: requests left in our queues are waiting on it */
+    bool canFastForward() { return m_idleFastForward && backend->canFastForward(); }
+    Cycle_t getWakeCycle() { return backend->getWakeCycle(); }
+    void skipCycles(Cycle_t cycles) { backend->skipCycles(cycles); }
+    void setEnableClockHandler( std::function<void()> func ) {
+        SimpleMemBackend::setEnableClockHandler(func);
+        backend->setEnableClockHandler(func);
+    }
+
 private:
 
     void handleMemReponse( ReqId id ) {
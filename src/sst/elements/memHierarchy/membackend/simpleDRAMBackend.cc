@@ -39,6 +39,7 @@ using namespace SST::MemHierarchy;
  *  SimpleDRAM relies on external (memController or other backend) request limiting. SimpleDRAM will block banks but will accept multiple requests per cycle if they don't have a bank conflict.
  *  SimpleDRAM assumes transfer granularity is a cache line -> this can be changed by changing 'cache_line_size_in_bytes'
  *  SimpleDRAM does not model bus contention back to the controller -> possible for multiple requests to return in the same cycle
+ *  SimpleDRAM restarts the parent's clock when a bank that rejected a request frees up, so the parent need not retry every cycle
  *
  *  TODO
  *   * Randomize bank bits?
@@ -98,9 +99,11 @@ SimpleDRAM::SimpleDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id,
     // Bookkeeping for bank/row state
     busy = (bool*) malloc(sizeof(bool) * banks);
     openRow = (int*) malloc(sizeof(int) * banks);
+    waiting = (bool*) malloc(sizeof(bool) * banks);
     for (int i = 0; i < banks; i++) {
         openRow[i] = -1;
         busy[i] = false;
+        waiting[i] = false;
     }
 
     // Self link for timing requests
@@ -121,17 +124,26 @@ void SimpleDRAM::handleSelfEvent(SST::Event *event){
         if (policy == RowPolicy::CLOSED) {
             self_link->send(tRP, new MemCtrlEvent(ev->bank));
         } else {
-            busy[ev->bank] = false;
+            freeBank(ev->bank);
         }
         handleMemResponse(ev->reqId);
         delete event;
     } else {
         openRow[ev->bank] = -1;
-        busy[ev->bank] = false;
+        freeBank(ev->bank);
         delete event;
     }
 }
 
+void SimpleDRAM::freeBank(int bank) {
+    busy[bank] = false;
+    if (waiting[bank]) {
+        waiting[bank] = false;
+        if (m_idleFastForward)
+            enableClock();
+    }
+}
+
 bool SimpleDRAM::issueRequest( ReqId reqId, Addr addr, bool isWrite, unsigned numBytes ){
 
     // Determine bank & row for address
@@ -145,7 +157,10 @@ bool SimpleDRAM::issueRequest( ReqId reqId, Addr addr, bool isWrite, unsigned nu
 #endif
 
     // If bank is busy -> return false;
-    if (busy[bank]) return false;
+    if (busy[bank]) {
+        waiting[bank] = true;
+        return false;
+    }
 
     int latency = tCAS;
     if (openRow[bank] != row) {
@@ -51,16 +51,19 @@ public:
     SimpleDRAM(ComponentId_t id, Params &params);
     bool issueRequest( ReqId, Addr, bool, unsigned );
     bool isClocked() { return false; }
+    bool canFastForward() { return m_idleFastForward; }
 
     typedef enum {OPEN, CLOSED, DYNAMIC, TIMEOUT } RowPolicy;
 
 private:
     void handleSelfEvent(SST::Event *event);
+    void freeBank(int bank);
 
     Link *self_link;
 
     int * openRow;
     bool * busy;
+    bool * waiting;     // A request to the bank was rejected while it was busy
 
     // Mapping parameters
     uint64_t lineOffset;
@@ -12,6 +12,10 @@
 
 #include <sst_config.h>
 #include <sst/core/timeLord.h>
+
+#include <algorithm>
+#include <limits>
+
 #include "membackend/timingDRAMBackend.h"
 
 using namespace SST;
@@ -22,7 +26,7 @@ bool TimingDRAM::Channel::m_printConfig = true;
 bool TimingDRAM::Rank::m_printConfig = true;
 bool TimingDRAM::Bank::m_printConfig = true;
 
-TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id, params), m_cycle(0) { 
+TimingDRAM::TimingDRAM(ComponentId_t id, Params &params) : SimpleMemBackend(id, params), m_cycle(0), m_wakeCycle(0), m_responded(false) { 
 
     int dram_id = params.find<int>("id", -1);
     assert( dram_id != -1 );
@@ -80,11 +84,29 @@ bool TimingDRAM::issueRequest( ReqId id, Addr addr, bool isWrite, unsigned numBy
 bool TimingDRAM::clock(Cycle_t cycle)
 {
     output->verbose(CALL_INFO, 5, DBG_MASK, "cycle %" PRIu64 "\n",m_cycle);
+    m_responded = false;
     for ( unsigned i = 0; i < m_channels.size(); i++ ) {
         m_channels[i]->clock(m_cycle);
     }
     ++m_cycle;
-    return false;
+
+    if ( ! m_idleFastForward || m_responded ) {
+        return false;
+    }
+
+    /* Nothing changes until a command completes or a new request arrives, so the clock can stop until then */
+    SimTime_t next = std::numeric_limits<SimTime_t>::max();
+    for ( unsigned i = 0; i < m_channels.size(); i++ ) {
+        next = std::min( next, m_channels[i]->getNextEventCycle(m_cycle) );
+        if ( next <= m_cycle ) {
+            return false;
+        }
+    }
+
+    m_wakeCycle = ( next == std::numeric_limits<SimTime_t>::max() ) ? 0 : cycle + 1 + (next - m_cycle);
+
+    output->verbose(CALL_INFO, 5, DBG_MASK, "idle until cycle %" PRIu64 "\n", next);
+    return true;
 }
 
 //==================================================================================
@@ -172,6 +194,29 @@ void TimingDRAM::Channel::clock( SimTime_t cycle )
     }
 }
 
+/*
+ * Earliest cycle at or after 'cycle' at which clock() would do anything
+ * Only commands completing count while every bank is stalled
+ */
+SimTime_t TimingDRAM::Channel::getNextEventCycle( SimTime_t cycle )
+{
+    if ( ! m_retiredTrans.empty() ) {
+        return cycle;
+    }
+
+    for ( unsigned i = 0; i < m_ranks.size(); i++ ) {
+        if ( ! m_ranks[i]->isStalled() ) {
+            return cycle;
+        }
+    }
+
+    SimTime_t next = std::numeric_limits<SimTime_t>::max();
+    for ( std::list<Cmd*>::iterator iter = m_issuedCmds.begin(); iter != m_issuedCmds.end(); ++iter ) {
+        next = std::min( next, (*iter)->getFiniTime() );
+    }
+    return next;
+}
+
 TimingDRAM::Cmd* TimingDRAM::Channel::popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle )
 {
     Cmd* cmd = nullptr;
@@ -228,6 +273,16 @@ TimingDRAM::Rank::Rank( ComponentId_t id, Params& params, unsigned mc, unsigned
     }
 }
 
+bool TimingDRAM::Rank::isStalled()
+{
+    for ( std::set<unsigned>::iterator iter = m_banksActive.begin(); iter != m_banksActive.end(); ++iter ) {
+        if ( ! m_banks[*iter]->isStalled() ) {
+            return false;
+        }
+    }
+    return true;
+}
+
 TimingDRAM::Cmd* TimingDRAM::Rank::popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle )
 {
     if (is_debug)
@@ -314,6 +369,25 @@ TimingDRAM::Cmd* TimingDRAM::Bank::popCmd( SimTime_t cycle, SimTime_t dataBusAva
     return cmd;
 }
 
+/*
+ * True if popCmd() cannot change this bank's state until its last command completes.
+ * An idle bank still in the active set is only removed from it, which has no effect.
+ * A bank with no command in flight may be counting down to a page close so is never stalled.
+ */
+bool TimingDRAM::Bank::isStalled()
+{
+    if ( isIdle() ) {
+        return true;
+    }
+
+    if ( nullptr == m_lastCmd || ! m_transQ->empty() ) {
+        return false;
+    }
+
+    // A COL may follow a COL before the first one completes
+    return m_cmdQ.empty() || m_cmdQ.front()->m_op != Cmd::COL || m_lastCmd->m_op != Cmd::COL;
+}
+
 void TimingDRAM::Bank::update( SimTime_t current )
 {
     if ( nullptr == m_lastCmd && m_row != -1 && m_pagePolicy->shouldClose( current ) ) {
@@ -103,6 +103,8 @@ private:
             return (m_row == -1 || !m_pagePolicy->canClose()) && m_cmdQ.empty() && m_transQ->empty();
         }
 
+        bool isStalled();
+
         unsigned getRank() { return m_rank; }
         unsigned getBank() { return m_bank; }
 
@@ -209,6 +211,8 @@ private:
             return ( now >= m_finiTime );
         }
 
+        SimTime_t getFiniTime() { return m_finiTime; }
+
         // these are used for debugging
         std::string& getName()  { return m_name; }
         unsigned getRank()      { return m_bank->getRank(); }
@@ -256,6 +260,8 @@ private:
             return !m_banksActive.empty();
         }
 
+        bool isStalled();
+
       private:
 
         const char* prefix() { return m_pre.c_str(); }
@@ -296,6 +302,7 @@ private:
         }
 
         void clock(SimTime_t );
+        SimTime_t getNextEventCycle(SimTime_t cycle);
 
       private:
         Cmd* popCmd( SimTime_t cycle, SimTime_t dataBusAvailCycle );
@@ -325,15 +332,22 @@ public:
     virtual bool issueRequest( ReqId, Addr, bool, unsigned );
     void handleResponse(ReqId  id ) {
         output->verbose(CALL_INFO, 2, DBG_MASK, "req=%" PRIu64 "\n", id );
+        m_responded = true;
         handleMemResponse( id );
     }
     virtual bool clock(Cycle_t cycle);
     virtual void finish() {}
 
+    virtual bool canFastForward() { return m_idleFastForward; }
+    virtual Cycle_t getWakeCycle() { return m_wakeCycle; }
+    virtual void skipCycles(Cycle_t cycles) { m_cycle += cycles; }
+
 private:
     std::vector<Channel*> m_channels;
     AddrMapper* m_mapper;
     SimTime_t   m_cycle;
+    Cycle_t     m_wakeCycle;    // When fast-forwarding, next cycle at which clock() has work
+    bool        m_responded;    // A response this cycle frees space for a previously rejected request
 
 };
 
@@ -84,6 +84,7 @@ MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Compo
     clockHandler_ = new Clock::Handler<MemCacheController>(this, &MemCacheController::clock);
     clockTimeBase_ = registerClock(clockfreq, clockHandler_);
     clockOn_ = true;
+    wakeSelfLink_ = configureSelfLink("wake", clockTimeBase_, new Event::Handler<MemCacheController>(this, &MemCacheController::handleWakeup));
 
     /* MemCacheController only supports new way of loading backend:
      *  -> Fill backend slot with backend and memcontroller loads the compatible convertor */
@@ -144,8 +145,8 @@ MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Compo
     std::string backingType = params.find<std::string>("backing", "mmap", found); /* Default to using an mmap backing store, fall back on malloc */
     backing_ = nullptr;
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -178,15 +179,24 @@ MemCacheController::MemCacheController(ComponentId_t id, Params &params) : Compo
             else if (e == 2) {
                 if (memoryFile == "") {
                     out.verbose(CALL_INFO, 1, 0, "%s, Could not MMAP backing store (likely, simulated memory exceeds real memory). Creating malloc based store instead.\n", getName().c_str());
-                    backing_ = new Backend::BackingMalloc(sizeBytes);
+                    backing_ = new Backend::BackingMalloc(sizeBytes, memBackendConvertor_->getMemSize());
                 } else {
                     out.fatal(CALL_INFO, -1, "%s, Error - Could not MMAP backing store from file %s\n", getName().c_str(), memoryFile.c_str());
                 }
             } else
                 out.fatal(CALL_INFO, -1, "%s, Error - unable to create backing store. Exception thrown is %d.\n", getName().c_str(), e);
         }
+    } else if (backingType == "sparse") {
+        bool hugePages = params.find<bool>("backing_huge_pages", false);
+        try {
+            backing_ = new Backend::BackingSparse( memBackendConvertor_->getMemSize(), hugePages );
+        }
+        catch ( int e ) {
+            out.verbose(CALL_INFO, 1, 0, "%s, Could not reserve sparse backing store (likely, simulated memory exceeds the virtual address space). Creating malloc based store instead.\n", getName().c_str());
+            backing_ = new Backend::BackingMalloc(sizeBytes, memBackendConvertor_->getMemSize());
+        }
     } else if (backingType == "malloc") {
-        backing_ = new Backend::BackingMalloc(sizeBytes);
+        backing_ = new Backend::BackingMalloc(sizeBytes, memBackendConvertor_->getMemSize());
     }
 
     /* Initialize cache */
@@ -540,8 +550,7 @@ bool MemCacheController::clock(Cycle_t cycle) {
     bool unclockBack = memBackendConvertor_->clock( cycle );
 
     if (unclockLink && unclockBack) {
-        memBackendConvertor_->turnClockOff();
-        clockOn_ = false;
+        turnClockOff(cycle);
         return true;
     }
 
@@ -555,6 +564,27 @@ Cycle_t MemCacheController::turnClockOn() {
     return cycle;
 }
 
+/*
+ * Turn the clock off after clock() at 'cycle'
+ * Same as MemController: a fast-forwarding backend may still need the clock at a known cycle
+ */
+void MemCacheController::turnClockOff(Cycle_t cycle) {
+    memBackendConvertor_->turnClockOff();
+    clockOn_ = false;
+
+    Cycle_t wake = memBackendConvertor_->getWakeCycle();
+    if (wake != 0)
+        wakeSelfLink_->send(wake > cycle + 1 ? wake - cycle - 1 : 0, nullptr);
+}
+
+/* Handler for wakeSelfLink_. Wakeups may be stale if the clock was turned on and off again since */
+void MemCacheController::handleWakeup(SST::Event* UNUSED(ev)) {
+    if (!clockOn_) {
+        Cycle_t cycle = turnClockOn();
+        memBackendConvertor_->turnClockOn(cycle);
+    }
+}
+
 void MemCacheController::handleCustomEvent(MemEventBase * ev) {
     out.fatal(CALL_INFO, -1, "%s, MemoryCache encountered unhandled event: %s\n",
             getName().c_str(), ev->getVerboseString().c_str());
@@ -623,13 +653,11 @@ void MemCacheController::readData(MemEvent* event) {
 
     localAddr = toLocalAddr(localAddr);
 
-    vector<uint8_t> payload;
-    payload.resize(event->getSize(), 0);
+    /* Read directly into the event's (pooled) payload rather than a temporary */
+    event->setZeroPayload(event->getSize());
 
     if (backing_)
-        backing_->get(localAddr, event->getSize(), payload);
-
-    event->setPayload(payload);
+        backing_->get(localAddr, event->getSize(), event->getPayload());
 }
 
 
@@ -42,8 +42,9 @@ public:
             {"num_caches",          "(uint) Total number of memory caches", "1"},\
             {"cache_num",           "(uint) Index of this cache between 0 and num_caches-1", "0"}, \
             {"cache_line_size",     "(uint) Cache line size in bytes", "64"}, \
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse' (reserve the whole range as a sparse anonymous mapping; falls back to 'malloc' if it cannot be reserved)", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing_huge_pages",  "(bool) For 'sparse' backing stores, request transparent huge pages for the reserved range", "false"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
             {"verbose",             "(uint) Output verbosity for warnings/errors. 0[fatal error only], 1[warnings], 2[full state dump on fatal error]","1"},\
             {"debug",               "(uint) 0: No debugging, 1: STDOUT, 2: STDERR, 3: FILE.", "0"},\
@@ -77,6 +78,7 @@ public:
     virtual void handleLocalMemResponse(SST::Event::id_type id, uint32_t flags);
 
     SST::Cycle_t turnClockOn();
+    void turnClockOff(SST::Cycle_t cycle);
 
     /* For updating memory values. CustomMemoryCommand should call this */
     void writeData(Addr addr, std::vector<uint8_t>* data);
@@ -138,6 +140,7 @@ protected:
     virtual void processInitEvent( MemEventInit* );
 
     virtual bool clock( SST::Cycle_t );
+    void handleWakeup( SST::Event* );
 
     void handleRead(MemEvent* ev, bool replay);
     void handleWrite(MemEvent* ev, bool replay);
@@ -175,6 +178,7 @@ protected:
 
     Clock::Handler<MemCacheController>* clockHandler_;
     TimeConverter* clockTimeBase_;
+    Link* wakeSelfLink_;        // Restarts the clock when a fast-forwarding backend needs it
 
     CustomCmdMemHandler * customCommandHandler_;
 
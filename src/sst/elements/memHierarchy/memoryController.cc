@@ -22,6 +22,7 @@
 
 #include "membackend/memBackendConvertor.h"
 #include "membackend/memBackend.h"
+#include "membackend/backingSnapshot.h"
 #include "memEventBase.h"
 #include "memEvent.h"
 #include "bus.h"
@@ -105,6 +106,7 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
     clockHandler_ = new Clock::Handler<MemController>(this, &MemController::clock);
     clockTimeBase_ = registerClock(clockfreq, clockHandler_);
     clockOn_ = true;
+    wakeSelfLink_ = configureSelfLink("wake", clockTimeBase_, new Event::Handler<MemController>(this, &MemController::handleWakeup));
 
 
     string link_lat         = params.find<std::string>("direct_link_latency", "10 ns");
@@ -266,8 +268,8 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
         if (oldBackVal) backingType = "none";
     }
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -300,15 +302,32 @@ MemController::MemController(ComponentId_t id, Params &params) : Component(id),
             else if (e == 2) {
                 if (memoryFile == "") {
                     out.verbose(CALL_INFO, 1, 0, "%s, Could not MMAP backing store (likely, simulated memory exceeds real memory). Creating malloc based store instead.\n", getName().c_str());
-                    backing_ = new Backend::BackingMalloc(sizeBytes);
+                    backing_ = new Backend::BackingMalloc(sizeBytes, memBackendConvertor_->getMemSize());
                 } else {
                     out.fatal(CALL_INFO, -1, "%s, Error - Could not MMAP backing store from file %s\n", getName().c_str(), memoryFile.c_str());
                 }
             } else
                 out.fatal(CALL_INFO, -1, "%s, Error - unable to create backing store. Exception thrown is %d.\n", getName().c_str(), e);
         }
+    } else if (backingType == "sparse") {
+        bool hugePages = params.find<bool>("backing_huge_pages", false);
+        try {
+            backing_ = new Backend::BackingSparse( memBackendConvertor_->getMemSize(), hugePages );
+        }
+        catch ( int e ) {
+            out.verbose(CALL_INFO, 1, 0, "%s, Could not reserve sparse backing store (likely, simulated memory exceeds the virtual address space). Creating malloc based store instead.\n", getName().c_str());
+            backing_ = new Backend::BackingMalloc(sizeBytes, memBackendConvertor_->getMemSize());
+        }
     } else if (backingType == "malloc") {
-        backing_ = new Backend::BackingMalloc(sizeBytes);
+        backing_ = new Backend::BackingMalloc(sizeBytes, memBackendConvertor_->getMemSize());
+    }
+
+    snapshotIn_ = params.find<std::string>("backing_snapshot_in", "");
+    snapshotOut_ = params.find<std::string>("backing_snapshot_out", "");
+    snapshotOutTime_ = params.find<std::string>("backing_snapshot_out_time", "");
+    snapshotWritten_ = false;
+    if (!backing_ && (!snapshotIn_.empty() || !snapshotOut_.empty())) {
+        out.fatal(CALL_INFO, -1, "%s, Error - backing_snapshot_in and backing_snapshot_out require a backing store but 'backing' is 'none'\n", getName().c_str());
     }
 
     /* Custom command handler */
@@ -436,8 +455,7 @@ bool MemController::clock(Cycle_t cycle) {
     bool unclockBack = memBackendConvertor_->clock( cycle );
 
     if (unclockLink && unclockBack) {
-        memBackendConvertor_->turnClockOff();
-        clockOn_ = false;
+        turnClockOff(cycle);
         return true;
     }
 
@@ -451,6 +469,28 @@ Cycle_t MemController::turnClockOn() {
     return cycle;
 }
 
+/*
+ * Turn the clock off after clock() at 'cycle'
+ * A fast-forwarding backend may still need the clock at a known cycle;
+ * the wakeup arrives the cycle before so that the clock is back on in time
+ */
+void MemController::turnClockOff(Cycle_t cycle) {
+    memBackendConvertor_->turnClockOff();
+    clockOn_ = false;
+
+    Cycle_t wake = memBackendConvertor_->getWakeCycle();
+    if (wake != 0)
+        wakeSelfLink_->send(wake > cycle + 1 ? wake - cycle - 1 : 0, nullptr);
+}
+
+/* Handler for wakeSelfLink_. Wakeups may be stale if the clock was turned on and off again since */
+void MemController::handleWakeup(SST::Event* UNUSED(ev)) {
+    if (!clockOn_) {
+        Cycle_t cycle = turnClockOn();
+        memBackendConvertor_->turnClockOn(cycle);
+    }
+}
+
 void MemController::handleCustomEvent(MemEventBase * ev) {
     if (!customCommandHandler_)
         out.fatal(CALL_INFO, -1, "%s, Error: Received custom event but no handler loaded. Ev = %s. Time = %" PRIu64 "ns\n",
@@ -531,6 +571,10 @@ void MemController::init(unsigned int phase) {
     adjustRegionToMemSize();
 
     if (!phase) {
+        /* Load the snapshot before any init writes so that they take precedence */
+        if (!snapshotIn_.empty())
+            loadBackingSnapshot();
+
         /* Announce our presence on link */
         link_->sendInitData(new MemEventInitCoherence(getName(), Endpoint::Memory, true, false, memBackendConvertor_->getRequestWidth(), false));
         link_->sendInitData(new MemEventInitEndpoint(getName().c_str(), Endpoint::Memory, region_, true));
@@ -544,6 +588,9 @@ void MemController::init(unsigned int phase) {
 void MemController::setup(void) {
     memBackendConvertor_->setup();
     link_->setup();
+
+    if (!snapshotOut_.empty() && !snapshotOutTime_.empty())
+        registerOneShot(snapshotOutTime_, new OneShot::Handler<MemController>(this, &MemController::handleSnapshotTime));
 }
 
 
@@ -554,6 +601,42 @@ void MemController::finish(void) {
     }
     memBackendConvertor_->finish();
     link_->finish();
+
+    if (!snapshotOut_.empty() && !snapshotWritten_)
+        saveBackingSnapshot();
+}
+
+void MemController::handleSnapshotTime() {
+    saveBackingSnapshot();
+    snapshotWritten_ = true;
+}
+
+void MemController::loadBackingSnapshot() {
+    try {
+        uint64_t pages = Backend::loadSnapshot(backing_, snapshotIn_);
+        out.verbose(CALL_INFO, 1, 0, "%s, Loaded %" PRIu64 " pages from backing snapshot '%s'\n", getName().c_str(), pages, snapshotIn_.c_str());
+    }
+    catch ( int e ) {
+        if (e == 1)
+            out.fatal(CALL_INFO, -1, "%s, Error - unable to open backing_snapshot_in. You specified '%s'.\n", getName().c_str(), snapshotIn_.c_str());
+        else if (e == 4)
+            out.fatal(CALL_INFO, -1, "%s, Error - backing snapshot '%s' is compressed but memHierarchy was built without libz.\n", getName().c_str(), snapshotIn_.c_str());
+        else if (e == 5)
+            out.fatal(CALL_INFO, -1, "%s, Error - backing snapshot '%s' holds data outside this memory's %" PRIu64 " bytes, it was saved from a larger memory.\n",
+                    getName().c_str(), snapshotIn_.c_str(), (uint64_t) memSize_);
+        else
+            out.fatal(CALL_INFO, -1, "%s, Error - '%s' is not a valid backing snapshot.\n", getName().c_str(), snapshotIn_.c_str());
+    }
+}
+
+void MemController::saveBackingSnapshot() {
+    try {
+        uint64_t pages = Backend::saveSnapshot(backing_, snapshotOut_);
+        out.verbose(CALL_INFO, 1, 0, "%s, Wrote %" PRIu64 " pages to backing snapshot '%s'\n", getName().c_str(), pages, snapshotOut_.c_str());
+    }
+    catch ( int e ) {
+        out.fatal(CALL_INFO, -1, "%s, Error - unable to write backing_snapshot_out '%s'. Exception thrown is %d.\n", getName().c_str(), snapshotOut_.c_str(), e);
+    }
 }
 
 void MemController::writeData(MemEvent* event) {
@@ -590,16 +673,14 @@ void MemController::readData(MemEvent* event) {
     bool noncacheable = event->queryFlag(MemEvent::F_NONCACHEABLE);
     Addr localAddr = noncacheable ? event->getAddr() : event->getBaseAddr();
 
-    vector<uint8_t> payload;
-    payload.resize(event->getSize(), 0);
+    /* Read directly into the event's (pooled) payload rather than a temporary */
+    event->setZeroPayload(event->getSize());
 
     if (backing_) {
-        backing_->get(localAddr, event->getSize(), payload);
+        backing_->get(localAddr, event->getSize(), event->getPayload());
         if (is_debug_addr(localAddr))
-            printDataValue(localAddr, &(payload), false);
+            printDataValue(localAddr, &(event->getPayload()), false);
     }
-
-    event->setPayload(payload);
 }
 
 
@@ -50,9 +50,13 @@ public:
             {"debug_addr",          "(comma separated uint) Address(es) to be debugged. Leave empty for all, otherwise specify one or more, comma-separated values. Start and end string with brackets",""},\
             {"listenercount",       "(uint) Counts the number of listeners attached to this controller, these are modules for tracing or components like prefetchers", "0"},\
             {"listener%(listenercount)d", "(string) Loads a listener module into the controller", ""},\
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "mmap"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse' (reserve the whole range as a sparse anonymous mapping; falls back to 'malloc' if it cannot be reserved)", "mmap"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing_huge_pages",  "(bool) For 'sparse' backing stores, request transparent huge pages for the reserved range", "false"},\
             {"memory_file",         "(string) Optional backing-store file to pre-load memory, or store resulting state", "N/A"},\
+            {"backing_snapshot_in", "(string) Optional backing-store snapshot to load into memory at init, e.g., one written by 'backing_snapshot_out'", ""},\
+            {"backing_snapshot_out","(string) Optional file to write a snapshot of the backing store to at the end of simulation. The snapshot holds memory contents only, data that caches hold dirty is not in it unless they were flushed first", ""},\
+            {"backing_snapshot_out_time", "(string) Optional simulated time to write 'backing_snapshot_out' at instead of the end of simulation, e.g., '100us'. If the simulation ends earlier, it is written at the end", ""},\
             {"addr_range_start",    "(uint) Lowest address handled by this memory.", "0"},\
             {"addr_range_end",      "(uint) Highest address handled by this memory.", "uint64_t-1"},\
             {"interleave_size",     "(string) Size of interleaved chunks. E.g., to interleave 8B chunks among 3 memories, set size=8B, step=24B", "0B"},\
@@ -89,6 +93,7 @@ public:
     virtual void handleMemResponse( SST::Event::id_type id, uint32_t flags );
 
     SST::Cycle_t turnClockOn();
+    void turnClockOff(SST::Cycle_t cycle);
 
     /* For updating memory values. CustomMemoryCommand should call this */
     void writeData(Addr addr, std::vector<uint8_t>* data);
@@ -117,9 +122,19 @@ protected:
     virtual void processInitEvent( MemEventInit* );
 
     virtual bool clock( SST::Cycle_t );
+    void handleWakeup( SST::Event* );
 
     void adjustRegionToMemSize();
 
+    /* Backing store snapshots */
+    void loadBackingSnapshot();
+    void saveBackingSnapshot();
+    void handleSnapshotTime();
+    std::string snapshotIn_;
+    std::string snapshotOut_;
+    std::string snapshotOutTime_;
+    bool snapshotWritten_;
+
     Output out;
     Output dbg;
     std::set<Addr> DEBUG_ADDR;
@@ -150,6 +165,7 @@ protected:
 
     Clock::Handler<MemController>* clockHandler_;
     TimeConverter* clockTimeBase_;
+    Link* wakeSelfLink_;        // Restarts the clock when a fast-forwarding backend needs it
 
     CustomCmdMemHandler * customCommandHandler_;
 
@@ -17,6 +17,8 @@
 #define _MSHR_H_
 
 #include <map>
+#include <list>
+#include <vector>
 #include <string>
 #include <sstream>
 
@@ -48,7 +50,6 @@ class MSHREntry {
         // Event entry
         MSHREntry(MemEventBase* ev, bool stallEvict) {
             type = MSHREntryType::Event;
-            evictPtrs = nullptr;
             event = ev;
             time = Simulation::getSimulation()->getCurrentSimCycle();
             inProgress = false;
@@ -60,13 +61,11 @@ class MSHREntry {
         // Writeback entry
         MSHREntry(bool downgr) {
             type = MSHREntryType::Writeback;
-            evictPtrs = nullptr;
             event = nullptr;
             time = Simulation::getSimulation()->getCurrentSimCycle();
             inProgress = false;
             needEvict = false;
             profiled = false;
-            event = nullptr;
             downgrade = downgr;
         }
 
@@ -74,27 +73,14 @@ class MSHREntry {
         MSHREntry(Addr addr) {
             type = MSHREntryType::Evict;
             event = nullptr;
-            evictPtrs = new std::list<Addr>;
-            evictPtrs->push_back(addr);
+            evictPtrs.push_back(addr);
             time = Simulation::getSimulation()->getCurrentSimCycle();
             inProgress = false;
             needEvict = false;
             profiled = false;
-            event = nullptr;
             downgrade = false;
         }
 
-        MSHREntry(const MSHREntry& entry) {
-            type = entry.type;
-            evictPtrs = entry.evictPtrs;
-            event = entry.event;
-            time = entry.time;
-            inProgress = entry.inProgress;
-            needEvict = entry.needEvict;
-            profiled = entry.profiled;
-            downgrade = entry.downgrade;
-        }
-
         MSHREntryType getType() { return type; }
 
         bool getInProgress() { return inProgress; }
@@ -108,8 +94,8 @@ class MSHREntry {
 
         SimTime_t getStartTime() { return time; }
 
-        std::list<Addr>* getPointers() {
-            return evictPtrs;
+        std::vector<Addr>* getPointers() {
+            return &evictPtrs;
         }
 
         MemEventBase * getEvent() {
@@ -142,7 +128,7 @@ class MSHREntry {
                 str << " Type: Event" << " (" << event->getBriefString() << ")";
             } else if (type == MSHREntryType::Evict) {
                 str << " Type: Evict (";
-                for (std::list<Addr>::iterator it = evictPtrs->begin(); it != evictPtrs->end(); it++) {
+                for (std::vector<Addr>::iterator it = evictPtrs.begin(); it != evictPtrs.end(); it++) {
                     str << " 0x" << std::hex << *it;
                 }
                 str << ")";
@@ -154,7 +140,7 @@ class MSHREntry {
 
     private:
         MSHREntryType type;
-        std::list<Addr> *evictPtrs; // Specific to Evict type
+        std::vector<Addr> evictPtrs; // Specific to Evict type
         MemEventBase* event;        // Specific to Event type
         SimTime_t time;
         bool needEvict;
@@ -165,7 +151,7 @@ class MSHREntry {
 
 struct MSHRRegister {
     MSHRRegister() : acksNeeded(0), dataDirty(false), pendingRetries(0) { }
-    list<MSHREntry> entries;
+    vector<MSHREntry> entries;
     uint32_t acksNeeded;
     vector<uint8_t> dataBuffer;
     bool dataDirty;
@@ -174,9 +160,30 @@ struct MSHRRegister {
     uint32_t getPendingRetries() { return pendingRetries; }
     void addPendingRetry() { pendingRetries++; }
     void removePendingRetry() { pendingRetries--; }
+
+    /* Reset for reuse, keeping the storage that has already been allocated */
+    void clear() {
+        entries.clear();
+        acksNeeded = 0;
+        dataBuffer.clear();
+        dataDirty = false;
+        pendingRetries = 0;
+    }
 };
 
-typedef map<Addr, MSHRRegister> MSHRBlock;
+/*
+ * Registers are kept in an open-addressing (linear probing) hash table indexed by address.
+ * The table is sized from the number of MSHR entries and grows if needed, since writebacks
+ * and evictions do not count against the MSHR size. A slot's register is recycled rather
+ * than freed so that steady-state operation does not allocate. The most recently found
+ * slot is cached since an event handler typically queries the same address many times.
+ */
+struct MSHRSlot {
+    MSHRSlot() : addr(0), valid(false) { }
+    Addr addr;
+    bool valid;
+    MSHRRegister reg;
+};
 
 /**
  *  Implements an MSHR with entries of type mshrEntry
@@ -199,7 +206,7 @@ public:
     MSHREntryType getFrontType(Addr addr);
 
     MemEventBase* getFrontEvent(Addr addr);
-    std::list<Addr>* getEvictPointers(Addr addr);
+    std::vector<Addr>* getEvictPointers(Addr addr);
     bool removeEvictPointer(Addr addr, Addr ptrAddr);
 
     // Special move accessor
@@ -257,7 +264,21 @@ private:
 
     void printDebug(uint32_t level, std::string action, Addr addr, std::string reason);
 
-    MSHRBlock mshr_;
+    /* Hash table management */
+    size_t homeSlot(Addr addr) {
+        uint64_t h = addr * 0x9E3779B97F4A7C15ULL;
+        return (h ^ (h >> 32)) & mask_;
+    }
+    MSHRRegister* findRegister(Addr addr);
+    MSHRRegister* findOrCreateRegister(Addr addr);
+    void eraseRegister(Addr addr);
+    void grow();
+
+    vector<MSHRSlot> mshr_;
+    size_t mask_;
+    size_t registers_;      // Number of valid slots
+    size_t lastSlot_;       // Slot of the last register found
+    bool lastValid_;
     Output* d_;
     Output* d2_;
     int size_;
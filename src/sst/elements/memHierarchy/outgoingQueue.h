@@ -0,0 +1,156 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_OUTGOINGQUEUE_H
+#define MEMHIERARCHY_OUTGOINGQUEUE_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <map>
+#include <unordered_map>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Outgoing event queue for the coherence controllers
+ *
+ * Keeps the send order of a list where a new item is inserted behind the
+ * last item that is due no later than it or that has the same address,
+ * found by scanning back from the tail. Items leave from the head only, so
+ * a head that is not yet due holds every item behind it. This keeps events
+ * to the same address in order without changing when anything is sent.
+ *
+ * Instead of scanning, the queue finds the insertion point from two indexes:
+ *  - the last queued item for each address
+ *  - the items that are due earlier than every item behind them; the last
+ *    of those due no later than the new item is the last such item overall
+ * Whichever of the two is further back in the list is the insertion point.
+ * Items carry order labels so that list positions can be compared.
+ * Insert is O(log n), pop is O(1).
+ *
+ * Usage:
+ *   while (queue.ready(now)) { T& item = queue.front(); ...; queue.pop(); }
+ * front() may be modified in place (e.g., for partial sends).
+ */
+template <typename T>
+class OutgoingQueue {
+public:
+    bool empty() const { return list_.empty(); }
+    size_t size() const { return list_.size(); }
+
+    void insert(uint64_t time, uint64_t addr, const T& item) {
+        // Last item due no later than 'time' and last item for 'addr'
+        Iter after = list_.end();
+        typename RecordMap::iterator rec = records_.upper_bound(time);
+        if (rec != records_.begin())
+            after = std::prev(rec)->second;
+
+        typename AddrMap::iterator last = lastForAddr_.find(addr);
+        if (last != lastForAddr_.end()) {
+            if (after == list_.end() || last->second.first->label > after->label)
+                after = last->second.first;
+        }
+
+        Iter node = list_.insert(after == list_.end() ? list_.begin() : std::next(after), Node(item, time, addr));
+        assignLabel(node);
+
+        // Everything behind the new item is due later, so it is a record and
+        // the records in front of it that are not due earlier are no longer
+        rec = records_.lower_bound(time);
+        while (rec != records_.end() && rec->second->label < node->label)
+            rec = records_.erase(rec);
+        records_.insert(std::make_pair(time, node));
+
+        // Nothing behind the new item has its address
+        if (last == lastForAddr_.end()) {
+            lastForAddr_.insert(std::make_pair(addr, std::make_pair(node, 1u)));
+        } else {
+            last->second.first = node;
+            last->second.second++;
+        }
+    }
+
+    /* Whether the head is due at 'now'. Must be called before front()/pop(). */
+    bool ready(uint64_t now) const {
+        return !list_.empty() && list_.front().time <= now;
+    }
+
+    T& front() { return list_.front().item; }
+
+    uint64_t frontTime() const { return list_.front().time; }
+
+    void pop() {
+        Iter head = list_.begin();
+        if (!records_.empty() && records_.begin()->second == head)
+            records_.erase(records_.begin());
+
+        typename AddrMap::iterator last = lastForAddr_.find(head->addr);
+        if (--(last->second.second) == 0)
+            lastForAddr_.erase(last);
+
+        list_.pop_front();
+    }
+
+    /* Visit every queued item in send order as f(time, item), for debug output */
+    template <typename F>
+    void forEach(F f) const {
+        for (typename std::list<Node>::const_iterator it = list_.begin(); it != list_.end(); it++)
+            f(it->time, it->item);
+    }
+
+private:
+    struct Node {
+        T item;
+        uint64_t time;
+        uint64_t addr;
+        uint64_t label;     // Increases along the list
+        Node(const T& i, uint64_t t, uint64_t a) : item(i), time(t), addr(a), label(0) { }
+    };
+
+    typedef typename std::list<Node>::iterator Iter;
+    typedef std::map<uint64_t, Iter> RecordMap;
+    typedef std::unordered_map<uint64_t, std::pair<Iter, unsigned int> > AddrMap;
+
+    static const uint64_t labelGap_ = 1ULL << 32;
+
+    /* Label a new node between its neighbours, relabelling the list if there is no room */
+    void assignLabel(Iter node) {
+        Iter next = std::next(node);
+        uint64_t lo = (node == list_.begin()) ? 0 : std::prev(node)->label;
+        uint64_t hi = (next == list_.end()) ? UINT64_MAX : next->label;
+
+        if (hi - lo < 2) {
+            uint64_t label = 0;
+            for (Iter it = list_.begin(); it != list_.end(); it++) {
+                label += labelGap_;
+                it->label = label;
+            }
+        } else if (next == list_.end() && hi - lo > labelGap_) {
+            node->label = lo + labelGap_;
+        } else {
+            node->label = lo + (hi - lo) / 2;
+        }
+    }
+
+    std::list<Node> list_;
+    RecordMap records_;         // Items due earlier than every item behind them, by time
+    AddrMap lastForAddr_;       // Last queued item and number of queued items for each address
+};
+
+}}
+
+#endif /* MEMHIERARCHY_OUTGOINGQUEUE_H */
@@ -0,0 +1,122 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_PAYLOADPOOL_H
+#define MEMHIERARCHY_PAYLOADPOOL_H
+
+#include <stdint.h>
+#include <cstddef>
+#include <vector>
+
+namespace SST { namespace MemHierarchy {
+
+/*
+ * Per-thread free list of payload storage
+ *
+ * MemEvents are created and destroyed at every hop through the hierarchy and
+ * each one with data used to allocate and free a line-sized vector. Payload
+ * storage is instead returned to a free list when an event is destroyed and
+ * handed to the next event that needs it. Free lists are thread-local so
+ * that each SST thread (and so each partition) recycles its own buffers
+ * without locking.
+ */
+class PayloadPool {
+public:
+    /* Ensure 'vec' can hold 'size' bytes, taking storage from the pool if possible */
+    static void acquire(std::vector<uint8_t>& vec, size_t size) {
+        if (vec.capacity() >= size)
+            return;
+        std::vector<std::vector<uint8_t> >& pool = freeList();
+        if (!pool.empty() && pool.back().capacity() >= size) {
+            vec.swap(pool.back());
+            pool.pop_back();
+        } else {
+            vec.reserve(size);
+        }
+    }
+
+    /* Return the storage held by 'vec' to the pool, leaving 'vec' empty */
+    static void release(std::vector<uint8_t>& vec) {
+        if (vec.capacity() == 0 || vec.capacity() > maxBufferBytes)
+            return;
+        std::vector<std::vector<uint8_t> >& pool = freeList();
+        if (pool.size() >= maxBuffers)
+            return;
+        vec.clear();
+        pool.emplace_back();
+        pool.back().swap(vec);
+    }
+
+private:
+    static const size_t maxBufferBytes = 4096;  // Don't hold on to unusually large payloads
+    static const size_t maxBuffers = 65536;     // Bound the memory held by each thread's pool
+
+    static std::vector<std::vector<uint8_t> >& freeList() {
+        static thread_local std::vector<std::vector<uint8_t> > pool;
+        return pool;
+    }
+};
+
+/*
+ * Payload vector whose storage comes from and returns to the PayloadPool.
+ * Behaves as a std::vector<uint8_t> so existing getPayload() users are unaffected.
+ */
+class PayloadBuffer : public std::vector<uint8_t> {
+public:
+    PayloadBuffer() : std::vector<uint8_t>() { }
+
+    PayloadBuffer(const PayloadBuffer& other) : std::vector<uint8_t>() {
+        copyFrom(other);
+    }
+
+    ~PayloadBuffer() {
+        PayloadPool::release(*this);
+    }
+
+    PayloadBuffer& operator=(const PayloadBuffer& other) {
+        if (this != &other)
+            copyFrom(other);
+        return *this;
+    }
+
+    PayloadBuffer& operator=(const std::vector<uint8_t>& other) {
+        copyFrom(other);
+        return *this;
+    }
+
+    void resize(size_type size, uint8_t value = 0) {
+        PayloadPool::acquire(*this, size);
+        std::vector<uint8_t>::resize(size, value);
+    }
+
+    void assign(const uint8_t* data, size_type size) {
+        PayloadPool::acquire(*this, size);
+        std::vector<uint8_t>::assign(data, data + size);
+    }
+
+private:
+    void copyFrom(const std::vector<uint8_t>& other) {
+        if (other.empty()) {
+            clear();
+            return;
+        }
+        PayloadPool::acquire(*this, other.size());
+        std::vector<uint8_t>::assign(other.begin(), other.end());
+    }
+};
+
+}}
+
+#endif /* MEMHIERARCHY_PAYLOADPOOL_H */
@@ -139,8 +139,8 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
         if (oldBackVal) backingType = "none";
     }
 
-    if (backingType != "none" && backingType != "mmap" && backingType != "malloc") {
-        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', or 'mmap'. You specified: %s\n",
+    if (backingType != "none" && backingType != "mmap" && backingType != "malloc" && backingType != "sparse") {
+        out.fatal(CALL_INFO, -1, "%s, Error - Invalid param: backing. Must be one of 'none', 'malloc', 'mmap', or 'sparse'. You specified: %s\n",
                 getName().c_str(), backingType.c_str());
     }
 
@@ -172,15 +172,24 @@ Scratchpad::Scratchpad(ComponentId_t id, Params &params) : Component(id) {
             else if (e == 2) {
                 if (memoryFile == "") {
                     out.output("%s, Could not MMAP backing store (likely, simulated memory exceeds real memory). Creating malloc based store instead.\n", getName().c_str());
-                    backing_ = new Backend::BackingMalloc(sizeBytes);
+                    backing_ = new Backend::BackingMalloc(sizeBytes, scratch_->getMemSize());
                 } else {
                     out.fatal(CALL_INFO, -1, "%s, Error - Could not MMAP backing store from file %s\n", getName().c_str(), memoryFile.c_str());
                 }
             } else
                 dbg.fatal(CALL_INFO, -1, "%s, Error - unable to create backing store. Exception thrown is %d.\n", getName().c_str(), e);
         }
+    } else if (backingType == "sparse") {
+        bool hugePages = params.find<bool>("backing_huge_pages", false);
+        try {
+            backing_ = new Backend::BackingSparse( scratch_->getMemSize(), hugePages );
+        }
+        catch ( int e ) {
+            out.verbose(CALL_INFO, 1, 0, "%s, Could not reserve sparse backing store (likely, simulated memory exceeds the virtual address space). Creating malloc based store instead.\n", getName().c_str());
+            backing_ = new Backend::BackingMalloc(sizeBytes, scratch_->getMemSize());
+        }
     } else if (backingType == "malloc") {
-        backing_ = new Backend::BackingMalloc(sizeBytes);
+        backing_ = new Backend::BackingMalloc(sizeBytes, scratch_->getMemSize());
     }
 
     // Assume no caching, may change during init
@@ -447,8 +456,8 @@ bool Scratchpad::clock(Cycle_t cycle) {
 
     // issue ready events
     uint32_t responseThisCycle = (responsesPerCycle_ == 0) ? 1 : 0;
-    while (!procMsgQueue_.empty() && procMsgQueue_.begin()->first < timestamp_) {
-        MemEventBase * sendEv = procMsgQueue_.begin()->second;
+    while (procMsgQueue_.ready(timestamp_ - 1)) {
+        MemEventBase * sendEv = procMsgQueue_.front();
 
         if (is_debug_event(sendEv)) {
             debug = true;
@@ -457,13 +466,13 @@ bool Scratchpad::clock(Cycle_t cycle) {
         }
 
         linkUp_->send(sendEv);
-        procMsgQueue_.erase(procMsgQueue_.begin());
+        procMsgQueue_.pop();
         responseThisCycle++;
         if (responseThisCycle == responsesPerCycle_) break;
     }
 
-    while (!memMsgQueue_.empty() && memMsgQueue_.begin()->first < timestamp_) {
-        MemEvent * sendEv = memMsgQueue_.begin()->second;
+    while (memMsgQueue_.ready(timestamp_ - 1)) {
+        MemEvent * sendEv = memMsgQueue_.front();
         sendEv->setDst(linkDown_->getTargetDestination(sendEv->getBaseAddr()));
 
         if (is_debug_event(sendEv)) {
@@ -474,7 +483,7 @@ bool Scratchpad::clock(Cycle_t cycle) {
 
         linkDown_->send(sendEv);
 
-        memMsgQueue_.erase(memMsgQueue_.begin());
+        memMsgQueue_.pop();
     }
 
     linkDown_->clock();
@@ -711,7 +720,7 @@ void Scratchpad::handleScratchGet(MemEventBase * event) {
                 Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), saddr, daddr, remoteRead->getID().first, remoteRead->getID().second, remoteRead->getBaseAddr());
     }
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, remoteRead));
+    memMsgQueue_.insert(timestamp_, remoteRead);
 
     // Insert into mshr and send inv if needed
     // start base addr -> end base addr
@@ -976,7 +985,7 @@ void Scratchpad::handleNack(MemEventBase * event) {
         uint64_t backoff = (0x1 << retries);
         nackedEvent->incrementRetries();
 
-        procMsgQueue_.insert(std::make_pair(timestamp_ + backoff, nackedEvent));
+        procMsgQueue_.insert(timestamp_ + backoff, nackedEvent);
 
     } else {
         delete nackedEvent;
@@ -1004,7 +1013,7 @@ void Scratchpad::handleRemoteRead(MemEvent * event) {
     outstandingEventList_.insert(std::make_pair(event->getID(), OutstandingEvent(event, response)));
     responseIDMap_.insert(std::make_pair(request->getID(), event->getID()));
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, request));
+    memMsgQueue_.insert(timestamp_, request);
 }
 
 
@@ -1025,11 +1034,11 @@ void Scratchpad::handleRemoteWrite(MemEvent * event) {
     request->setVirtualAddress(event->getVirtualAddress());
     request->setInstructionPointer(event->getInstructionPointer());
 
-    memMsgQueue_.insert(std::make_pair(timestamp_, request));
+    memMsgQueue_.insert(timestamp_, request);
 
     MemEvent * response = event->makeResponse();
 
-    procMsgQueue_.insert(std::make_pair(timestamp_, response));
+    procMsgQueue_.insert(timestamp_, response);
 
     delete event;
 }
@@ -1207,7 +1216,7 @@ void Scratchpad::doScratchWrite(MemEvent * event) {
 }
 
 void Scratchpad::sendResponse(MemEventBase * event) {
-    procMsgQueue_.insert(std::make_pair(timestamp_, event));
+    procMsgQueue_.insert(timestamp_, event);
 }
 
 
@@ -1224,7 +1233,7 @@ bool Scratchpad::startGet(Addr baseAddr, MoveEvent * get) {
         inv->setInstructionPointer(get->getInstructionPointer());
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Get            0x%-16" PRIx64 " 0x%-16" PRIx64 " Inv         (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
                 Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), get->getSrcBaseAddr(), get->getDstBaseAddr(), inv->getID().first, inv->getID().second, inv->getBaseAddr());
-        procMsgQueue_.insert(std::make_pair(timestamp_, inv));
+        procMsgQueue_.insert(timestamp_, inv);
         return true;
     }
     return false;
@@ -1244,7 +1253,7 @@ bool Scratchpad::startPut(Addr baseAddr, MoveEvent * put) {
         inv->setInstructionPointer(put->getInstructionPointer());
         dbg.debug(_L10_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Put            0x%-16" PRIx64 " 0x%-16" PRIx64 " Inv         (<%" PRIu64 ", %" PRIu32 ">, 0x%" PRIx64 ")\n",
                 Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), put->getSrcBaseAddr(), put->getDstBaseAddr(), inv->getID().first, inv->getID().second, inv->getBaseAddr());
-        procMsgQueue_.insert(std::make_pair(timestamp_, inv));
+        procMsgQueue_.insert(timestamp_, inv);
         return true;
     } else {
         // Derive addr and size from baseAddr and the put request
@@ -1285,7 +1294,7 @@ void Scratchpad::updatePut(SST::Event::id_type putID) {
                 outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr());
 //        dbg.debug(_L5_, "C: %-20" PRIu64 " %-20" PRIu64 " %-20s Finish        0x%-16" PRIx64 " <%" PRIu64 ", %" PRIu32 ">\n",
 //                Simulation::getSimulation()->getCurrentSimCycle(), timestamp_, getName().c_str(), outstandingEventList_.find(putID)->second.remoteWrite->getBaseAddr(), baseAddr, responseID.first, responseID.second);
-        memMsgQueue_.insert(std::make_pair(timestamp_, outstandingEventList_.find(putID)->second.remoteWrite));
+        memMsgQueue_.insert(timestamp_, outstandingEventList_.find(putID)->second.remoteWrite);
         sendResponse(outstandingEventList_.find(putID)->second.response);
         delete outstandingEventList_.find(putID)->second.request;
         outstandingEventList_.erase(putID);
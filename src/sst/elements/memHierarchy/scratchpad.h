@@ -29,6 +29,7 @@
 #include "sst/elements/memHierarchy/moveEvent.h"
 #include "sst/elements/memHierarchy/memEvent.h"
 #include "sst/elements/memHierarchy/memLinkBase.h"
+#include "sst/elements/memHierarchy/calendarQueue.h"
 
 namespace SST {
 namespace MemHierarchy {
@@ -46,8 +47,9 @@ public:
             {"size",                "(string) Size of the scratchpad in bytes (B), SI units ok", NULL},
             {"scratch_line_size",   "(string) Number of bytes in a scratch line with units. 'size' must be divisible by this number.", "64B"},
             {"memory_line_size",    "(string) Number of bytes in a remote memory line with units. Used to set base addresses for routing.", "64B"},
-            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', or 'mmap'", "malloc"},\
+            {"backing",             "(string) Type of backing store to use. Options: 'none' - no backing store (only use if simulation does not require correct memory values), 'malloc', 'mmap', or 'sparse' (reserve the whole range as a sparse anonymous mapping; falls back to 'malloc' if it cannot be reserved)", "malloc"},\
             {"backing_size_unit",   "(string) For 'malloc' backing stores, malloc granularity", "1MiB"},\
+            {"backing_huge_pages",  "(bool) For 'sparse' backing stores, request transparent huge pages for the reserved range", "false"},\
             {"memory_addr_offset",  "(uint) Amount to offset remote addresses by. Default is 'size' so that remote memory addresses start at 0", "size"},
             {"response_per_cycle",  "(uint) Maximum number of responses to return to processor each cycle. 0 is unlimited", "0"},
             {"backendConvertor",    "(string) Backend convertor to use for the scratchpad", "memHierarchy.scratchpadBackendConvertor"},
@@ -232,8 +234,8 @@ private:
 
 
     // Outgoing message queues - map send timestamp to event
-    std::multimap<uint64_t, MemEventBase*> procMsgQueue_;
-    std::multimap<uint64_t, MemEvent*> memMsgQueue_;
+    CalendarQueue<MemEventBase*> procMsgQueue_;
+    CalendarQueue<MemEvent*> memMsgQueue_;
 
     // Throughput limits
     uint32_t responsesPerCycle_;
@@ -0,0 +1,119 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef MEMHIERARCHY_SETPROBE_H
+#define MEMHIERARCHY_SETPROBE_H
+
+#include <stdint.h>
+
+/*
+ * Set-probe kernel for associative structures that store the tags of a set
+ * contiguously (e.g., CacheArray's flat layout).
+ *
+ * probeSet() returns the lowest way whose tag matches, or -1 on a miss. There
+ * are two kernels, AVX2 and a scalar loop, and both return the same way. A
+ * build that targets AVX2 uses it directly. Otherwise, on x86 with GCC or
+ * Clang, the AVX2 kernel is compiled for that target alone and chosen at
+ * startup if the CPU supports it. Every other build uses the scalar loop.
+ * SSE2 and SSE4.1 have no kernel, because at 2 tags per compare they were
+ * slower than the scalar loop. Define MH_SETPROBE_SCALAR to force the scalar loop.
+ */
+
+#if !defined(MH_SETPROBE_SCALAR)
+#if defined(__AVX2__)
+#define MH_SETPROBE_AVX2
+#include <immintrin.h>
+#elif (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define MH_SETPROBE_AVX2
+#define MH_SETPROBE_DISPATCH
+#include <immintrin.h>
+#endif
+#endif
+
+#if defined(MH_SETPROBE_DISPATCH)
+#define MH_SETPROBE_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define MH_SETPROBE_AVX2_TARGET
+#endif
+
+namespace SST { namespace MemHierarchy {
+
+inline int probeSetScalar(const uint64_t* tags, unsigned int ways, uint64_t tag) {
+    for (unsigned int i = 0; i < ways; i++) {
+        if (tags[i] == tag)
+            return i;
+    }
+    return -1;
+}
+
+#if defined(MH_SETPROBE_AVX2)
+MH_SETPROBE_AVX2_TARGET inline int probeSetAVX2(const uint64_t* tags, unsigned int ways, uint64_t tag) {
+    unsigned int i = 0;
+    const __m256i key = _mm256_set1_epi64x((long long)tag);
+    for (; i + 8 <= ways; i += 8) {
+        __m256i lo = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(tags + i)), key);
+        __m256i hi = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(tags + i + 4)), key);
+        unsigned int mask = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(lo))
+                          | ((unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(hi)) << 4);
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    for (; i + 4 <= ways; i += 4) {
+        __m256i eq = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i*)(tags + i)), key);
+        unsigned int mask = (unsigned int)_mm256_movemask_pd(_mm256_castsi256_pd(eq));
+        if (mask)
+            return i + __builtin_ctz(mask);
+    }
+    for (; i < ways; i++) {
+        if (tags[i] == tag)
+            return i;
+    }
+    return -1;
+}
+#endif
+
+#if defined(MH_SETPROBE_DISPATCH)
+/* Whether this CPU can run the AVX2 kernel, checked once */
+inline bool probeSetHasAVX2() {
+    static const bool hasAVX2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+    return hasAVX2;
+}
+#endif
+
+/* Name of the kernel in use, for output/benchmarking */
+inline const char* probeSetKernel() {
+#if defined(MH_SETPROBE_DISPATCH)
+    return probeSetHasAVX2() ? "avx2 (selected at startup)" : "scalar (selected at startup)";
+#elif defined(MH_SETPROBE_AVX2)
+    return "avx2";
+#else
+    return "scalar";
+#endif
+}
+
+inline int probeSet(const uint64_t* tags, unsigned int ways, uint64_t tag) {
+#if defined(MH_SETPROBE_DISPATCH)
+    if (probeSetHasAVX2())
+        return probeSetAVX2(tags, ways, tag);
+    return probeSetScalar(tags, ways, tag);
+#elif defined(MH_SETPROBE_AVX2)
+    return probeSetAVX2(tags, ways, tag);
+#else
+    return probeSetScalar(tags, ways, tag);
+#endif
+}
+
+}}
+#endif /* MEMHIERARCHY_SETPROBE_H */
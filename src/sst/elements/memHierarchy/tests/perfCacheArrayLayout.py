@@ -0,0 +1,79 @@
+# Performance comparison of the cache array layouts
+# A GUPS generator drives a small L1 and a large, highly-associative LLC.
+# Run once per layout and compare wall-clock time, e.g.,
+#   time sst perfCacheArrayLayout.py --model-options="pointer"
+#   time sst perfCacheArrayLayout.py --model-options="flat"
+# Statistics should be identical between the two runs.
+import sys
+import sst
+
+layout = "pointer"
+if len(sys.argv) > 1:
+    layout = sys.argv[1]
+
+llc_size = "32MiB"
+llc_assoc = 16
+memory_mb = 4096
+count = 2000000
+
+cpu = sst.Component("cpu", "miranda.BaseCPU")
+cpu.addParams({
+    "verbose" : 0,
+    "clock" : "2GHz",
+    "max_reqs_cycle" : 2,
+})
+gen = cpu.setSubComponent("generator", "miranda.GUPSGenerator")
+gen.addParams({
+    "verbose" : 0,
+    "count" : count,
+    "max_address" : memory_mb * 1024 * 1024,
+})
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : 2,
+    "cache_frequency" : "2GHz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : 8,
+    "cache_line_size" : 64,
+    "L1" : 1,
+    "cache_size" : "32KiB",
+    "cache_array_layout" : layout,
+})
+
+llc = sst.Component("llc", "memHierarchy.Cache")
+llc.addParams({
+    "access_latency_cycles" : 20,
+    "cache_frequency" : "2GHz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : llc_assoc,
+    "cache_line_size" : 64,
+    "cache_size" : llc_size,
+    "mshr_num_entries" : 64,
+    "cache_array_layout" : layout,
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "addr_range_end" : memory_mb * 1024 * 1024 - 1,
+    "backing" : "none",
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "50ns",
+    "mem_size" : str(memory_mb) + "MiB",
+})
+
+sst.setStatisticLoadLevel(1)
+sst.setStatisticOutput("sst.statOutputConsole")
+llc.enableStatistics(["TotalEventsReceived"])
+
+link_cpu_l1 = sst.Link("link_cpu_l1")
+link_cpu_l1.connect( (cpu, "cache_link", "500ps"), (l1cache, "high_network_0", "500ps") )
+link_l1_llc = sst.Link("link_l1_llc")
+link_l1_llc.connect( (l1cache, "low_network_0", "500ps"), (llc, "high_network_0", "500ps") )
+link_llc_mem = sst.Link("link_llc_mem")
+link_llc_mem.connect( (llc, "low_network_0", "500ps"), (memctrl, "direct_link", "500ps") )
@@ -1,5 +1,6 @@
 # Automatically generated SST Python input
 import sst
+import sys
 from mhlib import componentlist
 
 # Define the simulation components
@@ -185,6 +186,9 @@ memory.addParams({
     "row_size" : "8KiB",
     "row_policy" : "open"
 })
+# The testsuite also runs this with --model-options "--idle_fastforward=1", statistics must not change
+idle_fastforward = 1 if "--idle_fastforward=1" in sys.argv else 0
+memory.addParam("idle_fastforward", idle_fastforward)
 
 # Enable statistics
 sst.setStatisticLoadLevel(7)
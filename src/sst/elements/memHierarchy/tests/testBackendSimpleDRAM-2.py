@@ -1,4 +1,5 @@
 import sst
+import sys
 from mhlib import componentlist
 
 # Test functions
@@ -213,6 +214,9 @@ memory.addParams({
     "row_size" : "8KiB",
     "row_policy" : "closed",
 })
+# The testsuite also runs this with --model-options "--idle_fastforward=1", statistics must not change
+idle_fastforward = 1 if "--idle_fastforward=1" in sys.argv else 0
+memory.addParam("idle_fastforward", idle_fastforward)
 memNIC = memctrl.setSubComponent("cpulink", "memHierarchy.MemNIC")
 memNIC.addParams({
     "group" : 3,
@@ -1,5 +1,6 @@
 # Automatically generated SST Python input
 import sst
+import sys
 from mhlib import componentlist
 
 # Test timingDRAM with transactionQ = reorderTransactionQ and AddrMapper=sandyBridgeAddrMapper and pagepolicy=timeoutPagePolicy
@@ -146,6 +147,9 @@ memory.addParams({
     "channel.rank.printconfig" : 0,
     "channel.rank.bank.printconfig" : 0,
 })
+# The testsuite also runs this with --model-options "--idle_fastforward=1", statistics must not change
+idle_fastforward = 1 if "--idle_fastforward=1" in sys.argv else 0
+memory.addParam("idle_fastforward", idle_fastforward)
 
 # Do lower memory hierarchy links
 link_bus_l3 = sst.Link("link_bus_l3")
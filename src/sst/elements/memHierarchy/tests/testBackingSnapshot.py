@@ -0,0 +1,67 @@
+# Backing store snapshots
+# Options (--model-options):
+#   --ops=N              Number of CPU requests to issue
+#   --snapshot_in=FILE   Snapshot to load into memory at init
+#   --snapshot_out=FILE  Snapshot to write
+#   --snapshot_time=T    Simulated time to write the snapshot at
+import sst
+import sys
+
+ops = 1000
+snapshot_in = ""
+snapshot_out = ""
+snapshot_time = ""
+for arg in sys.argv[1:]:
+    if arg.startswith("--ops="):
+        ops = int(arg.split("=", 1)[1])
+    elif arg.startswith("--snapshot_in="):
+        snapshot_in = arg.split("=", 1)[1]
+    elif arg.startswith("--snapshot_out="):
+        snapshot_out = arg.split("=", 1)[1]
+    elif arg.startswith("--snapshot_time="):
+        snapshot_time = arg.split("=", 1)[1]
+
+cpu = sst.Component("cpu", "memHierarchy.standardCPU")
+cpu.addParams({
+    "memFreq" : 100,
+    "memSize" : "16MiB",
+    "clock" : "1GHz",
+    "maxOutstanding" : 10,
+    "opCount" : ops,
+    "write_freq" : 50,
+    "read_freq" : 50,
+})
+iface = cpu.setSubComponent("memory", "memHierarchy.standardInterface")
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : "4",
+    "cache_frequency" : "2 Ghz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MSI",
+    "associativity" : "4",
+    "cache_line_size" : "64",
+    "L1" : "1",
+    "cache_size" : "2KiB"
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "addr_range_end" : 16*1024*1024-1,
+    "backing" : "malloc",
+    "backing_snapshot_in" : snapshot_in,
+    "backing_snapshot_out" : snapshot_out,
+    "backing_snapshot_out_time" : snapshot_time,
+})
+
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "100ns",
+    "mem_size" : "16MiB"
+})
+
+link_cpu_cache_link = sst.Link("link_cpu_cache_link")
+link_cpu_cache_link.connect( (iface, "port", "1000ps"), (l1cache, "high_network_0", "1000ps") )
+link_mem_bus_link = sst.Link("link_mem_bus_link")
+link_mem_bus_link.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
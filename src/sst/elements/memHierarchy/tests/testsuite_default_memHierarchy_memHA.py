@@ -3,6 +3,7 @@
 from sst_unittest import *
 from sst_unittest_support import *
 import os.path
+import filecmp
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -183,10 +184,56 @@ class testcase_memHierarchy_memHA(SSTTestCase):
     
     def test_memHA_StdMem_mmio3(self):
         self.memHA_Template("StdMem_mmio3")
+
+    # Idle fast-forward of the DRAM backends must leave statistics unchanged,
+    # so these runs are checked against the same reference files
+    def test_memHA_BackendTimingDRAM_1_idleFastForward(self):
+        self.memHA_Template("BackendTimingDRAM_1", idle_fastforward=True)
+
+    def test_memHA_BackendTimingDRAM_2_idleFastForward(self):
+        self.memHA_Template("BackendTimingDRAM_2", idle_fastforward=True)
+
+    def test_memHA_BackendTimingDRAM_3_idleFastForward(self):
+        self.memHA_Template("BackendTimingDRAM_3", idle_fastforward=True)
+
+    def test_memHA_BackendTimingDRAM_4_idleFastForward(self):
+        self.memHA_Template("BackendTimingDRAM_4", idle_fastforward=True)
+
+    def test_memHA_BackendSimpleDRAM_1_idleFastForward(self):
+        self.memHA_Template("BackendSimpleDRAM_1", idle_fastforward=True)
+
+    def test_memHA_BackendSimpleDRAM_2_idleFastForward(self):
+        self.memHA_Template("BackendSimpleDRAM_2", idle_fastforward=True)
+
+    def test_memHA_BackendReorderRow_idleFastForward(self):
+        self.memHA_Template("BackendReorderRow", idle_fastforward=True)
+
+    # Write a snapshot partway through a run, load it into an idle run that writes
+    # it back out, and check that the two snapshots are identical
+    def test_memHA_BackingSnapshot(self):
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName = "test_memHA_BackingSnapshot"
+        sdlfile = "{0}/testBackingSnapshot.py".format(test_path)
+        snapshot = "{0}/{1}.snapshot".format(outdir, testDataFileName)
+        restored = "{0}/{1}_restored.snapshot".format(outdir, testDataFileName)
+
+        for name, args in (("write", "--ops=1000 --snapshot_out={0} --snapshot_time=50us".format(snapshot)),
+                           ("restore", "--ops=0 --snapshot_in={0} --snapshot_out={1}".format(snapshot, restored))):
+            outfile = "{0}/{1}_{2}.out".format(outdir, testDataFileName, name)
+            errfile = "{0}/{1}_{2}.err".format(outdir, testDataFileName, name)
+            self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path,
+                         other_args='--model-options "{0}"'.format(args))
+
+        # The header alone is 32 bytes, the first run must have written some pages
+        self.assertTrue(os.path.getsize(snapshot) > 32, "Snapshot {0} holds no pages".format(snapshot))
+        self.assertTrue(filecmp.cmp(snapshot, restored, shallow=False),
+                        "Restored snapshot {0} differs from {1}".format(restored, snapshot))
 #####
 
     def memHA_Template(self, testcase,
-                       ignore_err_file=False, testtimeout=240):
+                       ignore_err_file=False, testtimeout=240, idle_fastforward=False):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = self.get_test_output_run_dir()
@@ -199,6 +246,11 @@ class testcase_memHierarchy_memHA(SSTTestCase):
         testDataFileName=("test_memHA_{0}".format(testcase))
         sdlfile = "{0}/test{1}.py".format(test_path, testcasename_sdl)
         reffile = "{0}/refFiles/{1}.out".format(test_path, testDataFileName)
+
+        otherargs = ""
+        if idle_fastforward:
+            otherargs = '--model-options "--idle_fastforward=1"'
+            testDataFileName = "{0}_idleFastForward".format(testDataFileName)
         
         tmpfile = "{0}/{1}.tmp".format(outdir, testDataFileName)
 
@@ -212,7 +264,7 @@ class testcase_memHierarchy_memHA(SSTTestCase):
         log_debug("ref file = {0}".format(reffile))
 
         # Run SST in the tests directory
-        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path,
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=test_path, other_args=otherargs,
                      timeout_sec=testtimeout, mpi_out_files=mpioutfiles)
         
         # Lines to ignore
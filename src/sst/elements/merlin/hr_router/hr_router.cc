@@ -108,6 +108,7 @@ hr_router::~hr_router()
     delete [] in_port_busy;
     delete [] out_port_busy;
     delete [] progress_vcs;
+    delete [] progress_ports;
 
     for ( int i = 0 ; i < num_ports ; i++ ) {
         delete ports[i];
@@ -229,6 +230,8 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     out_port_busy = new int[num_ports];
 
     progress_vcs = new int[num_ports];
+    progress_ports = new int[num_ports];
+    initPortsWithData(num_ports);
 
     std::string inspector_config = params.find<std::string>("network_inspectors", "");
     split(inspector_config,",",inspector_names);
@@ -282,6 +285,7 @@ hr_router::hr_router(ComponentId_t cid, Params& params) :
     Params empty_params; // Empty params sent to subcomponents
     arb =
         loadAnonymousSubComponent<XbarArbitration>(xbar_arb, "XbarArb", 0, ComponentInfo::INSERT_STATS, empty_params);
+    sparse_arb = arb->isSparse();
 
     my_clock_handler = new Clock::Handler<hr_router>(this,&hr_router::clock_handler);
     xbar_tc = registerClock( xbar_clock, my_clock_handler);
@@ -327,8 +331,9 @@ hr_router::notifyEvent()
 
 
 #if !VERIFY_DECLOCKING
-    // Fix up the busy variables
-    for ( int i = 0; i < num_ports; i++ ) {
+    // Fix up the busy variables (sparse arbiters track busy
+    // themselves and catch up in reportSkippedCycles())
+    for ( int i = 0; !sparse_arb && i < num_ports; i++ ) {
     	// Should stop at zero, need to find a clean way to do this
     	// with no branch.  For now it should work.
         int64_t tmp = in_port_busy[i] - elapsed_cycles;
@@ -352,6 +357,7 @@ hr_router::sigHandler(int signal)
 void
 hr_router::dumpState(std::ostream& stream)
 {
+    arb->getPortBusy(in_port_busy, out_port_busy);
     stream << "Router id: " << id << std::endl;
     for ( int i = 0; i < num_ports; i++ ) {
 	ports[i]->dumpState(stream);
@@ -364,6 +370,7 @@ hr_router::dumpState(std::ostream& stream)
 void
 hr_router::printStatus(Output& out)
 {
+    arb->getPortBusy(in_port_busy, out_port_busy);
     out.output("Start Router:  id = %d\n", id);
     for ( int i = 0; i < num_ports; i++ ) {
         ports[i]->printStatus(out, out_port_busy[i], in_port_busy[i]);
@@ -400,6 +407,18 @@ hr_router::clock_handler(Cycle_t cycle)
 #endif
     }
 
+    if ( sparse_arb ) {
+        // Arbiter only reports the ports that moved or stalled and
+        // keeps the busy counts itself
+        int count = arb->arbitrateSparse(ports, get_ports_with_data(), get_port_ready_vcs(), progress_vcs, progress_ports);
+        for ( int p = 0; p < count; p++ ) {
+            int i = progress_ports[p];
+            if ( progress_vcs[i] > -1 ) moveEvent(i);
+            else xbar_stalls[i]->addData(1);
+        }
+        return false;
+    }
+
     // All we need to do is arbitrate the crossbar
 #if VERIFY_DECLOCKING
     arb->arbitrate(ports,in_port_busy,out_port_busy,progress_vcs,clocking);
@@ -411,25 +430,7 @@ hr_router::clock_handler(Cycle_t cycle)
     for ( int i = 0; i < num_ports; i++ ) {
         // if ( progress_vcs[i] != -1 ) {
         if ( progress_vcs[i] > -1 ) {
-            internal_router_event* ev = ports[i]->recv(progress_vcs[i]);
-            ports[ev->getNextPort()]->send(ev,ev->getVC());
-
-            if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
-                output.output("TRACE(%d): %" PRIu64 " ns: Copying event (src = %d, dest = %d) "
-                              "over crossbar in router %d (%s) from port %d, VC %d to port"
-                              " %d, VC %d.\n",
-                              ev->getTraceID(),
-                              getCurrentSimTimeNano(),
-                              ev->getSrc(),
-                              ev->getDest(),
-                              id,
-                              getName().c_str(),
-                              i,
-                              progress_vcs[i] ,
-                              ev->getNextPort(),
-                              ev->getVC());
-            }
-
+            moveEvent(i);
         }
         else if ( progress_vcs[i] == -2 ) {
                 xbar_stalls[i]->addData(1);
@@ -444,6 +445,29 @@ hr_router::clock_handler(Cycle_t cycle)
     return false;
 }
 
+void
+hr_router::moveEvent(int port)
+{
+    internal_router_event* ev = ports[port]->recv(progress_vcs[port]);
+    ports[ev->getNextPort()]->send(ev,ev->getVC());
+
+    if ( ev->getTraceType() == SimpleNetwork::Request::FULL ) {
+        output.output("TRACE(%d): %" PRIu64 " ns: Copying event (src = %d, dest = %d) "
+                      "over crossbar in router %d (%s) from port %d, VC %d to port"
+                      " %d, VC %d.\n",
+                      ev->getTraceID(),
+                      getCurrentSimTimeNano(),
+                      ev->getSrc(),
+                      ev->getDest(),
+                      id,
+                      getName().c_str(),
+                      port,
+                      progress_vcs[port] ,
+                      ev->getNextPort(),
+                      ev->getVC());
+    }
+}
+
 void hr_router::setup()
 {
     for ( int i = 0; i < num_ports; i++ ) {
@@ -116,6 +116,8 @@ private:
     int* in_port_busy;
     int* out_port_busy;
     int* progress_vcs;
+    int* progress_ports;    // Ports reported by a sparse arbiter
+    bool sparse_arb;
 
     UnitAlgebra input_buf_size;
     UnitAlgebra output_buf_size;
@@ -128,6 +130,7 @@ private:
     std::vector<std::string> inspector_names;
 
     bool clock_handler(Cycle_t cycle);
+    void moveEvent(int port);
     static void sigHandler(int signal);
 
     void init_vcs();
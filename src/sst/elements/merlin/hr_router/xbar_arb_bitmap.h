@@ -0,0 +1,402 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+
+#ifndef COMPONENTS_HR_ROUTER_XBAR_ARB_BITMAP_H
+#define COMPONENTS_HR_ROUTER_XBAR_ARB_BITMAP_H
+
+#include <sst/core/component.h>
+#include <sst/core/event.h>
+#include <sst/core/link.h>
+#include <sst/core/timeConverter.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "sst/elements/merlin/merlin.h"
+#include "sst/elements/merlin/router.h"
+
+namespace SST {
+namespace Merlin {
+
+// Sparse crossbar arbitration.  Instead of looping over every port
+// and VC each cycle, the arbiter walks the bitmask of input ports
+// that have data (maintained by the router) masked with the input
+// ports that are not busy, using find-first-set, and at each port
+// the bitmask of VCs with data, also kept by the router.  Busy ports
+// are held in a timing wheel indexed by the cycle they become free,
+// so nothing is decremented per cycle and idle periods cost nothing
+// to catch up.  The derived classes below only decide the order in
+// which input ports and VCs get to pick.
+class xbar_arb_bitmap : public XbarArbitration {
+
+protected:
+    int num_ports;
+    int num_vcs;
+    int num_words;
+
+    // Bit set if the xbar input (in_free) or output (out_free) of the
+    // port is not busy
+    std::vector<uint64_t> in_free;
+    std::vector<uint64_t> out_free;
+
+    // Cycle at which each busy port becomes free
+    std::vector<uint64_t> in_busy_until;
+    std::vector<uint64_t> out_busy_until;
+
+    // Timing wheel of busy ports.  Entries are port numbers, offset
+    // by num_ports for outputs.  A port is filed under the slot of the
+    // cycle it becomes free; longer waits stay in the slot for a full
+    // turn of the wheel.
+    static const int wheel_size = 64;
+    std::vector<int> wheel[wheel_size];
+
+    uint64_t cycle;        // Current arbitration cycle
+    uint64_t wheel_cycle;  // Next cycle whose wheel slot has not been processed
+
+    // Scratch list of candidate input ports for this cycle
+    std::vector<int> candidates;
+
+    // Scratch state for the dense arbitrate() interface
+    std::vector<uint64_t> dense_active;
+    std::vector<uint64_t> dense_ready;
+    std::vector<int> dense_progress_ports;
+
+public:
+
+    xbar_arb_bitmap(ComponentId_t cid, Params& params) :
+        XbarArbitration(cid),
+        num_ports(0),
+        num_vcs(0),
+        num_words(0),
+        cycle(0),
+        wheel_cycle(0)
+    {
+    }
+
+    ~xbar_arb_bitmap() {
+    }
+
+    void setPorts(int num_ports_s, int num_vcs_s) {
+        num_ports = num_ports_s;
+        num_vcs = num_vcs_s;
+        if ( num_vcs > 64 ) {
+            merlin_abort.fatal(CALL_INFO_LONG, 1, "xbar_arb_bitmap: supports at most 64 VCs, router has %d\n", num_vcs);
+        }
+
+        num_words = (num_ports + 63) / 64;
+        in_free.assign(num_words, 0);
+        out_free.assign(num_words, 0);
+        for ( int i = 0; i < num_ports; i++ ) {
+            in_free[i / 64] |= (uint64_t)1 << (i % 64);
+            out_free[i / 64] |= (uint64_t)1 << (i % 64);
+        }
+        in_busy_until.assign(num_ports, 0);
+        out_busy_until.assign(num_ports, 0);
+        candidates.reserve(num_ports);
+        dense_active.assign(num_words, 0);
+        dense_ready.assign(num_ports, 0);
+        dense_progress_ports.assign(num_ports, 0);
+        setVCs();
+    }
+
+    bool isSparse() { return true; }
+
+    // The sparse interface is always used by hr_router, but keep the
+    // dense one working for any other router
+    void arbitrate(
+#if VERIFY_DECLOCKING
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc, bool clocking
+#else
+                   PortInterface** ports, int* in_port_busy, int* out_port_busy, int* progress_vc
+#endif
+                   )
+    {
+        // No router bookkeeping to rely on, so build the masks from the VC heads
+        std::fill(dense_active.begin(), dense_active.end(), 0);
+        for ( int i = 0; i < num_ports; i++ ) {
+            progress_vc[i] = -1;
+            internal_router_event** vc_heads = ports[i]->getVCHeads();
+            uint64_t ready = 0;
+            for ( int vc = 0; vc < num_vcs; vc++ ) {
+                if ( vc_heads[vc] != NULL ) ready |= (uint64_t)1 << vc;
+            }
+            dense_ready[i] = ready;
+            if ( ready ) dense_active[i / 64] |= (uint64_t)1 << (i % 64);
+        }
+        arbitrateSparse(ports, dense_active.data(), dense_ready.data(), progress_vc, dense_progress_ports.data());
+        getPortBusy(in_port_busy, out_port_busy);
+    }
+
+    int arbitrateSparse(PortInterface** ports, const uint64_t* active_ports, const uint64_t* ready_vcs,
+                        int* progress_vc, int* progress_ports) {
+        expireBusy();
+
+        // Input ports that have data and are free to send
+        candidates.clear();
+        for ( int w = 0; w < num_words; w++ ) {
+            uint64_t bits = active_ports[w] & in_free[w];
+            while ( bits ) {
+                candidates.push_back(w * 64 + __builtin_ctzll(bits));
+                bits &= bits - 1;
+            }
+        }
+        orderPorts(candidates);
+
+        int count = 0;
+        for ( size_t c = 0; c < candidates.size(); c++ ) {
+            int port = candidates[c];
+            internal_router_event** vc_heads = ports[port]->getVCHeads();
+            uint64_t ready = ready_vcs[port];
+
+            bool stalled = false;
+            int granted = -1;
+            while ( ready ) {
+                int vc = nextVC(port, ready);
+                ready &= ~((uint64_t)1 << vc);
+
+                internal_router_event* src_event = vc_heads[vc];
+                int next_port = src_event->getNextPort();
+
+                // We can progress if the next port's output is not
+                // busy and there are enough credits
+                if ( !(out_free[next_port / 64] & ((uint64_t)1 << (next_port % 64))) ||
+                     !ports[next_port]->spaceToSend(src_event->getVC(), src_event->getFlitCount()) ) {
+                    stalled = true;
+                    continue;
+                }
+
+                granted = vc;
+                setBusy(port, false, src_event->getFlitCount());
+                setBusy(next_port, true, src_event->getFlitCount());
+                break;
+            }
+
+            if ( granted != -1 ) {
+                progress_vc[port] = granted;
+                progress_ports[count++] = port;
+                grantedVC(port, granted);
+            }
+            else if ( stalled ) {
+                progress_vc[port] = -2;
+                progress_ports[count++] = port;
+            }
+        }
+
+        endCycle();
+        cycle++;
+        return count;
+    }
+
+    void reportSkippedCycles(Cycle_t cycles) {
+        cycle += cycles;
+        skippedCycles(cycles);
+    }
+
+    void getPortBusy(int* in_port_busy, int* out_port_busy) {
+        for ( int i = 0; i < num_ports; i++ ) {
+            in_port_busy[i] = in_busy_until[i] > cycle ? in_busy_until[i] - cycle : 0;
+            out_port_busy[i] = out_busy_until[i] > cycle ? out_busy_until[i] - cycle : 0;
+        }
+    }
+
+protected:
+    // Policy hooks
+    virtual void setVCs() = 0;
+    // Put the candidate input ports in the order they pick outputs
+    virtual void orderPorts(std::vector<int>& ports) = 0;
+    // Return the VC in 'ready' (non-empty) that port should try next
+    virtual int nextVC(int port, uint64_t ready) = 0;
+    virtual void grantedVC(int port, int vc) = 0;
+    virtual void endCycle() {}
+    virtual void skippedCycles(Cycle_t cycles) {}
+
+    // Lowest set bit of mask at or above start, wrapping around
+    static int firstFrom(uint64_t mask, int start) {
+        uint64_t high = start < 64 ? mask & (~(uint64_t)0 << start) : 0;
+        return __builtin_ctzll(high ? high : mask);
+    }
+
+private:
+    void setBusy(int port, bool out, int flits) {
+        uint64_t until = cycle + flits;
+        if ( out ) {
+            out_busy_until[port] = until;
+            out_free[port / 64] &= ~((uint64_t)1 << (port % 64));
+        }
+        else {
+            in_busy_until[port] = until;
+            in_free[port / 64] &= ~((uint64_t)1 << (port % 64));
+        }
+        wheel[until % wheel_size].push_back(out ? port + num_ports : port);
+    }
+
+    // Free the ports whose busy time has ended by the current cycle
+    void expireBusy() {
+        if ( cycle < wheel_cycle ) return;
+        uint64_t slots = cycle - wheel_cycle + 1;
+        if ( slots > wheel_size ) slots = wheel_size;
+        for ( uint64_t s = 0; s < slots; s++ ) {
+            std::vector<int>& slot = wheel[(wheel_cycle + s) % wheel_size];
+            for ( size_t i = 0; i < slot.size(); ) {
+                int entry = slot[i];
+                bool out = entry >= num_ports;
+                int port = out ? entry - num_ports : entry;
+                uint64_t until = out ? out_busy_until[port] : in_busy_until[port];
+                if ( until > cycle ) {
+                    i++;
+                    continue;
+                }
+                if ( out ) out_free[port / 64] |= (uint64_t)1 << (port % 64);
+                else in_free[port / 64] |= (uint64_t)1 << (port % 64);
+                slot[i] = slot.back();
+                slot.pop_back();
+            }
+        }
+        wheel_cycle = cycle + 1;
+    }
+};
+
+
+class xbar_arb_bitmap_rr : public xbar_arb_bitmap {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        xbar_arb_bitmap_rr,
+        "merlin",
+        "xbar_arb_bitmap_rr",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Round robin arbitration unit for hr_router that only visits ports with data",
+        SST::Merlin::XbarArbitration)
+
+private:
+    int rr_port;
+    std::vector<int> rr_vcs;
+
+public:
+
+    xbar_arb_bitmap_rr(ComponentId_t cid, Params& params) :
+        xbar_arb_bitmap(cid, params),
+        rr_port(0)
+    {
+    }
+
+    void dumpState(std::ostream& stream) {
+        stream << "Current round robin port: " << rr_port << std::endl;
+        stream << "  Current round robin VC by port:" << std::endl;
+        for ( int i = 0; i < num_ports; i++ ) {
+            stream << i << ": " << rr_vcs[i] << std::endl;
+        }
+    }
+
+protected:
+    void setVCs() {
+        rr_vcs.assign(num_ports, 0);
+    }
+
+    // Candidates are in port order, rotate so rr_port goes first
+    void orderPorts(std::vector<int>& ports) {
+        std::vector<int>::iterator first = std::lower_bound(ports.begin(), ports.end(), rr_port);
+        std::rotate(ports.begin(), first, ports.end());
+    }
+
+    int nextVC(int port, uint64_t ready) {
+        return firstFrom(ready, rr_vcs[port]);
+    }
+
+    void grantedVC(int port, int vc) {
+        rr_vcs[port] = (vc + 1) % num_vcs;
+    }
+
+    void endCycle() {
+        rr_port = (rr_port + 1) % num_ports;
+    }
+
+    void skippedCycles(Cycle_t cycles) {
+        rr_port = (rr_port + cycles) % num_ports;
+    }
+};
+
+
+class xbar_arb_bitmap_lru : public xbar_arb_bitmap {
+
+public:
+
+    SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+        xbar_arb_bitmap_lru,
+        "merlin",
+        "xbar_arb_bitmap_lru",
+        SST_ELI_ELEMENT_VERSION(1,0,0),
+        "Least recently used arbitration unit for hr_router that only visits ports with data",
+        SST::Merlin::XbarArbitration)
+
+private:
+    // Sequence number of the last grant to each input port and VC.
+    // Lower numbers were granted longer ago and go first.
+    uint64_t grant_seq;
+    std::vector<uint64_t> port_last;
+    std::vector<uint64_t> vc_last;
+
+public:
+
+    xbar_arb_bitmap_lru(ComponentId_t cid, Params& params) :
+        xbar_arb_bitmap(cid, params),
+        grant_seq(0)
+    {
+    }
+
+    void dumpState(std::ostream& stream) {
+        stream << "Last grant by port:" << std::endl;
+        for ( int i = 0; i < num_ports; i++ ) {
+            stream << i << ": " << port_last[i] << std::endl;
+        }
+    }
+
+protected:
+    void setVCs() {
+        port_last.assign(num_ports, 0);
+        vc_last.assign(num_ports * num_vcs, 0);
+    }
+
+    void orderPorts(std::vector<int>& ports) {
+        std::stable_sort(ports.begin(), ports.end(),
+                         [this](int a, int b) { return port_last[a] < port_last[b]; });
+    }
+
+    int nextVC(int port, uint64_t ready) {
+        const uint64_t* last = &vc_last[port * num_vcs];
+        int best = __builtin_ctzll(ready);
+        ready &= ready - 1;
+        while ( ready ) {
+            int vc = __builtin_ctzll(ready);
+            if ( last[vc] < last[best] ) best = vc;
+            ready &= ready - 1;
+        }
+        return best;
+    }
+
+    void grantedVC(int port, int vc) {
+        grant_seq++;
+        port_last[port] = grant_seq;
+        vc_last[port * num_vcs + vc] = grant_seq;
+    }
+};
+
+}
+}
+
+#endif // COMPONENTS_HR_ROUTER_XBAR_ARB_BITMAP_H
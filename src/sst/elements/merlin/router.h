@@ -28,6 +28,7 @@
 #include <sst/core/interfaces/simpleNetwork.h>
 
 #include <queue>
+#include <vector>
 
 namespace SST {
 namespace Merlin {
@@ -50,6 +51,20 @@ protected:
 
     int vcs_with_data;
 
+    // Per port count of VCs with data, per port bitmask of the VCs
+    // with data (bit vc, first 64 VCs only) and a bitmask (bit p of
+    // word p/64) of the ports that have any, so arbitration can skip
+    // idle ports and VCs.  Sized by initPortsWithData().
+    std::vector<int> port_vcs_with_data;
+    std::vector<uint64_t> port_ready_vcs;
+    std::vector<uint64_t> ports_with_data;
+
+    void initPortsWithData(int num_ports) {
+        port_vcs_with_data.assign(num_ports, 0);
+        port_ready_vcs.assign(num_ports, 0);
+        ports_with_data.assign((num_ports + 63) / 64, 0);
+    }
+
 public:
 
     Router(ComponentId_t id) :
@@ -68,6 +83,27 @@ public:
     inline void dec_vcs_with_data() { vcs_with_data--; }
     inline int get_vcs_with_data() { return vcs_with_data; }
 
+    inline void inc_vcs_with_data(int port, int vc) {
+        vcs_with_data++;
+        if ( port < (int)port_vcs_with_data.size() ) {
+            if ( vc < 64 ) port_ready_vcs[port] |= (uint64_t)1 << vc;
+            if ( port_vcs_with_data[port]++ == 0 ) {
+                ports_with_data[port / 64] |= (uint64_t)1 << (port % 64);
+            }
+        }
+    }
+    inline void dec_vcs_with_data(int port, int vc) {
+        vcs_with_data--;
+        if ( port < (int)port_vcs_with_data.size() ) {
+            if ( vc < 64 ) port_ready_vcs[port] &= ~((uint64_t)1 << vc);
+            if ( --port_vcs_with_data[port] == 0 ) {
+                ports_with_data[port / 64] &= ~((uint64_t)1 << (port % 64));
+            }
+        }
+    }
+    inline const uint64_t* get_ports_with_data() { return ports_with_data.data(); }
+    inline const uint64_t* get_port_ready_vcs() { return port_ready_vcs.data(); }
+
     virtual int const* getOutputBufferCredits() = 0;
     virtual void sendCtrlEvent(CtrlRtrEvent* ev, int port = -1) = 0;
     virtual void recvCtrlEvent(int port, CtrlRtrEvent* ev) = 0;
@@ -650,6 +686,19 @@ public:
     virtual void reportSkippedCycles(Cycle_t cycles) {};
     virtual void dumpState(std::ostream& stream) {};
 
+    // Sparse arbiters only look at the input ports in active_ports (a
+    // bitmask of ports with data), and at each port only at the VCs in
+    // ready_vcs[port], and keep the xbar busy state themselves.  They
+    // fill progress_ports with the input ports that either progressed
+    // (progress_vc[port] >= 0) or stalled (progress_vc[port] == -2)
+    // and return how many there are.  The router then only visits
+    // those ports.
+    virtual bool isSparse() { return false; }
+    virtual int arbitrateSparse(PortInterface** ports, const uint64_t* active_ports, const uint64_t* ready_vcs,
+                                int* progress_vc, int* progress_ports) { return 0; }
+    // Copy the busy state of a sparse arbiter into the router's arrays
+    virtual void getPortBusy(int* in_port_busy, int* out_port_busy) {};
+
 };
 
 }
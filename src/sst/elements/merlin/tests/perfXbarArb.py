@@ -0,0 +1,76 @@
+# Performance comparison of hr_router crossbar arbiters
+# A high-radix dragonfly (31-port routers, 2 VNs) runs all-to-all test
+# traffic. Run once per arbiter and compare wall-clock time (router
+# cycles/sec), e.g.,
+#   time sst perfXbarArb.py --model-options="merlin.xbar_arb_lru"
+#   time sst perfXbarArb.py --model-options="merlin.xbar_arb_bitmap_lru"
+#   time sst perfXbarArb.py --model-options="merlin.xbar_arb_rr"
+#   time sst perfXbarArb.py --model-options="merlin.xbar_arb_bitmap_rr"
+import sys
+import sst
+from sst.merlin.base import *
+from sst.merlin.endpoint import *
+from sst.merlin.interface import *
+from sst.merlin.topology import *
+
+xbar_arb = "merlin.xbar_arb_lru"
+if len(sys.argv) > 1:
+    xbar_arb = sys.argv[1]
+
+if __name__ == "__main__":
+
+    ### Setup the topology
+    topo = topoDragonFly()
+    topo.hosts_per_router = 8
+    topo.routers_per_group = 16
+    topo.intergroup_links = 8
+    topo.num_groups = 9
+    topo.algorithm = ["minimal","ugal"]
+
+    # Set up the routers
+    router = hr_router()
+    router.link_bw = "4GB/s"
+    router.flit_size = "8B"
+    router.xbar_bw = "6GB/s"
+    router.input_latency = "20ns"
+    router.output_latency = "20ns"
+    router.input_buf_size = "4kB"
+    router.output_buf_size = "4kB"
+    router.num_vns = 2
+    router.xbar_arb = xbar_arb
+
+    topo.router = router
+    topo.link_latency = "20ns"
+
+    ### set up the endpoint
+    networkif = LinkControl()
+    networkif.link_bw = "4GB/s"
+    networkif.input_buf_size = "1kB"
+    networkif.output_buf_size = "1kB"
+
+    networkif2 = LinkControl()
+    networkif2.link_bw = "4GB/s"
+    networkif2.input_buf_size = "1kB"
+    networkif2.output_buf_size = "1kB"
+
+    networkif.vn_remap = [0]
+    networkif2.vn_remap = [1]
+
+    half = topo.getNumNodes() // 2
+
+    ep = TestJob(0,half)
+    ep.network_interface = networkif
+    ep.num_messages = 200
+    ep.message_size = "64B"
+
+    ep2 = TestJob(1,half)
+    ep2.network_interface = networkif2
+    ep2.num_messages = 200
+    ep2.message_size = "64B"
+
+    system = System()
+    system.setTopology(topo)
+    system.allocateNodes(ep,"linear")
+    system.allocateNodes(ep2,"linear")
+
+    system.build()
@@ -2,6 +2,7 @@
 
 from sst_unittest import *
 from sst_unittest_support import *
+import re
 
 ################################################################################
 # Code to support a single instance module initialize, must be called setUp method
@@ -76,6 +77,12 @@ class testcase_merlin_Component(SSTTestCase):
     def test_merlin_dragon_128_fl(self):
         self.merlin_test_template("dragon_128_test_fl")
 
+    def test_merlin_torus_64_xbar_arb_bitmap_rr(self):
+        self.merlin_xbar_arb_test_template("torus_64_test", "merlin.xbar_arb_bitmap_rr")
+
+    def test_merlin_torus_64_xbar_arb_bitmap_lru(self):
+        self.merlin_xbar_arb_test_template("torus_64_test", "merlin.xbar_arb_bitmap_lru")
+
 
 #####
 
@@ -113,3 +120,38 @@ class testcase_merlin_Component(SSTTestCase):
             diffdata = testing_get_diff_data(testcase)
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted Output file {0} does not match sorted Reference File {1}".format(outfile, reffile))
+
+    def merlin_xbar_arb_test_template(self, testcase, xbar_arb):
+        # The bitmap arbiters grant in a different order than the arbiter the
+        # reference file was made with, so the cycle stamps, stall counts and
+        # end time differ. Every NIC must still send and receive every packet.
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+
+        testDataFileName="test_merlin_{0}_{1}".format(testcase, xbar_arb.split(".")[-1])
+
+        sdlfile = "{0}/{1}.py".format(test_path, testcase)
+        reffile = "{0}/refFiles/test_merlin_{1}.out".format(test_path, testcase)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+        mpioutfiles = "{0}/{1}.testfile".format(outdir, testDataFileName)
+
+        self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles,
+                     other_args='--model-options "--xbar_arb={0}"'.format(xbar_arb))
+
+        if os_test_file(errfile, "-s"):
+            log_testing_note("merlin test {0} has a Non-Empty Error File {1}".format(testDataFileName, errfile))
+
+        out_lines = self._get_packet_lines(outfile)
+        ref_lines = self._get_packet_lines(reffile)
+        self.assertTrue(len(ref_lines) > 0, "Reference File {0} has no packet lines".format(reffile))
+        self.assertEqual(out_lines, ref_lines, "Packets sent and received in output file {0} do not match Reference File {1}".format(outfile, reffile))
+
+    def _get_packet_lines(self, filename):
+        lines = []
+        with open(filename, 'r') as fp:
+            for line in fp:
+                line = re.sub(r"^\s*\d+:\s*", "", line.strip())
+                if "Finished sending packets" in line or "received all packets" in line:
+                    lines.append(line)
+        return sorted(lines)
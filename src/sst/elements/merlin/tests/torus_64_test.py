@@ -11,6 +11,7 @@
 # information, see the LICENSE file in the top level directory of the
 # distribution.
 
+import sys
 import sst
 from sst.merlin import *
 
@@ -37,6 +38,9 @@ if __name__ == "__main__":
 
     #sst.merlin._params["checkerboard"] = "1"
     sst.merlin._params["xbar_arb"] = "merlin.xbar_arb_lru"
+    for arg in sys.argv[1:]:
+        if arg.startswith("--xbar_arb="):
+            sst.merlin._params["xbar_arb"] = arg[len("--xbar_arb="):]
 
     topo.prepParams()
     endPoint.prepParams()
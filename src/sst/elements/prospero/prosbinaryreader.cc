@@ -17,11 +17,14 @@
 #include "sst_config.h"
 #include "prosbinaryreader.h"
 
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 using namespace SST::Prospero;
 
 
 ProsperoBinaryTraceReader::ProsperoBinaryTraceReader( ComponentId_t id, Params& params, Output* out ) :
-	ProsperoTraceReader(id, params, out) {
+	ProsperoBlockTraceReader(id, params, out) {
 
 	std::string traceFile = params.find<std::string>("file", "");
 	traceInput = fopen(traceFile.c_str(), "rb");
@@ -31,50 +34,43 @@ ProsperoBinaryTraceReader::ProsperoBinaryTraceReader( ComponentId_t id, Params&
                     getName().c_str(), traceFile.c_str());
 	}
 
-	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
-	buffer = (char*) malloc(sizeof(char) * recordLength);
-}
+	traceMap = NULL;
+	traceMapLength = 0;
 
-ProsperoBinaryTraceReader::~ProsperoBinaryTraceReader() {
-	if(NULL != traceInput) {
-		fclose(traceInput);
-	}
+	if(params.find<bool>("use_mmap", true)) {
+		struct stat traceStat;
 
-	if(NULL != buffer) {
-		free(buffer);
-	}
-}
+		if(0 == fstat(fileno(traceInput), &traceStat) && S_ISREG(traceStat.st_mode) && traceStat.st_size > 0) {
+			void* map = mmap(NULL, (size_t) traceStat.st_size, PROT_READ, MAP_PRIVATE, fileno(traceInput), 0);
 
-void ProsperoBinaryTraceReader::copy(char* target, const char* source,
-	const size_t bufferOffset, const size_t len) {
+			if(MAP_FAILED != map) {
+				traceMap = (char*) map;
+				traceMapLength = (size_t) traceStat.st_size;
+				madvise(traceMap, traceMapLength, MADV_SEQUENTIAL);
+			}
+		}
 
-	for(size_t i = 0; i < len; ++i) {
-		target[i] = source[bufferOffset + i];
+		if(NULL == traceMap) {
+			output->verbose(CALL_INFO, 1, 0, "Unable to map trace file %s, reading it in blocks instead.\n",
+				traceFile.c_str());
+		}
 	}
+
+	startReading(traceMap, traceMapLength);
 }
 
-ProsperoTraceEntry* ProsperoBinaryTraceReader::readNextEntry() {
-	uint64_t reqAddress = 0;
-	uint64_t reqCycles  = 0;
-	char reqType = 'R';
-	uint32_t reqLength  = 0;
+ProsperoBinaryTraceReader::~ProsperoBinaryTraceReader() {
+	stopPrefetch();
 
-	if(feof(traceInput)) {
-		return NULL;
+	if(NULL != traceMap) {
+		munmap(traceMap, traceMapLength);
 	}
 
-	if(1 == fread(buffer, (size_t) recordLength, (size_t) 1, traceInput)) {
-		// We DID read an entry
-		copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
-		copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
-		copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
-		copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
-
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
-	} else {
-		// Did not get a full read?
-		return NULL;
+	if(NULL != traceInput) {
+		fclose(traceInput);
 	}
 }
+
+size_t ProsperoBinaryTraceReader::readBlock(char* buffer, size_t len) {
+	return fread(buffer, 1, len, traceInput);
+}
@@ -17,17 +17,16 @@
 #ifndef _H_SST_PROSPERO_BINARY_READER
 #define _H_SST_PROSPERO_BINARY_READER
 
-#include "prosreader.h"
+#include "prosblockreader.h"
 
 namespace SST {
 namespace Prospero {
 
-class ProsperoBinaryTraceReader : public ProsperoTraceReader {
+class ProsperoBinaryTraceReader : public ProsperoBlockTraceReader {
 
 public:
         ProsperoBinaryTraceReader( ComponentId_t id, Params& params, Output* out );
         ~ProsperoBinaryTraceReader();
-        ProsperoTraceEntry* readNextEntry();
 
  	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
         	ProsperoBinaryTraceReader,
@@ -39,15 +38,20 @@ public:
     	)
 
 	SST_ELI_DOCUMENT_PARAMS(
-		{ "file", "Sets the file for the trace reader to use", "" }
+		{ "file", "Sets the file for the trace reader to use", "" },
+		{ "use_mmap", "Map the trace into memory and decode it in place rather than reading it in blocks", "true" },
+		{ "block_size", "Bytes of trace read at a time when not mapped", "4194304" },
+		{ "batch_size", "Number of records decoded at a time", "4096" },
+		{ "prefetch", "Read the next block on a helper thread while the current one is decoded", "false" }
 	)
 
+protected:
+	size_t readBlock(char* buffer, size_t len);
+
 private:
-	void copy(char* target, const char* source,
-		const size_t offset, const size_t len);
 	FILE* traceInput;
-	char* buffer;
-	uint32_t recordLength;
+	char* traceMap;
+	size_t traceMapLength;
 
 };
 
@@ -17,11 +17,13 @@
 #include "sst_config.h"
 #include "prosbingzreader.h"
 
+#include <algorithm>
+
 using namespace SST::Prospero;
 
 
 ProsperoCompressedBinaryTraceReader::ProsperoCompressedBinaryTraceReader( ComponentId_t id, Params& params, Output* out ) :
-	ProsperoTraceReader(id, params, out) {
+	ProsperoBlockTraceReader(id, params, out) {
 
 	std::string traceFile = params.find<std::string>("file", "");
 	traceInput = gzopen(traceFile.c_str(), "rb");
@@ -31,56 +33,37 @@ ProsperoCompressedBinaryTraceReader::ProsperoCompressedBinaryTraceReader( Compon
 			getName().c_str(), traceFile.c_str());
 	}
 
-	recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
-	buffer = (char*) malloc(sizeof(char) * recordLength);
+	gzbuffer(traceInput, 256 * 1024);
+
+	startReading();
 }
 
 ProsperoCompressedBinaryTraceReader::~ProsperoCompressedBinaryTraceReader() {
+	stopPrefetch();
+
 	if(NULL != traceInput) {
 		gzclose(traceInput);
 	}
-
-	if(NULL != buffer) {
-		free(buffer);
-	}
 }
 
-void ProsperoCompressedBinaryTraceReader::copy(char* target, const char* source,
-	const size_t bufferOffset, const size_t len) {
+size_t ProsperoCompressedBinaryTraceReader::readBlock(char* buffer, size_t len) {
+	size_t bytesRead = 0;
 
-	for(size_t i = 0; i < len; ++i) {
-		target[i] = source[bufferOffset + i];
-	}
-}
+	while(bytesRead < len) {
+		const int result = gzread(traceInput, buffer + bytesRead, (unsigned int) std::min(len - bytesRead, (size_t) 1 << 30));
 
-ProsperoTraceEntry* ProsperoCompressedBinaryTraceReader::readNextEntry() {
-	output->verbose(CALL_INFO, 4, 0, "Reading next trace entry...\n");
+		if(result < 0) {
+			int errnum;
+			output->fatal(CALL_INFO, -1, "%s, Fatal: error decompressing trace: %s\n",
+				getName().c_str(), gzerror(traceInput, &errnum));
+		}
 
-	uint64_t reqAddress = 0;
-	uint64_t reqCycles  = 0;
-	char reqType = 'R';
-	uint32_t reqLength  = 0;
+		if(0 == result) {
+			break;
+		}
 
-	if(gzeof(traceInput)) {
-		output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
-		return NULL;
+		bytesRead += (size_t) result;
 	}
 
-	unsigned int bytesRead = gzread(traceInput, buffer, (unsigned int) recordLength);
-
-	if(bytesRead == recordLength) {
-		// We DID read an entry
-		copy((char*) &reqCycles,  buffer, (size_t) 0, sizeof(uint64_t));
-		copy((char*) &reqType,    buffer, sizeof(uint64_t), sizeof(char));
-		copy((char*) &reqAddress, buffer, sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
-		copy((char*) &reqLength,  buffer, sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
-
-		return new ProsperoTraceEntry(reqCycles, reqAddress,
-			reqLength,
-			(reqType == 'R' || reqType == 'r') ? READ : WRITE);
-	} else {
-		output->verbose(CALL_INFO, 2, 0, "Did not read a full record from the compressed trace, returning empty request.\n");
-		// Did not get a full read?
-		return NULL;
-	}
+	return bytesRead;
 }
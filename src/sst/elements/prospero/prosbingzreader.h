@@ -17,18 +17,17 @@
 #ifndef _H_SST_PROSPERO_GZ_BINARY_READER
 #define _H_SST_PROSPERO_GZ_BINARY_READER
 
-#include "prosreader.h"
+#include "prosblockreader.h"
 #include "zlib.h"
 
 namespace SST {
 namespace Prospero {
 
-class ProsperoCompressedBinaryTraceReader : public ProsperoTraceReader {
+class ProsperoCompressedBinaryTraceReader : public ProsperoBlockTraceReader {
 
 public:
         ProsperoCompressedBinaryTraceReader( ComponentId_t id, Params& params, Output* out );
         ~ProsperoCompressedBinaryTraceReader();
-        ProsperoTraceEntry* readNextEntry();
 
 	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
                	ProsperoCompressedBinaryTraceReader,
@@ -40,14 +39,17 @@ public:
 	)
 
        	SST_ELI_DOCUMENT_PARAMS(
-               	{ "file", "Sets the file for the trace reader to use", "" }
+               	{ "file", "Sets the file for the trace reader to use", "" },
+               	{ "block_size", "Bytes of uncompressed trace read at a time", "4194304" },
+               	{ "batch_size", "Number of records decoded at a time", "4096" },
+               	{ "prefetch", "Decompress the next block on a helper thread while the current one is decoded", "false" }
        	)
 
+protected:
+	size_t readBlock(char* buffer, size_t len);
+
 private:
-	void copy(char* target, const char* source, const size_t buffOffset, const size_t len);
 	gzFile traceInput;
-	char* buffer;
-	uint32_t recordLength;
 
 };
 
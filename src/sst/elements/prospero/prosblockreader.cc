@@ -0,0 +1,246 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "prosblockreader.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace SST::Prospero;
+
+
+ProsperoBlockTraceReader::ProsperoBlockTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoTraceReader(id, params, out) {
+
+	blockSize = params.find<size_t>("block_size", 4 * 1024 * 1024);
+	size_t batchSize = params.find<size_t>("batch_size", 4096);
+	prefetch = params.find<bool>("prefetch", false);
+
+	if(blockSize < recordLength) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: block_size must be at least one record (%" PRIu64 " bytes), got %" PRIu64 "\n",
+			getName().c_str(), (uint64_t) recordLength, (uint64_t) blockSize);
+	}
+
+	if(0 == batchSize) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: batch_size must be at least 1\n", getName().c_str());
+	}
+
+	batch.resize(batchSize);
+	batchCount = 0;
+	batchNext = 0;
+
+	block = NULL;
+	blockLength = 0;
+	blockOffset = 0;
+	traceDone = false;
+	partialLength = 0;
+
+	backLength = 0;
+	backReady = false;
+	backEmpty = false;
+	prefetchStop = false;
+
+	recordsRead = 0;
+	readTime = std::chrono::steady_clock::duration::zero();
+}
+
+ProsperoBlockTraceReader::~ProsperoBlockTraceReader() {
+	stopPrefetch();
+}
+
+void ProsperoBlockTraceReader::startReading(const char* mapped, size_t mappedLength) {
+	if(NULL != mapped) {
+		// The whole trace is one block, nothing to read or prefetch
+		prefetch = false;
+		block = mapped;
+		blockLength = mappedLength;
+		traceDone = true;
+		return;
+	}
+
+	frontBuffer.resize(blockSize);
+
+	if(prefetch) {
+		backBuffer.resize(blockSize);
+		prefetchThread = std::thread(&ProsperoBlockTraceReader::prefetchLoop, this);
+	}
+}
+
+void ProsperoBlockTraceReader::stopPrefetch() {
+	if(!prefetchThread.joinable()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(prefetchLock);
+		prefetchStop = true;
+	}
+	prefetchCond.notify_all();
+	prefetchThread.join();
+}
+
+void ProsperoBlockTraceReader::prefetchLoop() {
+	while(true) {
+		char* target;
+
+		{
+			std::unique_lock<std::mutex> lock(prefetchLock);
+			prefetchCond.wait(lock, [this]{ return prefetchStop || !backReady; });
+
+			if(prefetchStop) {
+				return;
+			}
+
+			// The back buffer belongs to this thread until it is marked ready
+			target = backBuffer.data();
+		}
+
+		const size_t bytesRead = readBlock(target, blockSize);
+
+		{
+			std::lock_guard<std::mutex> lock(prefetchLock);
+			backLength = bytesRead;
+			backEmpty = (0 == bytesRead);
+			backReady = true;
+		}
+		prefetchCond.notify_all();
+
+		if(0 == bytesRead) {
+			return;
+		}
+	}
+}
+
+bool ProsperoBlockTraceReader::nextBlock() {
+	if(traceDone) {
+		return false;
+	}
+
+	size_t bytesRead = 0;
+
+	if(prefetch) {
+		{
+			std::unique_lock<std::mutex> lock(prefetchLock);
+			prefetchCond.wait(lock, [this]{ return backReady; });
+
+			if(!backEmpty) {
+				frontBuffer.swap(backBuffer);
+				bytesRead = backLength;
+				backReady = false;
+			}
+		}
+		prefetchCond.notify_all();
+	} else {
+		bytesRead = readBlock(frontBuffer.data(), blockSize);
+	}
+
+	if(0 == bytesRead) {
+		traceDone = true;
+		return false;
+	}
+
+	block = frontBuffer.data();
+	blockLength = bytesRead;
+	blockOffset = 0;
+	return true;
+}
+
+static inline void decodeRecord(ProsperoTraceEntry& entry, const char* record) {
+	uint64_t reqCycles;
+	char reqType;
+	uint64_t reqAddress;
+	uint32_t reqLength;
+
+	memcpy(&reqCycles,  record, sizeof(uint64_t));
+	memcpy(&reqType,    record + sizeof(uint64_t), sizeof(char));
+	memcpy(&reqAddress, record + sizeof(uint64_t) + sizeof(char), sizeof(uint64_t));
+	memcpy(&reqLength,  record + sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t), sizeof(uint32_t));
+
+	entry.set(reqCycles, reqAddress, reqLength,
+		(reqType == 'R' || reqType == 'r') ? READ : WRITE);
+}
+
+bool ProsperoBlockTraceReader::decodeBatch() {
+	batchCount = 0;
+	batchNext = 0;
+
+	while(batchCount < batch.size()) {
+		const size_t available = blockLength - blockOffset;
+
+		if(partialLength > 0 || available < recordLength) {
+			// Record straddles the end of the block, assemble it piece by piece
+			const size_t needed = std::min(recordLength - partialLength, available);
+			if(needed > 0) {
+				memcpy(partial + partialLength, block + blockOffset, needed);
+				partialLength += needed;
+				blockOffset += needed;
+			}
+
+			if(partialLength == recordLength) {
+				decodeRecord(batch[batchCount++], partial);
+				partialLength = 0;
+			} else if(!nextBlock()) {
+				if(partialLength > 0) {
+					output->verbose(CALL_INFO, 2, 0, "Trace ends with a partial record of %" PRIu64 " bytes, ignoring it.\n",
+						(uint64_t) partialLength);
+					partialLength = 0;
+				}
+				break;
+			}
+			continue;
+		}
+
+		const size_t count = std::min(available / recordLength, batch.size() - batchCount);
+		const char* record = block + blockOffset;
+
+		for(size_t i = 0; i < count; ++i) {
+			decodeRecord(batch[batchCount++], record);
+			record += recordLength;
+		}
+
+		blockOffset += count * recordLength;
+	}
+
+	return batchCount > 0;
+}
+
+ProsperoTraceEntry* ProsperoBlockTraceReader::readNextEntry() {
+	if(batchNext == batchCount) {
+		output->verbose(CALL_INFO, 4, 0, "Decoding next batch of trace entries...\n");
+
+		const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		const bool haveEntries = decodeBatch();
+		readTime += std::chrono::steady_clock::now() - start;
+
+		if(!haveEntries) {
+			output->verbose(CALL_INFO, 2, 0, "End of trace file reached, returning empty request.\n");
+			return NULL;
+		}
+
+		recordsRead += batchCount;
+	}
+
+	return &batch[batchNext++];
+}
+
+void ProsperoBlockTraceReader::finish() {
+	const double seconds = std::chrono::duration<double>(readTime).count();
+
+	output->verbose(CALL_INFO, 1, 0, "%s read %" PRIu64 " records in %f s (%.0f records/s)\n",
+		getName().c_str(), recordsRead, seconds,
+		seconds > 0 ? ((double) recordsRead) / seconds : 0.0);
+}
@@ -0,0 +1,108 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_BLOCK_READER
+#define _H_SST_PROSPERO_BLOCK_READER
+
+#include "prosreader.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SST {
+namespace Prospero {
+
+/*
+ * Common base for the binary trace readers.
+ *
+ * Rather than reading one 21-byte record at a time, the trace is pulled in
+ * large blocks (or mapped directly, when the source allows it) and records
+ * are decoded a batch at a time into a reusable set of entries. Derived
+ * readers only supply the raw bytes through readBlock(). Optionally a helper
+ * thread fills the next block while the current one is being decoded.
+ *
+ * Entries returned by readNextEntry() belong to the reader and are valid
+ * until they are handed back through recycleEntry().
+ */
+class ProsperoBlockTraceReader : public ProsperoTraceReader {
+
+public:
+	ProsperoBlockTraceReader( ComponentId_t id, Params& params, Output* out );
+	~ProsperoBlockTraceReader();
+
+	ProsperoTraceEntry* readNextEntry();
+	void recycleEntry(const ProsperoTraceEntry* entry) { }
+	void finish();
+
+	static const size_t recordLength = sizeof(uint64_t) + sizeof(char) + sizeof(uint64_t) + sizeof(uint32_t);
+
+protected:
+	// Read up to len bytes of raw trace into buffer, returns the number of
+	// bytes read and 0 once the trace is exhausted. Called from the helper
+	// thread when prefetching is enabled.
+	virtual size_t readBlock(char* buffer, size_t len) = 0;
+
+	// Start decoding; derived constructors call this once their source is open.
+	// If mapped is non-NULL the trace is decoded in place and readBlock() is not used.
+	void startReading(const char* mapped = NULL, size_t mappedLength = 0);
+	void stopPrefetch();
+
+private:
+	bool decodeBatch();
+	bool nextBlock();
+	void prefetchLoop();
+
+	// Decoded entries
+	std::vector<ProsperoTraceEntry> batch;
+	size_t batchCount;
+	size_t batchNext;
+
+	// Raw trace bytes currently being decoded
+	const char* block;
+	size_t blockLength;
+	size_t blockOffset;
+	bool traceDone;
+
+	// A record split across two blocks is assembled here
+	char partial[recordLength];
+	size_t partialLength;
+
+	// Block storage, two buffers when prefetching
+	size_t blockSize;
+	std::vector<char> frontBuffer;
+	std::vector<char> backBuffer;
+
+	bool prefetch;
+	std::thread prefetchThread;
+	std::mutex prefetchLock;
+	std::condition_variable prefetchCond;
+	size_t backLength;
+	bool backReady;
+	bool backEmpty;
+	bool prefetchStop;
+
+	// Throughput of the reader itself, reported at finish
+	uint64_t recordsRead;
+	std::chrono::steady_clock::duration readTime;
+};
+
+}
+}
+
+#endif
@@ -124,6 +124,8 @@ void ProsperoComponent::init(unsigned int phase) {
 void ProsperoComponent::finish() {
 	const uint64_t nanoSeconds = getCurrentSimTimeNano();
 
+	reader->finish();
+
 	output->output("\n");
 	output->output("Prospero Component Statistics:\n");
 
@@ -326,6 +328,6 @@ void ProsperoComponent::issueRequest(const ProsperoTraceEntry* entry) {
 		currentOutstanding++;
 	}
 
-	// Delete this entry, we are done converting it into a request
-	delete entry;
+	// Done converting this entry into a request, return it to the reader
+	reader->recycleEntry(entry);
 }
@@ -0,0 +1,115 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "proslz4reader.h"
+
+using namespace SST::Prospero;
+
+
+ProsperoLZ4BinaryTraceReader::ProsperoLZ4BinaryTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoBlockTraceReader(id, params, out) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	traceInput = fopen(traceFile.c_str(), "rb");
+
+	if(NULL == traceInput) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in lz4 reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	context = NULL;
+	const LZ4F_errorCode_t result = LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
+
+	if(LZ4F_isError(result)) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unable to create an lz4 decompression context: %s\n",
+			getName().c_str(), LZ4F_getErrorName(result));
+	}
+
+	input.resize(256 * 1024);
+	inputLength = 0;
+	inputOffset = 0;
+	lastResult = 0;
+
+	startReading();
+}
+
+ProsperoLZ4BinaryTraceReader::~ProsperoLZ4BinaryTraceReader() {
+	stopPrefetch();
+
+	if(NULL != context) {
+		LZ4F_freeDecompressionContext(context);
+	}
+
+	if(NULL != traceInput) {
+		fclose(traceInput);
+	}
+}
+
+size_t ProsperoLZ4BinaryTraceReader::readBlock(char* buffer, size_t len) {
+	size_t bytesDecoded = 0;
+
+	while(bytesDecoded < len) {
+		if(inputOffset == inputLength) {
+			inputLength = fread(input.data(), 1, input.size(), traceInput);
+			inputOffset = 0;
+
+			if(0 == inputLength) {
+				// A zero result means the last frame was completed and flushed
+				if(0 == lastResult) {
+					break;
+				}
+
+				// Otherwise the context may still hold decoded data, which is flushed
+				// without input. A frame that still needs input is truncated.
+				size_t outputSize = len - bytesDecoded;
+				size_t inputSize = 0;
+
+				lastResult = LZ4F_decompress(context, buffer + bytesDecoded, &outputSize,
+					input.data(), &inputSize, NULL);
+
+				if(LZ4F_isError(lastResult)) {
+					output->fatal(CALL_INFO, -1, "%s, Fatal: error decompressing trace: %s\n",
+						getName().c_str(), LZ4F_getErrorName(lastResult));
+				}
+
+				if(0 == outputSize && 0 != lastResult) {
+					output->fatal(CALL_INFO, -1, "%s, Fatal: lz4 trace ends part way through a frame, the file is truncated.\n",
+						getName().c_str());
+				}
+
+				bytesDecoded += outputSize;
+				continue;
+			}
+		}
+
+		size_t outputSize = len - bytesDecoded;
+		size_t inputSize = inputLength - inputOffset;
+
+		lastResult = LZ4F_decompress(context, buffer + bytesDecoded, &outputSize,
+			input.data() + inputOffset, &inputSize, NULL);
+
+		if(LZ4F_isError(lastResult)) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: error decompressing trace: %s\n",
+				getName().c_str(), LZ4F_getErrorName(lastResult));
+		}
+
+		inputOffset += inputSize;
+		bytesDecoded += outputSize;
+	}
+
+	return bytesDecoded;
+}
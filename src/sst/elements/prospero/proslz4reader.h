@@ -0,0 +1,64 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_LZ4_BINARY_READER
+#define _H_SST_PROSPERO_LZ4_BINARY_READER
+
+#include "prosblockreader.h"
+#include <lz4frame.h>
+
+namespace SST {
+namespace Prospero {
+
+class ProsperoLZ4BinaryTraceReader : public ProsperoBlockTraceReader {
+
+public:
+        ProsperoLZ4BinaryTraceReader( ComponentId_t id, Params& params, Output* out );
+        ~ProsperoLZ4BinaryTraceReader();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+               	ProsperoLZ4BinaryTraceReader,
+               	"prospero",
+               	"ProsperoLZ4BinaryTraceReader",
+               	SST_ELI_ELEMENT_VERSION(1,0,0),
+               	"LZ4 Compressed Binary Trace Reader",
+	       	SST::Prospero::ProsperoTraceReader
+	)
+
+       	SST_ELI_DOCUMENT_PARAMS(
+               	{ "file", "Sets the file for the trace reader to use (a binary trace compressed with the lz4 frame format)", "" },
+               	{ "block_size", "Bytes of uncompressed trace read at a time", "4194304" },
+               	{ "batch_size", "Number of records decoded at a time", "4096" },
+               	{ "prefetch", "Decompress the next block on a helper thread while the current one is decoded", "false" }
+       	)
+
+protected:
+	size_t readBlock(char* buffer, size_t len);
+
+private:
+	FILE* traceInput;
+	LZ4F_dctx* context;
+	std::vector<char> input;
+	size_t inputLength;
+	size_t inputOffset;
+	size_t lastResult;
+
+};
+
+}
+}
+
+#endif
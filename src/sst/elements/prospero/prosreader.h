@@ -32,6 +32,11 @@ typedef enum {
 
 class ProsperoTraceEntry {
 public:
+	ProsperoTraceEntry() :
+		cycles(0), address(0), length(0), op(READ) {
+
+		}
+
 	ProsperoTraceEntry(
 		const uint64_t eCyc,
 		const uint64_t eAddr,
@@ -47,11 +52,20 @@ public:
 	uint32_t getLength() const { return length; }
 	uint64_t getIssueAtCycle() const { return cycles; }
 	ProsperoTraceEntryOperation getOperationType() const { return op; }
+
+	// Used by readers which decode into a reusable set of entries
+	void set(const uint64_t eCyc, const uint64_t eAddr, const uint32_t eLen,
+		const ProsperoTraceEntryOperation eOp) {
+		cycles = eCyc;
+		address = eAddr;
+		length = eLen;
+		op = eOp;
+	}
 private:
-	const uint64_t cycles;
-	const uint64_t address;
-	const uint32_t length;
-	const ProsperoTraceEntryOperation op;
+	uint64_t cycles;
+	uint64_t address;
+	uint32_t length;
+	ProsperoTraceEntryOperation op;
 };
 
 class ProsperoTraceReader : public SubComponent {
@@ -65,6 +79,10 @@ public:
 
 	~ProsperoTraceReader() { };
 	virtual ProsperoTraceEntry* readNextEntry() { return NULL; };
+
+	// Called once the CPU is done with an entry returned by readNextEntry. Readers
+	// that hand out entries from their own storage override this to keep them.
+	virtual void recycleEntry(const ProsperoTraceEntry* entry) { delete entry; }
 	void setOutput(Output* out) { output = out; }
 
 protected:
@@ -0,0 +1,104 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#include "sst_config.h"
+#include "proszstdreader.h"
+
+using namespace SST::Prospero;
+
+
+ProsperoZstdBinaryTraceReader::ProsperoZstdBinaryTraceReader( ComponentId_t id, Params& params, Output* out ) :
+	ProsperoBlockTraceReader(id, params, out) {
+
+	std::string traceFile = params.find<std::string>("file", "");
+	traceInput = fopen(traceFile.c_str(), "rb");
+
+	if(NULL == traceInput) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: Error opening trace file: %s in zstd reader.\n",
+			getName().c_str(), traceFile.c_str());
+	}
+
+	context = ZSTD_createDCtx();
+
+	if(NULL == context) {
+		output->fatal(CALL_INFO, -1, "%s, Fatal: unable to create a zstd decompression context.\n",
+			getName().c_str());
+	}
+
+	input.resize(ZSTD_DStreamInSize());
+	inputState.src = input.data();
+	inputState.size = 0;
+	inputState.pos = 0;
+	lastResult = 0;
+
+	startReading();
+}
+
+ProsperoZstdBinaryTraceReader::~ProsperoZstdBinaryTraceReader() {
+	stopPrefetch();
+
+	if(NULL != context) {
+		ZSTD_freeDCtx(context);
+	}
+
+	if(NULL != traceInput) {
+		fclose(traceInput);
+	}
+}
+
+size_t ProsperoZstdBinaryTraceReader::readBlock(char* buffer, size_t len) {
+	ZSTD_outBuffer outputState = { buffer, len, 0 };
+
+	while(outputState.pos < outputState.size) {
+		if(inputState.pos == inputState.size) {
+			inputState.size = fread(input.data(), 1, input.size(), traceInput);
+			inputState.pos = 0;
+
+			if(0 == inputState.size) {
+				// A zero result means the last frame was completed and flushed
+				if(0 == lastResult) {
+					break;
+				}
+
+				// Otherwise the context may still hold decoded data, which is flushed
+				// without input. A frame that still needs input is truncated.
+				const size_t flushedFrom = outputState.pos;
+				lastResult = ZSTD_decompressStream(context, &outputState, &inputState);
+
+				if(ZSTD_isError(lastResult)) {
+					output->fatal(CALL_INFO, -1, "%s, Fatal: error decompressing trace: %s\n",
+						getName().c_str(), ZSTD_getErrorName(lastResult));
+				}
+
+				if(outputState.pos == flushedFrom && 0 != lastResult) {
+					output->fatal(CALL_INFO, -1, "%s, Fatal: zstd trace ends part way through a frame, the file is truncated.\n",
+						getName().c_str());
+				}
+
+				continue;
+			}
+		}
+
+		lastResult = ZSTD_decompressStream(context, &outputState, &inputState);
+
+		if(ZSTD_isError(lastResult)) {
+			output->fatal(CALL_INFO, -1, "%s, Fatal: error decompressing trace: %s\n",
+				getName().c_str(), ZSTD_getErrorName(lastResult));
+		}
+	}
+
+	return outputState.pos;
+}
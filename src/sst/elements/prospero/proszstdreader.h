@@ -0,0 +1,63 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_SST_PROSPERO_ZSTD_BINARY_READER
+#define _H_SST_PROSPERO_ZSTD_BINARY_READER
+
+#include "prosblockreader.h"
+#include <zstd.h>
+
+namespace SST {
+namespace Prospero {
+
+class ProsperoZstdBinaryTraceReader : public ProsperoBlockTraceReader {
+
+public:
+        ProsperoZstdBinaryTraceReader( ComponentId_t id, Params& params, Output* out );
+        ~ProsperoZstdBinaryTraceReader();
+
+	SST_ELI_REGISTER_SUBCOMPONENT_DERIVED(
+               	ProsperoZstdBinaryTraceReader,
+               	"prospero",
+               	"ProsperoZstdBinaryTraceReader",
+               	SST_ELI_ELEMENT_VERSION(1,0,0),
+               	"Zstandard Compressed Binary Trace Reader",
+	       	SST::Prospero::ProsperoTraceReader
+	)
+
+       	SST_ELI_DOCUMENT_PARAMS(
+               	{ "file", "Sets the file for the trace reader to use (a binary trace compressed with zstd)", "" },
+               	{ "block_size", "Bytes of uncompressed trace read at a time", "4194304" },
+               	{ "batch_size", "Number of records decoded at a time", "4096" },
+               	{ "prefetch", "Decompress the next block on a helper thread while the current one is decoded", "false" }
+       	)
+
+protected:
+	size_t readBlock(char* buffer, size_t len);
+
+private:
+	FILE* traceInput;
+	ZSTD_DCtx* context;
+	std::vector<char> input;
+	ZSTD_inBuffer inputState;
+	size_t lastResult;
+
+};
+
+}
+}
+
+#endif
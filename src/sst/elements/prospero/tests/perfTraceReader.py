@@ -0,0 +1,69 @@
+# Throughput of the Prospero trace readers
+# Replays a trace through a small L1 and reports the records/s achieved by
+# the reader itself at the end of the run (reader verbose output), e.g.,
+#   sst perfTraceReader.py --model-options="binary sstprospero-0-0-bin.trace"
+#   sst perfTraceReader.py --model-options="binary sstprospero-0-0-bin.trace noprefetch nommap"
+#   sst perfTraceReader.py --model-options="compressed sstprospero-0-0-gz.trace prefetch"
+#   sst perfTraceReader.py --model-options="zstd sstprospero-0-0-bin.trace.zst prefetch"
+#   sst perfTraceReader.py --model-options="lz4 sstprospero-0-0-bin.trace.lz4 prefetch"
+# zstd and lz4 traces are binary traces compressed with the zstd and lz4 tools.
+import sys
+import sst
+
+readers = {
+    "binary" : "prospero.ProsperoBinaryTraceReader",
+    "compressed" : "prospero.ProsperoCompressedBinaryTraceReader",
+    "zstd" : "prospero.ProsperoZstdBinaryTraceReader",
+    "lz4" : "prospero.ProsperoLZ4BinaryTraceReader",
+}
+
+reader = "binary"
+trace = "sstprospero-0-0-bin.trace"
+if len(sys.argv) > 1:
+    reader = sys.argv[1]
+if len(sys.argv) > 2:
+    trace = sys.argv[2]
+options = sys.argv[3:]
+
+cpu = sst.Component("cpu", "prospero.prosperoCPU")
+cpu.addParams({
+    "verbose" : 1,
+    "clock" : "2GHz",
+    "max_outstanding" : 64,
+    "max_issue_per_cycle" : 4,
+})
+traceReader = cpu.setSubComponent("reader", readers[reader])
+traceReader.addParams({
+    "file" : trace,
+    "prefetch" : "prefetch" in options,
+})
+if reader == "binary":
+    traceReader.addParams({ "use_mmap" : "nommap" not in options })
+
+l1cache = sst.Component("l1cache", "memHierarchy.Cache")
+l1cache.addParams({
+    "access_latency_cycles" : 1,
+    "cache_frequency" : "2GHz",
+    "replacement_policy" : "lru",
+    "coherence_protocol" : "MESI",
+    "associativity" : 8,
+    "cache_line_size" : 64,
+    "L1" : 1,
+    "cache_size" : "64KiB",
+})
+
+memctrl = sst.Component("memory", "memHierarchy.MemController")
+memctrl.addParams({
+    "clock" : "1GHz",
+    "backing" : "none",
+})
+memory = memctrl.setSubComponent("backend", "memHierarchy.simpleMem")
+memory.addParams({
+    "access_time" : "10ns",
+    "mem_size" : "4096MiB",
+})
+
+link_cpu_l1 = sst.Link("link_cpu_l1")
+link_cpu_l1.connect( (cpu, "cache_link", "500ps"), (l1cache, "high_network_0", "500ps") )
+link_l1_mem = sst.Link("link_l1_mem")
+link_l1_mem.connect( (l1cache, "low_network_0", "50ps"), (memctrl, "direct_link", "50ps") )
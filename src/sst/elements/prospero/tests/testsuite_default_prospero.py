@@ -4,6 +4,7 @@ from sst_unittest import *
 from sst_unittest_support import *
 import os
 import glob
+import struct
 
 USE_PIN_TRACES = True
 USE_TAR_TRACES = False
@@ -110,8 +111,68 @@ class testcase_prospero(SSTTestCase):
     def test_prospero_binary_withdramsim_using_PIN_traces(self):
         self.prospero_test_template("binary", WITH_DRAMSIM, USE_PIN_TRACES)
 
+    zstd_missing = not sst_elements_config_include_file_get_value_int("HAVE_LIBZSTD", default=0, disable_warning=True)
+    lz4_missing = not sst_elements_config_include_file_get_value_int("HAVE_LIBLZ4", default=0, disable_warning=True)
+
+    @unittest.skipIf(zstd_missing, "test_prospero_zstd_truncated_trace test: Requires LIBZSTD, but LIBZSTD is not found in build configuration.")
+    def test_prospero_zstd_truncated_trace(self):
+        self.prospero_truncated_trace_template("zstd", "zstd -q -f {0} -o {1}")
+
+    @unittest.skipIf(lz4_missing, "test_prospero_lz4_truncated_trace test: Requires LIBLZ4, but LIBLZ4 is not found in build configuration.")
+    def test_prospero_lz4_truncated_trace(self):
+        self.prospero_truncated_trace_template("lz4", "lz4 -q -f {0} {1}")
+
 #####
 
+    def prospero_truncated_trace_template(self, reader, compress_cmd, testtimeout=120):
+        # A compressed binary trace must be read to the end, and the same trace cut
+        # short must stop the simulation instead of ending it early
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        tool = compress_cmd.split()[0]
+        rtn = OSCommand("which {0}".format(tool)).run()
+        if rtn.result() != 0:
+            self.skipTest("Prospero: the {0} tool is needed to compress the trace".format(tool))
+
+        testDataFileName = "test_prospero_{0}_truncated_trace".format(reader)
+        sdlfile = "{0}/perfTraceReader.py".format(test_path)
+        tracefile = "{0}/{1}.trace".format(tmpdir, testDataFileName)
+        compressedfile = "{0}/{1}.trace.{2}".format(tmpdir, testDataFileName, reader)
+        truncatedfile = "{0}/{1}_cut.trace.{2}".format(tmpdir, testDataFileName, reader)
+        outfile = "{0}/{1}.out".format(outdir, testDataFileName)
+        errfile = "{0}/{1}.err".format(outdir, testDataFileName)
+
+        # Binary trace records are: uint64 cycle, char type, uint64 address, uint32 size
+        with open(tracefile, 'wb') as fp:
+            for i in range(20000):
+                fp.write(struct.pack("=QcQI", i * 4, b'W' if i % 3 == 0 else b'R', (i * 64) % 1048576, 8))
+
+        rtn = OSCommand(compress_cmd.format(tracefile, compressedfile)).run()
+        self.assertTrue(rtn.result() == 0, "Prospero: {0} failed to compress {1}".format(tool, tracefile))
+
+        with open(compressedfile, 'rb') as fp:
+            data = fp.read()
+        with open(truncatedfile, 'wb') as fp:
+            fp.write(data[:len(data) - 100])
+
+        # The complete trace runs to the end
+        self.run_sst(sdlfile, outfile, errfile, set_cwd=tmpdir, timeout_sec=testtimeout,
+                     other_args='--model-options "{0} {1}"'.format(reader, compressedfile))
+
+        cmd = 'grep "FATAL" {0} '.format(outfile)
+        grep_result = os.system(cmd) != 0
+        self.assertTrue(grep_result, "Output file {0} contains the word 'FATAL'...".format(outfile))
+
+        # The truncated trace is fatal
+        cmd = 'sst {0} --model-options "{1} {2}"'.format(sdlfile, reader, truncatedfile)
+        rtn = OSCommand(cmd, set_cwd=tmpdir).run(timeout_sec=testtimeout)
+        log_debug("Prospero truncated {0} trace result = {1}; output =\n{2}{3}".format(reader, rtn.result(), rtn.output(), rtn.error()))
+        self.assertTrue(rtn.result() != 0, "Prospero: truncated {0} trace {1} did not stop the simulation".format(reader, truncatedfile))
+        self.assertTrue("the file is truncated" in rtn.output() + rtn.error(),
+                        "Prospero: truncated {0} trace {1} was not reported as truncated".format(reader, truncatedfile))
+
     def prospero_test_template(self, trace_name, with_dramsim, use_pin_traces, testtimeout=240):
         pass
         # Get the path to the test files
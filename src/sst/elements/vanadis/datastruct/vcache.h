@@ -24,6 +24,11 @@
 namespace SST {
 namespace Vanadis {
 
+/*
+ * LRU cache of owned pointers. Each entry keeps an iterator to its position
+ * in the recency list, so find/touch/store are all O(1) and the cache can be
+ * sized in the thousands of entries.
+ */
 template <typename I, typename T> class VanadisCache {
 public:
     VanadisCache(const size_t cache_entries) { reset(cache_entries); }
@@ -35,7 +40,7 @@ public:
 
     void clear() {
         for (auto next_value : data_values) {
-            delete next_value.second;
+            delete next_value.second.value;
         }
 
         ordering_q.clear();
@@ -52,24 +57,29 @@ public:
     bool contains(const I& value) const { return (data_values.find(value) != data_values.end()); }
 
     T find(const I& key) {
-        send_key_to_front(key);
-        return data_values.find(key)->second;
+        auto entry = data_values.find(key);
+        send_to_front(entry->second);
+        return entry->second.value;
     }
 
     void store(const I& key, T value) {
-        if (contains(key)) {
-            send_key_to_front(key);
-	    data_values[key] = value;
+        auto entry = data_values.find(key);
+
+        if (entry != data_values.end()) {
+            send_to_front(entry->second);
+            entry->second.value = value;
         } else {
             kill_lru_key();
-            data_values.insert(std::pair<I, T>(key, value));
             ordering_q.push_front(key);
+            data_values.insert(std::pair<I, CacheEntry>(key, CacheEntry(value, ordering_q.begin())));
         }
     }
 
     void touch(const I& key) {
-        if (contains(key)) {
-            send_key_to_front(key);
+        auto entry = data_values.find(key);
+
+        if (entry != data_values.end()) {
+            send_to_front(entry->second);
         }
     }
 
@@ -77,10 +87,17 @@ public:
     size_t capacity() const { return max_entries; }
 
 private:
+    struct CacheEntry {
+        CacheEntry(T v, typename std::list<I>::iterator p) : value(v), position(p) {}
+
+        T value;
+        typename std::list<I>::iterator position;
+    };
+
     void kill_lru_key() {
         // if we aren't full yet, then keep entries otherwise we will
         // throw away
-        if (ordering_q.size() < max_entries) {
+        if (ordering_q.size() < max_entries || ordering_q.empty()) {
             return;
         }
 
@@ -88,31 +105,18 @@ private:
         ordering_q.pop_back();
 
         auto find_key = data_values.find(remove_key);
-        delete find_key->second;
+        delete find_key->second.value;
         data_values.erase(find_key);
     }
 
-    void send_key_to_front(const I& key) {
-        bool found_key = false;
-
-        for (auto order_itr = ordering_q.begin(); order_itr != ordering_q.end();) {
-            if (key == (*order_itr)) {
-                ordering_q.erase(order_itr);
-                found_key = true;
-                break;
-            } else {
-                order_itr++;
-            }
-        }
-
-        if (found_key) {
-            ordering_q.push_front(key);
-        }
+    void send_to_front(CacheEntry& entry) {
+        // splice moves the node without invalidating the stored iterator
+        ordering_q.splice(ordering_q.begin(), ordering_q, entry.position);
     }
 
     size_t max_entries;
     std::list<I> ordering_q;
-    std::unordered_map<I, T> data_values;
+    std::unordered_map<I, CacheEntry> data_values;
 };
 
 } // namespace Vanadis
@@ -2309,6 +2309,12 @@ protected:
             }
             bundle->addInstruction(new VanadisInstructionDecodeFault(ins_address, hw_thr, options));
         }
+
+        // Mark the end of a micro-op group so the core can tell where an
+        // instruction ends
+        if ( bundle->getInstructionCount() > 0 ) {
+            bundle->getInstructionByIndex(bundle->getInstructionCount() - 1)->markEndOfMicroOpGroup();
+        }
     }
 
     uint16_t expand_rvc_int_register(const uint16_t reg_in) const { return reg_in + 8; }
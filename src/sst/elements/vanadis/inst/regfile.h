@@ -137,6 +137,8 @@ std:
     uint32_t getHWThread() const { return hw_thread; }
     uint16_t countIntRegs() const { return count_int_regs; }
     uint16_t countFPRegs() const { return count_fp_regs; }
+    uint32_t getIntRegWidth() const { return int_reg_width; }
+    uint32_t getFPRegWidth() const { return fp_reg_width; }
 
     void print(SST::Output* output)
     {
@@ -0,0 +1,245 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_FUNCTIONAL_MEMORY
+#define _H_VANADIS_FUNCTIONAL_MEMORY
+
+#include <sst/core/interfaces/stdMem.h>
+#include <sst/core/output.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+using namespace SST::Interfaces;
+
+namespace SST {
+namespace Vanadis {
+
+class VanadisFunctionalMemoryLine {
+public:
+    VanadisFunctionalMemoryLine(const uint64_t width) : data(width, 0), dirty(width, false), has_dirty(false) {}
+
+    std::vector<uint8_t> data;
+    std::vector<bool> dirty;
+    bool has_dirty;
+};
+
+/*
+ * A private, line granular copy of memory used when the core executes
+ * instructions functionally. Lines are filled on demand with reads through the
+ * data cache and dirty bytes are written back in one go before control leaves
+ * functional execution (syscalls, switching to detailed timing), after which
+ * every line is dropped and filled again on its next use. The copy is not
+ * coherent with other cores, so functional execution is limited to one core.
+ *
+ * The data cache only sees the first access to each line after a fill and the
+ * bulk write-backs, never the hits in this copy. Cache contents are therefore
+ * approximately warm, but replacement (LRU) state and dirty state are not those
+ * of the real reference stream. The detailed warm-up of each sample
+ * (sample_warmup) has to absorb this error.
+ */
+class VanadisFunctionalMemory {
+public:
+    VanadisFunctionalMemory(SST::Output* out, const uint64_t line_w, std::function<void(StandardMem::Request*)> send)
+        : output(out), line_width(line_w), sender(send), track_touched(false), lines_filled(0), lines_written(0) {}
+
+    ~VanadisFunctionalMemory() {
+        for (auto line_itr : lines) {
+            delete line_itr.second;
+        }
+    }
+
+    uint64_t getLineWidth() const { return line_width; }
+    uint64_t countLinesFilled() const { return lines_filled; }
+    uint64_t countLinesWritten() const { return lines_written; }
+
+    // Remember every line ever filled, a checkpoint needs to capture them
+    void trackTouchedLines() { track_touched = true; }
+    const std::set<uint64_t>& getTouchedLines() const { return touched_lines; }
+
+    void markTouched(const uint64_t addr, const uint64_t len) {
+        for (uint64_t line = lineStart(addr); line < (addr + len); line += line_width) {
+            touched_lines.insert(line);
+        }
+    }
+
+    // Fill every touched line which is not held at the moment
+    void requestTouchedLines() {
+        for (const uint64_t line : touched_lines) {
+            requestLines(line, line_width);
+        }
+    }
+
+    // True if every line touched by [addr, addr + len) is held locally
+    bool contains(const uint64_t addr, const uint64_t len) const {
+        for (uint64_t line = lineStart(addr); line < (addr + len); line += line_width) {
+            if (lines.find(line) == lines.end()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Issue a fill for every line of [addr, addr + len) not held or already requested
+    void requestLines(const uint64_t addr, const uint64_t len) {
+        for (uint64_t line = lineStart(addr); line < (addr + len); line += line_width) {
+            if ((lines.find(line) == lines.end()) && (requested_lines.find(line) == requested_lines.end())) {
+                output->verbose(CALL_INFO, 16, 0, "[func-mem] fill line 0x%llx\n", line);
+
+                StandardMem::Request* fill_req = new StandardMem::Read(line, line_width, 0, line);
+                pending_reads.insert(std::pair<StandardMem::Request::id_t, uint64_t>(fill_req->getID(), line));
+                requested_lines.insert(line);
+
+                sender(fill_req);
+            }
+        }
+    }
+
+    void read(const uint64_t addr, const uint64_t len, uint8_t* dest) const {
+        for (uint64_t i = 0; i < len; ++i) {
+            const VanadisFunctionalMemoryLine* line = lines.at(lineStart(addr + i));
+            dest[i] = line->data[(addr + i) % line_width];
+        }
+    }
+
+    void write(const uint64_t addr, const uint64_t len, const uint8_t* src) {
+        for (uint64_t i = 0; i < len; ++i) {
+            VanadisFunctionalMemoryLine* line = lines.at(lineStart(addr + i));
+            const uint64_t offset = (addr + i) % line_width;
+
+            line->data[offset] = src[i];
+            line->dirty[offset] = true;
+            line->has_dirty = true;
+        }
+    }
+
+    // Returns true (and deletes the event) if the response belongs to a fill
+    bool handleResponse(StandardMem::ReadResp* ev) {
+        auto read_itr = pending_reads.find(ev->getID());
+
+        if (read_itr == pending_reads.end()) {
+            if (discarded_reads.erase(ev->getID()) == 0) {
+                return false;
+            }
+        } else {
+            VanadisFunctionalMemoryLine* line = new VanadisFunctionalMemoryLine(line_width);
+            std::memcpy(&line->data[0], &ev->data[0], std::min((uint64_t)ev->data.size(), line_width));
+
+            lines.insert(std::pair<uint64_t, VanadisFunctionalMemoryLine*>(read_itr->second, line));
+
+            if (track_touched) {
+                touched_lines.insert(read_itr->second);
+            }
+            requested_lines.erase(read_itr->second);
+            pending_reads.erase(read_itr);
+            lines_filled++;
+        }
+
+        delete ev;
+        return true;
+    }
+
+    // Returns true (and deletes the event) if the response belongs to a write-back
+    bool handleResponse(StandardMem::WriteResp* ev) {
+        if (pending_writes.erase(ev->getID()) == 0) {
+            return false;
+        }
+
+        delete ev;
+        return true;
+    }
+
+    // Write every run of dirty bytes back to memory and forget all lines, any
+    // fill still in flight is dropped when it returns
+    void writeBackAndClear() {
+        for (auto line_itr : lines) {
+            VanadisFunctionalMemoryLine* line = line_itr.second;
+
+            if (line->has_dirty) {
+                uint64_t i = 0;
+
+                while (i < line_width) {
+                    if (!line->dirty[i]) {
+                        i++;
+                        continue;
+                    }
+
+                    const uint64_t run_start = i;
+                    while ((i < line_width) && line->dirty[i]) {
+                        i++;
+                    }
+
+                    std::vector<uint8_t> payload(line->data.begin() + run_start, line->data.begin() + i);
+                    StandardMem::Request* wb_req = new StandardMem::Write(line_itr.first + run_start, payload.size(),
+                                                                          payload, false, 0, line_itr.first + run_start);
+                    pending_writes.insert(wb_req->getID());
+
+                    sender(wb_req);
+                }
+
+                lines_written++;
+            }
+
+            delete line;
+        }
+
+        output->verbose(CALL_INFO, 16, 0, "[func-mem] cleared %" PRIu64 " lines, %" PRIu64 " writes in flight\n",
+                        (uint64_t)lines.size(), (uint64_t)pending_writes.size());
+
+        lines.clear();
+        requested_lines.clear();
+
+        for (auto read_itr : pending_reads) {
+            discarded_reads.insert(read_itr.first);
+        }
+
+        pending_reads.clear();
+    }
+
+    // No fills or write-backs are outstanding in the memory system
+    bool idle() const { return pending_reads.empty() && discarded_reads.empty() && pending_writes.empty(); }
+
+protected:
+    uint64_t lineStart(const uint64_t addr) const { return addr - (addr % line_width); }
+
+    SST::Output* output;
+    const uint64_t line_width;
+    std::function<void(StandardMem::Request*)> sender;
+
+    std::unordered_map<uint64_t, VanadisFunctionalMemoryLine*> lines;
+    std::unordered_set<uint64_t> requested_lines;
+    std::unordered_map<StandardMem::Request::id_t, uint64_t> pending_reads;
+    std::unordered_set<StandardMem::Request::id_t> discarded_reads;
+    std::unordered_set<StandardMem::Request::id_t> pending_writes;
+
+    bool track_touched;
+    std::set<uint64_t> touched_lines;
+
+    uint64_t lines_filled;
+    uint64_t lines_written;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -22,6 +22,7 @@
 #include "inst/regfile.h"
 #include "inst/vload.h"
 #include "inst/vstore.h"
+#include "lsq/vfuncmem.h"
 
 #include <cassert>
 #include <cinttypes>
@@ -53,6 +54,7 @@ public:
         address_mask = params.find<uint64_t>("address_mask", 0xFFFFFFFFFFFFFFFF);
 
         registerFiles = nullptr;
+        functionalMemory = nullptr;
 
         stat_load_issued = registerStatistic<uint64_t>("loads_issued", "1");
         stat_store_issued = registerStatistic<uint64_t>("stores_issued", "1");
@@ -88,9 +90,27 @@ public:
 
     virtual void printStatus(SST::Output& output) {}
 
+    // True when nothing is queued in the LSQ or waiting on the memory system
+    virtual bool isIdle() = 0;
+
+    // Send a request from the core's functional memory over the data cache interface
+    virtual void sendFunctionalRequest(StandardMem::Request* req) = 0;
+
+    void setFunctionalMemory(VanadisFunctionalMemory* func_mem) { functionalMemory = func_mem; }
+
+    uint64_t getAddressMask() const { return address_mask; }
+
 protected:
+    // Responses that do not match an LSQ entry may be fills or write-backs of
+    // the functional memory, returns true if the event was consumed
+    template <typename T>
+    bool handleFunctionalResponse(T* ev) {
+        return (nullptr != functionalMemory) && functionalMemory->handleResponse(ev);
+    }
+
     uint64_t address_mask;
     std::vector<VanadisRegisterFile*>* registerFiles;
+    VanadisFunctionalMemory* functionalMemory;
     SST::Output* output;
 
     Statistic<uint64_t>* stat_load_issued;
@@ -163,6 +163,10 @@ public:
 
     virtual size_t loadSize() { return op_q.size(); }
 
+    virtual bool isIdle() { return op_q.empty() && sc_inflight.empty(); }
+
+    virtual void sendFunctionalRequest(StandardMem::Request* req) { memInterface->send(req); }
+
     virtual void printStatus(SST::Output& output) {
         int next_index = 0;
 
@@ -630,6 +634,10 @@ public:
             }
 
             if (!processed) {
+                if (lsq->handleFunctionalResponse(ev)) {
+                    return;
+                }
+
                 out->verbose(CALL_INFO, 16, 0, "did not match any request.\n");
             }
 
@@ -719,6 +727,10 @@ public:
             }
 
             if (!processed) {
+                if (lsq->handleFunctionalResponse(ev)) {
+                    return;
+                }
+
                 out->verbose(CALL_INFO, 16, 0, "did not match any request.\n");
             }
 
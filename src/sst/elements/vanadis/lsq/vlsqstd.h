@@ -91,7 +91,8 @@ public:
                               "Set the maximum number of loads that can be issued per cycle", "2" })
 
     VanadisStandardLoadStoreQueue(ComponentId_t id, Params& params)
-        : VanadisLoadStoreQueue(id, params), processingLLSC(false) {
+        : VanadisLoadStoreQueue(id, params), pending_queued_loads(0), pending_mem_issued_stores(0),
+          pending_mem_issued_loads(0), processingLLSC(false) {
 
         max_mem_issued_stores = params.find<uint32_t>("lsq_store_pending", 8);
         max_mem_issued_loads = params.find<uint32_t>("lsq_load_pending", 8);
@@ -143,6 +144,12 @@ public:
         pending_queued_loads++;
     }
 
+    virtual bool isIdle() {
+        return store_q->empty() && load_q.empty() && pending_loads.empty() && pending_stores.empty();
+    }
+
+    virtual void sendFunctionalRequest(StandardMem::Request* req) { memInterface->send(req); }
+
     virtual void init(unsigned int phase) { memInterface->init(phase); }
 
     virtual void setInitialMemory(const uint64_t address, std::vector<uint8_t>& payload) {
@@ -545,12 +552,20 @@ public:
         virtual ~StandardMemHandlers() {}
 
         virtual void handle(StandardMem::ReadResp* ev) {
+            if (lsq->handleFunctionalResponse(ev)) {
+                return;
+            }
+
             auto check_ev_load_exists = lsq->pending_loads.find(ev->getID());
 
+            // Loads cleared by a pipeline flush (mis-speculation or a switch of
+            // execution mode) still return, drop them
             if (check_ev_load_exists == lsq->pending_loads.end()) {
-                out->fatal(CALL_INFO, -1,
-                                "Error: Received ReadResp but did not find"
-                                " a matching load in pending_loads\n");
+                out->verbose(CALL_INFO, 16, 0,
+                                "--> LSQ ReadResp did not match a pending load, dropping "
+                                "(addr: 0x%0llx).\n", ev->pAddr);
+                delete ev;
+                return;
             }
             
             StandardMem::ReadResp* resp = static_cast<StandardMem::ReadResp*>(ev);
@@ -676,6 +691,10 @@ public:
         } 
         
         virtual void handle(StandardMem::WriteResp* ev) {
+            if (lsq->handleFunctionalResponse(ev)) {
+                return;
+            }
+
             auto check_ev_exists = lsq->pending_stores.find(ev->getID());
 
             if (check_ev_exists == lsq->pending_stores.end()) {
@@ -34,5 +34,6 @@
 #include "os/callev/voscallwrite.h"
 #include "os/callev/voscallwritev.h"
 #include "os/callev/vosinitbrk.h"
+#include "os/callev/vosinitfunc.h"
 
 #endif
@@ -0,0 +1,37 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_SYSCALL_INIT_FUNCTIONAL
+#define _H_VANADIS_SYSCALL_INIT_FUNCTIONAL
+
+#include "os/voscallev.h"
+
+namespace SST {
+namespace Vanadis {
+
+// Tells the OS during init that the core executes functionally for part of the run
+class VanadisSyscallInitFunctionalEvent : public VanadisSyscallEvent {
+public:
+    VanadisSyscallInitFunctionalEvent() : VanadisSyscallEvent() {}
+    VanadisSyscallInitFunctionalEvent(uint32_t core, uint32_t thr, VanadisOSBitType bittype)
+        : VanadisSyscallEvent(core, thr, bittype) {}
+
+    VanadisSyscallOp getOperation() { return SYSCALL_OP_INIT_FUNCTIONAL; }
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
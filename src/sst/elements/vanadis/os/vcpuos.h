@@ -20,6 +20,7 @@
 #include <sst/core/subcomponent.h>
 
 #include <functional>
+#include <sys/stat.h>
 
 #include "inst/isatable.h"
 #include "inst/regfile.h"
@@ -29,7 +30,7 @@
 namespace SST {
 namespace Vanadis {
 
-enum VanadisCPUOSInitParameter { SYSCALL_INIT_PARAM_INIT_BRK };
+enum VanadisCPUOSInitParameter { SYSCALL_INIT_PARAM_INIT_BRK, SYSCALL_INIT_PARAM_FUNCTIONAL };
 
 class VanadisCPUOSHandler : public SST::SubComponent {
 public:
@@ -47,6 +48,10 @@ public:
         hw_thr = 0;
         core_id = 0;
         tid = 0;
+
+        program_brk = 0;
+        brk_pending = false;
+        uncheckpointed_call = nullptr;
     }
 
     virtual ~VanadisCPUOSHandler() { delete output; }
@@ -70,7 +75,88 @@ public:
     void setThreadID(int64_t new_tid) { tid = new_tid; }
     int64_t getThreadID() const { return tid; }
 
+    // Program break as last reported by the OS, recorded in checkpoints
+    uint64_t getProgramBreak() const { return program_brk; }
+
+    // While set, called with every block of memory a system call lets the OS write
+    void setOSWriteCallback(std::function<void(uint64_t, uint64_t)> cb) { os_write_callback = cb; }
+
+    // First call (while the callback was set) leaving OS state a checkpoint cannot hold, nullptr if none
+    const char* getUncheckpointedCall() const { return uncheckpointed_call; }
+
 protected:
+    // Pick up the new break from the response to a brk call
+    void updateProgramBreak(const int64_t rc_val) {
+        if (brk_pending) {
+            if (rc_val > 0) {
+                program_brk = (uint64_t)rc_val;
+            }
+
+            brk_pending = false;
+        }
+    }
+
+    // Report what a call is about to change outside of the core, called before it is sent
+    void recordCallEffects(VanadisSyscallEvent* call_ev) {
+        if (!os_write_callback) {
+            return;
+        }
+
+        switch (call_ev->getOperation()) {
+        case SYSCALL_OP_READ: {
+            VanadisSyscallReadEvent* read_ev = dynamic_cast<VanadisSyscallReadEvent*>(call_ev);
+
+            if (read_ev->getCount() > 0) {
+                os_write_callback(read_ev->getBufferAddress(), (uint64_t)read_ev->getCount());
+            }
+        } break;
+        case SYSCALL_OP_READLINK: {
+            VanadisSyscallReadLinkEvent* readlink_ev = dynamic_cast<VanadisSyscallReadLinkEvent*>(call_ev);
+
+            if (readlink_ev->getBufferSize() > 0) {
+                os_write_callback(readlink_ev->getBufferPointer(), (uint64_t)readlink_ev->getBufferSize());
+            }
+        } break;
+        case SYSCALL_OP_UNAME: {
+            // Five 65 byte strings
+            os_write_callback(dynamic_cast<VanadisSyscallUnameEvent*>(call_ev)->getUnameInfoAddress(), 65 * 5);
+        } break;
+        case SYSCALL_OP_FSTAT: {
+            // The node OS writes a block the size of the host's struct stat
+            os_write_callback(dynamic_cast<VanadisSyscallFstatEvent*>(call_ev)->getStructAddress(), sizeof(struct stat));
+        } break;
+        case SYSCALL_OP_GETTIME64: {
+            os_write_callback(dynamic_cast<VanadisSyscallGetTime64Event*>(call_ev)->getTimeStructAddress(),
+                              2 * sizeof(uint64_t));
+        } break;
+        case SYSCALL_OP_OPEN:
+        case SYSCALL_OP_OPENAT:
+        case SYSCALL_OP_MMAP:
+        case SYSCALL_OP_UNMAP: {
+            if (nullptr == uncheckpointed_call) {
+                uncheckpointed_call = getCallName(call_ev->getOperation());
+            }
+        } break;
+        default:
+            break;
+        }
+    }
+
+    static const char* getCallName(const VanadisSyscallOp op) {
+        switch (op) {
+        case SYSCALL_OP_OPEN:
+            return "open";
+        case SYSCALL_OP_OPENAT:
+            return "openat";
+        case SYSCALL_OP_MMAP:
+            return "mmap";
+        case SYSCALL_OP_UNMAP:
+            return "munmap";
+        default:
+            return "unknown";
+        }
+    }
+
     SST::Output* output;
     std::vector<std::function<void(uint32_t)>> returnCallbacks;
     uint32_t core_id;
@@ -83,6 +169,12 @@ protected:
 
     uint64_t* tls_address;
     int64_t tid;
+
+    uint64_t program_brk;
+    bool brk_pending;
+
+    std::function<void(uint64_t, uint64_t)> os_write_callback;
+    const char* uncheckpointed_call;
 };
 
 } // namespace Vanadis
@@ -111,6 +111,19 @@ VanadisNodeOSComponent::init(unsigned int phase) {
     for (VanadisNodeOSCoreHandler* next_handler : core_handlers) {
         next_handler->init(phase);
     }
+
+    // Functional execution keeps a private, non-coherent copy of memory in each core
+    // (and lets every SC succeed), so sharing memory between cores would go wrong silently
+    if (core_handlers.size() > 1) {
+        for (VanadisNodeOSCoreHandler* next_handler : core_handlers) {
+            if (next_handler->usesFunctionalExecution()) {
+                output->fatal(CALL_INFO, -1,
+                              "Error - core %" PRIu32 " uses functional execution (fast-forward or sampling), "
+                              "which is only supported on a node with a single core (this node has %" PRIu32 ").\n",
+                              next_handler->getCoreID(), (uint32_t)core_handlers.size());
+            }
+        }
+    }
 }
 
 void
@@ -81,6 +81,7 @@ public:
                 std::pair<uint32_t, VanadisOSFileDescriptor*>(2, new VanadisOSFileDescriptor(2, stderr_path)));
 
         current_brk_point = 0;
+        functional_exec = false;
 
         handlerSendMemCallback = std::bind(&VanadisNodeOSCoreHandler::sendMemRequest, this, std::placeholders::_1);
     }
@@ -97,6 +98,9 @@ public:
 
     uint32_t getCoreID() const { return core_id; }
 
+    // Core has announced it executes functionally (fast-forward or sampling)
+    bool usesFunctionalExecution() const { return functional_exec; }
+
     void handleIncomingSyscall(VanadisSyscallEvent* sys_ev) {
 
         switch (sys_ev->getOperation()) {
@@ -788,6 +792,11 @@ public:
                 current_brk_point = init_brk_ev->getUpdatedBRK();
             } break;
 
+            case SYSCALL_OP_INIT_FUNCTIONAL: {
+                output->verbose(CALL_INFO, 8, 0, "core executes functionally\n");
+                functional_exec = true;
+            } break;
+
             default:
                 output->fatal(CALL_INFO, -1, "Error - not implemented an an init event.\n");
             }
@@ -815,6 +824,7 @@ protected:
     uint32_t next_file_id;
 
     uint64_t current_brk_point;
+    bool functional_exec;
 };
 
 } // namespace Vanadis
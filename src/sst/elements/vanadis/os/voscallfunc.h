@@ -23,6 +23,7 @@ enum VanadisSyscallOp {
     SYSCALL_OP_UNKNOWN,
     SYSCALL_OP_ACCESS,
     SYSCALL_OP_INIT_BRK,
+    SYSCALL_OP_INIT_FUNCTIONAL,
     SYSCALL_OP_BRK,
     SYSCALL_OP_SET_THREAD_AREA,
     SYSCALL_OP_UNAME,
@@ -79,8 +79,13 @@ public:
         case SYSCALL_INIT_PARAM_INIT_BRK: {
             uint64_t* param_val_64 = (uint64_t*)param_val;
             output->verbose(CALL_INFO, 8, 0, "set initial brk point (init) event (0x%llx)\n", (*param_val_64));
+            program_brk = (*param_val_64);
             os_link->sendInitData(new VanadisSyscallInitBRKEvent(core_id, hw_thr, VanadisOSBitType::VANADIS_OS_64B, (*param_val_64)));
         } break;
+        case SYSCALL_INIT_PARAM_FUNCTIONAL: {
+            output->verbose(CALL_INFO, 8, 0, "set functional execution (init) event\n");
+            os_link->sendInitData(new VanadisSyscallInitFunctionalEvent(core_id, hw_thr, VanadisOSBitType::VANADIS_OS_64B));
+        } break;
         }
     }
 
@@ -146,6 +151,7 @@ public:
             output->verbose(CALL_INFO, 8, 0, "[syscall-handler] found a call to brk( value: %" PRIu64 " ), zero: %s\n",
                             newBrk, brk_zero_memory ? "yes" : "no");
             call_ev = new VanadisSyscallBRKEvent(core_id, hw_thr, VanadisOSBitType::VANADIS_OS_64B, newBrk, brk_zero_memory);
+            brk_pending = true;
         } break;
 
         case VANADIS_SYSCALL_RISCV_SET_THREAD_AREA: {
@@ -480,6 +486,7 @@ public:
 
         if (nullptr != call_ev) {
             output->verbose(CALL_INFO, 8, 0, "Sending event to operating system...\n");
+            recordCallEffects(call_ev);
             os_link->send(call_ev);
         }
     }
@@ -522,6 +529,7 @@ protected:
             const uint16_t rc_reg = isaTable->getIntPhysReg(VANADIS_SYSCALL_RISCV_RET_REG);
             const int64_t rc_val = (int64_t)os_resp->getReturnCode();
             regFile->setIntReg(rc_reg, rc_val);
+            updateProgramBreak(rc_val);
 
 //            if (os_resp->isSuccessful()) {
 //                if (rc_val < 0) {
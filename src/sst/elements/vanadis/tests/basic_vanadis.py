@@ -83,6 +83,37 @@ v_cpu_0.addParams({
 #       "retires_per_cycle" : 1
 })
 
+# Functional fast-forward and sampled simulation, all disabled unless set
+fast_forward = int(os.getenv("VANADIS_FAST_FORWARD", 0))
+sample_period = int(os.getenv("VANADIS_SAMPLE_PERIOD", 0))
+
+if fast_forward > 0:
+	print("Fast-forwarding " + str(fast_forward) + " instructions functionally.")
+	v_cpu_0.addParams({ "fast_forward" : fast_forward })
+
+if sample_period > 0:
+	print("Sampling with a period of " + str(sample_period) + " instructions.")
+	v_cpu_0.addParams({
+		"sample_period" : sample_period,
+		"sample_warmup" : int(os.getenv("VANADIS_SAMPLE_WARMUP", 2000)),
+		"sample_window" : int(os.getenv("VANADIS_SAMPLE_WINDOW", 1000))
+	})
+
+# Checkpoint at the end of the fast-forward, or start from one
+checkpoint_write = os.getenv("VANADIS_CHECKPOINT_WRITE", "")
+checkpoint_restore = os.getenv("VANADIS_CHECKPOINT_RESTORE", "")
+
+if checkpoint_write != "":
+	print("Writing checkpoint " + checkpoint_write + " when the fast-forward ends.")
+	v_cpu_0.addParams({
+		"checkpoint_write" : checkpoint_write,
+		"checkpoint_exit" : os.getenv("VANADIS_CHECKPOINT_EXIT", "no")
+	})
+
+if checkpoint_restore != "":
+	print("Restoring checkpoint " + checkpoint_restore + ".")
+	v_cpu_0.addParams({ "checkpoint_restore" : checkpoint_restore })
+
 app_args = os.getenv("VANADIS_EXE_ARGS", "")
 
 if app_args != "":
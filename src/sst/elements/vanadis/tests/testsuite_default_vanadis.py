@@ -7,6 +7,11 @@ from sst_unittest_parameterized import parameterized
 module_init = 0
 module_sema = threading.Semaphore()
 vanadis_test_matrix = []
+vanadis_checkpoint_matrix = []
+
+# Environment variables basic_vanadis.py reads to select a run mode
+vanadis_run_env_names = ["VANADIS_FAST_FORWARD", "VANADIS_SAMPLE_PERIOD", "VANADIS_SAMPLE_WARMUP", "VANADIS_SAMPLE_WINDOW",
+                         "VANADIS_CHECKPOINT_WRITE", "VANADIS_CHECKPOINT_EXIT", "VANADIS_CHECKPOINT_RESTORE"]
 
 ################################################################################
 # NOTES:
@@ -27,24 +32,51 @@ def build_vanadis_test_matrix():
     testlist.append(["basic_vanadis.py", "small/basic-ops", "test-branch", 300])
     testlist.append(["basic_vanadis.py", "small/basic-ops", "test-shift", 300])
 
+    # Every test is also run with functional execution, the program output must
+    # match the same reference files as the detailed run
+    runmodes = []
+    runmodes.append(["", {}])
+    runmodes.append(["fastforward", {"VANADIS_FAST_FORWARD" : "2000"}])
+    runmodes.append(["sampled", {"VANADIS_SAMPLE_PERIOD" : "1000", "VANADIS_SAMPLE_WARMUP" : "200", "VANADIS_SAMPLE_WINDOW" : "200"}])
+
     # Process each line and crack up into an index, hash, options and sdl file
+    testnum = 0
+    for runmode in runmodes:
+        for test_info in testlist:
+            # Make testnum start at 1
+            testnum = testnum + 1
+            sdlfile = test_info[0]
+            elftestdir = test_info[1]
+            elffile = test_info[2]
+            timeout_sec = test_info[3]
+            testname = "{0}_{1}".format(elftestdir.replace("/", "_"), elffile)
+            if runmode[0] != "":
+                testname = "{0}_{1}".format(testname, runmode[0])
+
+            # Build the test_data structure
+            test_data = (testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, runmode[0], runmode[1])
+            vanadis_test_matrix.append(test_data)
+
+def build_vanadis_checkpoint_matrix():
+    global vanadis_checkpoint_matrix
+    vanadis_checkpoint_matrix = []
+
+    # SDL file, test dir, compiled elf file, instructions before the checkpoint and run timeout
+    testlist = []
+    testlist.append(["basic_vanadis.py", "small/basic-io", "hello-world", 500, 120])
+    testlist.append(["basic_vanadis.py", "small/basic-ops", "test-branch", 2000, 300])
+
     for testnum, test_info in enumerate(testlist):
-        # Make testnum start at 1
         testnum = testnum + 1
-        sdlfile = test_info[0]
-        elftestdir = test_info[1]
-        elffile = test_info[2]
-        timeout_sec = test_info[3]
-        testname = "{0}_{1}".format(elftestdir.replace("/", "_"), elffile)
-
-        # Build the test_data structure
-        test_data = (testnum, testname, sdlfile, elftestdir, elffile, timeout_sec)
-        vanadis_test_matrix.append(test_data)
+        testname = "{0}_{1}_checkpoint".format(test_info[1].replace("/", "_"), test_info[2])
+        test_data = (testnum, testname, test_info[0], test_info[1], test_info[2], test_info[3], test_info[4])
+        vanadis_checkpoint_matrix.append(test_data)
 
 ################################################################################
 
 # At startup, build the ESshmem test matrix
 build_vanadis_test_matrix()
+build_vanadis_checkpoint_matrix()
 
 def gen_custom_name(testcase_func, param_num, param):
 # Full TestCaseName
@@ -94,18 +126,20 @@ class testcase_vanadis(SSTTestCase):
 #####
 
     @parameterized.expand(vanadis_test_matrix, name_func=gen_custom_name)
-    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, timeout_sec):
+    def test_vanadis_short_tests(self, testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, runmode, runenv):
         self._checkSkipConditions()
 
         log_debug("Running Vanadis test #{0} ({1}): elffile={4} in dir {3}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec))
-        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec)
+        self.vanadis_test_template(testnum, testname, sdlfile, elftestdir, elffile, timeout_sec, runmode, runenv)
 
 #####
 
-    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, testtimeout=120):
+    def vanadis_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, testtimeout=120, runmode="", runenv={}):
         # Get the path to the test files
         test_path = self.get_testsuite_dir()
         outdir = "{0}/vanadis_tests/{1}/{2}".format(self.get_test_output_run_dir(), elftestdir,elffile)
+        if runmode != "":
+            outdir = "{0}_{1}".format(outdir, runmode)
         tmpdir = self.get_test_output_tmp_dir()
         os.makedirs(outdir)
 
@@ -124,6 +158,11 @@ class testcase_vanadis(SSTTestCase):
         testfilepath = "{0}/{1}/{2}".format(test_path, elftestdir, elffile)
         os.environ['VANADIS_EXE'] = testfilepath
 
+        # Run mode settings, cleared again so they do not leak into the next test
+        for envname in vanadis_run_env_names:
+            os.environ.pop(envname, None)
+        os.environ.update(runenv)
+
         oscmd = self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=outdir, timeout_sec=testtimeout)
 
         # Perform the tests
@@ -153,6 +192,74 @@ class testcase_vanadis(SSTTestCase):
 
         # DEVELOPER NOTE: In the future, we may want to compare the SST output (statisics) vs some reference file
 
+#####
+
+    @parameterized.expand(vanadis_checkpoint_matrix, name_func=gen_custom_name)
+    def test_vanadis_checkpoint_tests(self, testnum, testname, sdlfile, elftestdir, elffile, ffwd_ins, timeout_sec):
+        self._checkSkipConditions()
+
+        log_debug("Running Vanadis checkpoint test #{0} ({1}): elffile={4} in dir {3}; using sdl={2}".format(testnum, testname, sdlfile, elftestdir, elffile))
+        self.vanadis_checkpoint_test_template(testnum, testname, sdlfile, elftestdir, elffile, ffwd_ins, timeout_sec)
+
+#####
+
+    # Write a checkpoint and stop, then finish the program from the checkpoint in
+    # a second run. Together the two runs must print what a single run prints.
+    def vanadis_checkpoint_test_template(self, testnum, testname, sdlfile, elftestdir, elffile, ffwd_ins, testtimeout=120):
+        test_path = self.get_testsuite_dir()
+        outdir = "{0}/vanadis_tests/{1}/{2}_checkpoint".format(self.get_test_output_run_dir(), elftestdir, elffile)
+        writedir = "{0}/write".format(outdir)
+        restoredir = "{0}/restore".format(outdir)
+        os.makedirs(writedir)
+        os.makedirs(restoredir)
+
+        testDataFileName="test_vanadis_{0}".format(testname)
+        sdlfile = "{0}/{1}".format(test_path, sdlfile)
+        ref_outfile = "{0}/{1}/{2}.stdout.gold".format(test_path, elftestdir, elffile)
+        ref_errfile = "{0}/{1}/{2}.stderr.gold".format(test_path, elftestdir, elffile)
+        ckpt_prefix = "{0}/ckpt".format(outdir)
+
+        os.environ['VANADIS_EXE'] = "{0}/{1}/{2}".format(test_path, elftestdir, elffile)
+
+        runs = []
+        runs.append([writedir, {"VANADIS_FAST_FORWARD" : str(ffwd_ins), "VANADIS_CHECKPOINT_WRITE" : ckpt_prefix, "VANADIS_CHECKPOINT_EXIT" : "yes"}])
+        runs.append([restoredir, {"VANADIS_CHECKPOINT_RESTORE" : ckpt_prefix}])
+
+        oscmds = []
+        for rundir, runenv in runs:
+            for envname in vanadis_run_env_names:
+                os.environ.pop(envname, None)
+            os.environ.update(runenv)
+
+            outfile = "{0}/{1}.out".format(rundir, testDataFileName)
+            errfile = "{0}/{1}.err".format(rundir, testDataFileName)
+            mpioutfiles = "{0}/{1}.testfile".format(rundir, testDataFileName)
+            oscmds.append(self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles, set_cwd=rundir, timeout_sec=testtimeout))
+
+            if rundir == writedir:
+                ckpt_file = "{0}-0.vckpt".format(ckpt_prefix)
+                self.assertTrue(os.path.isfile(ckpt_file), "Vanadis checkpoint {0} was not written".format(ckpt_file))
+
+        for envname in vanadis_run_env_names:
+            os.environ.pop(envname, None)
+
+        # What the program printed before the checkpoint plus what it printed after
+        for osfile, ref_file in [["stdout-os", ref_outfile], ["stderr-os", ref_errfile]]:
+            joined_file = "{0}/{1}".format(outdir, osfile)
+            with open(joined_file, "w") as joined:
+                for rundir, runenv in runs:
+                    run_osfile = "{0}/{1}".format(rundir, osfile)
+                    self.assertTrue(os.path.isfile(run_osfile), "Vanadis test {0} not found".format(run_osfile))
+                    with open(run_osfile, "r") as run_output:
+                        joined.write(run_output.read())
+
+            cmp_result = testing_compare_diff(testname, joined_file, ref_file)
+            if (cmp_result == False):
+                diffdata = testing_get_diff_data(testname)
+                log_failure(oscmds)
+                log_failure(diffdata)
+            self.assertTrue(cmp_result, "Vanadis checkpointed output {0} does not match reference output file {1}".format(joined_file, ref_file))
+
 
 ###############################################
 
@@ -177,6 +177,7 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
                                                         thread_decoders[i]->countISAIntReg(),
                                                         thread_decoders[i]->countISAFPReg()));
         retire_isa_tables[i]->reset(issue_isa_tables[i]);
+        mid_instruction.push_back(false);
 
         halted_masks[i] = true;
     }
@@ -258,6 +259,58 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 
     lsq->setRegisterFiles(&register_files);
 
+    // Functional execution is only set up if a fast-forward or sampling is requested
+    sampler = new VanadisSampler(output, params);
+    functional_mem = nullptr;
+    functional_mode = false;
+    mode_switch_drain = false;
+    functional_ins_per_cycle = params.find<uint64_t>("functional_instructions_per_cycle", 1024);
+
+    if (sampler->isEnabled()) {
+        // The functional copy of memory is shared by the threads of a core but not
+        // coherent with anything else, and every SC succeeds in it
+        if (hw_threads > 1) {
+            output->fatal(CALL_INFO, -1,
+                          "Error - functional execution (fast-forward or sampling) requires hardware_threads = 1, "
+                          "this core has %" PRIu32 ".\n",
+                          hw_threads);
+        }
+
+        std::function<void(StandardMem::Request*)> func_mem_send
+            = std::bind(&VanadisLoadStoreQueue::sendFunctionalRequest, lsq, std::placeholders::_1);
+
+        functional_mem = new VanadisFunctionalMemory(output, dCacheLineWidth, func_mem_send);
+        lsq->setFunctionalMemory(functional_mem);
+
+        functional_mode = sampler->isFunctional();
+        output->verbose(CALL_INFO, 2, 0, "Functional execution enabled, core starts %s.\n",
+                        functional_mode ? "functional" : "detailed");
+    } else {
+        delete sampler;
+        sampler = nullptr;
+    }
+
+    checkpoint_write_prefix = params.find<std::string>("checkpoint_write", "");
+    checkpoint_exit = params.find<bool>("checkpoint_exit", false);
+    checkpoint_state = VANADIS_CHECKPOINT_DISABLED;
+
+    if (checkpoint_write_prefix != "") {
+        // The checkpoint is taken where the fast-forward ends
+        if ((nullptr == sampler) || (!sampler->isFastForwarding())) {
+            output->fatal(CALL_INFO, -1,
+                          "Error - checkpoint_write requires fast_forward or fast_forward_until_address to be set.\n");
+        }
+
+        functional_mem->trackTouchedLines();
+        checkpoint_state = VANADIS_CHECKPOINT_WAIT;
+
+        // Buffers the OS fills belong in the image even if the core has not read them yet
+        for (uint32_t i = 0; i < hw_threads; ++i) {
+            thread_decoders[i]->getOSHandler()->setOSWriteCallback(std::bind(
+                &VanadisFunctionalMemory::markTouched, functional_mem, std::placeholders::_1, std::placeholders::_2));
+        }
+    }
+
     if (0 == core_id) {
         halted_masks[0] = false;
         uint64_t initial_config_ip = thread_decoders[0]->getInstructionPointer();
@@ -289,6 +342,24 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
         }
     }
 
+    // Registers are restored now, memory is overlaid on the binary image during init
+    restore_checkpoint = nullptr;
+    const std::string checkpoint_restore_prefix = params.find<std::string>("checkpoint_restore", "");
+
+    if (checkpoint_restore_prefix != "") {
+        const std::string restore_path = VanadisCheckpoint::getFileName(checkpoint_restore_prefix, core_id);
+        std::string restore_error;
+
+        restore_checkpoint = new VanadisCheckpoint();
+
+        if (!restore_checkpoint->read(restore_path, restore_error)) {
+            output->fatal(CALL_INFO, -1, "Error - unable to restore checkpoint %s: %s\n", restore_path.c_str(),
+                          restore_error.c_str());
+        }
+
+        restoreCheckpointRegisters();
+    }
+
     //	VanadisInstruction* test_ins = new VanadisAddInstruction(nextInsID++, 0,
     // 0, isa_options[0], 3, 4, 5); 	thread_decoders[0]->getDecodedQueue()->push(
     // test_ins ); 	rob[0]->push(test_ins);
@@ -457,6 +528,8 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
     stat_syscall_cycles = registerStatistic<uint64_t>("syscall-cycles", "1");
     stat_int_phys_regs_in_use = registerStatistic<uint64_t>("phys_int_reg_in_use", "1");
     stat_fp_phys_regs_in_use = registerStatistic<uint64_t>("phys_fp_reg_in_use", "1");
+    stat_ins_functional = registerStatistic<uint64_t>("instructions_functional", "1");
+    stat_functional_cycles = registerStatistic<uint64_t>("functional_cycles", "1");
 
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -465,6 +538,9 @@ VANADIS_COMPONENT::VANADIS_COMPONENT(SST::ComponentId_t id, SST::Params& params)
 VANADIS_COMPONENT::~VANADIS_COMPONENT() {
     delete[] instPrintBuffer;
     delete lsq;
+    delete sampler;
+    delete functional_mem;
+    delete restore_checkpoint;
 
     if (pipelineTrace != nullptr) {
         fclose(pipelineTrace);
@@ -892,6 +968,7 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                 issue_isa_tables[rob_front->getHWThread()], retire_isa_tables[rob_front->getHWThread()]);
 
             ins_retired_this_cycle++;
+            mid_instruction[rob_front->getHWThread()] = !rob_front->endsMicroOpGroup();
 
             if (perform_delay_cleanup) {
 
@@ -914,6 +991,7 @@ VANADIS_COMPONENT::performRetire(VanadisCircularQueue<VanadisInstruction*>* rob,
                 //{ 						stat_ins_retired->addData(1);
                 ins_retired_this_cycle++;
                 //					}
+                mid_instruction[delay_ins->getHWThread()] = !delay_ins->endsMicroOpGroup();
 
                 delete delay_ins;
             }
@@ -1128,6 +1206,10 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle) {
         return true;
     }
 
+    if (UNLIKELY(nullptr != sampler) && (functional_mode || mode_switch_drain)) {
+        return tickFunctional(cycle);
+    }
+
     stat_cycles->addData(1);
     ins_issued_this_cycle = 0;
     ins_retired_this_cycle = 0;
@@ -1257,6 +1339,16 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle) {
     // Record how many instructions we retired this cycle
     stat_ins_retired->addData(ins_retired_this_cycle);
 
+    if (UNLIKELY(nullptr != sampler)) {
+        sampler->advance(ins_retired_this_cycle, current_cycle);
+
+        // Leave the pipeline once the sampler wants functional execution and no
+        // instruction is half way through retirement
+        if (sampler->isFunctional() && (!tick_return) && canSwitchExecutionMode()) {
+            switchExecutionMode(true);
+        }
+    }
+
     uint64_t rob_total_count = 0;
     for (uint32_t i = 0; i < hw_threads; ++i) {
         rob_total_count += rob[i]->size();
@@ -1294,6 +1386,654 @@ VANADIS_COMPONENT::tick(SST::Cycle_t cycle) {
     }
 }
 
+bool
+VANADIS_COMPONENT::tickFunctional(const uint64_t cycle) {
+    stat_functional_cycles->addData(1);
+    bool tick_return = false;
+
+    if (mode_switch_drain) {
+        // Wait for the memory system to settle before the other mode starts
+        // issuing, fills and write-backs from the functional memory or loads and
+        // stores from the pipeline may still be in flight
+        mode_switch_drain = !(lsq->isIdle() && functional_mem->idle());
+    } else if (((VANADIS_CHECKPOINT_PENDING == checkpoint_state) || (VANADIS_CHECKPOINT_FILL == checkpoint_state))
+               && canSwitchExecutionMode()) {
+        tick_return = performCheckpoint();
+    } else {
+        for (uint32_t i = 0; i < hw_threads; ++i) {
+            if (halted_masks[i]) {
+                continue;
+            }
+
+            uint64_t executed = 0;
+            const int exe_rc = performFunctionalExecute(i, functional_ins_per_cycle, executed);
+
+            stat_ins_functional->addData(executed);
+
+            if (INT_MAX == exe_rc) {
+                tick_return = true;
+            }
+        }
+
+        if ((!tick_return) && (VANADIS_CHECKPOINT_PENDING != checkpoint_state) && (!sampler->isFunctional())
+            && canSwitchExecutionMode()) {
+            switchExecutionMode(false);
+        }
+    }
+
+    current_cycle++;
+
+    if (current_cycle >= max_cycle) {
+        output->verbose(CALL_INFO, 1, 0, "Reached maximum cycle %" PRIu64 ". Core stops processing.\n", current_cycle);
+        primaryComponentOKToEndSim();
+        return true;
+    } else {
+        return tick_return;
+    }
+}
+
+int
+VANADIS_COMPONENT::performFunctionalExecute(const uint32_t hw_thr, const uint64_t max_ins, uint64_t& executed) {
+    VanadisCircularQueue<VanadisInstruction*>* thr_rob = rob[hw_thr];
+
+    while (executed < max_ins) {
+        // The fast-forward has ended, the checkpoint is taken at the next boundary
+        if (UNLIKELY(VANADIS_CHECKPOINT_WAIT == checkpoint_state) && (!sampler->isFastForwarding())) {
+            checkpoint_state = VANADIS_CHECKPOINT_PENDING;
+        }
+
+        // Only hand over to the pipeline (or checkpoint) between two whole instructions
+        if (((!sampler->isFunctional()) || (VANADIS_CHECKPOINT_PENDING == checkpoint_state))
+            && atInstructionBoundary(hw_thr)) {
+            return 0;
+        }
+
+        if (thr_rob->empty()) {
+            thread_decoders[hw_thr]->tick(output, current_cycle);
+
+            // Waiting on the instruction cache, nothing more this cycle
+            if (thr_rob->empty()) {
+                return 1;
+            }
+        }
+
+        VanadisInstruction* ins = thr_rob->peek();
+
+        if (atInstructionBoundary(hw_thr) && sampler->checkMarker(ins->getInstructionAddress(), current_cycle)) {
+            continue;
+        }
+
+        if (UNLIKELY(ins->trapsError())) {
+            output->verbose(CALL_INFO, 0, 0, "Error has been detected in functionally executed instruction. Register status:\n");
+            retire_isa_tables[hw_thr]->print(output, register_files[hw_thr], print_int_reg, print_fp_reg, 0);
+
+            output->fatal(CALL_INFO, -1,
+                          "Instruction 0x%llx flags an error (instruction-type=%s) at cycle %" PRIu64 "\n",
+                          ins->getInstructionAddress(), ins->getInstCode(), current_cycle);
+        }
+
+        uint64_t retired = 0;
+
+        if (UNLIKELY(INST_SYSCALL == ins->getInstFuncType())) {
+            if (ins->completedExecution()) {
+                thr_rob->pop();
+                retireFunctional(ins);
+                delete ins;
+                retired = 1;
+            } else if (ins->checkFrontOfROB()) {
+                // Still waiting on the OS handler
+                return INT_MAX;
+            } else {
+                // The OS reads and writes memory through its own interface, so our
+                // copy has to be written back and dropped first
+                functional_mem->writeBackAndClear();
+
+                if (!functional_mem->idle()) {
+                    return 1;
+                }
+
+                VanadisSysCallInstruction* the_syscall_ins = dynamic_cast<VanadisSysCallInstruction*>(ins);
+
+                if (nullptr == the_syscall_ins) {
+                    output->fatal(CALL_INFO, -1, "Error: SYSCALL cannot be converted to an actual sys-call instruction.\n");
+                }
+
+                mapFunctionalRegisters(ins);
+                ins->markFrontOfROB();
+                stat_syscall_cycles->addData(1);
+
+                // The handler may complete (or halt the thread and delete the
+                // instruction) before it returns, so ins must not be used after this
+                thread_decoders[hw_thr]->getOSHandler()->handleSysCall(the_syscall_ins);
+                return INT_MAX;
+            }
+        } else if (ins->isSpeculated()) {
+            VanadisSpeculatedInstruction* spec_ins = dynamic_cast<VanadisSpeculatedInstruction*>(ins);
+
+            if (nullptr == spec_ins) {
+                output->fatal(CALL_INFO, -1,
+                              "Error - instruction is speculated, but not able to "
+                              "perform a cast to a speculated instruction.\n");
+            }
+
+            const bool has_delay_slot = (VANADIS_NO_DELAY_SLOT != spec_ins->getDelaySlotType());
+
+            if (has_delay_slot && (thr_rob->size() < 2)) {
+                thread_decoders[hw_thr]->tick(output, current_cycle);
+
+                if (thr_rob->size() < 2) {
+                    return 1;
+                }
+            }
+
+            if (executeFunctional(ins) != 0) {
+                return 1;
+            }
+
+            VanadisInstruction* delay_ins = has_delay_slot ? thr_rob->peekAt(1) : nullptr;
+
+            if ((nullptr != delay_ins) && (executeFunctional(delay_ins) != 0)) {
+                return 1;
+            }
+
+            const uint64_t taken_addr = spec_ins->getTakenAddress();
+            const bool mispredicted = (taken_addr != spec_ins->getSpeculatedAddress());
+
+            // Keep the predictor trained so it is warm when detailed timing resumes
+            thread_decoders[hw_thr]->getBranchPredictor()->push(spec_ins->getInstructionAddress(), taken_addr);
+
+            thr_rob->pop();
+            retireFunctional(ins);
+            retired = 1;
+
+            if (nullptr != delay_ins) {
+                thr_rob->pop();
+                retireFunctional(delay_ins);
+                delete delay_ins;
+                retired++;
+            }
+
+            if (mispredicted) {
+                handleMisspeculate(hw_thr, taken_addr);
+            }
+
+            delete ins;
+        } else {
+            if (executeFunctional(ins) != 0) {
+                return 1;
+            }
+
+            thr_rob->pop();
+            retireFunctional(ins);
+            delete ins;
+            retired = 1;
+        }
+
+        executed += retired;
+        sampler->advance(retired, current_cycle);
+    }
+
+    return 0;
+}
+
+int
+VANADIS_COMPONENT::executeFunctional(VanadisInstruction* ins) {
+    if (ins->completedExecution()) {
+        return 0;
+    }
+
+    mapFunctionalRegisters(ins);
+
+    const uint32_t hw_thr = ins->getHWThread();
+    int exe_rc = 0;
+
+    switch (ins->getInstFuncType()) {
+    case INST_LOAD:
+        exe_rc = executeFunctionalLoad(dynamic_cast<VanadisLoadInstruction*>(ins));
+        break;
+    case INST_STORE:
+        exe_rc = executeFunctionalStore(dynamic_cast<VanadisStoreInstruction*>(ins));
+        break;
+    case INST_FENCE:
+    case INST_NOOP:
+    case INST_FAULT:
+        ins->markExecuted();
+        break;
+    case INST_SYSCALL:
+        output->fatal(CALL_INFO, -1,
+                      "Error - SYSCALL (0x%llx) cannot be executed in a branch delay slot during functional "
+                      "execution.\n",
+                      ins->getInstructionAddress());
+        break;
+    default:
+        ins->execute(output, register_files[hw_thr]);
+        break;
+    }
+
+    if (UNLIKELY(ins->trapsError())) {
+        output->fatal(CALL_INFO, -1,
+                      "Instruction 0x%llx flags an error (instruction-type=%s) during functional execution at "
+                      "cycle %" PRIu64 "\n",
+                      ins->getInstructionAddress(), ins->getInstCode(), current_cycle);
+    }
+
+    // Writes to the zero register are not renamed away here, so reset it
+    const uint16_t zero_reg = isa_options[hw_thr]->getRegisterIgnoreWrites();
+
+    if (zero_reg < isa_options[hw_thr]->countISAIntRegisters()) {
+        register_files[hw_thr]->setIntReg<uint64_t>(retire_isa_tables[hw_thr]->getIntPhysReg(zero_reg), 0);
+    }
+
+    return exe_rc;
+}
+
+int
+VANADIS_COMPONENT::executeFunctionalLoad(VanadisLoadInstruction* load_ins) {
+    VanadisRegisterFile* reg_file = register_files[load_ins->getHWThread()];
+    uint64_t load_addr = 0;
+    uint16_t load_width = 0;
+    uint8_t load_data[64];
+
+    load_ins->computeLoadAddress(output, reg_file, &load_addr, &load_width);
+    load_addr = load_addr & lsq->getAddressMask();
+
+    if (load_addr < 4096) {
+        output->verbose(CALL_INFO, 16, 0,
+                        "[fault] address for load 0x%llx is less than 4096, indicates "
+                        "segmentation-fault, mark load error (load-ins: 0x%llx)\n",
+                        load_addr, load_ins->getInstructionAddress());
+        load_ins->flagError();
+        return 0;
+    }
+
+    if ((!load_ins->isPartialLoad()) && ((load_addr % load_width) > 0)) {
+        output->verbose(CALL_INFO, 16, 0, "[fault] load is not partial and 0x%llx is not aligned to load width (%" PRIu16 ")\n",
+                        load_addr, load_width);
+        load_ins->flagError();
+        return 0;
+    }
+
+    if (load_width > sizeof(load_data)) {
+        output->fatal(CALL_INFO, -1, "Error - functional load of %" PRIu16 " bytes is not supported.\n", load_width);
+    }
+
+    if (!functional_mem->contains(load_addr, load_width)) {
+        functional_mem->requestLines(load_addr, load_width);
+        return 1;
+    }
+
+    functional_mem->read(load_addr, load_width, load_data);
+
+    switch (load_ins->getValueRegisterType()) {
+    case LOAD_INT_REGISTER: {
+        const uint16_t target_reg = load_ins->getPhysIntRegOut(0);
+
+        if (target_reg != load_ins->getISAOptions()->getRegisterIgnoreWrites()) {
+            if (load_ins->isPartialLoad()) {
+                const uint16_t reg_offset = load_ins->getRegisterOffset();
+                char* reg_ptr = reg_file->getIntReg(target_reg);
+
+                for (uint16_t i = 0; i < load_width; ++i) {
+                    reg_ptr[reg_offset + i] = load_data[i];
+                }
+
+                if ((reg_offset + load_width) >= load_ins->getLoadWidth()) {
+                    if ((reg_ptr[reg_offset + load_width - 1] & 0x80) != 0) {
+                        for (uint16_t i = reg_offset + load_width; i < 8; ++i) {
+                            reg_ptr[i] = 0xFF;
+                        }
+                    }
+                }
+            } else if (load_ins->performSignExtension()) {
+                switch (load_width) {
+                case 1:
+                    reg_file->setIntReg<int8_t>(target_reg, *((int8_t*)load_data), true);
+                    break;
+                case 2:
+                    reg_file->setIntReg<int16_t>(target_reg, *((int16_t*)load_data), true);
+                    break;
+                case 4:
+                    reg_file->setIntReg<int32_t>(target_reg, *((int32_t*)load_data), true);
+                    break;
+                case 8:
+                    reg_file->setIntReg<int64_t>(target_reg, *((int64_t*)load_data), true);
+                    break;
+                }
+            } else {
+                switch (load_width) {
+                case 1:
+                    reg_file->setIntReg<uint8_t>(target_reg, *((uint8_t*)load_data), false);
+                    break;
+                case 2:
+                    reg_file->setIntReg<uint16_t>(target_reg, *((uint16_t*)load_data), false);
+                    break;
+                case 4:
+                    reg_file->setIntReg<uint32_t>(target_reg, *((uint32_t*)load_data), false);
+                    break;
+                case 8:
+                    reg_file->setIntReg<uint64_t>(target_reg, *((uint64_t*)load_data), false);
+                    break;
+                }
+            }
+        }
+    } break;
+    case LOAD_FP_REGISTER: {
+        const uint16_t target_reg = load_ins->getPhysFPRegOut(0);
+
+        if (load_ins->isPartialLoad()) {
+            output->fatal(CALL_INFO, -1, "Error - does not support partial load of a floating point register.\n");
+        }
+
+        switch (load_width) {
+        case 4:
+            reg_file->setFPReg(target_reg, *((float*)load_data));
+            break;
+        case 8:
+            reg_file->setFPReg(target_reg, *((double*)load_data));
+            break;
+        default:
+            output->fatal(CALL_INFO, -1,
+                          "Error - load to floating point register in not supported size (%" PRIu16 ")\n",
+                          load_width);
+            break;
+        }
+    } break;
+    }
+
+    load_ins->markExecuted();
+    return 0;
+}
+
+int
+VANADIS_COMPONENT::executeFunctionalStore(VanadisStoreInstruction* store_ins) {
+    VanadisRegisterFile* reg_file = register_files[store_ins->getHWThread()];
+    uint64_t store_addr = 0;
+    uint16_t store_width = 0;
+    const uint16_t reg_offset = store_ins->getRegisterOffset();
+    char* reg_ptr = nullptr;
+
+    switch (store_ins->getValueRegisterType()) {
+    case STORE_INT_REGISTER:
+        reg_ptr = reg_file->getIntReg(store_ins->getPhysIntRegIn(1));
+        break;
+    case STORE_FP_REGISTER:
+        reg_ptr = reg_file->getFPReg(store_ins->getPhysFPRegIn(0));
+        break;
+    }
+
+    store_ins->computeStoreAddress(output, reg_file, &store_addr, &store_width);
+    store_addr = store_addr & lsq->getAddressMask();
+
+    if (store_addr < 4096) {
+        output->verbose(CALL_INFO, 16, 0,
+                        "[fault] - address 0x%llx is less than 4096, indicates a "
+                        "segmentation fault (store-ins: 0x%llx)\n",
+                        store_addr, store_ins->getInstructionAddress());
+        store_ins->flagError();
+        store_ins->markExecuted();
+        return 0;
+    }
+
+    if (!functional_mem->contains(store_addr, store_width)) {
+        functional_mem->requestLines(store_addr, store_width);
+        return 1;
+    }
+
+    functional_mem->write(store_addr, store_width, (const uint8_t*)&reg_ptr[reg_offset]);
+
+    // Only one core sees the functional copy, so a store-conditional always succeeds
+    if (MEM_TRANSACTION_LLSC_STORE == store_ins->getTransactionType()) {
+        switch (store_ins->getValueRegisterType()) {
+        case STORE_INT_REGISTER:
+            reg_file->setIntReg<uint64_t>(store_ins->getPhysIntRegOut(0), (uint64_t)1);
+            break;
+        case STORE_FP_REGISTER:
+            reg_file->setFPReg(store_ins->getPhysFPRegOut(0), 1.0f);
+            break;
+        }
+    }
+
+    store_ins->markExecuted();
+    return 0;
+}
+
+void
+VANADIS_COMPONENT::retireFunctional(VanadisInstruction* ins) {
+    if (pipelineTrace != nullptr) {
+        fprintf(pipelineTrace, "0x%08llx %s\n", ins->getInstructionAddress(), ins->getInstCode());
+    }
+
+    mid_instruction[ins->getHWThread()] = !ins->endsMicroOpGroup();
+}
+
+void
+VANADIS_COMPONENT::mapFunctionalRegisters(VanadisInstruction* ins) {
+    // No renaming, every register is read and written in place through the
+    // retirement mapping
+    VanadisISATable* isa_table = retire_isa_tables[ins->getHWThread()];
+
+    for (uint16_t i = 0; i < ins->countISAIntRegIn(); ++i) {
+        ins->setPhysIntRegIn(i, isa_table->getIntPhysReg(ins->getISAIntRegIn(i)));
+    }
+
+    for (uint16_t i = 0; i < ins->countISAIntRegOut(); ++i) {
+        ins->setPhysIntRegOut(i, isa_table->getIntPhysReg(ins->getISAIntRegOut(i)));
+    }
+
+    for (uint16_t i = 0; i < ins->countISAFPRegIn(); ++i) {
+        ins->setPhysFPRegIn(i, isa_table->getFPPhysReg(ins->getISAFPRegIn(i)));
+    }
+
+    for (uint16_t i = 0; i < ins->countISAFPRegOut(); ++i) {
+        ins->setPhysFPRegOut(i, isa_table->getFPPhysReg(ins->getISAFPRegOut(i)));
+    }
+}
+
+bool
+VANADIS_COMPONENT::atInstructionBoundary(const uint32_t hw_thr) {
+    // The decoder marks the last micro-op of each instruction
+    return rob[hw_thr]->empty() || !mid_instruction[hw_thr];
+}
+
+bool
+VANADIS_COMPONENT::canSwitchExecutionMode() {
+    for (uint32_t i = 0; i < hw_threads; ++i) {
+        if (halted_masks[i]) {
+            continue;
+        }
+
+        if (!atInstructionBoundary(i)) {
+            return false;
+        }
+
+        if (!rob[i]->empty()) {
+            VanadisInstruction* rob_front = rob[i]->peek();
+
+            // A store or syscall which has started at the front of the ROB has to finish
+            if (((INST_STORE == rob_front->getInstFuncType()) || (INST_SYSCALL == rob_front->getInstFuncType()))
+                && (rob_front->checkFrontOfROB() || rob_front->completedExecution())) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+void
+VANADIS_COMPONENT::switchExecutionMode(const bool to_functional) {
+    output->verbose(CALL_INFO, 1, 0, "[sample] switching to %s execution at cycle %" PRIu64 "\n",
+                    to_functional ? "functional" : "detailed", current_cycle);
+
+    if (!to_functional) {
+        functional_mem->writeBackAndClear();
+    }
+
+    // Restart every thread from its next unretired instruction, the retirement
+    // register mapping is the architectural state both modes share
+    for (uint32_t i = 0; i < hw_threads; ++i) {
+        if (halted_masks[i]) {
+            continue;
+        }
+
+        const uint64_t next_ip
+            = rob[i]->empty() ? thread_decoders[i]->getInstructionPointer() : rob[i]->peek()->getInstructionAddress();
+
+        handleMisspeculate(i, next_ip);
+    }
+
+    functional_mode = to_functional;
+    mode_switch_drain = true;
+}
+
+bool
+VANADIS_COMPONENT::performCheckpoint() {
+    // Write-backs from the last syscall and the fills below have to land first
+    if (!functional_mem->idle()) {
+        return false;
+    }
+
+    if (VANADIS_CHECKPOINT_PENDING == checkpoint_state) {
+        // Only the program break of the node OS is restored, refuse rather than diverge later
+        for (uint32_t i = 0; i < hw_threads; ++i) {
+            const char* os_call = thread_decoders[i]->getOSHandler()->getUncheckpointedCall();
+
+            if (nullptr != os_call) {
+                output->fatal(CALL_INFO, -1,
+                              "Error - unable to write a checkpoint, thread %" PRIu32 " called %s() and open files "
+                              "and memory mappings of the node OS are not part of a checkpoint.\n",
+                              i, os_call);
+            }
+        }
+
+        // Lines written back earlier are only in memory, read them in again
+        functional_mem->requestTouchedLines();
+        checkpoint_state = VANADIS_CHECKPOINT_FILL;
+        return false;
+    }
+
+    writeCheckpoint();
+    checkpoint_state = VANADIS_CHECKPOINT_WRITTEN;
+
+    for (uint32_t i = 0; i < hw_threads; ++i) {
+        thread_decoders[i]->getOSHandler()->setOSWriteCallback(nullptr);
+    }
+
+    if (checkpoint_exit) {
+        output->verbose(CALL_INFO, 1, 0, "Checkpoint written at cycle %" PRIu64 ". Core stops processing.\n",
+                        current_cycle);
+        primaryComponentOKToEndSim();
+        return true;
+    }
+
+    return false;
+}
+
+void
+VANADIS_COMPONENT::writeCheckpoint() {
+    VanadisCheckpoint ckpt;
+
+    ckpt.core = core_id;
+    ckpt.cycle = current_cycle;
+    ckpt.brk = thread_decoders[0]->getOSHandler()->getProgramBreak();
+
+    for (uint32_t i = 0; i < hw_threads; ++i) {
+        VanadisCheckpointThread thr;
+        VanadisRegisterFile* reg_file = register_files[i];
+
+        thr.halted = halted_masks[i];
+        thr.ip = rob[i]->empty() ? thread_decoders[i]->getInstructionPointer() : rob[i]->peek()->getInstructionAddress();
+        thr.tls = thread_decoders[i]->getThreadLocalStoragePointer();
+        thr.tid = thread_decoders[i]->getOSHandler()->getThreadID();
+        thr.int_reg_width = reg_file->getIntRegWidth();
+        thr.fp_reg_width = reg_file->getFPRegWidth();
+
+        for (uint16_t j = 0; j < isa_options[i]->countISAIntRegisters(); ++j) {
+            const char* reg_ptr = reg_file->getIntReg(retire_isa_tables[i]->getIntPhysReg(j));
+            thr.int_regs.insert(thr.int_regs.end(), reg_ptr, reg_ptr + thr.int_reg_width);
+        }
+
+        for (uint16_t j = 0; j < isa_options[i]->countISAFPRegisters(); ++j) {
+            const char* reg_ptr = reg_file->getFPReg(retire_isa_tables[i]->getFPPhysReg(j));
+            thr.fp_regs.insert(thr.fp_regs.end(), reg_ptr, reg_ptr + thr.fp_reg_width);
+        }
+
+        ckpt.threads.push_back(thr);
+    }
+
+    // Every run of touched lines becomes one region
+    const uint64_t line_width = functional_mem->getLineWidth();
+
+    for (const uint64_t line : functional_mem->getTouchedLines()) {
+        if (!functional_mem->contains(line, line_width)) {
+            output->fatal(CALL_INFO, -1, "Error - checkpoint line 0x%llx was not filled.\n", line);
+        }
+
+        if (ckpt.regions.empty() || ((ckpt.regions.back().address + ckpt.regions.back().data.size()) != line)) {
+            ckpt.regions.emplace_back(line);
+        }
+
+        std::vector<uint8_t>& region_data = ckpt.regions.back().data;
+        region_data.resize(region_data.size() + line_width);
+        functional_mem->read(line, line_width, &region_data[region_data.size() - line_width]);
+    }
+
+    const std::string ckpt_path = VanadisCheckpoint::getFileName(checkpoint_write_prefix, core_id);
+
+    if (!ckpt.write(ckpt_path)) {
+        output->fatal(CALL_INFO, -1, "Error - unable to write checkpoint %s\n", ckpt_path.c_str());
+    }
+
+    output->verbose(CALL_INFO, 1, 0,
+                    "Wrote checkpoint %s at cycle %" PRIu64 " (%" PRIu64 " bytes of memory in %" PRIu64 " regions)\n",
+                    ckpt_path.c_str(), current_cycle, ckpt.countMemoryBytes(), (uint64_t)ckpt.regions.size());
+}
+
+void
+VANADIS_COMPONENT::restoreCheckpointRegisters() {
+    if (restore_checkpoint->threads.size() != hw_threads) {
+        output->fatal(CALL_INFO, -1, "Error - checkpoint has %" PRIu32 " hardware threads, core has %" PRIu32 ".\n",
+                      (uint32_t)restore_checkpoint->threads.size(), hw_threads);
+    }
+
+    for (uint32_t i = 0; i < hw_threads; ++i) {
+        const VanadisCheckpointThread& thr = restore_checkpoint->threads[i];
+        VanadisRegisterFile* reg_file = register_files[i];
+
+        const uint16_t int_reg_count = isa_options[i]->countISAIntRegisters();
+        const uint16_t fp_reg_count = isa_options[i]->countISAFPRegisters();
+
+        if ((thr.int_reg_width != reg_file->getIntRegWidth()) || (thr.fp_reg_width != reg_file->getFPRegWidth())
+            || (thr.int_regs.size() != ((size_t)int_reg_count * thr.int_reg_width))
+            || (thr.fp_regs.size() != ((size_t)fp_reg_count * thr.fp_reg_width))) {
+            output->fatal(CALL_INFO, -1,
+                          "Error - checkpoint registers of thread %" PRIu32 " do not match the ISA of this core.\n", i);
+        }
+
+        // Architectural registers land where the retirement table maps them
+        for (uint16_t j = 0; j < int_reg_count; ++j) {
+            std::memcpy(reg_file->getIntReg(retire_isa_tables[i]->getIntPhysReg(j)), &thr.int_regs[j * thr.int_reg_width],
+                        thr.int_reg_width);
+        }
+
+        for (uint16_t j = 0; j < fp_reg_count; ++j) {
+            std::memcpy(reg_file->getFPReg(retire_isa_tables[i]->getFPPhysReg(j)), &thr.fp_regs[j * thr.fp_reg_width],
+                        thr.fp_reg_width);
+        }
+
+        halted_masks[i] = thr.halted;
+        thread_decoders[i]->setInstructionPointer(thr.ip);
+        thread_decoders[i]->setThreadLocalStoragePointer(thr.tls);
+        thread_decoders[i]->getOSHandler()->setThreadID(thr.tid);
+
+        output->verbose(CALL_INFO, 8, 0, "Restored thread %" PRIu32 " (%s) at 0x%llx\n", i,
+                        thr.halted ? "halted" : "running", thr.ip);
+    }
+
+    output->verbose(CALL_INFO, 1, 0, "Restoring checkpoint of core %" PRIu32 " taken at cycle %" PRIu64 "\n",
+                    restore_checkpoint->core, restore_checkpoint->cycle);
+}
+
 int
 VANADIS_COMPONENT::checkInstructionResources(VanadisInstruction* ins, VanadisRegisterStack* int_regs,
                                              VanadisRegisterStack* fp_regs, VanadisISATable* isa_table) {
@@ -1675,7 +2415,11 @@ void
 VANADIS_COMPONENT::setup() {}
 
 void
-VANADIS_COMPONENT::finish() {}
+VANADIS_COMPONENT::finish() {
+    if (nullptr != sampler) {
+        sampler->printSummary();
+    }
+}
 
 void
 VANADIS_COMPONENT::printStatus(SST::Output& output) {
@@ -1726,6 +2470,11 @@ VANADIS_COMPONENT::init(unsigned int phase) {
     // everything should be correctly up and running by now (components, links
     // etc)
     if (0 == phase) {
+        // The OS refuses functional execution on nodes with more than one core
+        if (nullptr != sampler) {
+            thread_decoders[0]->getOSHandler()->registerInitParameter(SYSCALL_INIT_PARAM_FUNCTIONAL, nullptr);
+        }
+
         if (nullptr != binary_elf_info) {
             if (0 == core_id) {
                 output->verbose(CALL_INFO, 2, 0, "-> Loading %s, to locate program sections ...\n",
@@ -1899,6 +2648,11 @@ VANADIS_COMPONENT::init(unsigned int phase) {
                 uint64_t initial_brk = (uint64_t)initial_mem_contents.size();
                 initial_brk = initial_brk + (page_size - (initial_brk % page_size));
 
+                // A restored program carries on with the break it had grown to
+                if ((nullptr != restore_checkpoint) && (restore_checkpoint->brk > 0)) {
+                    initial_brk = restore_checkpoint->brk;
+                }
+
                 output->verbose(CALL_INFO, 2, 0,
                                 ">> Setting initial break point to image size in "
                                 "memory ( brk: 0x%llx )\n",
@@ -1910,6 +2664,23 @@ VANADIS_COMPONENT::init(unsigned int phase) {
         } else {
             output->verbose(CALL_INFO, 2, 0, "No ELF binary information loaded, will not perform any loading.\n");
         }
+
+        // Checkpointed memory is written after the binary so it takes precedence
+        if (nullptr != restore_checkpoint) {
+            output->verbose(CALL_INFO, 2, 0, "-> Restoring %" PRIu64 " bytes of memory in %" PRIu64 " regions from checkpoint...\n",
+                            restore_checkpoint->countMemoryBytes(), (uint64_t)restore_checkpoint->regions.size());
+
+            for (VanadisCheckpointRegion& region : restore_checkpoint->regions) {
+                lsq->setInitialMemory(region.address, region.data);
+
+                if (nullptr != functional_mem) {
+                    functional_mem->markTouched(region.address, region.data.size());
+                }
+            }
+
+            delete restore_checkpoint;
+            restore_checkpoint = nullptr;
+        }
     }
 
     output->verbose(CALL_INFO, 2, 0, "End: init-phase: %" PRIu32 "...\n", (uint32_t)phase);
@@ -2036,6 +2807,9 @@ VANADIS_COMPONENT::clearROBMisspeculate(const uint32_t hw_thr) {
 
     // clear the ROB entries and reset
     thr_rob->clear();
+
+    // Fetch restarts at the start of an instruction
+    mid_instruction[hw_thr] = false;
 }
 
 void
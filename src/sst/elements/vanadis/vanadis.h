@@ -37,7 +37,9 @@
 #include "lsq/vlsq.h"
 #include "lsq/vlsqseq.h"
 #include "lsq/vlsqstd.h"
+#include "vcheckpoint.h"
 #include "vfuncunit.h"
+#include "vsampler.h"
 
 namespace SST {
 namespace Vanadis {
@@ -124,7 +126,26 @@ public:
         { "decodes_per_cycle", "Number of instruction decodes per cycle" },
         { "print_int_reg", "Print integer registers true/false, auto set to true if verbose > 16" },
         { "print_fp_reg", "Print floating-point registers true/false, auto set to "
-                          "true if verbose > 16" })
+                          "true if verbose > 16" },
+        { "fast_forward",
+          "Number of instructions to execute functionally before detailed simulation starts, functional execution "
+          "requires a single core with one hardware thread" },
+        { "fast_forward_until_address",
+          "Execute functionally until the instruction at this address is reached, 0 disables the marker" },
+        { "functional_instructions_per_cycle", "Maximum number of instructions executed per cycle when functional" },
+        { "sample_period", "Instructions in each sample period after the fast-forward, 0 disables sampling" },
+        { "sample_warmup",
+          "Instructions of detailed warm-up before each measured window, also corrects cache replacement state which "
+          "functional warming only approximates" },
+        { "sample_window", "Instructions in each measured detailed window" },
+        { "sample_max_windows", "Stop sampling and execute functionally after this many windows, 0 is unlimited" },
+        { "sample_confidence", "Confidence level for the extrapolated CPI interval reported at the end" },
+        { "checkpoint_write",
+          "Write the architectural state to <prefix>-<core>.vckpt when the fast-forward ends, empty disables" },
+        { "checkpoint_exit", "Stop the core once the checkpoint has been written", "false" },
+        { "checkpoint_restore",
+          "Start from the checkpoint <prefix>-<core>.vckpt, the binary and app parameters must match the run it was "
+          "taken from" })
 
     SST_ELI_DOCUMENT_STATISTICS(
         { "cycles", "Number of cycles the core executed", "cycles", 1 },
@@ -143,6 +164,10 @@ public:
         { "stores_issued", "Number of store instructions issued to the LSQ", "instructions", 1 },
         { "phys_int_reg_in_use", "Number of physical integer registers that are in use each cycle", "registers", 1 },
         { "phys_fp_reg_in_use", "Number of physical floating point registers than are in use each cycle", "registers",
+          1 },
+        { "instructions_functional", "Number of instructions executed functionally (fast-forward and warming)",
+          "instructions", 1 },
+        { "functional_cycles", "Number of cycles spent executing functionally or switching execution mode", "cycles",
           1 })
 
     SST_ELI_DOCUMENT_PORTS({ "icache_link", "Connects the CPU to the instruction cache", {} },
@@ -213,6 +238,21 @@ private:
     int allocateFunctionalUnit(VanadisInstruction* ins);
     bool mapInstructiontoFunctionalUnit(VanadisInstruction* ins, std::vector<VanadisFunctionalUnit*>& functional_units);
 
+    bool tickFunctional(const uint64_t cycle);
+    int performFunctionalExecute(const uint32_t hw_thr, const uint64_t max_ins, uint64_t& executed);
+    int executeFunctional(VanadisInstruction* ins);
+    int executeFunctionalLoad(VanadisLoadInstruction* load_ins);
+    int executeFunctionalStore(VanadisStoreInstruction* store_ins);
+    void retireFunctional(VanadisInstruction* ins);
+    void mapFunctionalRegisters(VanadisInstruction* ins);
+    bool atInstructionBoundary(const uint32_t hw_thr);
+    bool canSwitchExecutionMode();
+    void switchExecutionMode(const bool to_functional);
+
+    bool performCheckpoint();
+    void writeCheckpoint();
+    void restoreCheckpointRegisters();
+
     SST::Output* output;
 
     uint16_t core_id;
@@ -252,6 +292,18 @@ private:
     VanadisLoadStoreQueue* lsq;
     StandardMem* memInstInterface;
 
+    VanadisSampler* sampler;
+    VanadisFunctionalMemory* functional_mem;
+    bool functional_mode;
+    bool mode_switch_drain;
+    uint64_t functional_ins_per_cycle;
+    std::vector<bool> mid_instruction;     // The last micro-op retired by each thread did not end its instruction
+
+    VanadisCheckpointState checkpoint_state;
+    std::string checkpoint_write_prefix;
+    bool checkpoint_exit;
+    VanadisCheckpoint* restore_checkpoint;
+
     bool* halted_masks;
     bool print_int_reg;
     bool print_fp_reg;
@@ -281,6 +333,8 @@ private:
     Statistic<uint64_t>* stat_syscall_cycles;
     Statistic<uint64_t>* stat_int_phys_regs_in_use;
     Statistic<uint64_t>* stat_fp_phys_regs_in_use;
+    Statistic<uint64_t>* stat_ins_functional;
+    Statistic<uint64_t>* stat_functional_cycles;
 
     uint32_t ins_issued_this_cycle;
     uint32_t ins_retired_this_cycle;
@@ -0,0 +1,246 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_CHECKPOINT
+#define _H_VANADIS_CHECKPOINT
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace SST {
+namespace Vanadis {
+
+#define VANADIS_CHECKPOINT_MAGIC "VANCKPT"
+#define VANADIS_CHECKPOINT_VERSION 1
+
+enum VanadisCheckpointState {
+    VANADIS_CHECKPOINT_DISABLED,
+    VANADIS_CHECKPOINT_WAIT,
+    VANADIS_CHECKPOINT_PENDING,
+    VANADIS_CHECKPOINT_FILL,
+    VANADIS_CHECKPOINT_WRITTEN
+};
+
+class VanadisCheckpointThread {
+public:
+    VanadisCheckpointThread() : halted(true), ip(0), tls(0), tid(0), int_reg_width(0), fp_reg_width(0) {}
+
+    bool halted;
+    uint64_t ip;
+    uint64_t tls;
+    int64_t tid;
+
+    // Architectural (ISA) registers in ISA order, int_reg_width / fp_reg_width bytes each
+    uint32_t int_reg_width;
+    uint32_t fp_reg_width;
+    std::vector<uint8_t> int_regs;
+    std::vector<uint8_t> fp_regs;
+};
+
+class VanadisCheckpointRegion {
+public:
+    VanadisCheckpointRegion(const uint64_t addr) : address(addr) {}
+
+    uint64_t address;
+    std::vector<uint8_t> data;
+};
+
+/*
+ * The architectural state of one core: per hardware thread the ISA registers,
+ * the next instruction, TLS pointer and thread id, the program break known to
+ * the OS and the memory the core touched or the OS wrote through system call
+ * buffers before the checkpoint. A restore loads the executable as usual and
+ * then overlays this state, so it must use the same binary and application
+ * parameters the checkpoint was taken with. Of the node OS only the program
+ * break is kept, no checkpoint is written once the program opened a file or
+ * mapped memory.
+ */
+class VanadisCheckpoint {
+public:
+    VanadisCheckpoint() : core(0), cycle(0), brk(0) {}
+
+    static std::string getFileName(const std::string& prefix, const uint32_t core) {
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), "-%" PRIu32 ".vckpt", core);
+        return prefix + suffix;
+    }
+
+    uint64_t countMemoryBytes() const {
+        uint64_t bytes = 0;
+
+        for (const VanadisCheckpointRegion& region : regions) {
+            bytes += region.data.size();
+        }
+
+        return bytes;
+    }
+
+    bool write(const std::string& path) const {
+        FILE* ckpt_file = fopen(path.c_str(), "wb");
+
+        if (nullptr == ckpt_file) {
+            return false;
+        }
+
+        bool good = (fwrite(VANADIS_CHECKPOINT_MAGIC, 1, 8, ckpt_file) == 8);
+        good = good && writeValue(ckpt_file, (uint32_t)VANADIS_CHECKPOINT_VERSION);
+        good = good && writeValue(ckpt_file, core);
+        good = good && writeValue(ckpt_file, cycle);
+        good = good && writeValue(ckpt_file, brk);
+        good = good && writeValue(ckpt_file, (uint32_t)threads.size());
+
+        for (const VanadisCheckpointThread& thr : threads) {
+            good = good && writeValue(ckpt_file, (uint8_t)(thr.halted ? 1 : 0));
+            good = good && writeValue(ckpt_file, thr.ip);
+            good = good && writeValue(ckpt_file, thr.tls);
+            good = good && writeValue(ckpt_file, thr.tid);
+            good = good && writeValue(ckpt_file, thr.int_reg_width);
+            good = good && writeBytes(ckpt_file, thr.int_regs);
+            good = good && writeValue(ckpt_file, thr.fp_reg_width);
+            good = good && writeBytes(ckpt_file, thr.fp_regs);
+        }
+
+        good = good && writeValue(ckpt_file, (uint64_t)regions.size());
+
+        for (const VanadisCheckpointRegion& region : regions) {
+            good = good && writeValue(ckpt_file, region.address);
+            good = good && writeBytes(ckpt_file, region.data);
+        }
+
+        return (0 == fclose(ckpt_file)) && good;
+    }
+
+    // Returns false (with the reason in error) if the file is missing, truncated
+    // or not a checkpoint this version can read
+    bool read(const std::string& path, std::string& error) {
+        FILE* ckpt_file = fopen(path.c_str(), "rb");
+
+        if (nullptr == ckpt_file) {
+            error = "unable to open file";
+            return false;
+        }
+
+        char magic[8];
+        uint32_t version = 0;
+        uint32_t thread_count = 0;
+        uint64_t region_count = 0;
+
+        bool good = (fread(magic, 1, 8, ckpt_file) == 8) && (0 == std::memcmp(magic, VANADIS_CHECKPOINT_MAGIC, 8));
+        good = good && readValue(ckpt_file, version) && (VANADIS_CHECKPOINT_VERSION == version);
+
+        if (!good) {
+            error = "not a Vanadis checkpoint or unsupported version";
+            fclose(ckpt_file);
+            return false;
+        }
+
+        good = good && readValue(ckpt_file, core);
+        good = good && readValue(ckpt_file, cycle);
+        good = good && readValue(ckpt_file, brk);
+        good = good && readValue(ckpt_file, thread_count);
+
+        threads.clear();
+        regions.clear();
+
+        for (uint32_t i = 0; good && (i < thread_count); ++i) {
+            VanadisCheckpointThread thr;
+            uint8_t halted = 0;
+
+            good = good && readValue(ckpt_file, halted);
+            good = good && readValue(ckpt_file, thr.ip);
+            good = good && readValue(ckpt_file, thr.tls);
+            good = good && readValue(ckpt_file, thr.tid);
+            good = good && readValue(ckpt_file, thr.int_reg_width);
+            good = good && readBytes(ckpt_file, thr.int_regs);
+            good = good && readValue(ckpt_file, thr.fp_reg_width);
+            good = good && readBytes(ckpt_file, thr.fp_regs);
+
+            thr.halted = (0 != halted);
+            threads.push_back(thr);
+        }
+
+        good = good && readValue(ckpt_file, region_count);
+
+        for (uint64_t i = 0; good && (i < region_count); ++i) {
+            uint64_t address = 0;
+            good = good && readValue(ckpt_file, address);
+
+            regions.emplace_back(address);
+            good = good && readBytes(ckpt_file, regions.back().data);
+        }
+
+        fclose(ckpt_file);
+
+        if (!good) {
+            error = "file is truncated";
+        }
+
+        return good;
+    }
+
+    uint32_t core;
+    uint64_t cycle;
+    uint64_t brk;
+
+    std::vector<VanadisCheckpointThread> threads;
+    std::vector<VanadisCheckpointRegion> regions;
+
+protected:
+    template <typename T>
+    static bool writeValue(FILE* f, const T v) {
+        return fwrite(&v, sizeof(T), 1, f) == 1;
+    }
+
+    template <typename T>
+    static bool readValue(FILE* f, T& v) {
+        return fread(&v, sizeof(T), 1, f) == 1;
+    }
+
+    // Length prefixed block of bytes
+    static bool writeBytes(FILE* f, const std::vector<uint8_t>& bytes) {
+        return writeValue(f, (uint64_t)bytes.size())
+            && (bytes.empty() || (fwrite(&bytes[0], 1, bytes.size(), f) == bytes.size()));
+    }
+
+    static bool readBytes(FILE* f, std::vector<uint8_t>& bytes) {
+        uint64_t len = 0;
+
+        if (!readValue(f, len)) {
+            return false;
+        }
+
+        // Guard against a corrupt length before allocating
+        const long here = ftell(f);
+        fseek(f, 0, SEEK_END);
+        const long end = ftell(f);
+        fseek(f, here, SEEK_SET);
+
+        if (len > (uint64_t)(end - here)) {
+            return false;
+        }
+
+        bytes.resize(len);
+        return bytes.empty() || (fread(&bytes[0], 1, len, f) == len);
+    }
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -0,0 +1,286 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+#ifndef _H_VANADIS_SAMPLER
+#define _H_VANADIS_SAMPLER
+
+#include <sst/core/output.h>
+#include <sst/core/params.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace SST {
+namespace Vanadis {
+
+enum VanadisSamplePhase {
+    VANADIS_SAMPLE_FAST_FORWARD,
+    VANADIS_SAMPLE_FUNCTIONAL_WARM,
+    VANADIS_SAMPLE_DETAILED_WARM,
+    VANADIS_SAMPLE_MEASURE,
+    VANADIS_SAMPLE_DETAILED,
+    VANADIS_SAMPLE_FUNCTIONAL
+};
+
+/*
+ * Decides when the core executes functionally and when it runs through the
+ * detailed pipeline. The run starts with a functional fast-forward which ends
+ * after a number of instructions or when a marker address is executed. If
+ * sampling is enabled each sample period is then split SMARTS style into
+ * functional warming, detailed warming and a measured detailed window, the
+ * CPI of the windows is extrapolated to the whole sampled region. Functional
+ * warming trains the branch predictor on every branch but the data cache only
+ * on line fills and write-backs (see VanadisFunctionalMemory), so the caches
+ * enter detailed warming with approximate replacement state; size
+ * sample_warmup to cover that. Instructions are counted as micro-ops, the same
+ * way instructions_retired counts them.
+ */
+class VanadisSampler {
+public:
+    VanadisSampler(SST::Output* out, SST::Params& params) : output(out) {
+        fast_forward = params.find<uint64_t>("fast_forward", 0);
+        fast_forward_address = params.find<uint64_t>("fast_forward_until_address", 0);
+
+        period = params.find<uint64_t>("sample_period", 0);
+        warmup = params.find<uint64_t>("sample_warmup", 2000);
+        window = params.find<uint64_t>("sample_window", 1000);
+        max_windows = params.find<uint64_t>("sample_max_windows", 0);
+        confidence = params.find<double>("sample_confidence", 0.95);
+
+        if ((period > 0) && (period < (warmup + window))) {
+            output->fatal(CALL_INFO, -1,
+                          "Error - sample_period (%" PRIu64 ") must be at least sample_warmup (%" PRIu64
+                          ") plus sample_window (%" PRIu64 ")\n",
+                          period, warmup, window);
+        }
+
+        if ((period > 0) && (0 == window)) {
+            output->fatal(CALL_INFO, -1, "Error - sample_window must be greater than zero when sampling.\n");
+        }
+
+        if ((confidence <= 0.0) || (confidence >= 1.0)) {
+            output->fatal(CALL_INFO, -1, "Error - sample_confidence (%f) must be between 0 and 1.\n", confidence);
+        }
+
+        phase_count = 0;
+        phase_start_cycle = 0;
+        sampled_instructions = 0;
+        windows = 0;
+        cpi_sum = 0;
+        cpi_sum_sq = 0;
+
+        if ((fast_forward > 0) || (fast_forward_address > 0)) {
+            phase = VANADIS_SAMPLE_FAST_FORWARD;
+        } else {
+            enterSampling(0);
+        }
+
+        output->verbose(CALL_INFO, 2, 0, "Sampling Configuration:\n");
+        output->verbose(CALL_INFO, 2, 0, "-> Fast-forward instructions:  %" PRIu64 "\n", fast_forward);
+        output->verbose(CALL_INFO, 2, 0, "-> Fast-forward until address: 0x%llx\n", fast_forward_address);
+        output->verbose(CALL_INFO, 2, 0, "-> Sample period:              %" PRIu64 "\n", period);
+        output->verbose(CALL_INFO, 2, 0, "-> Sample detailed warm-up:    %" PRIu64 "\n", warmup);
+        output->verbose(CALL_INFO, 2, 0, "-> Sample window:              %" PRIu64 "\n", window);
+    }
+
+    // Is any functional execution configured at all
+    bool isEnabled() const { return (fast_forward > 0) || (fast_forward_address > 0) || (period > 0); }
+
+    VanadisSamplePhase getPhase() const { return phase; }
+
+    bool isFunctional() const {
+        return (VANADIS_SAMPLE_FAST_FORWARD == phase) || (VANADIS_SAMPLE_FUNCTIONAL_WARM == phase)
+            || (VANADIS_SAMPLE_FUNCTIONAL == phase);
+    }
+
+    bool isFastForwarding() const { return VANADIS_SAMPLE_FAST_FORWARD == phase; }
+
+    // Instructions left in the current phase, unbounded phases never end
+    uint64_t remaining() const {
+        const uint64_t target = phaseLength();
+        return (target > phase_count) ? (target - phase_count) : 0;
+    }
+
+    // Called for every instruction executed while fast-forwarding
+    bool checkMarker(const uint64_t ins_addr, const uint64_t cycle) {
+        if ((VANADIS_SAMPLE_FAST_FORWARD == phase) && (fast_forward_address > 0) && (ins_addr == fast_forward_address)) {
+            output->verbose(CALL_INFO, 1, 0,
+                            "[sample] reached fast-forward marker 0x%llx after %" PRIu64 " instructions.\n",
+                            fast_forward_address, phase_count);
+            enterSampling(cycle);
+            return true;
+        }
+
+        return false;
+    }
+
+    void advance(const uint64_t instructions, const uint64_t cycle) {
+        phase_count += instructions;
+
+        if (VANADIS_SAMPLE_FAST_FORWARD != phase) {
+            sampled_instructions += instructions;
+        }
+
+        while (phase_count >= phaseLength()) {
+            const uint64_t overshoot = phase_count - phaseLength();
+
+            switch (phase) {
+            case VANADIS_SAMPLE_FAST_FORWARD:
+                output->verbose(CALL_INFO, 1, 0, "[sample] fast-forward of %" PRIu64 " instructions completed.\n",
+                                phaseLength());
+                enterSampling(cycle);
+                sampled_instructions += overshoot;
+                break;
+            case VANADIS_SAMPLE_FUNCTIONAL_WARM:
+                phase = VANADIS_SAMPLE_DETAILED_WARM;
+                break;
+            case VANADIS_SAMPLE_DETAILED_WARM:
+                phase = VANADIS_SAMPLE_MEASURE;
+                phase_start_cycle = cycle;
+                break;
+            case VANADIS_SAMPLE_MEASURE:
+                recordWindow(phase_count, cycle - phase_start_cycle);
+                phase = ((max_windows > 0) && (windows >= max_windows)) ? VANADIS_SAMPLE_FUNCTIONAL
+                                                                        : firstPeriodPhase();
+                break;
+            default:
+                break;
+            }
+
+            // Extra instructions spill over into the next phase
+            phase_count = overshoot;
+        }
+    }
+
+    void printSummary() {
+        if (0 == period) {
+            return;
+        }
+
+        output->verbose(CALL_INFO, 0, 0, "[sample] sampled region:      %" PRIu64 " instructions, %" PRIu64 " windows\n",
+                        sampled_instructions, windows);
+
+        if (windows < 2) {
+            output->verbose(CALL_INFO, 0, 0, "[sample] too few windows measured to extrapolate.\n");
+            return;
+        }
+
+        const double n = (double)windows;
+        const double mean_cpi = cpi_sum / n;
+        const double var_cpi = std::max(0.0, (cpi_sum_sq - (n * mean_cpi * mean_cpi)) / (n - 1.0));
+        const double std_cpi = std::sqrt(var_cpi);
+        const double z = normalQuantile(confidence);
+        const double half = z * std_cpi / std::sqrt(n);
+        const double cov = (mean_cpi > 0) ? (std_cpi / mean_cpi) : 0;
+
+        output->verbose(CALL_INFO, 0, 0, "[sample] mean CPI:            %f (std-dev: %f)\n", mean_cpi, std_cpi);
+        output->verbose(CALL_INFO, 0, 0, "[sample] CPI %4.1f%% interval:  [%f, %f] (+/- %5.2f%%)\n",
+                        confidence * 100.0, mean_cpi - half, mean_cpi + half,
+                        (mean_cpi > 0) ? (100.0 * half / mean_cpi) : 0.0);
+        output->verbose(CALL_INFO, 0, 0, "[sample] extrapolated IPC:    %f [%f, %f]\n",
+                        (mean_cpi > 0) ? (1.0 / mean_cpi) : 0.0, (mean_cpi + half > 0) ? 1.0 / (mean_cpi + half) : 0.0,
+                        (mean_cpi - half > 0) ? 1.0 / (mean_cpi - half) : std::numeric_limits<double>::infinity());
+        output->verbose(CALL_INFO, 0, 0, "[sample] extrapolated cycles: %" PRIu64 "\n",
+                        (uint64_t)(mean_cpi * (double)sampled_instructions));
+        output->verbose(CALL_INFO, 0, 0, "[sample] windows for +/-3%%:   %" PRIu64 "\n",
+                        (uint64_t)std::ceil(std::pow(z * cov / 0.03, 2.0)));
+    }
+
+protected:
+    // The first phase of every sample period, functional warming is skipped if
+    // the period is fully covered by the detailed warm-up and window
+    VanadisSamplePhase firstPeriodPhase() const {
+        return (period > (warmup + window)) ? VANADIS_SAMPLE_FUNCTIONAL_WARM
+                                            : ((warmup > 0) ? VANADIS_SAMPLE_DETAILED_WARM : VANADIS_SAMPLE_MEASURE);
+    }
+
+    void enterSampling(const uint64_t cycle) {
+        phase_count = 0;
+        phase = (period > 0) ? firstPeriodPhase() : VANADIS_SAMPLE_DETAILED;
+        phase_start_cycle = cycle;
+    }
+
+    uint64_t phaseLength() const {
+        switch (phase) {
+        case VANADIS_SAMPLE_FAST_FORWARD:
+            return (fast_forward > 0) ? fast_forward : std::numeric_limits<uint64_t>::max();
+        case VANADIS_SAMPLE_FUNCTIONAL_WARM:
+            return period - warmup - window;
+        case VANADIS_SAMPLE_DETAILED_WARM:
+            return warmup;
+        case VANADIS_SAMPLE_MEASURE:
+            return window;
+        default:
+            return std::numeric_limits<uint64_t>::max();
+        }
+    }
+
+    void recordWindow(const uint64_t instructions, const uint64_t cycles) {
+        const double cpi = (double)cycles / (double)instructions;
+
+        output->verbose(CALL_INFO, 2, 0,
+                        "[sample] window %" PRIu64 ": %" PRIu64 " instructions in %" PRIu64 " cycles (CPI %f)\n",
+                        windows, instructions, cycles, cpi);
+
+        cpi_sum += cpi;
+        cpi_sum_sq += cpi * cpi;
+        windows++;
+    }
+
+    // z such that a standard normal lies within +/- z with the given probability
+    static double normalQuantile(const double p) {
+        double lo = 0.0;
+        double hi = 10.0;
+
+        for (int i = 0; i < 100; ++i) {
+            const double mid = (lo + hi) / 2.0;
+
+            if (std::erf(mid / std::sqrt(2.0)) < p) {
+                lo = mid;
+            } else {
+                hi = mid;
+            }
+        }
+
+        return (lo + hi) / 2.0;
+    }
+
+    SST::Output* output;
+
+    uint64_t fast_forward;
+    uint64_t fast_forward_address;
+    uint64_t period;
+    uint64_t warmup;
+    uint64_t window;
+    uint64_t max_windows;
+    double confidence;
+
+    VanadisSamplePhase phase;
+    uint64_t phase_count;
+    uint64_t phase_start_cycle;
+    uint64_t sampled_instructions;
+
+    uint64_t windows;
+    double cpi_sum;
+    double cpi_sum_sq;
+};
+
+} // namespace Vanadis
+} // namespace SST
+
+#endif
@@ -30,10 +30,18 @@ int handleOTFSendMsg(void *userData, uint64_t time, uint32_t sender, uint32_t re
 	uint32_t length, uint32_t source, OTF_KeyValueList *list) {
 
 	OTFReader* reader = (OTFReader*) userData;
-	std::cout << "OTF: Send message from " << sender << " to " << receiver << " qSize=" << reader->getCurrentQueueSize() << std::endl;
+	OTFTraceRecord* rec = reader->claimRecord();
+	if(NULL == rec) {
+		return OTF_RETURN_ABORT;
+	}
 
-	ZodiacSendEvent* sendEv = new ZodiacSendEvent(receiver, length, HERMES_DOUBLE, 0, group);
-	reader->enqueueEvent(sendEv);
+	rec->type = OTFTraceRecord::SEND;
+	rec->time = time;
+	rec->process = sender;
+	rec->peer = receiver;
+	rec->length = length;
+	rec->group = group;
+	reader->publishRecord();
 
 	return OTF_RETURN_OK;
 }
@@ -42,22 +50,50 @@ int handleOTFRecvMsg(void *userData, uint64_t time, uint32_t recvProc, uint32_t
 	uint32_t length, uint32_t source, OTF_KeyValueList *list) {
 
 	OTFReader* reader = (OTFReader*) userData;
-	std::cout << "OTF: Recv message from " << sendProc << " to " << recvProc << " qSize=" << reader->getCurrentQueueSize() << std::endl;
+	OTFTraceRecord* rec = reader->claimRecord();
+	if(NULL == rec) {
+		return OTF_RETURN_ABORT;
+	}
 
-	ZodiacRecvEvent* recvEv = new ZodiacRecvEvent(recvProc, length, HERMES_DOUBLE, 0, group);
-	reader->enqueueEvent(recvEv);
+	rec->type = OTFTraceRecord::RECV;
+	rec->time = time;
+	rec->process = recvProc;
+	rec->peer = sendProc;
+	rec->length = length;
+	rec->group = group;
+	reader->publishRecord();
 
 	return OTF_RETURN_OK;
 }
 
 int handleOTFEnter(void* data, uint64_t time, uint32_t func, uint32_t proc, uint32_t src) {
-	std::cout << "OTF: Entered function: " << func << " on process: " << proc << " at time: " << time << std::endl;
+	OTFReader* reader = (OTFReader*) data;
+	OTFTraceRecord* rec = reader->claimRecord();
+	if(NULL == rec) {
+		return OTF_RETURN_ABORT;
+	}
+
+	rec->type = OTFTraceRecord::ENTER;
+	rec->time = time;
+	rec->process = proc;
+	rec->value = func;
+	reader->publishRecord();
 
 	return OTF_RETURN_OK;
 }
 
 int handleOTFExit(void* data, uint64_t time, uint32_t func, uint32_t proc, uint32_t src) {
-	std::cout << "OTF: Exited function: " << func << " on process: " << proc << " at time: " << time << std::endl;
+	OTFReader* reader = (OTFReader*) data;
+	OTFTraceRecord* rec = reader->claimRecord();
+	if(NULL == rec) {
+		return OTF_RETURN_ABORT;
+	}
+
+	rec->type = OTFTraceRecord::EXIT;
+	rec->time = time;
+	rec->process = proc;
+	rec->value = func;
+	reader->publishRecord();
 
 	return OTF_RETURN_OK;
 }
@@ -65,8 +101,17 @@ int handleOTFExit(void* data, uint64_t time, uint32_t func, uint32_t proc, uint3
 int handleOTFCollectiveOperation(void *userData, uint64_t time, uint32_t process, uint32_t collective, uint32_t procGroup,
 	uint32_t rootProc, uint32_t sent, uint32_t received, uint64_t duration, uint32_t source, OTF_KeyValueList *list) {
 
-	std::cout << "OTF: Performed a collective operation on process: " << process << ", collective: " <<
-		collective << " at time: " << time << std::endl;
+	OTFReader* reader = (OTFReader*) userData;
+	OTFTraceRecord* rec = reader->claimRecord();
+	if(NULL == rec) {
+		return OTF_RETURN_ABORT;
+	}
+
+	rec->type = OTFTraceRecord::COLLECTIVE;
+	rec->time = time;
+	rec->process = process;
+	rec->value = collective;
+	reader->publishRecord();
 
 	return OTF_RETURN_OK;
 }
@@ -74,20 +119,40 @@ int handleOTFCollectiveOperation(void *userData, uint64_t time, uint32_t process
 int handleOTFBeginCollective(void *userData, uint64_t time, uint32_t process, uint32_t collOp, uint64_t matchingId, uint32_t procGroup,
 	uint32_t rootProc, uint64_t sent, uint64_t received, uint32_t scltoken, OTF_KeyValueList *list) {
 
-	std::cout << "OTF: Began a collective on process: " << process << " collective: " << collOp
-		<< " at time: " << time << std::endl;
+	OTFReader* reader = (OTFReader*) userData;
+	OTFTraceRecord* rec = reader->claimRecord();
+	if(NULL == rec) {
+		return OTF_RETURN_ABORT;
+	}
+
+	rec->type = OTFTraceRecord::BEGIN_COLLECTIVE;
+	rec->time = time;
+	rec->process = process;
+	rec->value = collOp;
+	reader->publishRecord();
 
 	return OTF_RETURN_OK;
 }
 
 int handleOTFEndCollective(void *userData, uint64_t time, uint32_t process, uint64_t matchingId, OTF_KeyValueList *list) {
-	std::cout << "OTF: Ended a collective on process: " << process << std::endl;
+	OTFReader* reader = (OTFReader*) userData;
+	OTFTraceRecord* rec = reader->claimRecord();
+	if(NULL == rec) {
+		return OTF_RETURN_ABORT;
+	}
 
+	rec->type = OTFTraceRecord::END_COLLECTIVE;
+	rec->time = time;
+	rec->process = process;
+	reader->publishRecord();
 
 	return OTF_RETURN_OK;
 }
 
-OTFReader::OTFReader(string file, uint32_t focusRank, uint32_t maxQLength, std::queue<ZodiacEvent*>* evQ) {
+OTFReader::OTFReader(string file, uint32_t focusRank, uint32_t maxQLength, std::queue<ZodiacEvent*>* evQ,
+	uint32_t lookahead, bool prefetch) :
+	ring(lookahead)
+{
 	// Open a maximum of 5 files concurrently
 	fileMgr = OTF_FileManager_open(5);
 
@@ -149,9 +214,27 @@ OTFReader::OTFReader(string file, uint32_t focusRank, uint32_t maxQLength, std::
 	eventQ = evQ;
 	qLimit = maxQLength;
 	foundFinalize = false;
+	decodeDone = false;
+
+	if(prefetch) {
+		decodeThread = std::thread(&OTFReader::decodeLoop, this);
+	}
+}
+
+OTFReader::~OTFReader() {
+	if(decodeThread.joinable()) {
+		ring.close();
+		decodeThread.join();
+	}
 }
 
 void OTFReader::close() {
+	// The helper thread may still be reading ahead, stop it before the trace goes
+	if(decodeThread.joinable()) {
+		ring.close();
+		decodeThread.join();
+	}
+
 	OTF_HandlerArray_close(handlers);
 	OTF_FileManager_close(fileMgr);
 	OTF_Reader_close(reader);
@@ -162,10 +245,22 @@ uint32_t OTFReader::generateNextEvents() {
 
 	while((eventQ->size() < qLimit) && (!foundFinalize)) {
 		std::cout << "Reading next event, queue size: " << eventQ->size() << std::endl;
-		if(OTF_READ_ERROR == OTF_Reader_readEvents(reader, handlers)) {
-			// We read zero events from the file, exit the loop
+
+		OTFTraceRecord* rec;
+		if(decodeThread.joinable()) {
+			rec = ring.front();
+		} else {
+			decodeAvailable();
+			rec = ring.tryFront();
+		}
+
+		if(NULL == rec) {
+			// The trace has no more records, exit the loop
 			break;
 		}
+
+		generateEvents(*rec);
+		ring.pop();
 	}
 
 	// Return the size of the queue back to the caller, they
@@ -187,3 +282,83 @@ void OTFReader::enqueueEvent(ZodiacEvent* ev) {
 	assert(eventQ->size() < qLimit);
 	eventQ->push(ev);
 }
+
+OTFTraceRecord* OTFReader::claimRecord() {
+	// Without a helper thread a slot is free whenever a record is read
+	return decodeThread.joinable() ? ring.claim() : ring.tryClaim();
+}
+
+void OTFReader::publishRecord() {
+	ring.publish();
+}
+
+void OTFReader::decodeLoop() {
+	while(!decodeDone) {
+		// Wait for a free slot here, a handler then claims it without waiting
+		if(NULL == ring.claim()) {
+			// The reader is being closed
+			break;
+		}
+
+		decodeNext();
+	}
+
+	ring.finish();
+}
+
+void OTFReader::decodeAvailable() {
+	// Without a helper thread the ring is refilled, a lookahead at a time, once it has been drained
+	if(NULL != ring.tryFront()) {
+		return;
+	}
+
+	while(!decodeDone && NULL != ring.tryClaim()) {
+		decodeNext();
+	}
+}
+
+void OTFReader::decodeNext() {
+	// The record limit is one, so this decodes at most one record
+	const uint64_t count = OTF_Reader_readEvents(reader, handlers);
+
+	if(0 == count || OTF_READ_ERROR == count) {
+		// End of the trace, or a handler aborted because the reader was closed
+		decodeDone = true;
+	}
+}
+
+void OTFReader::generateEvents(const OTFTraceRecord& rec) {
+	switch(rec.type) {
+	case OTFTraceRecord::SEND:
+		std::cout << "OTF: Send message from " << rec.process << " to " << rec.peer << " qSize=" << getCurrentQueueSize() << std::endl;
+		enqueueEvent(new ZodiacSendEvent(rec.peer, rec.length, HERMES_DOUBLE, 0, rec.group));
+		break;
+
+	case OTFTraceRecord::RECV:
+		std::cout << "OTF: Recv message from " << rec.peer << " to " << rec.process << " qSize=" << getCurrentQueueSize() << std::endl;
+		enqueueEvent(new ZodiacRecvEvent(rec.process, rec.length, HERMES_DOUBLE, 0, rec.group));
+		break;
+
+	case OTFTraceRecord::ENTER:
+		std::cout << "OTF: Entered function: " << rec.value << " on process: " << rec.process << " at time: " << rec.time << std::endl;
+		break;
+
+	case OTFTraceRecord::EXIT:
+		std::cout << "OTF: Exited function: " << rec.value << " on process: " << rec.process << " at time: " << rec.time << std::endl;
+		break;
+
+	case OTFTraceRecord::COLLECTIVE:
+		std::cout << "OTF: Performed a collective operation on process: " << rec.process << ", collective: " <<
+			rec.value << " at time: " << rec.time << std::endl;
+		break;
+
+	case OTFTraceRecord::BEGIN_COLLECTIVE:
+		std::cout << "OTF: Began a collective on process: " << rec.process << " collective: " << rec.value
+			<< " at time: " << rec.time << std::endl;
+		break;
+
+	case OTFTraceRecord::END_COLLECTIVE:
+		std::cout << "OTF: Ended a collective on process: " << rec.process << std::endl;
+		break;
+	}
+}
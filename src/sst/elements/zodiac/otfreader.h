@@ -24,11 +24,13 @@
 #include <string>
 #include <iostream>
 #include <queue>
+#include <thread>
 
 #include "sst/elements/hermes/msgapi.h"
 #include "zevent.h"
 #include "zsendevent.h"
 #include "zrecvevent.h"
+#include "tracering.h"
 #include "otf.h"
 
 using namespace std;
@@ -53,15 +55,43 @@ int handleOTFEndCollective(void *userData, uint64_t time, uint32_t process, uint
 namespace SST {
 namespace Zodiac {
 
+// One OTF record of the focus rank. Plain data, so it can be decoded away
+// from the simulation thread and acted on when it is consumed.
+struct OTFTraceRecord {
+	enum RecordType { ENTER, EXIT, SEND, RECV, COLLECTIVE, BEGIN_COLLECTIVE, END_COLLECTIVE };
+
+	RecordType type;
+	uint64_t time;
+	uint32_t process;
+	uint32_t peer;   // receiver of a send, sender of a receive
+	uint32_t value;  // function entered or exited, collective operation
+	uint32_t length;
+	uint32_t group;
+};
+
+/*
+ * Reads the OTF trace of one rank.
+ *
+ * The OTF handlers only decode records into a fixed ring of lookahead
+ * entries, either on a helper thread which runs ahead of the simulation
+ * (prefetch) or, when the ring runs dry, on the simulation thread itself.
+ * Messages are printed and events are created as the records are consumed.
+ */
 class OTFReader {
     public:
-	OTFReader(string file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue);
+	OTFReader(string file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue,
+		uint32_t lookahead = 256, bool prefetch = false);
+	~OTFReader();
         void close();
 	uint32_t generateNextEvents();
 	uint32_t getQueueLimit();
 	uint32_t getCurrentQueueSize();
 	void enqueueEvent(ZodiacEvent* ev);
 
+	// Called by the OTF handlers: the slot to decode the next record into, NULL once closed
+	OTFTraceRecord* claimRecord();
+	void publishRecord();
+
     private:
 	OTF_Reader* reader;
 	OTF_FileManager* fileMgr;
@@ -71,6 +101,16 @@ class OTFReader {
 	bool foundFinalize;
 	std::queue<ZodiacEvent*>* eventQ;
 
+	// Decoding side, owned by the helper thread when prefetching
+	TraceRing<OTFTraceRecord> ring;
+	std::thread decodeThread;
+	bool decodeDone;
+	void decodeLoop();
+	void decodeAvailable();
+	void decodeNext();
+
+	// Simulation side
+	void generateEvents(const OTFTraceRecord& rec);
 };
 
 }
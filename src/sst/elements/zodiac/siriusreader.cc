@@ -32,12 +32,12 @@ using namespace SST::Zodiac;
 #endif
 
 
-SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, std::queue<ZodiacEvent*>* evQ, int verbose)
+SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t lookahead, std::queue<ZodiacEvent*>* evQ, int verbose, bool prefetch) :
+	ring(lookahead)
 {
 
 	rank = focusOnRank;
 	eventQ = evQ;
-	qLimit = maxQLen;
 	foundFinalize = false;
 
 	trace = fopen(file, "rb");
@@ -47,8 +47,20 @@ SiriusReader::SiriusReader(char* file, uint32_t focusOnRank, uint32_t maxQLen, s
 	}
 
 	prevEventTime = 0;
+	decodeDone = false;
 	output = new Output("SiriusReader", verbose, 0, Output::STDOUT);
 	readInit();
+
+	if(prefetch) {
+		decodeThread = std::thread(&SiriusReader::decodeLoop, this);
+	}
+}
+
+SiriusReader::~SiriusReader() {
+	if(decodeThread.joinable()) {
+		ring.close();
+		decodeThread.join();
+	}
 }
 
 void SiriusReader::close() {
@@ -58,161 +70,206 @@ void SiriusReader::close() {
 		output->verbose(CALL_INFO, 4, 0, "Closing trace file.\n");
 	}
 
+	// The helper thread may still be reading ahead, stop it before the file goes
+	if(decodeThread.joinable()) {
+		ring.close();
+		decodeThread.join();
+	}
+
 	fclose(trace);
+	trace = NULL;
 }
 
 uint32_t SiriusReader::generateNextEvents() {
-//	int finalized_reached = 0;
+	SiriusTraceRecord* rec;
+
+	if(decodeThread.joinable()) {
+		rec = ring.front();
+	} else {
+		decodeAvailable();
+		rec = ring.tryFront();
+	}
 
-	while((foundFinalize == false) && (eventQ->size() < qLimit)) {
-		generateNextEvent();
+	if(NULL != rec) {
+		generateEvents(*rec);
+		ring.pop();
 	}
 
 	return (uint32_t) eventQ->size();
 }
 
 uint32_t SiriusReader::getQueueLimit() {
-	return qLimit;
+	return (uint32_t) ring.capacity();
 }
 
 uint32_t SiriusReader::getCurrentQueueSize() {
 	return eventQ->size();
 }
 
-void SiriusReader::generateNextEvent() {
-	uint32_t call_type = readUINT32();
-	double callTime = readTime();
-	double evTimeDiff = callTime - prevEventTime;
+void SiriusReader::decodeLoop() {
+	while(!decodeDone) {
+		SiriusTraceRecord* slot = ring.claim();
+		if(NULL == slot) {
+			// The reader is being closed
+			break;
+		}
+
+		if(decodeNext(*slot)) {
+			ring.publish();
+		}
+	}
 
-	if(evTimeDiff > 0) {
-		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0, "Generated a compute event (length=%f)\n", evTimeDiff);
-		ZodiacComputeEvent* ev = new ZodiacComputeEvent(evTimeDiff);
-		eventQ->push(ev);
-	} else {
-		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0,
-			"Did not generate next event timing prevTime=%f, callTime=%f, diff=%f\n",
-			prevEventTime, callTime, evTimeDiff);
+	ring.finish();
+}
+
+void SiriusReader::decodeAvailable() {
+	// Without a helper thread the ring is refilled, a lookahead at a time, once it has been drained
+	if(NULL != ring.tryFront()) {
+		return;
 	}
 
-	switch(call_type) {
-	case SIRIUS_MPI_SEND:
-		readSend();
-		break;
+	SiriusTraceRecord* slot;
+	while(!decodeDone && NULL != (slot = ring.tryClaim())) {
+		if(decodeNext(*slot)) {
+			ring.publish();
+		}
+	}
+}
+
+bool SiriusReader::decodeNext(SiriusTraceRecord& rec) {
+	rec.callType = readUINT32();
+	if(feof(trace)) {
+		// Trace ended without a finalize
+		decodeDone = true;
+		return false;
+	}
+
+	rec.callTime = readTime();
+	rec.prevEventTime = prevEventTime;
+	rec.computeTime = rec.callTime - prevEventTime;
 
+	uint64_t buffer;
+	uint64_t status;
+
+	switch(rec.callType) {
+	case SIRIUS_MPI_SEND:
 	case SIRIUS_MPI_RECV:
-		readRecv();
+		buffer    = readUINT64();
+		rec.count = readUINT32();
+		rec.dtype = readUINT32();
+		rec.peer  = readINT32();
+		rec.tag   = readINT32();
+		rec.comm  = readUINT32();
 		break;
 
 	case SIRIUS_MPI_IRECV:
-		readIrecv();
+		buffer    = readUINT64();
+		rec.count = readUINT32();
+		rec.dtype = readUINT32();
+		rec.peer  = readINT32();
+		rec.tag   = readINT32();
+		rec.comm  = readUINT32();
+		rec.req   = readUINT64();
 		break;
 
 	case SIRIUS_MPI_ALLREDUCE:
-		readAllreduce();
+		buffer    = readUINT64();
+		buffer    = readUINT64();
+		rec.count = readUINT32();
+		rec.dtype = readUINT32();
+		rec.op    = readUINT32();
+		rec.comm  = readUINT32();
 		break;
 
 	case SIRIUS_MPI_BARRIER:
-		readBarrier();
+		rec.comm  = readUINT32();
 		break;
 
 	case SIRIUS_MPI_WAIT:
-		readWait();
+		rec.req   = readUINT64();
+		status    = readUINT64();
 		break;
 
 	case SIRIUS_MPI_INIT:
-		readInit();
 		break;
 
 	case SIRIUS_MPI_FINALIZE:
-		readFinalize();
+		decodeDone = true;
 		break;
 
 	default:
-		std::cout << "Unknown MPI command in trace (" << call_type << ") position: " <<
+		std::cout << "Unknown MPI command in trace (" << rec.callType << ") position: " <<
 			ftell(trace) << std::endl;
 		exit(-1);
 		break;
 	}
 
-
 	// Read the profiled MPI time
 	prevEventTime = readTime();
 	// read the MPI function result
 	readINT32();
-}
 
-void SiriusReader::readAllreduce() {
-	uint64_t sbuff = readUINT64();
-	uint64_t rbuff = readUINT64();
-	uint32_t length = readUINT32();
-	uint32_t dtype = readUINT32();
-	uint32_t op    = readUINT32();
-	uint32_t comm  = readUINT32();
-
-	output->verbose(__LINE__, __FILE__, "readAllreduce", 8, 0, "Read an MPI_Allreduce\n");
-
-	ZodiacAllreduceEvent* ev = new ZodiacAllreduceEvent(
-			length,
-			convertToHermesType(dtype),
-			convertToHermesOp(op),
-			comm);
-	eventQ->push(ev);
+	return true;
 }
 
-void SiriusReader::readSend() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  dest   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-
-	output->verbose(__LINE__, __FILE__, "readSend", 8, 0, "Read an MPI_Send\n");
-
-	ZodiacSendEvent* ev = new ZodiacSendEvent((uint32_t) dest, count,
-		convertToHermesType(dtype), tag, comm);
-	eventQ->push(ev);
-}
-
-void SiriusReader::readRecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
+void SiriusReader::generateEvents(const SiriusTraceRecord& rec) {
+	if(rec.computeTime > 0) {
+		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0, "Generated a compute event (length=%f)\n", rec.computeTime);
+		ZodiacComputeEvent* ev = new ZodiacComputeEvent(rec.computeTime);
+		eventQ->push(ev);
+	} else {
+		output->verbose(__LINE__, __FILE__, "generateNextEvent", 8, 0,
+			"Did not generate next event timing prevTime=%f, callTime=%f, diff=%f\n",
+			rec.prevEventTime, rec.callTime, rec.computeTime);
+	}
 
-	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Recv\n");
+	switch(rec.callType) {
+	case SIRIUS_MPI_SEND:
+		output->verbose(__LINE__, __FILE__, "readSend", 8, 0, "Read an MPI_Send\n");
+		eventQ->push(new ZodiacSendEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm));
+		break;
 
-	ZodiacRecvEvent* ev = new ZodiacRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm);
-	eventQ->push(ev);
-}
+	case SIRIUS_MPI_RECV:
+		output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Recv\n");
+		eventQ->push(new ZodiacRecvEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm));
+		break;
 
-void SiriusReader::readIrecv() {
-	uint64_t buffer = readUINT64();
-	uint32_t count  = readUINT32();
-	uint32_t dtype  = readUINT32();
-	int32_t  src   = readINT32();
-	int32_t  tag    = readINT32();
-	uint32_t comm   = readUINT32();
-	uint64_t req    = readUINT64();
+	case SIRIUS_MPI_IRECV:
+		output->verbose(__LINE__, __FILE__, "readIrecv", 8, 0, "Read an MPI_Irecv\n");
+		eventQ->push(new ZodiacIRecvEvent((uint32_t) rec.peer, rec.count,
+			convertToHermesType(rec.dtype), rec.tag, rec.comm, rec.req));
+		break;
 
-	output->verbose(__LINE__, __FILE__, "readIrecv", 8, 0, "Read an MPI_Irecv\n");
+	case SIRIUS_MPI_ALLREDUCE:
+		output->verbose(__LINE__, __FILE__, "readAllreduce", 8, 0, "Read an MPI_Allreduce\n");
+		eventQ->push(new ZodiacAllreduceEvent(rec.count,
+			convertToHermesType(rec.dtype),
+			convertToHermesOp(rec.op),
+			rec.comm));
+		break;
 
-	ZodiacIRecvEvent* ev = new ZodiacIRecvEvent((uint32_t) src, count,
-		convertToHermesType(dtype), tag, comm, req);
-	eventQ->push(ev);
-}
+	case SIRIUS_MPI_BARRIER:
+		output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Barrier\n");
+		eventQ->push(new ZodiacBarrierEvent(rec.comm));
+		break;
 
-void SiriusReader::readWait() {
-	uint64_t reqID = readUINT64();
-	uint64_t status = readUINT64();
+	case SIRIUS_MPI_WAIT:
+		output->verbose(__LINE__, __FILE__, "readWait", 8, 0, "Read an MPI_Wait\n");
+		eventQ->push(new ZodiacWaitEvent(rec.req));
+		break;
 
-	output->verbose(__LINE__, __FILE__, "readWait", 8, 0, "Read an MPI_Wait\n");
+	case SIRIUS_MPI_INIT:
+		readInit();
+		break;
 
-	ZodiacWaitEvent* ev = new ZodiacWaitEvent(reqID);
-	eventQ->push(ev);
+	case SIRIUS_MPI_FINALIZE:
+		output->verbose(__LINE__, __FILE__, "readFinalize", 8, 0, "Read an MPI_Finalize\n");
+		eventQ->push(new ZodiacFinalizeEvent());
+		foundFinalize = true;
+		break;
+	}
 }
 
 void SiriusReader::readInit() {
@@ -221,24 +278,6 @@ void SiriusReader::readInit() {
 	eventQ->push(ev);
 }
 
-void SiriusReader::readFinalize() {
-	output->verbose(__LINE__, __FILE__, "readFinalize", 8, 0, "Read an MPI_Finalize\n");
-
-	ZodiacFinalizeEvent* ev = new ZodiacFinalizeEvent();
-	eventQ->push(ev);
-
-	foundFinalize = true;
-}
-
-void SiriusReader::readBarrier() {
-	uint32_t comm = readUINT32();
-
-	output->verbose(__LINE__, __FILE__, "readRecv", 8, 0, "Read an MPI_Barrier\n");
-
-	ZodiacBarrierEvent* ev = new ZodiacBarrierEvent(comm);
-	eventQ->push(ev);
-}
-
 uint32_t SiriusReader::readUINT32() {
 	uint32_t temp;
 	fread(&temp, 1, sizeof(uint32_t), trace);
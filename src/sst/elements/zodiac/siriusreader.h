@@ -25,6 +25,7 @@
 #include <string>
 #include <iostream>
 #include <queue>
+#include <thread>
 
 #include "sst/core/output.h"
 #include "sst/elements/hermes/msgapi.h"
@@ -41,6 +42,7 @@
 #include "zwaitevent.h"
 #include "zfinalizeevent.h"
 #include "zallredevent.h"
+#include "tracering.h"
 
 using namespace std;
 using namespace SST::Hermes;
@@ -49,9 +51,36 @@ using namespace SST::Hermes::MP;
 namespace SST {
 namespace Zodiac {
 
+// One MPI call read from a SIRIUS trace, together with the compute time
+// which preceded it. Plain data, so it can be decoded away from the
+// simulation thread and turned into Zodiac events when it is consumed.
+struct SiriusTraceRecord {
+	uint32_t callType;
+	double computeTime; // seconds since the previous call returned, no compute event if <= 0
+	double callTime;
+	double prevEventTime;
+	uint32_t count;
+	uint32_t dtype;
+	uint32_t op;
+	int32_t peer; // destination of a send, source of a receive
+	int32_t tag;
+	uint32_t comm;
+	uint64_t req;
+};
+
+/*
+ * Reads the SIRIUS trace of one rank.
+ *
+ * Records are decoded into a fixed ring of lookahead entries, either by a
+ * helper thread which runs ahead of the simulation (prefetch) or, when the
+ * ring runs dry, by the simulation thread itself. Events are only created
+ * as the component asks for them, so memory use is bounded by the lookahead
+ * whatever the length of the trace.
+ */
 class SiriusReader {
     public:
-	SiriusReader(char* file, uint32_t rank, uint32_t qLimit, std::queue<ZodiacEvent*>* eventQueue, int verbose);
+	SiriusReader(char* file, uint32_t rank, uint32_t lookahead, std::queue<ZodiacEvent*>* eventQueue, int verbose, bool prefetch = false);
+	~SiriusReader();
         void close();
 	void setOutput(Output* oput);
 	uint32_t generateNextEvents();
@@ -62,25 +91,27 @@ class SiriusReader {
     private:
 	Output* output;
 	uint32_t rank;
-	uint32_t qLimit;
 	bool foundFinalize;
 	std::queue<ZodiacEvent*>* eventQ;
 	FILE* trace;
+
+	// Decoding side, owned by the helper thread when prefetching
+	TraceRing<SiriusTraceRecord> ring;
+	std::thread decodeThread;
 	double prevEventTime;
-	void generateNextEvent();
+	bool decodeDone;
+	void decodeLoop();
+	void decodeAvailable();
+	bool decodeNext(SiriusTraceRecord& rec);
 	inline uint32_t readUINT32();
 	inline uint64_t readUINT64();
 	inline double readTime();
 	inline int32_t readINT32();
 	inline int64_t readINT64();
-	void readSend();
-	void readIrecv();
-	void readRecv();
+
+	// Simulation side
+	void generateEvents(const SiriusTraceRecord& rec);
 	void readInit();
-	void readFinalize();
-	void readBarrier();
-	void readWait();
-	void readAllreduce();
 
 	PayloadDataType convertToHermesType(uint32_t dtype);
 	ReductionOperation convertToHermesOp(uint32_t op);
@@ -8,6 +8,7 @@ iterations = 1;
 msgSize = 0;
 shape = "2"
 num_vNics = 1
+prefetch = 1
 
 netPktSizeBytes="64B"
 netFlitSize="8B"
@@ -17,8 +18,9 @@ def main():
     global msgSize
     global shape
     global num_vNics
+    global prefetch
     try:
-        opts, args = getopt.getopt(sys.argv[1:], "", ["msgSize=","iter=","shape=","numCores="])
+        opts, args = getopt.getopt(sys.argv[1:], "", ["msgSize=","iter=","shape=","numCores=","prefetch="])
     except getopt.GetopError as err:
         print (str(err))
         sys.exit(2)
@@ -31,6 +33,8 @@ def main():
             num_vNics = a
         elif o in ("--shape"):
             shape = a
+        elif o in ("--prefetch"):
+            prefetch = a
         else:
             assert False, "unhandle option" 
 
@@ -102,6 +106,7 @@ driverParams = ({
 		"sharedTrace" : "allred-128.stf",
 		"printStats" : 1,
 		"buffersize" : 140,
+		"prefetch" : prefetch,
 		"os.name" : "hermesParams",
 		"hermesParams.debug" : 0,
 		"hermesParams.verboseLevel" : 1,
@@ -60,6 +60,9 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
     def test_Sirius_Zodiac_128(self):
         self.SiriusZodiacTrace_test_template("8x8x2")
 
+    def test_Sirius_Zodiac_16_prefetch(self):
+        self.SiriusZodiacTrace_prefetch_test_template("4x4")
+
 #####
 
     def SiriusZodiacTrace_test_template(self, testcase, testtimeout = 60):
@@ -112,6 +115,50 @@ class testcase_SiriusZodiacTrace(SSTTestCase):
             log_failure(diffdata)
         self.assertTrue(cmp_result, "Sorted/Filtered output file {0} does not match Reference File {1}".format(tmpfile2, reffile))
 
+#####
+
+    def SiriusZodiacTrace_prefetch_test_template(self, testcase, testtimeout = 60):
+        # Decoding the traces on a helper thread (prefetch=1) or on the
+        # simulation thread (prefetch=0) must replay the same event stream
+        test_path = self.get_testsuite_dir()
+        outdir = self.get_test_output_run_dir()
+        tmpdir = self.get_test_output_tmp_dir()
+
+        self.testSiriusZodiacTraceDir = "{0}/testSiriusZodiacTrace".format(tmpdir)
+        self.testSiriusZodiacTraceTestsDir = "{0}/sst/elements/zodiac/test/allreduce".format(self.testSiriusZodiacTraceDir)
+
+        sdlfile = "{0}/allreduce/allreduce.py".format(test_path)
+        testDataFileName="test_Sirius_prefetch_{0}".format(testcase)
+
+        filtered = []
+        for prefetch in ("0", "1"):
+            runName = "{0}_{1}".format(testDataFileName, prefetch)
+            outfile = "{0}/{1}.out".format(outdir, runName)
+            errfile = "{0}/{1}.err".format(outdir, runName)
+            tmpfile = "{0}/{1}_filtered.tmp".format(outdir, runName)
+            mpioutfiles = "{0}/{1}.testfile".format(outdir, runName)
+            otherargs = '--model-options \"--shape={0} --prefetch={1}\"'.format(testcase, prefetch)
+
+            self.run_sst(sdlfile, outfile, errfile, mpi_out_files=mpioutfiles,
+                         other_args=otherargs, set_cwd=self.testSiriusZodiacTraceTestsDir,
+                         timeout_sec=testtimeout)
+
+            if os_test_file(errfile, "-s"):
+                log_testing_note("SiriusZodiacTrace test {0} has a Non-Empty Error File {1}".format(runName, errfile))
+
+            # Per-rank event counts and bytes, and the simulated time
+            cmd = "grep -e 'Total ' -e 'simulated time' {0} | sort > {1}".format(outfile, tmpfile)
+            os.system(cmd)
+            filtered.append(tmpfile)
+
+        self.assertTrue(os_test_file(filtered[0], "-s"), "SiriusZodiacTrace test {0} produced no statistics".format(testDataFileName))
+
+        cmp_result = testing_compare_diff(testDataFileName, filtered[0], filtered[1])
+        if (cmp_result == False):
+            diffdata = testing_get_diff_data(testDataFileName)
+            log_failure(diffdata)
+        self.assertTrue(cmp_result, "Output with prefetch=0 {0} does not match output with prefetch=1 {1}".format(filtered[0], filtered[1]))
+
 #####
 
     def _setupSiriusZodiacTraceTestFiles(self):
@@ -0,0 +1,175 @@
+// Copyright 2009-2021 NTESS. Under the terms
+// of Contract DE-NA0003525 with NTESS, the U.S.
+// Government retains certain rights in this software.
+//
+// Copyright (c) 2009-2021, NTESS
+// All rights reserved.
+//
+// Portions are copyright of other developers:
+// See the file CONTRIBUTORS.TXT in the top level directory
+// the distribution for more information.
+//
+// This file is part of the SST software package. For license
+// information, see the LICENSE file in the top level directory of the
+// distribution.
+
+
+#ifndef _H_ZODIAC_TRACE_RING
+#define _H_ZODIAC_TRACE_RING
+
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace SST {
+namespace Zodiac {
+
+/*
+ * Fixed-size single-producer/single-consumer ring of decoded trace records.
+ *
+ * The slots are allocated once and reused, so the records held ahead of the
+ * simulation never exceed the capacity, however long the trace is. Handing a
+ * record over is lock-free; the mutex is only taken by a side that has to
+ * sleep because the ring is full (producer) or empty (consumer), and by the
+ * other side when it sees it must wake it. A sleeping producer is only woken
+ * once a quarter of the ring is free, so it refills in batches.
+ *
+ * The producer calls claim()/tryClaim(), fills the slot and publish()es it,
+ * then finish() after the last record. The consumer reads front()/tryFront()
+ * and pop()s, and may close() the ring early to release the producer.
+ */
+template<typename T>
+class TraceRing {
+    public:
+	TraceRing(uint32_t minCapacity) : head(0), tail(0), finishedFlag(false), closedFlag(false),
+		producerWaiting(false), consumerWaiting(false) {
+
+		uint64_t capacity = 1;
+		while(capacity < minCapacity) {
+			capacity <<= 1;
+		}
+
+		slots.resize(capacity);
+		mask = capacity - 1;
+		refill = (capacity + 3) / 4;
+	}
+
+	uint64_t capacity() const { return mask + 1; }
+
+	// Producer: the next slot to fill, NULL if the ring is full
+	T* tryClaim() {
+		const uint64_t t = tail.load(std::memory_order_relaxed);
+		if(t - head.load(std::memory_order_acquire) > mask) {
+			return NULL;
+		}
+		return &slots[t & mask];
+	}
+
+	// Producer: the next slot to fill, waiting for space. NULL once the consumer has closed the ring.
+	T* claim() {
+		T* slot = tryClaim();
+		if(NULL != slot || closedFlag.load()) {
+			return slot;
+		}
+
+		std::unique_lock<std::mutex> lock(waitLock);
+		producerWaiting.store(true);
+		waitCond.wait(lock, [this]{ return closedFlag.load() ||
+			(capacity() - (tail.load(std::memory_order_relaxed) - head.load())) >= refill; });
+		producerWaiting.store(false);
+
+		return closedFlag.load() ? NULL : tryClaim();
+	}
+
+	// Producer: hand the claimed slot to the consumer
+	void publish() {
+		tail.store(tail.load(std::memory_order_relaxed) + 1);
+		if(consumerWaiting.load()) {
+			wake();
+		}
+	}
+
+	// Producer: no more records will be published
+	void finish() {
+		finishedFlag.store(true);
+		if(consumerWaiting.load()) {
+			wake();
+		}
+	}
+
+	// Consumer: the oldest published record, NULL if none is available yet
+	T* tryFront() {
+		const uint64_t h = head.load(std::memory_order_relaxed);
+		if(h == tail.load(std::memory_order_acquire)) {
+			return NULL;
+		}
+		return &slots[h & mask];
+	}
+
+	// Consumer: the oldest record, waiting for the producer. NULL once the ring is finished and drained.
+	T* front() {
+		T* slot = tryFront();
+		if(NULL != slot) {
+			return slot;
+		}
+
+		{
+			std::unique_lock<std::mutex> lock(waitLock);
+			consumerWaiting.store(true);
+			waitCond.wait(lock, [this]{ return finishedFlag.load() || tail.load() != head.load(std::memory_order_relaxed); });
+			consumerWaiting.store(false);
+		}
+
+		// A record published just before finish() is still delivered
+		return tryFront();
+	}
+
+	// Consumer: release the record returned by front()
+	void pop() {
+		const uint64_t h = head.load(std::memory_order_relaxed) + 1;
+		head.store(h);
+		if(producerWaiting.load() && (capacity() - (tail.load() - h)) >= refill) {
+			wake();
+		}
+	}
+
+	// Consumer: stop reading, a producer waiting for space gives up
+	void close() {
+		closedFlag.store(true);
+		wake();
+	}
+
+	bool finished() const { return finishedFlag.load(); }
+
+    private:
+	void wake() {
+		// Taking the lock orders this with a waiter that has set its flag but not yet slept
+		{
+			std::lock_guard<std::mutex> lock(waitLock);
+		}
+		waitCond.notify_all();
+	}
+
+	std::vector<T> slots;
+	uint64_t mask;
+	uint64_t refill;
+
+	// head is only written by the consumer and tail by the producer
+	std::atomic<uint64_t> head;
+	std::atomic<uint64_t> tail;
+	std::atomic<bool> finishedFlag;
+	std::atomic<bool> closedFlag;
+
+	std::mutex waitLock;
+	std::condition_variable waitCond;
+	std::atomic<bool> producerWaiting;
+	std::atomic<bool> consumerWaiting;
+};
+
+}
+}
+
+#endif
@@ -52,9 +52,16 @@ ZodiacOTFTraceReader::ZodiacOTFTraceReader(ComponentId_t id, Params& params) :
     std::cout << "Creating a new event queue..." << std::endl;
     eventQ = new std::queue<ZodiacEvent*>();
 
+    uint32_t lookahead = params.find<uint32_t>("lookahead", 256);
+    if(0 == lookahead) {
+	std::cerr << "Error: lookahead must be at least 1" << std::endl;
+	exit(-1);
+    }
+    bool prefetch = params.find<bool>("prefetch", true);
+
     // Create a new reader and set it so that we only process one record per call
     std::cout << "Creating a new OTF Reader..." << std::endl;
-    reader = new OTFReader(trace_file, rank, 64, eventQ);
+    reader = new OTFReader(trace_file, rank, 64, eventQ, lookahead, prefetch);
 
     registerAsPrimaryComponent();
     primaryComponentDoNotEndSim();
@@ -69,6 +69,13 @@ ZodiacSiriusTraceReader::ZodiacSiriusTraceReader(ComponentId_t id, Params& param
 
     eventQ = new std::queue<ZodiacEvent*>();
 
+    traceLookahead = params.find<uint32_t>("lookahead", 256);
+    if(0 == traceLookahead) {
+        std::cerr << "Error: lookahead must be at least 1" << std::endl;
+        exit(-1);
+    }
+    tracePrefetch = params.find<bool>("prefetch", true);
+
     verbosityLevel = params.find("verbose", 0);
     std::cout << "Set verbosity level to " << verbosityLevel << std::endl;
 
@@ -101,7 +108,7 @@ void ZodiacSiriusTraceReader::setup() {
     sprintf(trace_name, "%s.%d", trace_file.c_str(), rank);
 
     printf("Opening trace file: %s\n", trace_name);
-    trace = new SiriusReader(trace_name, rank, 64, eventQ, verbosityLevel);
+    trace = new SiriusReader(trace_name, rank, traceLookahead, eventQ, verbosityLevel, tracePrefetch);
     trace->setOutput(&zOut);
 
     int count = trace->generateNextEvents();
@@ -62,6 +62,8 @@ public:
 	{ "scalecompute", "Scale compute event times by a double precision value (allows dilation of times in traces), default is 1.0", "1.0" },
 	{ "verbose", "Sets the verbosity level for the component to output debug/information messages", "0" },
 	{ "buffer", "Sets the size of the buffer to use for message data backing, default is 4096 bytes", "4096" },
+	{ "lookahead", "Number of trace records which may be decoded ahead of the simulation, bounds the memory used by the reader", "256" },
+	{ "prefetch", "Decode the trace on a helper thread, overlapping it with the simulation (0 = decode on the simulation thread)", "1" },
     	{ "name","used internally","" },
     	{ "module","used internally","" }
   )
@@ -130,6 +132,8 @@ private:
   int rank;
   string trace_file;
   int verbosityLevel;
+  uint32_t traceLookahead;
+  bool tracePrefetch;
 
   uint64_t zSendCount;
   uint64_t zRecvCount;